@@ -24,7 +24,7 @@
 
 using namespace std; 
 
-int KE_model_comparisons() {
+int KE_model_comparisons( unsigned int n_threads = 0 ) {
 
     // -------------------------------------------------------------------------
     // Normalisation:
@@ -59,7 +59,7 @@ int KE_model_comparisons() {
     //                              Open flux file
     // -------------------------------------------------------------------------
     
-    TFile f_flux("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root");
+    TFile f_flux( InputPath("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root").c_str() );
     if (f_flux.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -73,7 +73,7 @@ int KE_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Default
-    TFile f1_xsec("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root");
+    TFile f1_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root").c_str() );
     if (f1_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -83,7 +83,7 @@ int KE_model_comparisons() {
     }
     
     // Default+MEC
-    TFile f2_xsec("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root");
+    TFile f2_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root").c_str() );
     if (f2_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -93,7 +93,7 @@ int KE_model_comparisons() {
     }
     
     // G16_02b
-    TFile f3_xsec("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root");
+    TFile f3_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root").c_str() );
     if (f3_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -103,7 +103,7 @@ int KE_model_comparisons() {
     }
     
     // G16_01a
-    TFile f4_xsec("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root");
+    TFile f4_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root").c_str() );
     if (f4_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -113,7 +113,7 @@ int KE_model_comparisons() {
     }
     
     // G16_01b
-    TFile f5_xsec("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root");
+    TFile f5_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root").c_str() );
     if (f5_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -127,7 +127,7 @@ int KE_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Open Default
-    TFile f1("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root");
+    TFile f1( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f1.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -137,7 +137,7 @@ int KE_model_comparisons() {
     }
 
     // Open Default+MEC
-    TFile f2("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root");
+    TFile f2( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f2.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -147,7 +147,7 @@ int KE_model_comparisons() {
     }
 
     // Open G16_02b
-    TFile f3("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root");
+    TFile f3( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f3.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -157,7 +157,7 @@ int KE_model_comparisons() {
     }
 
     // Open G16_01a
-    TFile f4("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root");
+    TFile f4( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f4.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -167,7 +167,7 @@ int KE_model_comparisons() {
     }
 
     // Open G16_01b
-    TFile f5("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root");
+    TFile f5( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f5.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -186,6 +186,28 @@ int KE_model_comparisons() {
     TTree *gst3 = (TTree*) f3.Get("gst");
     TTree *gst4 = (TTree*) f4.Get("gst");
     TTree *gst5 = (TTree*) f5.Get("gst");
+
+    // -------------------------------------------------------------------------
+    //                     Set up the reads of the gst trees
+    // -------------------------------------------------------------------------
+    // Only the branches needed by the fills below are read from the files
+    // With n_threads > 1 the branches are read and unzipped in parallel
+    vector< string > planned_fills;
+
+    planned_fills.push_back( "El" );
+    planned_fills.push_back( "Ev" );
+    planned_fills.push_back( "pl" );
+    planned_fills.push_back( "cthl" );
+    planned_fills.push_back( "cc && (nfpip + nfpim + nfpi0 == 0)" );
+    planned_fills.push_back( "nc && (nfpip + nfpim + nfpi0 == 0)" );
+
+    SetGstThreads( n_threads );
+
+    OpenGstReader( gst1, planned_fills );
+    OpenGstReader( gst2, planned_fills );
+    OpenGstReader( gst3, planned_fills );
+    OpenGstReader( gst4, planned_fills );
+    OpenGstReader( gst5, planned_fills );
    
     // Vector of doubles for the reconstructed energy
     vector< double > MC_reco_1_CC;
@@ -471,7 +493,120 @@ int KE_model_comparisons() {
     delete h3_reco_NC;
     delete h4_reco_NC;
     delete h5_reco_NC;
-    
+
+    // -------------------------------------------------------------------------
+    //                  Energy estimators and migrations
+    // -------------------------------------------------------------------------
+    // The CCQE, calorimetric and proton corrected energies of CC0pi and CC1pi
+    // for each model, all from one pass over its events
+    TTree *estimator_trees[5] = { gst1, gst2, gst3, gst4, gst5 };
+
+    const int n_estimator_topologies = 2;
+    int         estimator_topologies[n_estimator_topologies] = { kCC0Pi, kCC1Pi };
+    const char* estimator_labels[n_estimator_topologies]     = { "CC0pi", "CC1pi" };
+
+    TFile f_migrations( "energy_migrations.root", "RECREATE" );
+
+    vector< vector< TH1D* > > estimator_stacks( kNEstimators );
+
+    // The CC0pi response of each estimator for each model, for the bias test
+    vector< vector< ResponseMatrix > > cc0pi_responses( kNEstimators, vector< ResponseMatrix >( 5 ) );
+
+    for( int i = 0; i < 5; ++i ){
+
+        vector< EnergyMigration > migrations;
+
+        for( int t = 0; t < n_estimator_topologies; ++t ){
+            for( int e = 0; e < kNEstimators; ++e ){
+                EnergyMigration migration;
+                migration.estimator     = e;
+                migration.topology_mask = TopologyBit( estimator_topologies[t] );
+                BookSparseMigration( migration.matrix, 60, 0, 3 );
+                migrations.push_back( migration );
+            }
+        }
+
+        RunEnergyMigrations( estimator_trees[i], migrations );
+
+        for( unsigned int m = 0; m < migrations.size(); ++m ){
+
+            int t = m / kNEstimators;
+            int e = migrations[m].estimator;
+
+            TH2D *h_migration = new TH2D( Form( "h%d_migration_%s_%s", i + 1, EstimatorName( e ), estimator_labels[t] ),
+                                          Form( "True vs %s E_{#nu}, %s", EstimatorName( e ), estimator_labels[t] ),
+                                          60, 0, 3, 60, 0, 3 );
+            MigrationToTH2( migrations[m].matrix, h_migration );
+            h_migration->Write();
+
+            // The reconstructed CC0pi energies of the models for each estimator
+            if( t == 0 ){
+                BuildResponseMatrix( migrations[m].matrix, cc0pi_responses[e][i] );
+
+                TH1D *h_reco = new TH1D( Form( "h%d_reco_%s_cc0pi", i + 1, EstimatorName( e ) ),
+                                         Form( "%s E_{#nu}, CC0#pi", EstimatorName( e ) ), 60, 0, 3 );
+                h_reco->SetDirectory( 0 );
+                MigrationRecoTH1( migrations[m].matrix, h_reco );
+                estimator_stacks[e].push_back( h_reco );
+            }
+        }
+    }
+
+    f_migrations.Close();
+
+    for( int e = 0; e < kNEstimators; ++e ){
+
+        HistStacker(estimator_stacks[e], leg_entries, norms, Form( "Neutrino %s energies, CC0#pi", EstimatorName( e ) ),
+                    Form( "Reco_%s_CC0Pi_Plot.png", EstimatorName( e ) ), "E_{#nu}", "Number of SBND events");
+
+        for( unsigned int i = 0; i < estimator_stacks[e].size(); ++i ){
+            delete estimator_stacks[e][i];
+        }
+    }
+
+    // Unfold the CC0pi energies of each model with the response of every
+    // other model, the chi2 to the true energies of the model unfolded
+    ofstream file_unfolding;
+    file_unfolding.open( "unfolding_bias_CC0pi.txt" );
+
+    const char* model_names[5] = { "Default", "Default + MEC", "G17_02b", "G17_01a", "G17_01b" };
+
+    for( int e = 0; e < kNEstimators; ++e ){
+
+        vector< UnfoldBias > bias;
+        UnfoldBiasTest( cc0pi_responses[e], 4, bias );
+
+        file_unfolding << " " << EstimatorName( e ) << " energy, 4 iterations, chi2 of data model (row) unfolded with response model (column) " << endl;
+        for( int i = 0; i < 5; ++i ){
+            file_unfolding << setw(16) << model_names[i];
+            for( int j = 0; j < 5; ++j ){
+                file_unfolding << setw(14) << bias[ i * 5 + j ].chi2;
+            }
+            file_unfolding << endl;
+        }
+        file_unfolding << endl;
+    }
+
+    file_unfolding.close();
+
+    // -------------------------------------------------------------------------
+    //                          I/O run summary
+    // -------------------------------------------------------------------------
+    ofstream file_io;
+    file_io.open( "KE_model_comparisons_run_summary.txt" );
+
+    GstIOReport( gst1, "Default", file_io );
+    GstIOReport( gst2, "Default + MEC", file_io );
+    GstIOReport( gst3, "G17_02b", file_io );
+    GstIOReport( gst4, "G17_01a", file_io );
+    GstIOReport( gst5, "G17_01b", file_io );
+
+    CloseGstReader( gst1 );
+    CloseGstReader( gst2 );
+    CloseGstReader( gst3 );
+    CloseGstReader( gst4 );
+    CloseGstReader( gst5 );
+
     return 0;
 }
 
@@ -666,74 +801,93 @@ void RecoNuE( TTree *event_tree,
               vector< double > &reco_E_CC, 
               vector< double > &reco_E_NC,
               vector< double > &MC_reco_E_CC, 
-              vector< double > &MC_reco_E_NC ){
-
-    // Get the branches to calculate reconstructed energy and MC energy
-    TBranch *b_mu_e  = event_tree->GetBranch("El");
-    TBranch *b_nu_e  = event_tree->GetBranch("Ev");
-    TBranch *b_mu_p  = event_tree->GetBranch("pl");
-    TBranch *b_theta = event_tree->GetBranch("cthl");
-    TBranch *b_nfpi0 = event_tree->GetBranch("nfpi0");
-    TBranch *b_nfpip = event_tree->GetBranch("nfpip");
-    TBranch *b_nfpim = event_tree->GetBranch("nfpim");
-    TBranch *b_cc    = event_tree->GetBranch("cc");
-    TBranch *b_nc    = event_tree->GetBranch("nc");
-    TBranch *b_pdgf  = event_tree->GetBranch("pdgf");
+              vector< double > &MC_reco_E_NC,
+              bool full_tree ){
+
+    // The CC0pi and NC0pi skims hold every event used here, when written,
+    // unless the full tree is asked for
+    vector< int > reco_topologies;
+    reco_topologies.push_back( kCC0Pi );
+    reco_topologies.push_back( kNC0Pi );
+
+    s_branches reco_branches;
+    const char* reco_names[9] = { "El", "Ev", "pl", "cthl", "nfpi0", "nfpip", "nfpim", "cc", "nc" };
+    reco_branches.insert( reco_names, reco_names + 9 );
+
+    vector< TTree* > reco_trees( 1, event_tree );
+    if( !full_tree ) GstSkimTrees( event_tree, reco_topologies, reco_branches, reco_trees );
+
+    for( unsigned int t = 0; t < reco_trees.size(); ++t ){
+
+        TTree *reco_tree = reco_trees[t];
+
+        // Get the branches to calculate reconstructed energy and MC energy
+        TBranch *b_mu_e  = reco_tree->GetBranch("El");
+        TBranch *b_nu_e  = reco_tree->GetBranch("Ev");
+        TBranch *b_mu_p  = reco_tree->GetBranch("pl");
+        TBranch *b_theta = reco_tree->GetBranch("cthl");
+        TBranch *b_nfpi0 = reco_tree->GetBranch("nfpi0");
+        TBranch *b_nfpip = reco_tree->GetBranch("nfpip");
+        TBranch *b_nfpim = reco_tree->GetBranch("nfpim");
+        TBranch *b_cc    = reco_tree->GetBranch("cc");
+        TBranch *b_nc    = reco_tree->GetBranch("nc");
+        TBranch *b_pdgf  = reco_tree->GetBranch("pdgf");
     
-    // The variables from the branches and get the leaves
-    double m_n   = 0.93828;   // Nucleon mass, GeV
-    double m_mu  = 0.10566;   // Muon mass, GeV
+        // The variables from the branches and get the leaves
+        double m_n   = 0.93828;   // Nucleon mass, GeV
+        double m_mu  = 0.10566;   // Muon mass, GeV
 
-    int n_values = event_tree->GetEntries(); // Number of entries to loop over
-    int zero_count = 0;
+        int n_values = reco_tree->GetEntries(); // Number of entries to loop over
+        int zero_count = 0;
     
-    // Loop over the leaves and calculate the reconstructed energy
-    for( int i = 0; i < n_values; ++i){
+        // Loop over the leaves and calculate the reconstructed energy
+        for( int i = 0; i < n_values; ++i){
         
-        event_tree->GetEntry(i);
+            ReadGstEntry( reco_tree, i );
 
-        double reco, reco_mc, e, p, cth;
+            double reco, reco_mc, e, p, cth;
         
-        // For CC0pi
-        if( b_cc->GetLeaf("cc")->GetValue() != 0 
-            && b_nfpip->GetLeaf("nfpip")->GetValue()
-             + b_nfpim->GetLeaf("nfpim")->GetValue()
-             + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){ 
+            // For CC0pi
+            if( b_cc->GetLeaf("cc")->GetValue() != 0 
+                && b_nfpip->GetLeaf("nfpip")->GetValue()
+                 + b_nfpim->GetLeaf("nfpim")->GetValue()
+                 + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){ 
          
-                // Get the values needed
-                e   = b_mu_e->GetLeaf("El")->GetValue();
-                p   = b_mu_p->GetLeaf("pl")->GetValue();
-                cth = b_theta->GetLeaf("cthl")->GetValue(); 
+                    // Get the values needed
+                    e   = b_mu_e->GetLeaf("El")->GetValue();
+                    p   = b_mu_p->GetLeaf("pl")->GetValue();
+                    cth = b_theta->GetLeaf("cthl")->GetValue(); 
 
 
-                reco = TMath::Abs( ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ) ); 
+                    reco = TMath::Abs( ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ) ); 
         
-                reco_mc = reco - double(b_nu_e->GetLeaf("Ev")->GetValue());
+                    reco_mc = reco - double(b_nu_e->GetLeaf("Ev")->GetValue());
         
-                // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
-                MC_reco_E_CC.push_back(reco_mc);
-                reco_E_CC.push_back(reco);
-
-        }
-        // For NC0pi
-        else if( b_nc->GetLeaf("nc")->GetValue() != 0 
-                 && b_nfpip->GetLeaf("nfpip")->GetValue()
-                  + b_nfpim->GetLeaf("nfpim")->GetValue()
-                  + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
+                    // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
+                    MC_reco_E_CC.push_back(reco_mc);
+                    reco_E_CC.push_back(reco);
+
+            }
+            // For NC0pi
+            else if( b_nc->GetLeaf("nc")->GetValue() != 0 
+                     && b_nfpip->GetLeaf("nfpip")->GetValue()
+                      + b_nfpim->GetLeaf("nfpim")->GetValue()
+                      + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
               
-                // Get the values
-                e   = b_mu_e->GetLeaf("El")->GetValue();
-                p   = b_mu_p->GetLeaf("pl")->GetValue();
-                cth = b_theta->GetLeaf("cthl")->GetValue(); 
+                    // Get the values
+                    e   = b_mu_e->GetLeaf("El")->GetValue();
+                    p   = b_mu_p->GetLeaf("pl")->GetValue();
+                    cth = b_theta->GetLeaf("cthl")->GetValue(); 
             
-                reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
+                    reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
         
-                reco_mc = reco - double(b_nu_e->GetLeaf("Ev")->GetValue());
+                    reco_mc = reco - double(b_nu_e->GetLeaf("Ev")->GetValue());
 
-                // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
-                MC_reco_E_NC.push_back(reco_mc);
-                reco_E_NC.push_back(reco);
+                    // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
+                    MC_reco_E_NC.push_back(reco_mc);
+                    reco_E_NC.push_back(reco);
 
+            }
         }
     }
 }
@@ -777,7 +931,7 @@ void FSPNumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
         
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
      
         // Count #final state leptons
         if( b_fspl->GetLeaf("fspl")->GetValue() == 13 ){
@@ -909,7 +1063,7 @@ void FSINumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
     
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
     
         // Charged current
         // CC0Pi
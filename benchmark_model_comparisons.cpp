@@ -0,0 +1,549 @@
+/*
+ * A root macro to benchmark the model comparison macros on synthetic
+ * samples of increasing size
+ *
+ * For each sample size this times:
+ *      - each helper declared in model_comparisons.h (Norm, HistStacker,
+ *        RecoNuE, FSPNumbers, FSINumbers and MakeTable), reading either
+ *        all of the gst branches or only those planned by OpenGstReader
+ *      - filling a histogram with TTree::Draw and with FlatDraw, with
+ *        and without the compiled expressions
+ *      - the fills of one model through each backend of the fill engine,
+ *        TTreeFormula, compiled expressions and RDataFrame, for each
+ *        thread count
+ *      - the end-to-end run of the six analysis macros, for each thread
+ *        count, each macro being run in its own root process
+ *
+ * The samples are made with make_synthetic_gst.cpp below bench_samples/
+ * if they do not already exist, and the results are written to JSON
+ * together with the commit they were taken at so that they can be
+ * compared between commits
+ *
+ * Run from the top of the repository:
+ *      root -l -b -q load_modules.cpp 'benchmark_model_comparisons.cpp+("1000,10000,100000", "1,2,4")'
+ *
+*/
+
+// The helpers are the ones used by model_comparisons
+#include "model_comparisons.cpp"
+#include "TStopwatch.h"
+#include "TSystem.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// A single timing:
+//      name      : the helper or macro which was timed
+//      variant   : how the gst tree was read, or "end_to_end"
+//      n_events  : the number of events in each sample file
+//      n_threads : the thread budget for reading the gst trees
+//      repeats   : the number of calls the times are summed over
+//      real_time : wall clock time per call (s)
+//      cpu_time  : cpu time per call (s)
+//      status    : "ok", "failed" for a macro which exited with an error,
+//                  or "incomplete" for a total which leaves failed runs out
+// -------------------------------------------------------------------------
+struct BenchResult {
+    string       name;
+    string       variant;
+    Long64_t     n_events;
+    unsigned int n_threads;
+    int          repeats;
+    double       real_time;
+    double       cpu_time;
+    string       status;
+};
+
+typedef vector< BenchResult > v_bench;
+
+// -------------------------------------------------------------------------
+// Split a comma separated list of numbers
+// -------------------------------------------------------------------------
+vector< Long64_t > BenchList( const char* list ){
+
+    vector< Long64_t > values;
+    stringstream ss( list );
+    string item;
+
+    while( getline( ss, item, ',' ) ){
+        if( item.find_first_not_of(" ") == string::npos ) continue;
+        values.push_back( atoll( item.c_str() ) );
+    }
+
+    return values;
+}
+
+// -------------------------------------------------------------------------
+// Keep the time from a stopped stopwatch
+// -------------------------------------------------------------------------
+void AddBenchResult( v_bench &results,
+                     const string &name,
+                     const string &variant,
+                     Long64_t n_events,
+                     unsigned int n_threads,
+                     int repeats,
+                     TStopwatch &timer ){
+
+    BenchResult result;
+    result.name      = name;
+    result.variant   = variant;
+    result.n_events  = n_events;
+    result.n_threads = n_threads;
+    result.repeats   = repeats;
+    result.real_time = timer.RealTime() / repeats;
+    result.cpu_time  = timer.CpuTime() / repeats;
+    result.status    = "ok";
+    results.push_back( result );
+
+    cout << setw(14) << name << setw(18) << variant << setw(12) << n_events
+         << setw(4) << n_threads << setw(14) << setprecision(4) << result.real_time << " s " << endl;
+}
+
+// -------------------------------------------------------------------------
+// The directory holding the synthetic sample with n_events per model,
+// which is made if it does not exist yet
+// -------------------------------------------------------------------------
+string BenchSample( const string &repo_dir,
+                    Long64_t n_events ){
+
+    string dir = repo_dir + "/bench_samples/" + to_string( n_events );
+    string gst = dir + "/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root";
+
+    // AccessPathName is true if the file does not exist
+    if( gSystem->AccessPathName( gst.c_str() ) ){
+
+        string command = "cd " + repo_dir + " && root -l -b -q load_modules.cpp"
+                       + " 'make_synthetic_gst.cpp+(" + to_string( n_events ) + ", \"" + dir + "\")'"
+                       + " > " + dir + ".log 2>&1";
+
+        gSystem->mkdir( dir.c_str(), kTRUE );
+
+        if( gSystem->Exec( command.c_str() ) != 0 ){
+            cerr << " Could not make the synthetic sample, see " << dir << ".log " << endl;
+            exit(1);
+        }
+    }
+
+    return dir;
+}
+
+// -------------------------------------------------------------------------
+// Time the helpers on one sample
+// -------------------------------------------------------------------------
+void BenchHelpers( const string &sample_dir,
+                   Long64_t n_events,
+                   v_bench &results ){
+
+    gSystem->Setenv( "SBND_INPUT_DIR", sample_dir.c_str() );
+
+    TFile f_flux( InputPath("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root").c_str() );
+    TFile f_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root").c_str() );
+    TFile f_gst( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
+
+    if( f_flux.IsZombie() || f_xsec.IsZombie() || f_gst.IsZombie() ){
+        cerr << " Error opening the synthetic sample in " << sample_dir << endl;
+        exit(1);
+    }
+
+    TTree *gst = (TTree*) f_gst.Get("gst");
+
+    TStopwatch timer;
+    ostringstream sink;
+
+    // Norm
+    int n_norm = 100;
+    double norm = 0;
+    timer.Start();
+    for( int i = 0; i < n_norm; ++i ){
+        norm = Norm( int( n_events ), f_xsec, f_flux );
+    }
+    timer.Stop();
+    AddBenchResult( results, "Norm", "-", n_events, 1, n_norm, timer );
+
+    // The loops, reading all of the branches then only the planned ones
+    vector< string > fsi_fills;
+    fsi_fills.push_back( "cc && nc && coh && nfpip + nfpim + nfpi0" );
+
+    vector< string > reco_fills;
+    reco_fills.push_back( "El + Ev + pl + cthl" );
+    reco_fills.push_back( "cc && nc && nfpip + nfpim + nfpi0" );
+
+    vector< string > fsp_fills;
+    fsp_fills.push_back( "fspl + nfp + nfn + nfpip + nfpim + nfpi0" );
+
+    vector< double > n_cc_fsi, n_nc_fsi, n_cc_mc_fsi, n_nc_mc_fsi;
+
+    for( int planned = 0; planned < 2; ++planned ){
+
+        string variant = planned ? "planned_branches" : "all_branches";
+
+        vector< double > reco_cc, reco_nc, mc_reco_cc, mc_reco_nc;
+        m_map n_fsp;
+
+        n_cc_fsi.clear();
+        n_nc_fsi.clear();
+        n_cc_mc_fsi.clear();
+        n_nc_mc_fsi.clear();
+
+        if( planned ) OpenGstReader( gst, fsi_fills, false );
+        timer.Start();
+        FSINumbers( gst, sink, norm, n_cc_fsi, n_nc_fsi, n_cc_mc_fsi, n_nc_mc_fsi );
+        timer.Stop();
+        AddBenchResult( results, "FSINumbers", variant, n_events, 1, 1, timer );
+
+        if( planned ) OpenGstReader( gst, reco_fills, false );
+        timer.Start();
+        RecoNuE( gst, reco_cc, reco_nc, mc_reco_cc, mc_reco_nc );
+        timer.Stop();
+        AddBenchResult( results, "RecoNuE", variant, n_events, 1, 1, timer );
+
+        if( planned ) OpenGstReader( gst, fsp_fills, false );
+        timer.Start();
+        FSPNumbers( gst, n_fsp );
+        timer.Stop();
+        AddBenchResult( results, "FSPNumbers", variant, n_events, 1, 1, timer );
+
+        CloseGstReader( gst );
+        gst->SetBranchStatus( "*", 1 );
+    }
+
+    // MakeTable, the same model five times over
+    m_outer cc_model_ints;
+    m_outer nc_model_ints;
+    vector< string > FHS;
+    for( int i = 0; i < 5; ++i ){
+        cc_model_ints.insert( pair< string, vector< double > >( "Model " + to_string(i), n_cc_fsi ) );
+        nc_model_ints.insert( pair< string, vector< double > >( "Model " + to_string(i), n_nc_fsi ) );
+    }
+    for( unsigned int i = 0; i < n_cc_fsi.size(); ++i ){
+        FHS.push_back( "FSI " + to_string(i) );
+    }
+
+    int n_table = 100;
+    timer.Start();
+    for( int i = 0; i < n_table; ++i ){
+        sink.str("");
+        MakeTable( cc_model_ints, nc_model_ints, FHS, sink );
+    }
+    timer.Stop();
+    AddBenchResult( results, "MakeTable", "-", n_events, 1, n_table, timer );
+
+    // Filling one histogram through TTree::Draw then through FlatDraw
+    const char* cc0pi = "cc && (nfpip + nfpim + nfpi0 == 0) ";
+    TH1D *h_fill = new TH1D( "h_bench_fill", "Q^{2}, CC0#pi", 50, 0, 2.5 );
+
+    timer.Start();
+    gst->Draw( "Q2>>h_bench_fill", cc0pi, "goff" );
+    timer.Stop();
+    AddBenchResult( results, "Fill", "TTree::Draw", n_events, 1, 1, timer );
+
+    timer.Start();
+    FlatDraw( gst, "Q2>>h_bench_fill", cc0pi );
+    timer.Stop();
+    AddBenchResult( results, "Fill", "FlatDraw", n_events, 1, 1, timer );
+
+    // The first compiled fill includes compiling, or loading from the cache
+    bool use_jit = FlatJit();
+    SetFlatJit( true );
+
+    timer.Start();
+    FlatDraw( gst, "Q2>>h_bench_fill", cc0pi );
+    timer.Stop();
+    AddBenchResult( results, "Fill", "FlatDraw JIT first", n_events, 1, 1, timer );
+
+    timer.Start();
+    FlatDraw( gst, "Q2>>h_bench_fill", cc0pi );
+    timer.Stop();
+    AddBenchResult( results, "Fill", "FlatDraw JIT", n_events, 1, 1, timer );
+
+    SetFlatJit( use_jit );
+
+    delete h_fill;
+
+    // HistStacker, on Q2 CC0pi for the same model five times over
+    vector< TH1D* > stack;
+    vector< string > leg_entries;
+    vector< double > norms;
+    for( int i = 0; i < 5; ++i ){
+        string name = "h_bench_Q2_" + to_string(i);
+        TH1D *h = new TH1D( name.c_str(), "Q^{2}, CC0#pi", 50, 0, 2.5 );
+        gst->Draw( ( "Q2>>" + name ).c_str(), "cc && (nfpip + nfpim + nfpi0 == 0) ", "goff" );
+        stack.push_back( h );
+        leg_entries.push_back( " Model " + to_string(i) + " " );
+        norms.push_back( norm );
+    }
+
+    string plot = sample_dir + "/bench_stack.png";
+    timer.Start();
+    HistStacker( stack, leg_entries, norms, "Q2, CC0#pi", plot.c_str(), "Q^{2}", "Number of SBND events" );
+    timer.Stop();
+    AddBenchResult( results, "HistStacker", "-", n_events, 1, 1, timer );
+
+    for( unsigned int i = 0; i < stack.size(); ++i ){
+        delete stack[i];
+    }
+}
+
+// -------------------------------------------------------------------------
+// The histograms model_comparisons fills for one model, as fills for the
+// engine: variable, selection, topology and binning
+// -------------------------------------------------------------------------
+struct BenchFill {
+    const char* variable;
+    const char* selection;
+    int         topology;
+    int         n_x;
+    double      x_min;
+    double      x_max;
+    int         n_y;
+    double      y_min;
+    double      y_max;
+};
+
+const int n_bench_fills = 14;
+
+const BenchFill bench_fills[n_bench_fills] = {
+    { "Q2",           "",            kCC0Pi,  50, 0, 2.5, 0,  0, 0   },
+    { "Q2",           "",            kCC1PiP, 50, 0, 2.5, 0,  0, 0   },
+    { "Q2",           "",            kCC1Pi0, 50, 0, 2.5, 0,  0, 0   },
+    { "Q2",           "",            kNC1Pi0, 50, 0, 2.5, 0,  0, 0   },
+    { "Ev",           "",            kCC0Pi,  50, 0, 3,   0,  0, 0   },
+    { "Ev",           "",            kCC1PiP, 50, 0, 3,   0,  0, 0   },
+    { "cthf",         "pdgf == 211", kCC1PiP, 40, -1, 1,  0,  0, 0   },
+    { "pf",           "pdgf == 211", kCC1PiP, 40, 0, 1.5, 0,  0, 0   },
+    { "cthl",         "",            kCC0Pi,  40, -1, 1,  0,  0, 0   },
+    { "pl",           "",            kCC0Pi,  40, 0, 1.5, 0,  0, 0   },
+    { "(nfp+nfn)",    "",            kCC0Pi,  25, 0, 25,  0,  0, 0   },
+    { "(sumKEf/nfp)", "",            kCC0Pi,  50, 0, 2.5, 0,  0, 0   },
+    { "sumKEf:nfp",   "",            kCC0Pi,  12, 0, 12,  50, 0, 2.5 },
+    { "ys:EvRF",      "",            kCC1Pi,  40, 0, 2.5, 40, 0, 1   }
+};
+
+// -------------------------------------------------------------------------
+// Time the fills of one model through each backend of the fill engine:
+// the handwritten TTreeFormula loop, the compiled expressions and one
+// RDataFrame graph, on the given thread budget
+// -------------------------------------------------------------------------
+void BenchFillBackends( const string &sample_dir,
+                        Long64_t n_events,
+                        unsigned int n_threads,
+                        v_bench &results ){
+
+    gSystem->Setenv( "SBND_INPUT_DIR", sample_dir.c_str() );
+
+    TFile f_gst( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
+
+    if( f_gst.IsZombie() ){
+        cerr << " Error opening the synthetic sample in " << sample_dir << endl;
+        exit(1);
+    }
+
+    TTree *gst = (TTree*) f_gst.Get("gst");
+
+    vector< string > planned_fills;
+    vector< FlatFill > fills( n_bench_fills );
+
+    for( int i = 0; i < n_bench_fills; ++i ){
+
+        const BenchFill &fill = bench_fills[i];
+
+        planned_fills.push_back( fill.variable );
+        planned_fills.push_back( fill.selection );
+
+        fills[i].variable      = fill.variable;
+        fills[i].selection     = fill.selection;
+        fills[i].topology_mask = TopologyBit( fill.topology );
+    }
+    planned_fills.push_back( kTopologyFill );
+
+    SetGstThreads( n_threads );
+    OpenGstReader( gst, planned_fills, false );
+
+    bool use_jit = FlatJit();
+    bool use_rdf = FlatRDF();
+
+    const int n_backends = 3;
+    const char* backends[n_backends] = { "TTreeFormula", "JIT", "RDataFrame" };
+
+    TStopwatch timer;
+
+    for( int b = 0; b < n_backends; ++b ){
+
+        SetFlatJit( b == 1 );
+        SetFlatRDF( b == 2 );
+
+        // The first pass compiles the expressions, the second is timed
+        for( int pass = 0; pass < 2; ++pass ){
+
+            for( int i = 0; i < n_bench_fills; ++i ){
+                const BenchFill &fill = bench_fills[i];
+                BookFlatHist( fills[i].hist, fill.n_x, fill.x_min, fill.x_max, fill.n_y, fill.y_min, fill.y_max );
+            }
+
+            timer.Start();
+            FillFlat( gst, fills );
+            timer.Stop();
+        }
+
+        AddBenchResult( results, "FillBackend", backends[b], n_events, n_threads, 1, timer );
+    }
+
+    SetFlatJit( use_jit );
+    SetFlatRDF( use_rdf );
+
+    CloseGstReader( gst );
+    SetGstThreads( 0 );
+}
+
+// -------------------------------------------------------------------------
+// Time the six analysis macros, each in its own root process
+// -------------------------------------------------------------------------
+void BenchEndToEnd( const string &repo_dir,
+                    const string &sample_dir,
+                    Long64_t n_events,
+                    unsigned int n_threads,
+                    v_bench &results ){
+
+    const char* macros[6] = { "model_comparisons",
+                              "KE_model_comparisons",
+                              "proton_model_comparisons",
+                              "other_model_comparisons",
+                              "n_1d_model_comparisons",
+                              "inel_model_comparisons" };
+
+    // Run in a scratch directory so the plots are not overwritten
+    string run_dir = sample_dir + "/run_" + to_string( n_threads );
+    gSystem->mkdir( run_dir.c_str(), kTRUE );
+
+    TStopwatch timer;
+
+    // The total of the macros which ran to the end
+    BenchResult total;
+    total.name      = "six_analyses";
+    total.variant   = "end_to_end";
+    total.n_events  = n_events;
+    total.n_threads = n_threads;
+    total.repeats   = 1;
+    total.real_time = 0;
+    total.cpu_time  = 0;
+    total.status    = "ok";
+
+    for( int i = 0; i < 6; ++i ){
+
+        string command = "cd " + run_dir + " && SBND_INPUT_DIR=" + sample_dir
+                       + " root -l -b -q '" + repo_dir + "/load_modules.cpp(\"" + repo_dir + "\")'"
+                       + " '" + repo_dir + "/" + macros[i] + ".cpp+(" + to_string( n_threads ) + ")'"
+                       + " > " + macros[i] + ".log 2>&1";
+
+        timer.Start();
+        int status = gSystem->Exec( command.c_str() );
+        timer.Stop();
+
+        AddBenchResult( results, macros[i], "end_to_end", n_events, n_threads, 1, timer );
+
+        // A failed run stops early, so its time is kept but marked and not
+        // added to the total
+        if( status != 0 ){
+            cerr << " " << macros[i] << " failed, see " << run_dir << "/" << macros[i] << ".log " << endl;
+            results.back().status = "failed";
+            total.status          = "incomplete";
+            continue;
+        }
+
+        total.real_time += results.back().real_time;
+        total.cpu_time  += results.back().cpu_time;
+    }
+
+    results.push_back( total );
+
+    cout << setw(14) << total.name << setw(18) << total.variant << setw(12) << n_events
+         << setw(4) << n_threads << setw(14) << setprecision(4) << total.real_time << " s " << total.status << endl;
+}
+
+// -------------------------------------------------------------------------
+// Write the results to JSON
+// -------------------------------------------------------------------------
+void WriteBenchJSON( const v_bench &results,
+                     const char* file_name ){
+
+    ofstream file;
+    file.open( file_name );
+
+    TString commit = gSystem->GetFromPipe( "git rev-parse --short HEAD 2> /dev/null" );
+
+    file << "{" << endl;
+    file << "  \"commit\": \"" << commit.Data() << "\"," << endl;
+    file << "  \"host\": \"" << gSystem->HostName() << "\"," << endl;
+    file << "  \"results\": [" << endl;
+
+    for( unsigned int i = 0; i < results.size(); ++i ){
+
+        const BenchResult &r = results[i];
+        double rate = r.real_time > 0 && r.variant != "-" ? r.n_events / r.real_time : 0;
+
+        file << "    { \"name\": \"" << r.name << "\""
+             << ", \"variant\": \"" << r.variant << "\""
+             << ", \"events\": " << r.n_events
+             << ", \"threads\": " << r.n_threads
+             << ", \"repeats\": " << r.repeats
+             << setprecision(6)
+             << ", \"real_s\": " << r.real_time
+             << ", \"cpu_s\": " << r.cpu_time
+             << ", \"events_per_s\": " << rate
+             << ", \"status\": \"" << r.status << "\" }"
+             << ( i + 1 < results.size() ? "," : "" ) << endl;
+    }
+
+    file << "  ]" << endl;
+    file << "}" << endl;
+}
+
+// -------------------------------------------------------------------------
+//                          The macro
+// -------------------------------------------------------------------------
+int benchmark_model_comparisons( const char* sizes = "1000,10000,100000",
+                                 const char* threads = "1,2,4",
+                                 const char* out_json = "benchmark_results.json",
+                                 bool end_to_end = true ){
+
+    string repo_dir = gSystem->WorkingDirectory();
+
+    vector< Long64_t > n_events  = BenchList( sizes );
+    vector< Long64_t > n_threads = BenchList( threads );
+
+    if( n_events.empty() || n_threads.empty() ){
+        cerr << " Give at least one sample size and one thread count " << endl;
+        exit(1);
+    }
+
+    v_bench results;
+
+    for( unsigned int i = 0; i < n_events.size(); ++i ){
+
+        string sample_dir = BenchSample( repo_dir, n_events[i] );
+
+        BenchHelpers( sample_dir, n_events[i], results );
+
+        for( unsigned int j = 0; j < n_threads.size(); ++j ){
+            BenchFillBackends( sample_dir, n_events[i], (unsigned int) n_threads[j], results );
+        }
+
+        if( !end_to_end ) continue;
+
+        // Compile the macros once before anything is timed
+        if( i == 0 ){
+            v_bench warm_up;
+            BenchEndToEnd( repo_dir, sample_dir, n_events[i], 1, warm_up );
+        }
+
+        for( unsigned int j = 0; j < n_threads.size(); ++j ){
+            BenchEndToEnd( repo_dir, sample_dir, n_events[i], (unsigned int) n_threads[j], results );
+        }
+    }
+
+    WriteBenchJSON( results, out_json );
+
+    cout << " Benchmark results written to " << out_json << endl;
+
+    return 0;
+}
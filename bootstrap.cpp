@@ -0,0 +1,107 @@
+/*
+ * Poisson bootstrap replicas for the statistical uncertainties
+ *
+ * See bootstrap.h for the description of each function
+ *
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include "bootstrap.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+// The standard deviation of n values
+// -------------------------------------------------------------------------
+static double BootstrapSpread( const double *values,
+                               int n ){
+
+    double mean = 0;
+    for( int i = 0; i < n; ++i ) mean += values[i];
+    mean /= n;
+
+    double sum = 0;
+    for( int i = 0; i < n; ++i ) sum += ( values[i] - mean ) * ( values[i] - mean );
+
+    return sqrt( sum / ( n - 1 ) );
+}
+
+// -------------------------------------------------------------------------
+//                          weights of an entry
+// -------------------------------------------------------------------------
+void BootstrapWeights( unsigned int model_key,
+                       Long64_t entry,
+                       vector< double > &weights ){
+
+    if( weights.empty() ) return;
+
+    CounterRng rng = MakeCounterRng( model_key, entry, kRngBootstrap );
+    RngPoissons( rng, 1, &weights[0], weights.size() );
+}
+
+// -------------------------------------------------------------------------
+//                          errors of a fill
+// -------------------------------------------------------------------------
+double FlatBootstrapErrors( const FlatFill &fill,
+                            vector< double > &errors ){
+
+    const FlatUniverses &replicas = fill.replicas;
+
+    if( replicas.cells.empty() ){
+        cerr << " The fill " << fill.variable << " has no bootstrap replicas " << endl;
+        exit(1);
+    }
+
+    int n_replicas = replicas.n_universes;
+    int n_cells    = fill.hist.cells.size();
+    int n_x        = fill.hist.x.n_bins;
+    int n_y        = fill.hist.y.n_bins;
+
+    errors.assign( n_cells, 0 );
+    vector< double > totals( n_replicas, 0 );
+
+    for( int cell = 0; cell < n_cells; ++cell ){
+
+        const double *block = &replicas.cells[ Long64_t( cell ) * n_replicas ];
+
+        errors[cell] = BootstrapSpread( block, n_replicas );
+
+        // The under and overflow are left out of the integral
+        int bin_x = cell % ( n_x + 2 );
+        int bin_y = cell / ( n_x + 2 );
+        if( bin_x < 1 || bin_x > n_x ) continue;
+        if( n_y > 0 && ( bin_y < 1 || bin_y > n_y ) ) continue;
+
+        for( int r = 0; r < n_replicas; ++r ) totals[r] += block[r];
+    }
+
+    return BootstrapSpread( &totals[0], n_replicas );
+}
+
+// -------------------------------------------------------------------------
+//                          errors into a TH1
+// -------------------------------------------------------------------------
+void BootstrapErrorsToTH1( const FlatFill &fill,
+                           TH1 *h ){
+
+    if( h->GetNcells() != int( fill.hist.cells.size() ) ){
+        cerr << " The binning of " << h->GetName() << " does not match the flat histogram " << endl;
+        exit(1);
+    }
+
+    vector< double > errors;
+    FlatBootstrapErrors( fill, errors );
+
+    for( unsigned int i = 0; i < errors.size(); ++i ){
+        h->SetBinError( i, errors[i] );
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Poisson bootstrap replicas for the statistical uncertainties
+ *
+ * Each event enters each of K replicas with a weight drawn from a Poisson
+ * distribution of mean 1, so the spread of a bin over the replicas is its
+ * statistical uncertainty, for any selection or weighting and with the
+ * correlations between bins and between distributions of the same events
+ *
+ * The weights of an entry come from its stream of counter_rng.h, so the
+ * replicas are the same whichever entries are read, in whatever order and
+ * on whatever thread
+ *
+*/
+
+#ifndef BOOTSTRAP_H
+#define BOOTSTRAP_H
+
+#include <vector>
+#include "TTree.h"
+#include "TH1.h"
+#include "flat_hist.h"
+#include "counter_rng.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The number of replicas the macros use
+// -------------------------------------------------------------------------
+const int kBootstrapReplicas = 100;
+
+// -------------------------------------------------------------------------
+// The Poisson(1) weight of an entry in each of weights.size() replicas,
+// from the kRngBootstrap stream of the entry. The model_key is the
+// RngModelKey of the gst tree, so that each model has its own replicas
+// -------------------------------------------------------------------------
+void BootstrapWeights( unsigned int model_key,
+                       Long64_t entry,
+                       vector< double > &weights );
+
+// -------------------------------------------------------------------------
+// The standard deviation over the replicas of each cell of a fill, in the
+// cell order of its histogram, and of the sum of the bins without the
+// under and overflow. Returns the latter
+// -------------------------------------------------------------------------
+double FlatBootstrapErrors( const FlatFill &fill,
+                            vector< double > &errors );
+
+// -------------------------------------------------------------------------
+// Set the errors of a TH1D or TH2D, filled from a fill with FlatToTH1, to
+// the bootstrap errors of the fill
+// -------------------------------------------------------------------------
+void BootstrapErrorsToTH1( const FlatFill &fill,
+                           TH1 *h );
+
+// -------------------------------------------------------------------------
+
+#endif
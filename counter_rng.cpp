@@ -0,0 +1,192 @@
+/*
+ * A counter-based random number generator for the event loops
+ *
+ * See counter_rng.h for the description of each function
+ *
+*/
+
+#include <cmath>
+#include <vector>
+#include "TFile.h"
+#include "TMath.h"
+#include "counter_rng.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          key of a model
+// -------------------------------------------------------------------------
+unsigned int RngModelKey( const string &name ){
+
+    // FNV-1a
+    unsigned int key = 2166136261u;
+    for( unsigned int i = 0; i < name.size(); ++i ){
+        key = ( key ^ (unsigned char) name[i] ) * 16777619u;
+    }
+
+    return key;
+}
+
+unsigned int RngModelKey( TTree *event_tree ){
+
+    TFile *file = event_tree->GetCurrentFile();
+
+    // A chain has no current file until one of its trees is loaded
+    if( !file && event_tree->GetEntries() > 0 ){
+        event_tree->LoadTree( 0 );
+        file = event_tree->GetCurrentFile();
+    }
+
+    return RngModelKey( string( file ? file->GetUUID().AsString() : event_tree->GetName() ) );
+}
+
+// -------------------------------------------------------------------------
+//                          words of a stream
+// -------------------------------------------------------------------------
+void RngWords( CounterRng &rng,
+               unsigned int *words,
+               int n ){
+
+    int i = 0;
+
+    // What is left of the last block
+    while( i < n && rng.n_used < 4 ) words[i++] = rng.words[ rng.n_used++ ];
+
+    // Whole blocks straight into the output, each independent of the others
+    int n_blocks = ( n - i ) / 4;
+
+    for( int b = 0; b < n_blocks; ++b ){
+
+        unsigned int counter[4] = { rng.counter[0] + b, rng.counter[1], rng.counter[2], rng.counter[3] };
+        if( counter[0] < rng.counter[0] ) ++counter[1];
+
+        Philox4x32( counter, rng.key, &words[ i + 4 * b ] );
+    }
+
+    unsigned int next = rng.counter[0] + n_blocks;
+    if( next < rng.counter[0] ) ++rng.counter[1];
+    rng.counter[0] = next;
+
+    i += 4 * n_blocks;
+
+    // and the rest from a new block
+    while( i < n ) words[i++] = RngWord( rng );
+}
+
+// -------------------------------------------------------------------------
+//                          uniforms
+// -------------------------------------------------------------------------
+void RngUniforms( CounterRng &rng,
+                  double *values,
+                  int n ){
+
+    vector< unsigned int > words( 2 * n );
+    if( n > 0 ) RngWords( rng, &words[0], 2 * n );
+
+    for( int i = 0; i < n; ++i ){
+
+        unsigned long long a = words[ 2 * i ] >> 5;
+        unsigned long long b = words[ 2 * i + 1 ] >> 6;
+
+        values[i] = ( ( a << 26 ) + b + 0.5 ) * ( 1. / 9007199254740992. );
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          Gaussians
+// -------------------------------------------------------------------------
+void RngGaussians( CounterRng &rng,
+                   double *values,
+                   int n ){
+
+    // Uniforms for each pair, an odd n uses one of the last pair
+    int n_pairs = ( n + 1 ) / 2;
+
+    vector< double > u( 2 * n_pairs );
+    if( n_pairs > 0 ) RngUniforms( rng, &u[0], 2 * n_pairs );
+
+    for( int p = 0; p < n_pairs; ++p ){
+
+        double r   = sqrt( -2 * log( u[ 2 * p ] ) );
+        double phi = TMath::TwoPi() * u[ 2 * p + 1 ];
+
+        values[ 2 * p ] = r * cos( phi );
+        if( 2 * p + 1 < n ) values[ 2 * p + 1 ] = r * sin( phi );
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          Poisson variates
+// -------------------------------------------------------------------------
+void RngPoissons( CounterRng &rng,
+                  double mean,
+                  double *values,
+                  int n ){
+
+    if( mean <= 0 ){
+        for( int i = 0; i < n; ++i ) values[i] = 0;
+        return;
+    }
+
+    // Inversion, one uniform each
+    if( mean < 10 ){
+
+        vector< double > u( n );
+        if( n > 0 ) RngUniforms( rng, &u[0], n );
+
+        double p0 = exp( -mean );
+
+        for( int i = 0; i < n; ++i ){
+
+            int    k   = 0;
+            double p   = p0;
+            double cdf = p0;
+
+            while( u[i] > cdf && p > 0 ){
+                ++k;
+                p   *= mean / k;
+                cdf += p;
+            }
+            values[i] = k;
+        }
+        return;
+    }
+
+    // PTRS, two uniforms for each try
+    double slam     = sqrt( mean );
+    double loglam   = log( mean );
+    double b        = 0.931 + 2.53 * slam;
+    double a        = -0.059 + 0.02483 * b;
+    double invalpha = 1.1239 + 1.1328 / ( b - 3.4 );
+    double vr       = 0.9277 - 3.6224 / ( b - 2 );
+
+    for( int i = 0; i < n; ++i ){
+
+        while( true ){
+
+            double U  = RngUniform( rng ) - 0.5;
+            double V  = RngUniform( rng );
+            double us = 0.5 - fabs( U );
+            double k  = floor( ( 2 * a / us + b ) * U + mean + 0.43 );
+
+            if( us >= 0.07 && V <= vr ){
+                values[i] = k;
+                break;
+            }
+            if( k < 0 || ( us < 0.013 && V > us ) ) continue;
+
+            if( log( V ) + log( invalpha ) - log( a / ( us * us ) + b ) <= -mean + k * loglam - lgamma( k + 1 ) ){
+                values[i] = k;
+                break;
+            }
+        }
+    }
+}
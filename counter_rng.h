@@ -0,0 +1,177 @@
+/*
+ * A counter-based random number generator for the event loops
+ *
+ * The numbers of an event come from the Philox4x32-10 generator of Salmon
+ * et al., "Parallel random numbers: as easy as 1, 2, 3" (SC11): a keyed
+ * bijection of a 128 bit counter, so any number of the sequence can be
+ * found without those before it. The stream of an event is found from the
+ * model, the entry number and what the numbers are for, so the smearing,
+ * bootstrap and toys of an entry are the same however the entries are
+ * split between threads, chunks or passes, and a parallel run gives the
+ * same results bit for bit as a serial one
+ *
+ * The batch functions draw many numbers from a stream at once, a whole
+ * Philox block of 4 words at a time, with the same sequence as drawing
+ * them one by one
+ *
+*/
+
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <string>
+#include "TTree.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// What a stream is drawn for, so that each use has its own numbers
+// -------------------------------------------------------------------------
+enum RngPurpose {
+    kRngBootstrap,
+    kRngSmearing,
+    kRngToy,
+    kNRngPurposes
+};
+
+// -------------------------------------------------------------------------
+// The stream of one entry
+//      key     : the model and the purpose
+//      counter : the block of the stream, then the entry number in the
+//                upper two words
+//      words   : the last block drawn
+//      n_used  : how many of its words have been used
+// -------------------------------------------------------------------------
+struct CounterRng {
+    unsigned int key[2];
+    unsigned int counter[4];
+    unsigned int words[4];
+    int          n_used;
+};
+
+// -------------------------------------------------------------------------
+// Philox4x32-10: the 4 words of the block of a counter under a key
+// -------------------------------------------------------------------------
+inline void Philox4x32( const unsigned int counter[4],
+                        const unsigned int key[2],
+                        unsigned int out[4] ){
+
+    unsigned int c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    unsigned int k0 = key[0],     k1 = key[1];
+
+    for( int round = 0; round < 10; ++round ){
+
+        unsigned long long p0 = (unsigned long long) 0xD2511F53u * c0;
+        unsigned long long p1 = (unsigned long long) 0xCD9E8D57u * c2;
+
+        unsigned int hi0 = (unsigned int)( p0 >> 32 ), lo0 = (unsigned int) p0;
+        unsigned int hi1 = (unsigned int)( p1 >> 32 ), lo1 = (unsigned int) p1;
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+// -------------------------------------------------------------------------
+// The key of a model from a name which identifies it
+// -------------------------------------------------------------------------
+unsigned int RngModelKey( const string &name );
+
+// -------------------------------------------------------------------------
+// The key of the model of a gst tree, from the UUID of its file, that of
+// the first file of a chain. The UUID is written in the file when it is
+// made, so a copy read from another directory or machine, or through
+// SBND_INPUT_DIR, has the same key, while each model has its own. The
+// name of the tree is used for a tree without a file
+// -------------------------------------------------------------------------
+unsigned int RngModelKey( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// The stream of an entry of a model for a purpose
+// -------------------------------------------------------------------------
+inline CounterRng MakeCounterRng( unsigned int model_key,
+                                  Long64_t entry,
+                                  int purpose ){
+
+    CounterRng rng;
+
+    rng.key[0]     = model_key;
+    rng.key[1]     = (unsigned int) purpose;
+    rng.counter[0] = 0;
+    rng.counter[1] = 0;
+    rng.counter[2] = (unsigned int)( (unsigned long long) entry );
+    rng.counter[3] = (unsigned int)( (unsigned long long) entry >> 32 );
+    rng.n_used     = 4;
+
+    return rng;
+}
+
+// -------------------------------------------------------------------------
+// The next 32 bit word of a stream
+// -------------------------------------------------------------------------
+inline unsigned int RngWord( CounterRng &rng ){
+
+    if( rng.n_used == 4 ){
+        Philox4x32( rng.counter, rng.key, rng.words );
+        if( ++rng.counter[0] == 0 ) ++rng.counter[1];
+        rng.n_used = 0;
+    }
+
+    return rng.words[ rng.n_used++ ];
+}
+
+// -------------------------------------------------------------------------
+// The next uniform of a stream in (0,1), with 53 random bits from two words
+// -------------------------------------------------------------------------
+inline double RngUniform( CounterRng &rng ){
+
+    unsigned long long a = RngWord( rng ) >> 5;
+    unsigned long long b = RngWord( rng ) >> 6;
+
+    return ( ( a << 26 ) + b + 0.5 ) * ( 1. / 9007199254740992. );
+}
+
+// -------------------------------------------------------------------------
+// The next n words of a stream, whole blocks at a time
+// -------------------------------------------------------------------------
+void RngWords( CounterRng &rng,
+               unsigned int *words,
+               int n );
+
+// -------------------------------------------------------------------------
+// n uniforms in (0,1), as n calls of RngUniform
+// -------------------------------------------------------------------------
+void RngUniforms( CounterRng &rng,
+                  double *values,
+                  int n );
+
+// -------------------------------------------------------------------------
+// n Gaussians of mean 0 and width 1, by the Box-Muller transform of pairs
+// of uniforms
+// -------------------------------------------------------------------------
+void RngGaussians( CounterRng &rng,
+                   double *values,
+                   int n );
+
+// -------------------------------------------------------------------------
+// n Poisson variates of a mean, by inversion below a mean of 10 and by
+// the transformed rejection of Hormann (PTRS) above
+// -------------------------------------------------------------------------
+void RngPoissons( CounterRng &rng,
+                  double mean,
+                  double *values,
+                  int n );
+
+// -------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * The friend tree of derived variables for a gst file
+ *
+ * See derived_tree.h for the description of each function
+ *
+*/
+
+#include <vector>
+#include <cstdlib>
+#include "TFile.h"
+#include "TMath.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "derived_tree.h"
+#include "topologies.h"
+#include "event_kinematics.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The gst branches the derived variables are computed from
+// -------------------------------------------------------------------------
+const int n_derived_inputs = 18;
+
+const char* derived_inputs[n_derived_inputs] = { "cc", "nc", "coh", "nfpip", "nfpim", "nfpi0",
+                                                 "El", "Ev", "pl", "cthl", "nfp", "nfn", "sumKEf",
+                                                 "nf", "pdgf", "Ef", "pf", "cthf" };
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                      derived variables of an event
+// -------------------------------------------------------------------------
+void ComputeGstDerived( const GstEvent &event,
+                        GstDerived &derived ){
+
+    double m_n  = 0.93828;   // Nucleon mass, GeV
+    double m_mu = 0.10566;   // Muon mass, GeV
+
+    // The same reconstruction as RecoNuE
+    double e   = event.El;
+    double p   = event.pl;
+    double cth = event.cthl;
+
+    derived.reco_Ev       = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  );
+    derived.reco_residual = derived.reco_Ev - event.Ev;
+
+    TopologyEvent topology;
+    topology.cc    = event.cc;
+    topology.nc    = event.nc;
+    topology.coh   = event.coh;
+    topology.nfpip = event.nfpip;
+    topology.nfpim = event.nfpim;
+    topology.nfpi0 = event.nfpi0;
+
+    derived.topology   = ClassifyTopology( topology );
+    derived.avg_KE_p   = event.nfp != 0 ? event.sumKEf / event.nfp : 0;
+    derived.n_nucleons = event.nfp + event.nfn;
+
+    derived.E_vis        = ( event.cc ? event.El : 0 ) + HadronicEnergy( event.pdgf, event.Ef, event.nf );
+    derived.lead_p_pf    = 0;
+    derived.lead_p_cthf  = -2;
+    derived.lead_pi_pf   = 0;
+    derived.lead_pi_cthf = -2;
+
+    for( int i = 0; i < event.nf; ++i ){
+
+        int pdg = TMath::Abs( event.pdgf[i] );
+
+        if( pdg == 2212 && event.pf[i] > derived.lead_p_pf ){
+            derived.lead_p_pf   = event.pf[i];
+            derived.lead_p_cthf = event.cthf[i];
+        }
+        else if( ( pdg == 211 || pdg == 111 ) && event.pf[i] > derived.lead_pi_pf ){
+            derived.lead_pi_pf   = event.pf[i];
+            derived.lead_pi_cthf = event.cthf[i];
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// Compute the derived variables of the entries first to last - 1 of a gst
+// file, each range is read through its own TFile so that the ranges can
+// be read on separate threads
+// -------------------------------------------------------------------------
+static void ComputeGstDerivedRange( const string &gst_path,
+                                    Long64_t first,
+                                    Long64_t last,
+                                    vector< GstDerived > &derived ){
+
+    TFile file( gst_path.c_str() );
+    TTree *event_tree = file.IsZombie() ? 0 : (TTree*) file.Get("gst");
+
+    if( !event_tree ){
+        cerr << " Could not read the gst tree in " << gst_path << endl;
+        exit(1);
+    }
+
+    GstEvent event;
+
+    event_tree->SetBranchStatus( "*", 0 );
+    for( int i = 0; i < n_derived_inputs; ++i ){
+        bool is_array = false;
+        event_tree->SetBranchStatus( derived_inputs[i], 1 );
+        event_tree->SetBranchAddress( derived_inputs[i], GstEventField( event, derived_inputs[i], is_array ) );
+    }
+
+    for( Long64_t entry = first; entry < last; ++entry ){
+
+        event_tree->GetEntry( entry );
+
+        if( event.nf > kGstMaxParticles ){
+            cerr << " Entry " << entry << " has " << event.nf << " final state particles, more than "
+                 << kGstMaxParticles << endl;
+            exit(1);
+        }
+
+        ComputeGstDerived( event, derived[entry] );
+    }
+
+    event_tree->ResetBranchAddresses();
+}
+
+// -------------------------------------------------------------------------
+//                      write the derived variables
+// -------------------------------------------------------------------------
+Long64_t WriteGstDerived( const string &gst_path ){
+
+    Long64_t n_entries = 0;
+    {
+        TFile file( gst_path.c_str() );
+        TTree *event_tree = file.IsZombie() ? 0 : (TTree*) file.Get("gst");
+
+        if( !event_tree ){
+            cerr << " Could not read the gst tree in " << gst_path << endl;
+            exit(1);
+        }
+        n_entries = event_tree->GetEntries();
+    }
+
+    vector< GstDerived > derived( n_entries );
+
+    unsigned int n_threads = GstThreads();
+
+    if( n_threads < 2 ){
+        ComputeGstDerivedRange( gst_path, 0, n_entries, derived );
+    }
+    else{
+
+        // A few ranges per thread to even out the load
+        Long64_t range = ( n_entries + 4 * n_threads - 1 ) / ( 4 * n_threads );
+        if( range < 1 ) range = 1;
+
+        vector< Long64_t > firsts;
+        for( Long64_t first = 0; first < n_entries; first += range ){
+            firsts.push_back( first );
+        }
+
+        ROOT::TThreadExecutor pool( n_threads );
+        pool.Foreach( [&]( Long64_t first ){
+                          Long64_t last = first + range < n_entries ? first + range : n_entries;
+                          ComputeGstDerivedRange( gst_path, first, last, derived );
+                      }, firsts );
+    }
+
+    // The friend is matched entry by entry, so it is filled in order
+    string derived_path = GstDerivedPath( gst_path );
+
+    TFile file( derived_path.c_str(), "RECREATE" );
+
+    if( file.IsZombie() ){
+        cerr << " Could not write " << derived_path << endl;
+        exit(1);
+    }
+
+    TTree *derived_tree = new TTree( kGstDerivedTree, kGstDerivedVersion );
+
+    GstDerived row;
+    derived_tree->Branch( "reco_Ev",       &row.reco_Ev,       "reco_Ev/D" );
+    derived_tree->Branch( "reco_residual", &row.reco_residual, "reco_residual/D" );
+    derived_tree->Branch( "topology",      &row.topology,      "topology/i" );
+    derived_tree->Branch( "avg_KE_p",      &row.avg_KE_p,      "avg_KE_p/D" );
+    derived_tree->Branch( "n_nucleons",    &row.n_nucleons,    "n_nucleons/I" );
+    derived_tree->Branch( "E_vis",         &row.E_vis,         "E_vis/D" );
+    derived_tree->Branch( "lead_p_pf",     &row.lead_p_pf,     "lead_p_pf/D" );
+    derived_tree->Branch( "lead_p_cthf",   &row.lead_p_cthf,   "lead_p_cthf/D" );
+    derived_tree->Branch( "lead_pi_pf",    &row.lead_pi_pf,    "lead_pi_pf/D" );
+    derived_tree->Branch( "lead_pi_cthf",  &row.lead_pi_cthf,  "lead_pi_cthf/D" );
+
+    for( Long64_t entry = 0; entry < n_entries; ++entry ){
+        row = derived[entry];
+        derived_tree->Fill();
+    }
+
+    derived_tree->Write();
+    file.Close();
+
+    return n_entries;
+}
@@ -0,0 +1,69 @@
+/*
+ * The friend tree of derived variables for a gst file
+ *
+ * Quantities such as the average proton kinetic energy, sumKEf/nfp, or
+ * the CCQE reconstructed energy are otherwise recomputed by every Draw in
+ * every macro. They are computed once here, in parallel over ranges of
+ * entries, and written to a gst_derived tree in GstDerivedPath of the gst
+ * file. OpenGstReader attaches it as a friend whenever it is there and up
+ * to date, so the columns can be used in any Draw expression, and the
+ * fill engine reads them in place of the expressions they hold
+ *
+ * To write the derived variables of the five models, with 4 threads:
+ *      root -l -b -q load_modules.cpp 'make_derived_trees.cpp+(4)'
+ *
+*/
+
+#ifndef DERIVED_TREE_H
+#define DERIVED_TREE_H
+
+#include <string>
+#include "TTree.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The derived variables of a gst entry, the branches of gst_derived
+//      reco_Ev       : CCQE reconstructed neutrino energy from the lepton,
+//                      as RecoNuE (GeV)
+//      reco_residual : reco_Ev - Ev (GeV)
+//      topology      : the mask of the topologies in topologies.h
+//      avg_KE_p      : sumKEf / nfp, 0 without protons as in TTree::Draw
+//      n_nucleons    : nfp + nfn
+//      E_vis         : visible energy, the charged lepton energy for CC
+//                      plus the HadronicEnergy of event_kinematics.h (GeV)
+//      lead_p_pf     : momentum of the leading proton, 0 if none (GeV)
+//      lead_p_cthf   : cos theta of the leading proton, -2 if none
+//      lead_pi_pf    : momentum of the leading pion, 0 if none (GeV)
+//      lead_pi_cthf  : cos theta of the leading pion, -2 if none
+// -------------------------------------------------------------------------
+struct GstDerived {
+    Double_t reco_Ev;
+    Double_t reco_residual;
+    UInt_t   topology;
+    Double_t avg_KE_p;
+    Int_t    n_nucleons;
+    Double_t E_vis;
+    Double_t lead_p_pf;
+    Double_t lead_p_cthf;
+    Double_t lead_pi_pf;
+    Double_t lead_pi_cthf;
+};
+
+// -------------------------------------------------------------------------
+// Compute the derived variables of an event
+// -------------------------------------------------------------------------
+void ComputeGstDerived( const GstEvent &event,
+                        GstDerived &derived );
+
+// -------------------------------------------------------------------------
+// Write the derived variables of every entry of the gst tree in gst_path
+// to GstDerivedPath( gst_path ), using the thread budget of SetGstThreads.
+// Returns the number of entries written
+// -------------------------------------------------------------------------
+Long64_t WriteGstDerived( const string &gst_path );
+
+// -------------------------------------------------------------------------
+
+#endif
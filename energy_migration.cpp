@@ -0,0 +1,123 @@
+/*
+ * Neutrino energy estimators and their true vs reco migration matrices
+ *
+ * See energy_migration.h for the description of each function
+ *
+*/
+
+#include <cstdlib>
+#include "energy_migration.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          book a matrix
+// -------------------------------------------------------------------------
+void BookSparseMigration( SparseMigration &migration,
+                          int n_bins,
+                          double min,
+                          double max ){
+
+    if( n_bins < 1 || !( max > min ) ){
+        cerr << " Invalid binning for a migration matrix " << endl;
+        exit(1);
+    }
+
+    BookFlatAxis( migration.true_axis, n_bins, min, max );
+    BookFlatAxis( migration.reco_axis, n_bins, min, max );
+
+    migration.entries = 0;
+    migration.cells.clear();
+}
+
+// -------------------------------------------------------------------------
+//                          fill the matrices
+// -------------------------------------------------------------------------
+Long64_t RunEnergyMigrations( TTree *event_tree,
+                              vector< EnergyMigration > &migrations ){
+
+    vector< unsigned int > topology_masks;
+
+    for( unsigned int m = 0; m < migrations.size(); ++m ){
+
+        if( migrations[m].estimator < 0 || migrations[m].estimator >= kNEstimators ){
+            cerr << " Unknown energy estimator " << migrations[m].estimator << endl;
+            exit(1);
+        }
+        topology_masks.push_back( migrations[m].topology_mask );
+    }
+
+    return ScanKinematics( event_tree, topology_masks, [&]( const EventKinematics &kinematics ){
+
+        const double *true_Ev = &kinematics.values[kKinEv][0];
+
+        for( unsigned int m = 0; m < migrations.size(); ++m ){
+
+            EnergyMigration &migration = migrations[m];
+
+            const double *reco_Ev = &kinematics.values[ EstimatorVariable( migration.estimator ) ][0];
+
+            for( Long64_t i = 0; i < kinematics.n_events; ++i ){
+
+                if( ( kinematics.topology[i] & migration.topology_mask ) != migration.topology_mask ) continue;
+
+                FillSparseMigration( migration.matrix, true_Ev[i], reco_Ev[i] );
+            }
+        }
+    } );
+}
+
+// -------------------------------------------------------------------------
+//                          copy into a TH2
+// -------------------------------------------------------------------------
+void MigrationToTH2( const SparseMigration &migration,
+                     TH2 *h ){
+
+    if( h->GetNcells() != ( migration.true_axis.n_bins + 2 ) * ( migration.reco_axis.n_bins + 2 ) ){
+        cerr << " The binning of " << h->GetName() << " does not match the migration matrix " << endl;
+        exit(1);
+    }
+
+    h->Reset();
+
+    for( map< Long64_t, double >::const_iterator it = migration.cells.begin(); it != migration.cells.end(); ++it ){
+        h->SetBinContent( int( it->first ), it->second );
+    }
+
+    h->SetEntries( double( migration.entries ) );
+}
+
+// -------------------------------------------------------------------------
+//                          reco projection
+// -------------------------------------------------------------------------
+void MigrationRecoTH1( const SparseMigration &migration,
+                       TH1 *h ){
+
+    if( h->GetNcells() != migration.reco_axis.n_bins + 2 ){
+        cerr << " The binning of " << h->GetName() << " does not match the reconstructed energy axis " << endl;
+        exit(1);
+    }
+
+    h->Reset();
+
+    int n_true = migration.true_axis.n_bins + 2;
+
+    vector< double > contents( migration.reco_axis.n_bins + 2, 0 );
+    for( map< Long64_t, double >::const_iterator it = migration.cells.begin(); it != migration.cells.end(); ++it ){
+        contents[ it->first / n_true ] += it->second;
+    }
+
+    for( unsigned int bin = 0; bin < contents.size(); ++bin ){
+        if( contents[bin] != 0 ) h->SetBinContent( bin, contents[bin] );
+    }
+
+    h->SetEntries( double( migration.entries ) );
+}
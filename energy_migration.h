@@ -0,0 +1,134 @@
+/*
+ * Neutrino energy estimators and their true vs reco migration matrices
+ *
+ * RecoNuE only reconstructs the CCQE energy from the lepton, and keeps a
+ * list of the reco - true differences to histogram afterwards. The fused
+ * kernel of event_kinematics.h computes the CCQE, calorimetric and proton
+ * corrected energies of each event together, and RunEnergyMigrations
+ * fills the migration matrix of true Ev against the reconstructed energy
+ * for any number of estimators and topologies from that one pass
+ *
+ * A migration matrix is held sparse: most of the bins far from the
+ * diagonal are never filled, so only the cells which are hold a value.
+ * MigrationToTH2 and MigrationRecoTH1 copy them out for the plots
+ *
+*/
+
+#ifndef ENERGY_MIGRATION_H
+#define ENERGY_MIGRATION_H
+
+#include <vector>
+#include <map>
+#include "TTree.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "flat_hist.h"
+#include "event_kinematics.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The neutrino energy estimators
+//      kEstCCQE         : from the lepton kinematics, as RecoNuE
+//      kEstCalorimetric : the lepton and visible hadronic energy
+//      kEstProton       : the lepton and proton energy with the removal
+//                         energy of each proton
+// -------------------------------------------------------------------------
+enum EnergyEstimator {
+    kEstCCQE,
+    kEstCalorimetric,
+    kEstProton,
+    kNEstimators
+};
+
+// -------------------------------------------------------------------------
+// The KinematicVariable and name of each estimator
+// -------------------------------------------------------------------------
+inline int EstimatorVariable( int estimator ){
+
+    static const int variables[kNEstimators] = { kKinRecoEv, kKinCaloEv, kKinProtonEv };
+
+    return variables[estimator];
+}
+
+inline const char* EstimatorName( int estimator ){
+
+    static const char* names[kNEstimators] = { "CCQE", "calorimetric", "proton" };
+
+    return names[estimator];
+}
+
+// -------------------------------------------------------------------------
+// A sparse migration matrix with uniform bins
+//      true_axis : the true energy, x
+//      reco_axis : the reconstructed energy, y
+//      entries   : the number of fills
+//      cells     : the filled cells, by the global bin of a TH2 with these
+//                  axes, bin_true + ( true_axis.n_bins + 2 ) * bin_reco
+// -------------------------------------------------------------------------
+struct SparseMigration {
+    FlatAxis                 true_axis;
+    FlatAxis                 reco_axis;
+    Long64_t                 entries;
+    map< Long64_t, double >  cells;
+};
+
+// -------------------------------------------------------------------------
+// Book an empty matrix with the same binning on both axes
+// -------------------------------------------------------------------------
+void BookSparseMigration( SparseMigration &migration,
+                          int n_bins,
+                          double min,
+                          double max );
+
+// -------------------------------------------------------------------------
+// Fill a matrix
+// -------------------------------------------------------------------------
+inline void FillSparseMigration( SparseMigration &migration,
+                                 double true_value,
+                                 double reco_value,
+                                 double weight = 1 ){
+
+    Long64_t cell = FlatBin( migration.true_axis, true_value )
+                  + Long64_t( migration.true_axis.n_bins + 2 ) * FlatBin( migration.reco_axis, reco_value );
+
+    migration.cells[cell] += weight;
+    ++migration.entries;
+}
+
+// -------------------------------------------------------------------------
+// The migration of an estimator for the events of a topology
+//      estimator     : an EnergyEstimator
+//      topology_mask : the TopologyBit of each topology the event must
+//                      belong to, 0 for every event
+//      matrix        : booked before RunEnergyMigrations is called
+// -------------------------------------------------------------------------
+struct EnergyMigration {
+    int             estimator;
+    unsigned int    topology_mask;
+    SparseMigration matrix;
+};
+
+// -------------------------------------------------------------------------
+// Fill each of the matrices in a single pass over a gst tree, through
+// ScanKinematics. Returns the number of events computed
+// -------------------------------------------------------------------------
+Long64_t RunEnergyMigrations( TTree *event_tree,
+                              vector< EnergyMigration > &migrations );
+
+// -------------------------------------------------------------------------
+// Copy a matrix into a TH2D with the same binning, true on x
+// -------------------------------------------------------------------------
+void MigrationToTH2( const SparseMigration &migration,
+                     TH2 *h );
+
+// -------------------------------------------------------------------------
+// Fill a TH1D with the reconstructed energy binning with the projection of
+// a matrix onto it, the reconstructed energy distribution
+// -------------------------------------------------------------------------
+void MigrationRecoTH1( const SparseMigration &migration,
+                       TH1 *h );
+
+// -------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,629 @@
+/*
+ * The event kinematics of the macros in one fused kernel
+ *
+ * See event_kinematics.h for the description of each function
+ *
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "TBranch.h"
+#include "event_kinematics.h"
+#include "topologies.h"
+#include "topology_index.h"
+#include "event_store.h"
+#include "counter_rng.h"
+#include "smearing.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The input columns, by the gst branch or store column they are read from
+// -------------------------------------------------------------------------
+const int n_kinematics_columns = 20;
+
+const char* kinematics_columns[n_kinematics_columns] = { "cc", "Ev", "EvRF", "Q2", "ys", "El", "pl", "cthl",
+                                                         "pxl", "pyl", "nfp", "nfn", "sumKEf", "topology",
+                                                         "pdgf", "Ef", "pxf", "pyf", "pf", "cthf" };
+
+// The gst branches read for each event without a store, nf first
+const int n_kinematics_branches = 25;
+
+const char* kinematics_branches[n_kinematics_branches] = { "nf", "cc", "nc", "coh", "nfpip", "nfpim", "nfpi0",
+                                                           "Ev", "EvRF", "Q2", "ys", "El", "pl", "cthl", "pxl", "pyl",
+                                                           "nfp", "nfn", "sumKEf", "pdgf", "Ef", "pxf", "pyf", "pf", "cthf" };
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          variable of a name
+// -------------------------------------------------------------------------
+int KinematicIndex( const string &name ){
+
+    for( int v = 0; v < kNKinematics; ++v ){
+        if( name == KinematicName( v ) ) return v;
+    }
+
+    return -1;
+}
+
+// -------------------------------------------------------------------------
+// The input columns in the order of kinematics_columns
+// -------------------------------------------------------------------------
+static void KinematicsColumns( KinematicsInput &input,
+                               vector< vector< double >* > &columns ){
+
+    vector< double > *all[n_kinematics_columns] = { &input.cc, &input.Ev, &input.EvRF, &input.Q2, &input.ys,
+                                                    &input.El, &input.pl, &input.cthl, &input.pxl, &input.pyl,
+                                                    &input.nfp, &input.nfn, &input.sumKEf, &input.topology,
+                                                    &input.pdgf, &input.Ef, &input.pxf, &input.pyf, &input.pf,
+                                                    &input.cthf };
+
+    columns.assign( all, all + n_kinematics_columns );
+}
+
+// -------------------------------------------------------------------------
+//                          empty a batch
+// -------------------------------------------------------------------------
+void ClearKinematicsInput( KinematicsInput &input ){
+
+    vector< vector< double >* > columns;
+    KinematicsColumns( input, columns );
+
+    for( unsigned int i = 0; i < columns.size(); ++i ){
+        columns[i]->clear();
+    }
+
+    input.offsets.assign( 1, 0 );
+}
+
+// -------------------------------------------------------------------------
+//                          add an event to a batch
+// -------------------------------------------------------------------------
+void AppendKinematicsEvent( const GstEvent &event,
+                            unsigned int topology,
+                            KinematicsInput &input ){
+
+    if( input.offsets.empty() ) input.offsets.push_back( 0 );
+
+    input.cc.push_back( event.cc );
+    input.Ev.push_back( event.Ev );
+    input.EvRF.push_back( event.EvRF );
+    input.Q2.push_back( event.Q2 );
+    input.ys.push_back( event.ys );
+    input.El.push_back( event.El );
+    input.pl.push_back( event.pl );
+    input.cthl.push_back( event.cthl );
+    input.pxl.push_back( event.pxl );
+    input.pyl.push_back( event.pyl );
+    input.nfp.push_back( event.nfp );
+    input.nfn.push_back( event.nfn );
+    input.sumKEf.push_back( event.sumKEf );
+    input.topology.push_back( topology );
+
+    for( int k = 0; k < event.nf; ++k ){
+        input.pdgf.push_back( event.pdgf[k] );
+        input.Ef.push_back( event.Ef[k] );
+        input.pxf.push_back( event.pxf[k] );
+        input.pyf.push_back( event.pyf[k] );
+        input.pf.push_back( event.pf[k] );
+        input.cthf.push_back( event.cthf[k] );
+    }
+
+    input.offsets.push_back( input.offsets.back() + event.nf );
+}
+
+// -------------------------------------------------------------------------
+// The angle between two vectors in the transverse plane, -1 if either
+// has no length
+// -------------------------------------------------------------------------
+static inline double TransverseAngle( double ax, double ay,
+                                      double bx, double by ){
+
+    double norm = sqrt( ( ax * ax + ay * ay ) * ( bx * bx + by * by ) );
+    if( !( norm > 0 ) ) return -1;
+
+    double c = ( ax * bx + ay * by ) / norm;
+    return acos( c < -1 ? -1 : ( c > 1 ? 1 : c ) );
+}
+
+// -------------------------------------------------------------------------
+//                          the fused kernel
+// -------------------------------------------------------------------------
+void ComputeKinematics( const KinematicsInput &input,
+                        EventKinematics &output ){
+
+    double m_n  = 0.93828;   // Nucleon mass, GeV
+    double m_mu = 0.10566;   // Muon mass, GeV
+    double m_p  = 0.93827;   // Proton mass, GeV
+
+    Long64_t n_events = input.Ev.size();
+
+    output.n_events = n_events;
+    output.topology.resize( n_events );
+    output.values.resize( kNKinematics );
+    for( int v = 0; v < kNKinematics; ++v ){
+        output.values[v].resize( n_events );
+    }
+
+    // One pointer per output column, so the loop writes each with a store
+    double *out[kNKinematics];
+    for( int v = 0; v < kNKinematics; ++v ){
+        out[v] = n_events ? &output.values[v][0] : 0;
+    }
+
+    for( Long64_t i = 0; i < n_events; ++i ){
+
+        bool   cc   = input.cc[i] != 0;
+        double Ev   = input.Ev[i];
+        double El   = input.El[i];
+        double pl   = input.pl[i];
+        double cthl = input.cthl[i];
+        double nfp  = input.nfp[i];
+
+        output.topology[i] = (unsigned int) input.topology[i];
+
+        out[kKinQ2][i]   = input.Q2[i];
+        out[kKinEv][i]   = Ev;
+        out[kKinEvRF][i] = input.EvRF[i];
+        out[kKinYs][i]   = input.ys[i];
+
+        out[kKinPMu][i]   = cc ? pl : 0;
+        out[kKinCthMu][i] = cc ? cthl : -2;
+
+        out[kKinNNucleons][i] = nfp + input.nfn[i];
+        out[kKinAvgKEp][i]    = nfp != 0 ? input.sumKEf[i] / nfp : 0;
+
+        // The same reconstruction as RecoNuE
+        out[kKinRecoEv][i] = ( 1 / ( 1 - ( ( 1 / m_n ) * ( El - pl*cthl ) ) ) ) * ( El - ( 1 / ( 2 * m_n) ) * m_mu * m_mu );
+
+        // The energy and momentum transfer from the lepton, with the
+        // nucleon at rest
+        double m2_l = El * El - pl * pl;
+        double nu   = Ev - El;
+        double Q2   = 2 * Ev * ( El - pl * cthl ) - ( m2_l > 0 ? m2_l : 0 );
+        double W2   = m_n * m_n + 2 * m_n * nu - Q2;
+
+        out[kKinW][i] = W2 > 0 ? sqrt( W2 ) : 0;
+        out[kKinX][i] = nu > 0 ? Q2 / ( 2 * m_n * nu ) : 0;
+
+        // The particles, once for all of the variables which need them
+        Long64_t first       = input.offsets[i];
+        Long64_t n_particles = input.offsets[ i + 1 ] - first;
+
+        double E_had   = n_particles > 0 ? HadronicEnergy( &input.pdgf[first], &input.Ef[first], n_particles ) : 0;
+        double p_p     = 0;
+        double px_p    = 0;
+        double py_p    = 0;
+        double p_pi    = 0;
+        double cth_pi  = -2;
+        double E_p     = 0;
+
+        for( Long64_t k = first; k < first + n_particles; ++k ){
+
+            int pdg = abs( int( input.pdgf[k] ) );
+
+            if( pdg == 2212 ){
+                E_p += input.Ef[k] - m_p + kRemovalEnergy;
+
+                if( input.pf[k] > p_p ){
+                    p_p  = input.pf[k];
+                    px_p = input.pxf[k];
+                    py_p = input.pyf[k];
+                }
+            }
+            else if( pdg == 211 && input.pf[k] > p_pi ){
+                p_pi   = input.pf[k];
+                cth_pi = input.cthf[k];
+            }
+        }
+
+        out[kKinPPi][i]   = p_pi;
+        out[kKinCthPi][i] = cth_pi;
+        out[kKinEHad][i]  = E_had;
+
+        out[kKinCaloEv][i]   = ( cc ? El : 0 ) + E_had;
+        out[kKinProtonEv][i] = ( cc ? El : 0 ) + E_p;
+
+        // The imbalance of the transverse momenta of the lepton and the
+        // leading proton, the beam along z
+        double dpT     = -1;
+        double dalphaT = -1;
+        double dphiT   = -1;
+
+        if( cc && p_p > 0 ){
+            double pxl  = input.pxl[i];
+            double pyl  = input.pyl[i];
+            double dpx  = pxl + px_p;
+            double dpy  = pyl + py_p;
+
+            dpT     = sqrt( dpx * dpx + dpy * dpy );
+            dalphaT = TransverseAngle( -pxl, -pyl, dpx, dpy );
+            dphiT   = TransverseAngle( -pxl, -pyl, px_p, py_p );
+        }
+
+        out[kKinDpT][i]     = dpT;
+        out[kKinDalphaT][i] = dalphaT;
+        out[kKinDphiT][i]   = dphiT;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Whether an event of a topology is in every topology of one of the masks
+// -------------------------------------------------------------------------
+static inline bool KinematicsSelected( unsigned int topology,
+                                       const vector< unsigned int > &topology_masks ){
+
+    for( unsigned int m = 0; m < topology_masks.size(); ++m ){
+        if( ( topology & topology_masks[m] ) == topology_masks[m] ) return true;
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------
+// Keep only the events of a batch with a 1 in keep, in place
+// -------------------------------------------------------------------------
+static void SelectKinematicsEvents( KinematicsInput &input,
+                                    const vector< unsigned char > &keep ){
+
+    vector< vector< double >* > columns;
+    KinematicsColumns( input, columns );
+
+    // The event and the particle columns, after the topology
+    const int n_event_columns = 14;
+
+    Long64_t n_events = input.Ev.size();
+    Long64_t kept     = 0;
+    Long64_t row      = 0;
+
+    for( Long64_t i = 0; i < n_events; ++i ){
+
+        if( !keep[i] ) continue;
+
+        for( int c = 0; c < n_event_columns; ++c ){
+            ( *columns[c] )[kept] = ( *columns[c] )[i];
+        }
+
+        Long64_t first = input.offsets[i];
+        Long64_t last  = input.offsets[ i + 1 ];
+
+        for( int c = n_event_columns; c < n_kinematics_columns; ++c ){
+            vector< double > &column = *columns[c];
+            for( Long64_t k = first; k < last; ++k ) column[ row + k - first ] = column[k];
+        }
+
+        input.offsets[kept] = row;
+        row += last - first;
+        ++kept;
+    }
+
+    input.offsets[kept] = row;
+    input.offsets.resize( kept + 1 );
+
+    for( int c = 0; c < n_kinematics_columns; ++c ){
+        columns[c]->resize( c < n_event_columns ? kept : row );
+    }
+}
+
+// -------------------------------------------------------------------------
+// One pass over the blocks of an event store
+// -------------------------------------------------------------------------
+static Long64_t KinematicsFromStore( EventStore &store,
+                                     const vector< int > &store_columns,
+                                     const vector< unsigned int > &topology_masks,
+                                     const function< void( const EventKinematics& ) > &consume ){
+
+    KinematicsInput  input;
+    EventKinematics  kinematics;
+
+    vector< vector< double >* > columns;
+    KinematicsColumns( input, columns );
+
+    // The topologies are read first, the blocks without an event of the
+    // masks are not read any further
+    const int topology_column = 13;
+    LoadEventColumns( store, vector< string >( 1, "topology" ) );
+
+    vector< unsigned char > keep;
+    Long64_t n_computed = 0;
+
+    for( Long64_t block = 0; block < store.n_blocks; ++block ){
+
+        ReadEventBlock( store, store_columns[topology_column], block, input.topology );
+
+        Long64_t n_events = input.topology.size();
+        Long64_t n_kept   = 0;
+
+        keep.assign( n_events, 0 );
+        for( Long64_t i = 0; i < n_events; ++i ){
+            keep[i] = KinematicsSelected( (unsigned int) input.topology[i], topology_masks );
+            n_kept += keep[i];
+        }
+        if( n_kept == 0 ) continue;
+
+        for( int c = 0; c < n_kinematics_columns; ++c ){
+            if( c != topology_column ) ReadEventBlock( store, store_columns[c], block, *columns[c] );
+        }
+        ReadParticleOffsets( store, block, input.offsets );
+
+        if( n_kept < n_events ) SelectKinematicsEvents( input, keep );
+
+        ComputeKinematics( input, kinematics );
+        consume( kinematics );
+
+        n_computed += n_kept;
+    }
+
+    return n_computed;
+}
+
+// -------------------------------------------------------------------------
+//                          bind the kernel branches
+// -------------------------------------------------------------------------
+void KinematicsBranches( s_branches &branches ){
+
+    branches.insert( kinematics_branches, kinematics_branches + n_kinematics_branches );
+}
+
+void BranchKinematicsEvent( TTree *event_tree,
+                            GstEvent &event,
+                            vector< TBranch* > &branches ){
+
+    vector< string > names( kinematics_branches, kinematics_branches + n_kinematics_branches );
+
+    if( GstSmearing() ){
+        s_branches smearing_branches;
+        SmearingBranches( smearing_branches );
+        for( s_branches::iterator it = smearing_branches.begin(); it != smearing_branches.end(); ++it ){
+            if( find( names.begin(), names.end(), *it ) == names.end() ) names.push_back( *it );
+        }
+    }
+
+    branches.assign( names.size(), (TBranch*) 0 );
+
+    for( unsigned int b = 0; b < names.size(); ++b ){
+
+        bool is_array = false;
+        branches[b]   = event_tree->GetBranch( names[b].c_str() );
+
+        if( !branches[b] ){
+            cerr << " The gst tree has no " << names[b] << " branch for the event kinematics " << endl;
+            exit(1);
+        }
+        branches[b]->SetAddress( GstEventField( event, names[b], is_array ) );
+    }
+}
+
+void ReadKinematicsEvent( const vector< TBranch* > &branches,
+                          const GstEvent &event,
+                          Long64_t entry,
+                          Long64_t local_entry ){
+
+    // The count first, so that the arrays are not read past their end
+    branches[0]->GetEntry( local_entry, 1 );
+
+    if( event.nf > kGstMaxParticles ){
+        cerr << " Entry " << entry << " has " << event.nf << " final state particles, more than "
+             << kGstMaxParticles << endl;
+        exit(1);
+    }
+
+    for( unsigned int b = 1; b < branches.size(); ++b ){
+        branches[b]->GetEntry( local_entry, 1 );
+    }
+}
+
+// -------------------------------------------------------------------------
+// One pass over the entries of a gst tree, in batches of the block size
+// of the store
+// -------------------------------------------------------------------------
+static Long64_t KinematicsFromTree( TTree *event_tree,
+                                    const vector< unsigned int > &topology_masks,
+                                    const function< void( const EventKinematics& ) > &consume ){
+
+    GstEvent event;
+
+    const SmearingConfig *smearing  = GstSmearing();
+    unsigned int          smear_key = smearing ? RngModelKey( event_tree ) : 0;
+
+    vector< TBranch* > branches;
+    BranchKinematicsEvent( event_tree, event, branches );
+
+    // The topology index holds the true topologies, a smeared event may
+    // have another
+    TEntryList *entries = smearing ? 0 : GstTopologyUnion( event_tree, topology_masks );
+
+    KinematicsInput input;
+    EventKinematics kinematics;
+    TopologyEvent   topology;
+
+    ClearKinematicsInput( input );
+
+    Long64_t n_entries  = entries ? entries->GetN() : event_tree->GetEntries();
+    Long64_t n_computed = 0;
+
+    for( Long64_t i_entry = 0; i_entry < n_entries; ++i_entry ){
+
+        Long64_t entry = entries ? entries->GetEntry( i_entry ) : i_entry;
+
+        Long64_t local_entry = event_tree->LoadTree( entry );
+        if( local_entry < 0 ) break;
+
+        ReadKinematicsEvent( branches, event, entry, local_entry );
+
+        if( smearing ) SmearGstEvent( *smearing, smear_key, entry, event );
+
+        topology.cc    = event.cc;
+        topology.nc    = event.nc;
+        topology.coh   = event.coh;
+        topology.nfpip = event.nfpip;
+        topology.nfpim = event.nfpim;
+        topology.nfpi0 = event.nfpi0;
+
+        unsigned int mask = ClassifyTopology( topology );
+        if( !KinematicsSelected( mask, topology_masks ) ) continue;
+
+        AppendKinematicsEvent( event, mask, input );
+        ++n_computed;
+
+        if( Long64_t( input.Ev.size() ) == kEventBlockSize ){
+            ComputeKinematics( input, kinematics );
+            consume( kinematics );
+            ClearKinematicsInput( input );
+        }
+    }
+    delete entries;
+
+    if( !input.Ev.empty() ){
+        ComputeKinematics( input, kinematics );
+        consume( kinematics );
+    }
+
+    for( unsigned int b = 0; b < branches.size(); ++b ){
+        event_tree->ResetBranchAddress( branches[b] );
+    }
+
+    return n_computed;
+}
+
+// -------------------------------------------------------------------------
+//                          single pass scan
+// -------------------------------------------------------------------------
+Long64_t ScanKinematics( TTree *event_tree,
+                         const vector< unsigned int > &topology_masks,
+                         const function< void( const EventKinematics& ) > &consume ){
+
+    // The store holds the true kinematics, smeared events are read from the tree
+    EventStore *store = GstSmearing() ? 0 : GstEventStore( event_tree );
+
+    if( store ){
+
+        vector< int > store_columns( n_kinematics_columns );
+        bool complete = true;
+
+        for( int c = 0; c < n_kinematics_columns; ++c ){
+            store_columns[c] = EventStoreColumn( *store, kinematics_columns[c] );
+            if( store_columns[c] < 0 ) complete = false;
+        }
+
+        if( complete ) return KinematicsFromStore( *store, store_columns, topology_masks, consume );
+    }
+
+    return KinematicsFromTree( event_tree, topology_masks, consume );
+}
+
+// -------------------------------------------------------------------------
+//                          kinematic fills
+// -------------------------------------------------------------------------
+int FlatKinematicsCount( const vector< FlatFill > &fills ){
+
+    int n_kinematics = 0;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].kinematics.empty() ) ++n_kinematics;
+    }
+
+    return n_kinematics;
+}
+
+bool BeginKinematicsPass( const vector< FlatFill > &fills,
+                          KinematicsPass &pass ){
+
+    pass.fills.clear();
+    pass.weights.clear();
+    pass.channels.clear();
+    ClearKinematicsInput( pass.input );
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        const FlatFill &fill = fills[i];
+        if( fill.kinematics.empty() ) continue;
+
+        if( !fill.universes.cells.empty() || !fill.replicas.cells.empty() || !fill.oscillated.cells.empty() ){
+            cerr << " The kinematic fill " << fill.variable << " cannot have universes, replicas or oscillations " << endl;
+            exit(1);
+        }
+
+        pass.fills.push_back( i );
+    }
+
+    return !pass.fills.empty();
+}
+
+// -------------------------------------------------------------------------
+// Fill the kinematic fills from the batch of a pass, and empty it
+// -------------------------------------------------------------------------
+static void FillKinematicsBatch( KinematicsPass &pass,
+                                 vector< FlatFill > &fills ){
+
+    if( pass.input.Ev.empty() ) return;
+
+    ComputeKinematics( pass.input, pass.output );
+
+    unsigned int n_fills = pass.fills.size();
+
+    for( unsigned int f = 0; f < n_fills; ++f ){
+
+        FlatFill &fill = fills[ pass.fills[f] ];
+
+        bool by_channel = !fill.channels.empty();
+
+        const double *x = &pass.output.values[ fill.kinematics[0] ][0];
+        const double *y = fill.kinematics.size() > 1 ? &pass.output.values[ fill.kinematics[1] ][0] : 0;
+
+        for( Long64_t i = 0; i < pass.output.n_events; ++i ){
+
+            double weight = pass.weights[ i * n_fills + f ];
+            if( weight == 0 ) continue;
+
+            if( y ){
+                FillFlatHist( fill.hist, x[i], y[i], weight );
+                if( by_channel ) FillFlatHist( fill.channels[ pass.channels[i] ], x[i], y[i], weight );
+            }
+            else{
+                FillFlatHist( fill.hist, x[i], weight );
+                if( by_channel ) FillFlatHist( fill.channels[ pass.channels[i] ], x[i], weight );
+            }
+        }
+    }
+
+    pass.weights.clear();
+    pass.channels.clear();
+    ClearKinematicsInput( pass.input );
+}
+
+void AddKinematicsEvent( KinematicsPass &pass,
+                         vector< FlatFill > &fills,
+                         const GstEvent &event,
+                         unsigned int topology,
+                         int channel,
+                         const double *weights ){
+
+    unsigned int n_fills = pass.fills.size();
+
+    bool selected = false;
+    for( unsigned int f = 0; f < n_fills; ++f ){
+        if( weights[f] != 0 ) selected = true;
+    }
+    if( !selected ) return;
+
+    AppendKinematicsEvent( event, topology, pass.input );
+    pass.weights.insert( pass.weights.end(), weights, weights + n_fills );
+    pass.channels.push_back( channel );
+
+    if( Long64_t( pass.input.Ev.size() ) == kEventBlockSize ) FillKinematicsBatch( pass, fills );
+}
+
+void EndKinematicsPass( KinematicsPass &pass,
+                        vector< FlatFill > &fills ){
+
+    FillKinematicsBatch( pass, fills );
+}
@@ -0,0 +1,295 @@
+/*
+ * The event kinematics of the macros in one fused kernel
+ *
+ * Q2, Ev, the muon and pion kinematics, the average proton kinetic energy
+ * and the reconstructed neutrino energy are each plotted through a Draw
+ * expression of their own, so a gst tree is read and its particle arrays
+ * looped over once for every one of them. ComputeKinematics takes the
+ * input columns of a batch of events, one array for each gst branch with
+ * the particles of all of the events one after the other, and computes
+ * every KinematicVariable of every event in a single pass, with W, x, the
+ * transverse kinematic imbalance, the visible hadronic energy and the
+ * calorimetric and proton corrected neutrino energies besides
+ *
+ * The output is a struct of arrays, one contiguous column per variable.
+ * A fill booked with FlatBookKinematics takes its variables from these
+ * columns: FillFlat gathers the events it reads for the other fills of the
+ * pass into batches, and fills the histograms of the kinematic fills from
+ * the output of each. ScanKinematics runs the kernel on its own, over the
+ * blocks of the event store when it has been written, or batches of the
+ * events read from the bound gst branches otherwise
+ *
+*/
+
+#ifndef EVENT_KINEMATICS_H
+#define EVENT_KINEMATICS_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include "TTree.h"
+#include "flat_hist.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The energy taken to remove a proton from the argon nucleus, added for
+// each proton by the proton corrected energy (GeV)
+// -------------------------------------------------------------------------
+const double kRemovalEnergy = 0.0295;
+
+// -------------------------------------------------------------------------
+// The gst branches the kernel reads, as a planned fill for OpenGstReader
+// -------------------------------------------------------------------------
+const char* const kKinematicsFill = "nf + cc + nc + coh + nfpip + nfpim + nfpi0 + Ev + EvRF + Q2 + ys + El + pl + cthl + "
+                                    "pxl + pyl + nfp + nfn + sumKEf + pdgf + Ef + pxf + pyf + pf + cthf";
+
+// -------------------------------------------------------------------------
+// The visible energy of a final state particle in the hadronic system, the
+// kinetic energy of a proton and the energy of a pion, kaon, photon or
+// electron, 0 for anything else (GeV)
+// -------------------------------------------------------------------------
+inline double HadronEnergy( int pdg,
+                            double E ){
+
+    const double m_p = 0.93827;   // Proton mass, GeV
+
+    pdg = pdg < 0 ? -pdg : pdg;
+
+    if( pdg == 2212 ) return E - m_p;
+    if( pdg == 211 || pdg == 111 || pdg == 321 || pdg == 311 || pdg == 310 || pdg == 130 || pdg == 22 || pdg == 11 ) return E;
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+// The visible hadronic energy of the n_particles final state particles of
+// an event, the sum of their HadronEnergy (GeV). Shared by the kernel and
+// the E_vis of derived_tree.h
+// -------------------------------------------------------------------------
+template< class P >
+inline double HadronicEnergy( const P *pdgf,
+                              const double *Ef,
+                              Long64_t n_particles ){
+
+    double E_had = 0;
+
+    for( Long64_t k = 0; k < n_particles; ++k ){
+        E_had += HadronEnergy( int( pdgf[k] ), Ef[k] );
+    }
+
+    return E_had;
+}
+
+// -------------------------------------------------------------------------
+// The variables of the kernel
+//      kKinQ2, kKinEv, kKinEvRF, kKinYs : the gst Q2, Ev, EvRF and ys
+//      kKinPMu, kKinCthMu      : momentum (GeV) and cos theta of the charged
+//                                lepton for CC, 0 and -2 for NC
+//      kKinPPi, kKinCthPi      : momentum (GeV) and cos theta of the leading
+//                                charged pion, 0 and -2 if none
+//      kKinNNucleons           : nfp + nfn
+//      kKinAvgKEp              : sumKEf / nfp, 0 without protons
+//      kKinRecoEv              : CCQE reconstructed energy, as RecoNuE (GeV)
+//      kKinW, kKinX            : the invariant mass (GeV) and Bjorken x of a
+//                                nucleon at rest, from Ev and the lepton
+//      kKinDpT, kKinDalphaT,   : the transverse kinematic imbalance of the
+//      kKinDphiT                 lepton and the leading proton, dpT (GeV)
+//                                and the angles (rad), -1 for NC or
+//                                without a proton
+//      kKinEHad                : visible hadronic energy, HadronicEnergy of
+//                                the final state particles (GeV)
+//      kKinCaloEv              : calorimetric neutrino energy, the charged
+//                                lepton energy for CC plus E_had (GeV)
+//      kKinProtonEv            : proton corrected neutrino energy, the charged
+//                                lepton energy for CC plus the kinetic energy
+//                                of each proton and kRemovalEnergy (GeV)
+// -------------------------------------------------------------------------
+enum KinematicVariable {
+    kKinQ2,
+    kKinEv,
+    kKinEvRF,
+    kKinYs,
+    kKinPMu,
+    kKinCthMu,
+    kKinPPi,
+    kKinCthPi,
+    kKinNNucleons,
+    kKinAvgKEp,
+    kKinRecoEv,
+    kKinW,
+    kKinX,
+    kKinDpT,
+    kKinDalphaT,
+    kKinDphiT,
+    kKinEHad,
+    kKinCaloEv,
+    kKinProtonEv,
+    kNKinematics
+};
+
+// -------------------------------------------------------------------------
+// The name of each variable, as the derived columns where they share one
+// -------------------------------------------------------------------------
+inline const char* KinematicName( int variable ){
+
+    static const char* names[kNKinematics] = { "Q2", "Ev", "EvRF", "ys",
+                                               "p_mu", "cth_mu", "p_pi", "cth_pi",
+                                               "n_nucleons", "avg_KE_p", "reco_Ev",
+                                               "W", "x", "dpT", "dalphaT", "dphiT", "E_had",
+                                               "calo_Ev", "proton_Ev" };
+
+    return names[variable];
+}
+
+// -------------------------------------------------------------------------
+// The variable of a name, or -1 if there is none
+// -------------------------------------------------------------------------
+int KinematicIndex( const string &name );
+
+// -------------------------------------------------------------------------
+// The input columns of a batch of events, a value for each event or, for
+// the particle columns, one for each particle
+//      topology  : the ClassifyTopology mask of each event
+//      offsets   : the particles of event i are rows offsets[i] to
+//                  offsets[i + 1] - 1 of the particle columns
+// -------------------------------------------------------------------------
+struct KinematicsInput {
+    vector< double >   cc;
+    vector< double >   Ev;
+    vector< double >   EvRF;
+    vector< double >   Q2;
+    vector< double >   ys;
+    vector< double >   El;
+    vector< double >   pl;
+    vector< double >   cthl;
+    vector< double >   pxl;
+    vector< double >   pyl;
+    vector< double >   nfp;
+    vector< double >   nfn;
+    vector< double >   sumKEf;
+    vector< double >   topology;
+    vector< Long64_t > offsets;
+    vector< double >   pdgf;
+    vector< double >   Ef;
+    vector< double >   pxf;
+    vector< double >   pyf;
+    vector< double >   pf;
+    vector< double >   cthf;
+};
+
+// -------------------------------------------------------------------------
+// The output of the kernel for a batch
+//      n_events : the number of events
+//      topology : the topology mask of each event
+//      values   : a column of n_events values for each KinematicVariable
+// -------------------------------------------------------------------------
+struct EventKinematics {
+    Long64_t                    n_events;
+    vector< unsigned int >      topology;
+    vector< vector< double > >  values;
+};
+
+// -------------------------------------------------------------------------
+// Empty the input columns, ready for a new batch
+// -------------------------------------------------------------------------
+void ClearKinematicsInput( KinematicsInput &input );
+
+// -------------------------------------------------------------------------
+// Add an event read from the gst branches to the end of a batch
+// -------------------------------------------------------------------------
+void AppendKinematicsEvent( const GstEvent &event,
+                            unsigned int topology,
+                            KinematicsInput &input );
+
+// -------------------------------------------------------------------------
+// Compute every variable of every event of a batch in one pass
+// -------------------------------------------------------------------------
+void ComputeKinematics( const KinematicsInput &input,
+                        EventKinematics &output );
+
+// -------------------------------------------------------------------------
+// Compute the kinematics of a gst tree in a single pass, through the event
+// store if it holds the input columns, otherwise from the gst branches,
+// and pass the output of each batch to consume. Only the events in every
+// topology of one of the masks of TopologyBits are computed, all of them
+// if a mask is 0. Returns the number of events computed
+// -------------------------------------------------------------------------
+Long64_t ScanKinematics( TTree *event_tree,
+                         const vector< unsigned int > &topology_masks,
+                         const function< void( const EventKinematics& ) > &consume );
+
+// -------------------------------------------------------------------------
+// The number of fills which take their variables from the kernel, those
+// booked with FlatBookKinematics
+// -------------------------------------------------------------------------
+int FlatKinematicsCount( const vector< FlatFill > &fills );
+
+// -------------------------------------------------------------------------
+// The kinematic fills of a FillFlat pass, the events of which are gathered
+// into a batch and filled from its kinematics every kEventBlockSize events
+//      fills    : the index of each kinematic fill in the fills of the pass
+//      weights  : the weight of each event of the batch in each of them,
+//                 event * fills.size() + f, 0 if it is not selected
+//      channels : the InteractionChannel of each event of the batch
+// -------------------------------------------------------------------------
+struct KinematicsPass {
+    vector< int >    fills;
+    vector< double > weights;
+    vector< int >    channels;
+    KinematicsInput  input;
+    EventKinematics  output;
+};
+
+// -------------------------------------------------------------------------
+// Start a pass for the kinematic fills of fills, returns whether there are
+// any. Exits if one has universes, replicas or oscillations, which are
+// only filled from the variables of the other fills
+// -------------------------------------------------------------------------
+bool BeginKinematicsPass( const vector< FlatFill > &fills,
+                          KinematicsPass &pass );
+
+// -------------------------------------------------------------------------
+// Add an event to the batch of a pass, with its topology, channel and the
+// weight of the event in each of the kinematic fills, in the order of
+// pass.fills. Events with no weight in any of them are left out
+// -------------------------------------------------------------------------
+void AddKinematicsEvent( KinematicsPass &pass,
+                         vector< FlatFill > &fills,
+                         const GstEvent &event,
+                         unsigned int topology,
+                         int channel,
+                         const double *weights );
+
+// -------------------------------------------------------------------------
+// Fill the kinematic fills with the events left in the batch of a pass
+// -------------------------------------------------------------------------
+void EndKinematicsPass( KinematicsPass &pass,
+                        vector< FlatFill > &fills );
+
+// -------------------------------------------------------------------------
+// Add the gst branches of the kernel to a set of branches
+// -------------------------------------------------------------------------
+void KinematicsBranches( s_branches &branches );
+
+// -------------------------------------------------------------------------
+// Bind the gst branches of the kernel, and those the smearing of
+// smearing.h needs if it is set, to the fields of an event, nf first
+// -------------------------------------------------------------------------
+void BranchKinematicsEvent( TTree *event_tree,
+                            GstEvent &event,
+                            vector< TBranch* > &branches );
+
+// -------------------------------------------------------------------------
+// Read an entry into the event the branches were bound to. Exits if it has
+// more than kGstMaxParticles particles
+// -------------------------------------------------------------------------
+void ReadKinematicsEvent( const vector< TBranch* > &branches,
+                          const GstEvent &event,
+                          Long64_t entry,
+                          Long64_t local_entry );
+
+// -------------------------------------------------------------------------
+
+#endif
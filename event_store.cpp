@@ -0,0 +1,1152 @@
+/*
+ * Columnar store of the scalar gst branches with zone maps
+ *
+ * See event_store.h for the description of each function
+ *
+ * The file holds, in order:
+ *      the version, the GstSourceStamp of the gst file, the cluster column,
+ *      the number of entries and the names of the columns
+ *      the position of the zone maps
+ *      the encoded values of each column, block by block
+ *      the zone maps: the encoding of each column and whether it is a
+ *      particle column, then the position, minimum, maximum, error and
+ *      packed bits of each of its blocks
+ *      the number of particles in each block
+ *
+*/
+
+#include <map>
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TSystem.h"
+#include "event_store.h"
+#include "gst_reader.h"
+#include "topologies.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The gst branches the store holds, those of them which the tree has
+// -------------------------------------------------------------------------
+const int n_store_branches = 40;
+
+const char* store_branches[n_store_branches] = {
+    "neu",   "fspl",  "tgt",   "hitnuc", "qel",   "mec",    "res",   "dis",
+    "coh",   "cc",    "nc",    "wght",   "x",     "y",      "W",     "Q2",
+    "xs",    "ys",    "Ws",    "Q2s",    "Ev",    "EvRF",   "El",    "pxl",
+    "pyl",   "pzl",   "pl",    "cthl",   "nfp",   "nfn",    "nfpip", "nfpim",
+    "nfpi0", "nfkp",  "nfkm",  "nfk0",   "nfem",  "nfother", "sumKEf", "nf"
+};
+
+// The particle arrays it holds, each with nf values, and KEf after them
+const int n_particle_branches = 7;
+
+const char* particle_branches[n_particle_branches] = { "pdgf", "Ef", "pxf", "pyf", "pzf", "pf", "cthf" };
+
+// -------------------------------------------------------------------------
+// The stores opened so far, by file name, 0 for those which are not usable
+// -------------------------------------------------------------------------
+static map< string, EventStore* > event_stores;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          store file location
+// -------------------------------------------------------------------------
+string EventStorePath( const string &gst_path ){
+
+    string path = gst_path;
+
+    if( path.size() > 5 && path.compare( path.size() - 5, 5, ".root" ) == 0 ){
+        path.erase( path.size() - 5 );
+    }
+    path += ".event_store";
+
+    const char* store_dir = getenv( "SBND_STORE_DIR" );
+
+    if( !store_dir ) return path;
+
+    for( unsigned int i = 0; i < path.size(); ++i ){
+        if( path[i] == '/' ) path[i] = '_';
+    }
+
+    return string( store_dir ) + "/" + path;
+}
+
+// -------------------------------------------------------------------------
+// Write and read the plain values of the file
+// -------------------------------------------------------------------------
+template< typename T >
+static void WriteStoreValue( ofstream &file,
+                             const T &value ){
+
+    file.write( (const char*) &value, sizeof( T ) );
+}
+
+template< typename T >
+static void ReadStoreValue( ifstream &file,
+                            T &value ){
+
+    file.read( (char*) &value, sizeof( T ) );
+}
+
+static void WriteStoreString( ofstream &file,
+                              const string &value ){
+
+    Int_t size = value.size();
+    WriteStoreValue( file, size );
+    file.write( value.data(), size );
+}
+
+static string ReadStoreString( ifstream &file ){
+
+    Int_t size = 0;
+    ReadStoreValue( file, size );
+
+    // A file which is not a store can give any size
+    if( !file || size < 0 || size > 1000000 ) return "";
+
+    string value( size, ' ' );
+    file.read( &value[0], size );
+
+    return file ? value : "";
+}
+
+// -------------------------------------------------------------------------
+// A float in IEEE half precision, rounded to the nearest with ties to even
+// -------------------------------------------------------------------------
+static unsigned short HalfFromFloat( float value ){
+
+    UInt_t bits;
+    memcpy( &bits, &value, 4 );
+
+    UInt_t sign = ( bits >> 16 ) & 0x8000;
+    bits &= 0x7fffffff;
+
+    // Infinite, NaN or beyond the largest half
+    if( bits >= 0x47800000 ) return sign | ( bits > 0x7f800000 ? 0x7e00 : 0x7c00 );
+
+    // Below the smallest normal half, in units of 2^-24
+    if( bits < 0x38800000 ){
+        float magnitude;
+        memcpy( &magnitude, &bits, 4 );
+        return sign | (unsigned short) nearbyint( magnitude * 16777216.f );
+    }
+
+    // Rebias the exponent from 127 to 15 and round off 13 bits of mantissa
+    bits += 0xc8000fff + ( ( bits >> 13 ) & 1 );
+
+    return sign | ( bits >> 13 );
+}
+
+// -------------------------------------------------------------------------
+// A half precision value as a float, without branches so that a loop of
+// them is vectorised
+// -------------------------------------------------------------------------
+static inline float FloatFromHalf( unsigned short half ){
+
+    UInt_t bits     = UInt_t( half & 0x7fff ) << 13;
+    UInt_t exponent = bits & 0x0f800000;
+
+    // Rebias the exponent, infinite and NaN keep the largest one, and the
+    // subnormals are made normal then have the implicit bit taken away
+    bits += ( exponent == 0x0f800000 ? 0x70000000u : 0x38000000u ) + ( exponent == 0 ? 0x00800000u : 0u );
+
+    float value;
+    memcpy( &value, &bits, 4 );
+    value -= exponent == 0 ? 6.103515625e-05f : 0.f;
+
+    memcpy( &bits, &value, 4 );
+    bits |= UInt_t( half & 0x8000 ) << 16;
+    memcpy( &value, &bits, 4 );
+
+    return value;
+}
+
+// -------------------------------------------------------------------------
+// The encoding of a column: a bitmap or packed if its values are all flags
+// or integers, otherwise as the float bits ask and its range allows
+// -------------------------------------------------------------------------
+static int ColumnEncoding( const vector< double > &values,
+                           int float_bits ){
+
+    bool   flags    = true;
+    bool   integers = true;
+    double max_abs  = 0;
+    double min      = 0;
+    double max      = 0;
+
+    for( unsigned int i = 0; i < values.size(); ++i ){
+
+        double value = values[i];
+
+        if( value != 0 && value != 1 ) flags = false;
+        if( !( value == floor( value ) ) || fabs( value ) > 4503599627370496. ) integers = false;
+        if( fabs( value ) > max_abs ) max_abs = fabs( value );
+
+        if( i == 0 || value < min ) min = value;
+        if( i == 0 || value > max ) max = value;
+    }
+
+    // Every block is then packed in at most 32 bits
+    if( max - min >= 4294967296. ) integers = false;
+
+    if( flags )                                 return kStoreBitmap;
+    if( integers )                              return kStorePacked;
+    if( float_bits == 16 && max_abs <= 65504 )  return kStoreHalf;
+    if( float_bits <= 32 && max_abs <= FLT_MAX ) return kStoreFloat;
+
+    return kStoreDouble;
+}
+
+// -------------------------------------------------------------------------
+// The bits needed to pack a block, the fewest of 0, 1, 2, 4, 8, 16 and 32
+// which hold the difference between its largest and smallest values
+// -------------------------------------------------------------------------
+static Int_t PackedBits( double block_min,
+                         double block_max ){
+
+    Int_t bits = 0;
+    while( bits < 32 && block_max - block_min >= ldexp( 1., bits ) ) bits = bits ? 2 * bits : 1;
+
+    return bits;
+}
+
+// -------------------------------------------------------------------------
+// The bytes of an encoded block
+// -------------------------------------------------------------------------
+static Long64_t EventBlockBytes( const EventColumn &column,
+                                 Long64_t block,
+                                 Long64_t n_rows ){
+
+    if( column.encoding == kStoreDouble ) return n_rows * sizeof( double );
+    if( column.encoding == kStoreFloat )  return n_rows * sizeof( float );
+    if( column.encoding == kStoreHalf )   return n_rows * sizeof( unsigned short );
+
+    Int_t bits = column.block_bits[block];
+    if( bits == 0 ) return 0;
+
+    Long64_t per_word = 64 / bits;
+    return ( ( n_rows + per_word - 1 ) / per_word ) * sizeof( ULong64_t );
+}
+
+// -------------------------------------------------------------------------
+// Encode the values of a block, recording its bits and error in the column
+// -------------------------------------------------------------------------
+static void EncodeEventBlock( EventColumn &column,
+                              const double *values,
+                              Long64_t n_rows,
+                              vector< char > &bytes ){
+
+    Long64_t block = column.block_bits.size();
+    double   error = 0;
+    Int_t    bits  = 0;
+
+    if( column.encoding == kStorePacked ) bits = PackedBits( column.block_min[block], column.block_max[block] );
+    if( column.encoding == kStoreBitmap ) bits = 1;
+
+    column.block_bits.push_back( bits );
+    bytes.assign( EventBlockBytes( column, block, n_rows ), 0 );
+
+    // A block of a particle column may have no particles
+    if( n_rows == 0 ){
+        column.block_error.push_back( 0 );
+        return;
+    }
+
+    if( column.encoding == kStoreDouble ){
+        memcpy( &bytes[0], values, n_rows * sizeof( double ) );
+    }
+    else if( column.encoding == kStoreFloat ){
+        for( Long64_t i = 0; i < n_rows; ++i ){
+            float value = values[i];
+            memcpy( &bytes[ i * sizeof( float ) ], &value, sizeof( float ) );
+            if( fabs( values[i] - value ) > error ) error = fabs( values[i] - value );
+        }
+    }
+    else if( column.encoding == kStoreHalf ){
+        for( Long64_t i = 0; i < n_rows; ++i ){
+            unsigned short half = HalfFromFloat( values[i] );
+            memcpy( &bytes[ i * sizeof( unsigned short ) ], &half, sizeof( unsigned short ) );
+            if( fabs( values[i] - FloatFromHalf( half ) ) > error ) error = fabs( values[i] - FloatFromHalf( half ) );
+        }
+    }
+    else if( bits > 0 ){
+
+        // The difference from the block minimum, or the flag of a bitmap
+        double   reference = column.encoding == kStorePacked ? column.block_min[block] : 0;
+        Long64_t per_word  = 64 / bits;
+
+        for( Long64_t i = 0; i < n_rows; ++i ){
+
+            ULong64_t word;
+            memcpy( &word, &bytes[ ( i / per_word ) * sizeof( ULong64_t ) ], sizeof( ULong64_t ) );
+            word |= ULong64_t( values[i] - reference ) << ( ( i % per_word ) * bits );
+            memcpy( &bytes[ ( i / per_word ) * sizeof( ULong64_t ) ], &word, sizeof( ULong64_t ) );
+        }
+    }
+
+    column.block_error.push_back( error );
+}
+
+// -------------------------------------------------------------------------
+// Unpack a block of values of a fixed number of bits, which the compiler
+// turns into shifts and masks over several values at a time
+// -------------------------------------------------------------------------
+template< int bits >
+static void UnpackEventBlock( const char* data,
+                              Long64_t n_rows,
+                              double reference,
+                              double *values ){
+
+    const Long64_t  per_word = 64 / bits;
+    const ULong64_t mask     = ( ULong64_t(1) << bits ) - 1;
+
+    for( Long64_t i = 0; i < n_rows; ++i ){
+        ULong64_t word;
+        memcpy( &word, data + ( i / per_word ) * sizeof( ULong64_t ), sizeof( ULong64_t ) );
+        values[i] = reference + double( Long64_t( ( word >> ( ( i % per_word ) * bits ) ) & mask ) );
+    }
+}
+
+// -------------------------------------------------------------------------
+// Decode the values of a block
+// -------------------------------------------------------------------------
+static void DecodeEventBlock( const EventColumn &column,
+                              Long64_t block,
+                              const char* data,
+                              Long64_t n_rows,
+                              double *values ){
+
+    if( column.encoding == kStoreDouble ){
+        memcpy( values, data, n_rows * sizeof( double ) );
+        return;
+    }
+
+    if( column.encoding == kStoreFloat ){
+        for( Long64_t i = 0; i < n_rows; ++i ){
+            float value;
+            memcpy( &value, data + i * sizeof( float ), sizeof( float ) );
+            values[i] = value;
+        }
+        return;
+    }
+
+    if( column.encoding == kStoreHalf ){
+        for( Long64_t i = 0; i < n_rows; ++i ){
+            unsigned short half;
+            memcpy( &half, data + i * sizeof( unsigned short ), sizeof( unsigned short ) );
+            values[i] = FloatFromHalf( half );
+        }
+        return;
+    }
+
+    double reference = column.encoding == kStorePacked ? column.block_min[block] : 0;
+
+    switch( column.block_bits[block] ){
+        case 0:  for( Long64_t i = 0; i < n_rows; ++i ) values[i] = reference; break;
+        case 1:  UnpackEventBlock< 1 >(  data, n_rows, reference, values ); break;
+        case 2:  UnpackEventBlock< 2 >(  data, n_rows, reference, values ); break;
+        case 4:  UnpackEventBlock< 4 >(  data, n_rows, reference, values ); break;
+        case 8:  UnpackEventBlock< 8 >(  data, n_rows, reference, values ); break;
+        case 16: UnpackEventBlock< 16 >( data, n_rows, reference, values ); break;
+        case 32: UnpackEventBlock< 32 >( data, n_rows, reference, values ); break;
+        default:
+            cerr << " Unknown packing of " << column.name << " in the event store " << endl;
+            exit(1);
+    }
+}
+
+// -------------------------------------------------------------------------
+// The values of a particle array for every entry one after the other, with
+// those of entry e from first[e], or for KEf, a leaf of 0, the kinetic
+// energy of each particle from Ef and pf
+// -------------------------------------------------------------------------
+static void ReadParticleColumn( TTree *event_tree,
+                                TLeaf *leaf,
+                                const vector< Long64_t > &first,
+                                vector< double > &values ){
+
+    Long64_t n_entries = first.size() - 1;
+
+    TLeaf *energy   = leaf ? leaf : event_tree->GetLeaf( "Ef" );
+    TLeaf *momentum = leaf ? 0    : event_tree->GetLeaf( "pf" );
+    TLeaf *count    = energy->GetLeafCount();
+
+    values.assign( first[n_entries], 0 );
+
+    for( Long64_t entry = 0; entry < n_entries; ++entry ){
+
+        // The count is read first, the arrays are read with its length
+        count->GetBranch()->GetEntry( entry, 1 );
+        energy->GetBranch()->GetEntry( entry, 1 );
+        if( momentum ) momentum->GetBranch()->GetEntry( entry, 1 );
+
+        Long64_t n = first[ entry + 1 ] - first[entry];
+
+        if( energy->GetLen() != n || ( momentum && momentum->GetLen() != n ) ){
+            cerr << " The particle arrays of entry " << entry << " do not have nf values " << endl;
+            exit(1);
+        }
+
+        for( Long64_t k = 0; k < n; ++k ){
+
+            double value = energy->GetValue( k );
+
+            if( momentum ){
+                double p = momentum->GetValue( k );
+                value -= sqrt( max( value * value - p * p, 0. ) );
+            }
+
+            values[ first[entry] + k ] = value;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          write the store
+// -------------------------------------------------------------------------
+Long64_t WriteEventStore( const string &gst_path,
+                          const string &cluster_column,
+                          int float_bits ){
+
+    if( float_bits != 16 && float_bits != 32 && float_bits != 64 ){
+        cerr << " The event store can only round to 16, 32 or 64 bits, not " << float_bits << endl;
+        exit(1);
+    }
+
+    TFile gst_file( gst_path.c_str() );
+    TTree *event_tree = gst_file.IsZombie() ? 0 : (TTree*) gst_file.Get("gst");
+
+    if( !event_tree ){
+        cerr << " Could not read the gst tree in " << gst_path << endl;
+        exit(1);
+    }
+
+    // The scalar numeric branches of the tree, then its particle arrays
+    vector< string > names;
+    vector< TLeaf* > leaves;
+    vector< bool >   particles;
+    TLeaf *cluster_leaf = 0;
+
+    for( int i = 0; i < n_store_branches; ++i ){
+
+        TLeaf *leaf = event_tree->GetLeaf( store_branches[i] );
+        if( !leaf || leaf->GetLeafCount() || leaf->GetLen() != 1 ) continue;
+
+        names.push_back( store_branches[i] );
+        leaves.push_back( leaf );
+        particles.push_back( false );
+        if( cluster_column == store_branches[i] ) cluster_leaf = leaf;
+    }
+
+    TLeaf *count_leaf = event_tree->GetLeaf( "nf" );
+    if( find( names.begin(), names.end(), "nf" ) == names.end() ) count_leaf = 0;
+
+    for( int i = 0; count_leaf && i < n_particle_branches; ++i ){
+
+        TLeaf *leaf = event_tree->GetLeaf( particle_branches[i] );
+        if( !leaf || !leaf->GetLeafCount() || string( leaf->GetLeafCount()->GetName() ) != "nf" ) continue;
+
+        names.push_back( particle_branches[i] );
+        leaves.push_back( leaf );
+        particles.push_back( true );
+    }
+
+    if( find( names.begin(), names.end(), "Ef" ) != names.end() && find( names.begin(), names.end(), "pf" ) != names.end() ){
+        names.push_back( "KEf" );
+        leaves.push_back( 0 );
+        particles.push_back( true );
+    }
+
+    if( !cluster_leaf ){
+        cerr << " The events cannot be written in the order of " << cluster_column << endl;
+        exit(1);
+    }
+
+    Long64_t n_entries = event_tree->GetEntries();
+    Long64_t n_blocks  = ( n_entries + kEventBlockSize - 1 ) / kEventBlockSize;
+
+    // The order of the events, their topologies and where their particles
+    // start, from a first pass
+    vector< double >   key( n_entries );
+    vector< double >   topology( n_entries );
+    vector< Long64_t > order( n_entries );
+    vector< Long64_t > first( n_entries + 1, 0 );
+
+    TopologyLeaves topology_leaves;
+    TopologyEvent  event;
+    GetTopologyLeaves( event_tree, topology_leaves );
+
+    for( Long64_t entry = 0; entry < n_entries; ++entry ){
+
+        cluster_leaf->GetBranch()->GetEntry( entry, 1 );
+        key[entry] = cluster_leaf->GetValue();
+
+        ReadTopologyEvent( topology_leaves, entry, event );
+        topology[entry] = ClassifyTopology( event );
+
+        Long64_t n_particles = 0;
+        if( count_leaf ){
+            count_leaf->GetBranch()->GetEntry( entry, 1 );
+            n_particles = Long64_t( count_leaf->GetValue() );
+        }
+        first[ entry + 1 ] = first[entry] + n_particles;
+
+        order[entry] = entry;
+    }
+
+    // NaN last, events with the same value in the order of the gst tree
+    stable_sort( order.begin(), order.end(), [&key]( Long64_t a, Long64_t b ){
+        return !std::isnan( key[a] ) && ( std::isnan( key[b] ) || key[a] < key[b] );
+    } );
+
+    string store_path = EventStorePath( gst_path );
+    ofstream file( store_path.c_str(), ios::binary | ios::trunc );
+
+    if( !file ){
+        cerr << " Could not write " << store_path << endl;
+        exit(1);
+    }
+
+    // The particles of each block, in the order they are written
+    vector< Long64_t > block_particles( n_blocks, 0 );
+    for( Long64_t i = 0; i < n_entries; ++i ){
+        block_particles[ i / kEventBlockSize ] += first[ order[i] + 1 ] - first[ order[i] ];
+    }
+
+    names.insert( names.begin(), "topology" );
+    names.insert( names.begin(), "gst_entry" );
+    leaves.insert( leaves.begin(), 2, (TLeaf*) 0 );
+    particles.insert( particles.begin(), 2, false );
+
+    Int_t n_columns = names.size();
+
+    WriteStoreString( file, kEventStoreVersion );
+    WriteStoreString( file, GstSourceStamp( event_tree ) );
+    WriteStoreString( file, cluster_column );
+    WriteStoreValue( file, n_entries );
+    WriteStoreValue( file, n_columns );
+    for( int c = 0; c < n_columns; ++c ) WriteStoreString( file, names[c] );
+
+    // Set once the zone maps are written
+    Long64_t zone_maps = 0;
+    Long64_t zone_maps_at = file.tellp();
+    WriteStoreValue( file, zone_maps );
+
+    vector< EventColumn > columns( n_columns );
+    vector< double >      values( n_entries );
+    vector< double >      sorted;
+    vector< char >        bytes;
+
+    for( int c = 0; c < n_columns; ++c ){
+
+        if( c == 0 ){
+            for( Long64_t entry = 0; entry < n_entries; ++entry ) values[entry] = entry;
+        }
+        else if( c == 1 ){
+            values.swap( topology );
+        }
+        else if( particles[c] ){
+            ReadParticleColumn( event_tree, leaves[c], first, values );
+        }
+        else{
+            values.resize( n_entries );
+            TBranch *branch = leaves[c]->GetBranch();
+            for( Long64_t entry = 0; entry < n_entries; ++entry ){
+                branch->GetEntry( entry, 1 );
+                values[entry] = leaves[c]->GetValue();
+            }
+        }
+
+        // The particles of each event follow on from those of the last
+        sorted.clear();
+        for( Long64_t i = 0; i < n_entries; ++i ){
+            if( particles[c] ) sorted.insert( sorted.end(), values.begin() + first[ order[i] ], values.begin() + first[ order[i] + 1 ] );
+            else               sorted.push_back( values[ order[i] ] );
+        }
+
+        EventColumn &column = columns[c];
+        column.name      = names[c];
+        column.encoding  = ColumnEncoding( sorted, float_bits );
+        column.particles = particles[c];
+
+        Long64_t row = 0;
+
+        for( Long64_t block = 0; block < n_blocks; ++block ){
+
+            Long64_t n_rows = particles[c] ? block_particles[block] : min( kEventBlockSize, n_entries - row );
+
+            double block_min = numeric_limits< double >::infinity();
+            double block_max = -numeric_limits< double >::infinity();
+
+            for( Long64_t i = row; i < row + n_rows; ++i ){
+                if( sorted[i] < block_min ) block_min = sorted[i];
+                if( sorted[i] > block_max ) block_max = sorted[i];
+            }
+
+            column.offsets.push_back( file.tellp() );
+            column.block_min.push_back( block_min );
+            column.block_max.push_back( block_max );
+
+            EncodeEventBlock( column, n_rows ? &sorted[row] : 0, n_rows, bytes );
+            file.write( bytes.data(), bytes.size() );
+
+            row += n_rows;
+        }
+    }
+
+    zone_maps = file.tellp();
+
+    for( int c = 0; c < n_columns; ++c ){
+
+        Int_t particle_column = columns[c].particles;
+        WriteStoreValue( file, columns[c].encoding );
+        WriteStoreValue( file, particle_column );
+
+        for( Long64_t block = 0; block < n_blocks; ++block ){
+            WriteStoreValue( file, columns[c].offsets[block] );
+            WriteStoreValue( file, columns[c].block_min[block] );
+            WriteStoreValue( file, columns[c].block_max[block] );
+            WriteStoreValue( file, columns[c].block_error[block] );
+            WriteStoreValue( file, columns[c].block_bits[block] );
+        }
+    }
+
+    for( Long64_t block = 0; block < n_blocks; ++block ) WriteStoreValue( file, block_particles[block] );
+
+    file.seekp( zone_maps_at );
+    WriteStoreValue( file, zone_maps );
+    file.close();
+
+    if( !file ){
+        cerr << " Could not write " << store_path << endl;
+        exit(1);
+    }
+
+    return n_entries;
+}
+
+// -------------------------------------------------------------------------
+// Open a store and read its zone maps, or return 0 if it is not current
+// -------------------------------------------------------------------------
+static EventStore *OpenEventStore( const string &store_path,
+                                   const string &source ){
+
+    ifstream *file = new ifstream( store_path.c_str(), ios::binary );
+
+    if( !*file || ReadStoreString( *file ) != kEventStoreVersion || ReadStoreString( *file ) != source ){
+        cout << " The event store " << store_path << " is not a current store and is not used " << endl;
+        delete file;
+        return 0;
+    }
+
+    EventStore *store = new EventStore;
+    store->path           = store_path;
+    store->cluster_column = ReadStoreString( *file );
+    store->file           = file;
+
+    Int_t n_columns = 0;
+    ReadStoreValue( *file, store->n_entries );
+    ReadStoreValue( *file, n_columns );
+
+    store->n_blocks = ( store->n_entries + kEventBlockSize - 1 ) / kEventBlockSize;
+    store->columns.resize( n_columns );
+
+    for( int c = 0; c < n_columns; ++c ) store->columns[c].name = ReadStoreString( *file );
+
+    Long64_t zone_maps = 0;
+    ReadStoreValue( *file, zone_maps );
+    file->seekg( zone_maps );
+
+    for( int c = 0; c < n_columns; ++c ){
+
+        EventColumn &column = store->columns[c];
+
+        Int_t particle_column = 0;
+        ReadStoreValue( *file, column.encoding );
+        ReadStoreValue( *file, particle_column );
+        column.particles = particle_column;
+
+        column.offsets.resize( store->n_blocks );
+        column.block_min.resize( store->n_blocks );
+        column.block_max.resize( store->n_blocks );
+        column.block_error.resize( store->n_blocks );
+        column.block_bits.resize( store->n_blocks );
+
+        for( Long64_t block = 0; block < store->n_blocks; ++block ){
+            ReadStoreValue( *file, column.offsets[block] );
+            ReadStoreValue( *file, column.block_min[block] );
+            ReadStoreValue( *file, column.block_max[block] );
+            ReadStoreValue( *file, column.block_error[block] );
+            ReadStoreValue( *file, column.block_bits[block] );
+        }
+    }
+
+    store->block_particles.resize( store->n_blocks );
+    for( Long64_t block = 0; block < store->n_blocks; ++block ) ReadStoreValue( *file, store->block_particles[block] );
+
+    if( !*file ){
+        cout << " The event store " << store_path << " could not be read and is not used " << endl;
+        delete file;
+        delete store;
+        return 0;
+    }
+
+    return store;
+}
+
+// -------------------------------------------------------------------------
+//                          find a store
+// -------------------------------------------------------------------------
+EventStore *GstEventStore( TTree *event_tree ){
+
+    TFile *gst_file = event_tree->GetCurrentFile();
+    if( !gst_file ) return 0;
+
+    string store_path = EventStorePath( gst_file->GetName() );
+
+    map< string, EventStore* >::iterator it = event_stores.find( store_path );
+
+    if( it == event_stores.end() ){
+
+        EventStore *store = 0;
+        if( !gSystem->AccessPathName( store_path.c_str() ) ){
+            store = OpenEventStore( store_path, GstSourceStamp( event_tree ) );
+        }
+
+        it = event_stores.insert( make_pair( store_path, store ) ).first;
+    }
+
+    return it->second;
+}
+
+// -------------------------------------------------------------------------
+//                          column of the store
+// -------------------------------------------------------------------------
+int EventStoreColumn( const EventStore &store,
+                      const string &name ){
+
+    for( unsigned int c = 0; c < store.columns.size(); ++c ){
+        if( store.columns[c].name == name ) return c;
+    }
+
+    return -1;
+}
+
+// -------------------------------------------------------------------------
+//                          load columns
+// -------------------------------------------------------------------------
+Long64_t LoadEventColumns( EventStore &store,
+                           const vector< string > &names ){
+
+    Long64_t n_bytes = 0;
+
+    for( unsigned int i = 0; i < names.size(); ++i ){
+
+        int c = EventStoreColumn( store, names[i] );
+
+        if( c < 0 ){
+            cerr << " The event store " << store.path << " has no " << names[i] << " column " << endl;
+            exit(1);
+        }
+
+        EventColumn &column = store.columns[c];
+
+        if( column.data.empty() && store.n_blocks > 0 ){
+
+            Long64_t last = store.n_blocks - 1;
+            Long64_t size = column.offsets[last] - column.offsets[0]
+                          + EventBlockBytes( column, last, EventColumnRows( store, c, last ) );
+
+            if( size > 0 ){
+                column.data.resize( size );
+                store.file->seekg( column.offsets[0] );
+                store.file->read( &column.data[0], size );
+            }
+
+            if( !*store.file ){
+                cerr << " Could not read " << column.name << " from " << store.path << endl;
+                exit(1);
+            }
+        }
+
+        n_bytes += column.data.size();
+    }
+
+    return n_bytes;
+}
+
+// -------------------------------------------------------------------------
+//                          read a block
+// -------------------------------------------------------------------------
+void ReadEventBlock( EventStore &store,
+                     int column,
+                     Long64_t block,
+                     vector< double > &values ){
+
+    const EventColumn &c = store.columns[column];
+
+    Long64_t n_rows  = EventColumnRows( store, column, block );
+    Long64_t n_bytes = EventBlockBytes( c, block, n_rows );
+
+    values.resize( n_rows );
+    if( n_rows == 0 ) return;
+
+    // From memory once loaded, otherwise from the file
+    const char* data = 0;
+
+    if( !c.data.empty() ){
+        data = &c.data[ c.offsets[block] - c.offsets[0] ];
+    }
+    else if( n_bytes > 0 ){
+        store.buffer.resize( n_bytes );
+        store.file->seekg( c.offsets[block] );
+        store.file->read( &store.buffer[0], n_bytes );
+
+        if( !*store.file ){
+            cerr << " Could not read block " << block << " of " << c.name << " from " << store.path << endl;
+            exit(1);
+        }
+        data = &store.buffer[0];
+    }
+
+    DecodeEventBlock( c, block, data, n_rows, &values[0] );
+}
+
+// -------------------------------------------------------------------------
+//                          particles of a block
+// -------------------------------------------------------------------------
+void ReadParticleOffsets( EventStore &store,
+                          Long64_t block,
+                          vector< Long64_t > &offsets ){
+
+    int count_column = EventStoreColumn( store, "nf" );
+
+    if( count_column < 0 || store.block_particles.empty() ){
+        cerr << " The event store " << store.path << " has no particle columns " << endl;
+        exit(1);
+    }
+
+    vector< double > counts;
+    ReadEventBlock( store, count_column, block, counts );
+
+    offsets.resize( counts.size() + 1 );
+    offsets[0] = 0;
+    for( unsigned int i = 0; i < counts.size(); ++i ) offsets[ i + 1 ] = offsets[i] + Long64_t( counts[i] );
+
+    if( offsets.back() != store.block_particles[block] ){
+        cerr << " The particles of block " << block << " of " << store.path << " do not add up to nf " << endl;
+        exit(1);
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          particle kernels
+// -------------------------------------------------------------------------
+void CutParticles( const EventCut &cut,
+                   const vector< double > &values,
+                   double error,
+                   vector< unsigned char > &keep ){
+
+    Long64_t       n    = values.size();
+    const double  *v    = values.data();
+    unsigned char *k    = keep.data();
+    double         low  = cut.value - error;
+    double         high = cut.value + error;
+
+    // One comparison a particle, with the operator chosen outside the loop
+    if(      cut.op == "<" )  for( Long64_t i = 0; i < n; ++i ) k[i] &= v[i] <  high;
+    else if( cut.op == "<=" ) for( Long64_t i = 0; i < n; ++i ) k[i] &= v[i] <= high;
+    else if( cut.op == ">" )  for( Long64_t i = 0; i < n; ++i ) k[i] &= v[i] >  low;
+    else if( cut.op == ">=" ) for( Long64_t i = 0; i < n; ++i ) k[i] &= v[i] >= low;
+    else                      for( Long64_t i = 0; i < n; ++i ) k[i] &= ( v[i] >= low ) & ( v[i] <= high );
+}
+
+void CountParticles( const vector< Long64_t > &offsets,
+                     const vector< unsigned char > &keep,
+                     vector< double > &counts ){
+
+    counts.resize( offsets.size() - 1 );
+
+    for( unsigned int e = 0; e + 1 < offsets.size(); ++e ){
+        int n = 0;
+        for( Long64_t i = offsets[e]; i < offsets[ e + 1 ]; ++i ) n += keep[i];
+        counts[e] = n;
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          zone map check
+// -------------------------------------------------------------------------
+bool EventBlockMayPass( const EventStore &store,
+                        Long64_t block,
+                        const vector< EventCut > &cuts ){
+
+    for( unsigned int i = 0; i < cuts.size(); ++i ){
+
+        const EventCut &cut       = cuts[i];
+        double          block_min = store.columns[cut.column].block_min[block];
+        double          block_max = store.columns[cut.column].block_max[block];
+
+        // The smallest value passes a < cut if any does, the largest a > cut
+        if( block_min > block_max ) return false;
+        if( cut.op == "<"  && !( block_min <  cut.value ) ) return false;
+        if( cut.op == "<=" && !( block_min <= cut.value ) ) return false;
+        if( cut.op == ">"  && !( block_max >  cut.value ) ) return false;
+        if( cut.op == ">=" && !( block_max >= cut.value ) ) return false;
+        if( cut.op == "==" && !( block_min <= cut.value && cut.value <= block_max ) ) return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------
+// Strip the spaces and any parentheses around the whole of an expression
+// -------------------------------------------------------------------------
+static string BareStoreTerm( const string &term ){
+
+    string bare;
+    for( unsigned int i = 0; i < term.size(); ++i ){
+        if( term[i] != ' ' ) bare += term[i];
+    }
+
+    while( bare.size() > 1 && bare[0] == '(' && bare[ bare.size() - 1 ] == ')' ){
+
+        // Only if the first parenthesis closes at the end, not for "(a)<(b)"
+        int depth = 0;
+        unsigned int i = 0;
+        for( ; i < bare.size(); ++i ){
+            if( bare[i] == '(' ) ++depth;
+            if( bare[i] == ')' && --depth == 0 ) break;
+        }
+        if( i != bare.size() - 1 ) break;
+
+        bare = bare.substr( 1, bare.size() - 2 );
+    }
+
+    return bare;
+}
+
+// -------------------------------------------------------------------------
+// A term "column op number" or "number op column" as a cut, or false
+// -------------------------------------------------------------------------
+static bool StoreTermCut( const EventStore &store,
+                          const string &term,
+                          EventCut &cut ){
+
+    size_t at = term.find_first_of( "<>=!" );
+    if( at == string::npos || at == 0 ) return false;
+
+    string op = term.substr( at, 1 );
+    if( at + 1 < term.size() && term[ at + 1 ] == '=' ) op += '=';
+    if( op != "<" && op != "<=" && op != ">" && op != ">=" && op != "==" ) return false;
+
+    string left  = term.substr( 0, at );
+    string right = term.substr( at + op.size() );
+
+    // The number must be the whole of its side, "3" but not "3+x" or "3<x"
+    char  *end    = 0;
+    double value  = strtod( right.c_str(), &end );
+    bool   flip   = false;
+
+    if( right.empty() || *end ){
+        value = strtod( left.c_str(), &end );
+        if( left.empty() || *end ) return false;
+        left.swap( right );
+        flip = true;
+    }
+
+    int column = EventStoreColumn( store, left );
+    if( column < 0 ) return false;
+
+    // "3 > Ev" is "Ev < 3"
+    if( flip ){
+        if(      op == "<" )  op = ">";
+        else if( op == "<=" ) op = ">=";
+        else if( op == ">" )  op = "<";
+        else if( op == ">=" ) op = "<=";
+    }
+
+    cut.column = column;
+    cut.op     = op;
+    cut.value  = value;
+
+    return true;
+}
+
+// -------------------------------------------------------------------------
+//                          cuts of a selection
+// -------------------------------------------------------------------------
+void EventSelectionCuts( const EventStore &store,
+                         const string &selection,
+                         vector< EventCut > &cuts ){
+
+    string bare = BareStoreTerm( selection );
+
+    // The terms joined by && outside any parentheses or brackets, unless
+    // the selection is not a conjunction
+    vector< string > terms;
+    int    depth = 0;
+    size_t first = 0;
+
+    for( size_t i = 0; i < bare.size(); ++i ){
+
+        char c = bare[i];
+        if( c == '(' || c == '[' ) ++depth;
+        if( c == ')' || c == ']' ) --depth;
+        if( depth != 0 ) continue;
+
+        if( c == '?' || ( c == '|' && i + 1 < bare.size() && bare[ i + 1 ] == '|' ) ) return;
+
+        if( c == '&' && i + 1 < bare.size() && bare[ i + 1 ] == '&' ){
+            terms.push_back( bare.substr( first, i - first ) );
+            first = i + 2;
+            ++i;
+        }
+    }
+    terms.push_back( bare.substr( first ) );
+
+    for( unsigned int i = 0; i < terms.size(); ++i ){
+
+        EventCut cut;
+        if( StoreTermCut( store, BareStoreTerm( terms[i] ), cut ) ) cuts.push_back( cut );
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          entries of the fills
+// -------------------------------------------------------------------------
+TEntryList *GstStoreEntries( TTree *event_tree,
+                             const vector< unsigned int > &topology_masks,
+                             const vector< string > &selections ){
+
+    if( topology_masks.empty() ) return 0;
+
+    EventStore *store = GstEventStore( event_tree );
+    if( !store ) return 0;
+
+    int n_fills = topology_masks.size();
+
+    vector< vector< EventCut > > cuts( n_fills );
+    for( int f = 0; f < n_fills; ++f ){
+        EventSelectionCuts( *store, selections[f], cuts[f] );
+        if( cuts[f].empty() && !topology_masks[f] ) return 0;
+    }
+
+    int entry_column    = EventStoreColumn( *store, "gst_entry" );
+    int topology_column = EventStoreColumn( *store, "topology" );
+
+    // The topologies are read for every block of every scan, once
+    LoadEventColumns( *store, vector< string >( 1, "topology" ) );
+
+    vector< bool > particle_cuts( n_fills, false );
+    for( int f = 0; f < n_fills; ++f ){
+        for( unsigned int j = 0; j < cuts[f].size(); ++j ){
+            if( store->columns[ cuts[f][j].column ].particles ) particle_cuts[f] = true;
+        }
+    }
+
+    // The values of each column read for the current block, and for the
+    // fills with particle cuts the number of particles of each event which
+    // pass them all
+    vector< vector< double > > values( store->columns.size() );
+    vector< bool >             read( store->columns.size() );
+    vector< int >              open_fills;
+    vector< Long64_t >         selected;
+    vector< Long64_t >         particle_offsets;
+    vector< unsigned char >    keep;
+    vector< vector< double > > passing( n_fills );
+
+    for( Long64_t block = 0; block < store->n_blocks; ++block ){
+
+        open_fills.clear();
+        for( int f = 0; f < n_fills; ++f ){
+            if( EventBlockMayPass( *store, block, cuts[f] ) ) open_fills.push_back( f );
+        }
+
+        if( open_fills.empty() ) continue;
+
+        read.assign( read.size(), false );
+        read[ entry_column ]    = true;
+        read[ topology_column ] = true;
+        for( unsigned int i = 0; i < open_fills.size(); ++i ){
+            for( unsigned int j = 0; j < cuts[ open_fills[i] ].size(); ++j ){
+                read[ cuts[ open_fills[i] ][j].column ] = true;
+            }
+        }
+
+        for( unsigned int c = 0; c < read.size(); ++c ){
+            if( read[c] ) ReadEventBlock( *store, c, block, values[c] );
+        }
+
+        particle_offsets.clear();
+
+        for( unsigned int i = 0; i < open_fills.size(); ++i ){
+
+            int f = open_fills[i];
+            if( !particle_cuts[f] ) continue;
+
+            if( particle_offsets.empty() ) ReadParticleOffsets( *store, block, particle_offsets );
+
+            keep.assign( store->block_particles[block], 1 );
+            for( unsigned int j = 0; j < cuts[f].size(); ++j ){
+                const EventCut &cut = cuts[f][j];
+                if( store->columns[ cut.column ].particles ){
+                    CutParticles( cut, values[ cut.column ], store->columns[ cut.column ].block_error[block], keep );
+                }
+            }
+            CountParticles( particle_offsets, keep, passing[f] );
+        }
+
+        Long64_t n_rows = EventBlockEntries( *store, block );
+
+        for( Long64_t row = 0; row < n_rows; ++row ){
+
+            unsigned int mask = (unsigned int) values[ topology_column ][row];
+
+            for( unsigned int i = 0; i < open_fills.size(); ++i ){
+
+                int f = open_fills[i];
+                if( ( mask & topology_masks[f] ) != topology_masks[f] ) continue;
+                if( particle_cuts[f] && passing[f][row] == 0 ) continue;
+
+                // A rounded value may pass if the value it came from may
+                bool pass = true;
+                for( unsigned int j = 0; pass && j < cuts[f].size(); ++j ){
+                    const EventCut &cut = cuts[f][j];
+                    if( store->columns[ cut.column ].particles ) continue;
+                    pass = PassEventCut( cut, values[ cut.column ][row], store->columns[ cut.column ].block_error[block] );
+                }
+
+                if( pass ){
+                    selected.push_back( Long64_t( values[ entry_column ][row] ) );
+                    break;
+                }
+            }
+        }
+    }
+
+    // The gst tree is read in the order of its entries
+    sort( selected.begin(), selected.end() );
+
+    TEntryList *entries = new TEntryList( "gst_store_entries", "entries selected by the event store" );
+    entries->SetTree( event_tree );
+    entries->SetDirectory( 0 );
+
+    for( unsigned int i = 0; i < selected.size(); ++i ) entries->Enter( selected[i] );
+
+    return entries;
+}
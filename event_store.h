@@ -0,0 +1,284 @@
+/*
+ * Columnar store of the scalar gst branches with zone maps
+ *
+ * The kinematic slice studies restrict Ev, Q2 or pl to a window, which
+ * only a small fraction of each sample falls in, but a gst tree has to be
+ * read entry by entry to find them. The store is a sidecar file holding
+ * each numeric scalar branch as a column of its own, cut into blocks of
+ * kEventBlockSize events, with the smallest and largest value of every
+ * column in every block: its zone map
+ *
+ * The events are written in the order of one column, Ev by default, so
+ * that its blocks cover narrow ranges and those of the columns which
+ * follow it, Q2 and pl for example, are narrower too. A range cut then
+ * rules out most of the blocks from the zone maps alone, and only the
+ * columns of the cuts are read for the others. The gst_entry column holds
+ * the entry of each event in the gst tree and the topology column its
+ * ClassifyTopology mask
+ *
+ * Each column is written in the smallest of the encodings of EventEncoding
+ * which holds it exactly: the multiplicities are bit-packed and the flags
+ * are bitmaps. The kinematic columns can also be rounded to float or half
+ * precision, with the largest error this makes in each block recorded so
+ * that cuts on them still find every event. The blocks are decoded by
+ * plain loops over fixed bit widths which the compiler vectorises, and
+ * LoadEventColumns keeps the encoded columns of a scan in memory. The
+ * scans of GstStoreEntries, the event kinematics and the threshold scans
+ * read the topology column for every block, so they load it once for
+ * the process
+ *
+ * The final state particle arrays, pdgf, Ef, pf, cthf and the momenta, and
+ * the kinetic energy KEf of each particle, are particle columns: the values
+ * of all of the particles of a block one after the other, in the order of
+ * the events, with the particles of each event found from the offsets of
+ * ReadParticleOffsets. A particle cut, pdgf == 211, is then one pass over
+ * a contiguous array and CountParticles reduces it to a count for each
+ * event
+ *
+ * FillFlat takes the range cuts out of the selections of its fills,
+ * "Ev < 3" or "Q2 >= 0.2 && Q2 < 0.4" for example, and only reads the
+ * entries of the gst tree which the store finds some fill may select
+ *
+ * To write the stores of the five models:
+ *      root -l -b -q load_modules.cpp make_event_stores.cpp+
+ *
+*/
+
+#ifndef EVENT_STORE_H
+#define EVENT_STORE_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include "TTree.h"
+#include "TEntryList.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The version the stores are written with, a store of another version is
+// not used, and the number of events in each block
+// -------------------------------------------------------------------------
+const char* const kEventStoreVersion = "gst event store v3";
+const Long64_t    kEventBlockSize    = 4096;
+
+// -------------------------------------------------------------------------
+// How the values of a column are written
+//      kStoreDouble : as they are
+//      kStoreFloat  : rounded to float
+//      kStoreHalf   : rounded to IEEE half precision, only for columns
+//                     within its range of +-65504
+//      kStorePacked : integer values, as their difference from the block
+//                     minimum in 0, 1, 2, 4, 8, 16 or 32 bits
+//      kStoreBitmap : values of only 0 and 1, in one bit each
+// -------------------------------------------------------------------------
+enum EventEncoding {
+    kStoreDouble,
+    kStoreFloat,
+    kStoreHalf,
+    kStorePacked,
+    kStoreBitmap
+};
+
+// -------------------------------------------------------------------------
+// A column of the store
+//      name        : the gst branch, gst_entry, topology or KEf
+//      encoding    : the EventEncoding of its values
+//      particles   : whether it has a value for each particle rather than
+//                    each event
+//      offsets     : the position of the values of each block in the file
+//      block_min   : the smallest value in each block, NaN are left out so
+//                    a block of only NaN has block_min > block_max
+//      block_max   : the largest value in each block
+//      block_error : the largest difference between a value of the block
+//                    and what is read back, 0 unless rounded
+//      block_bits  : the bits of each packed value in the block
+//      data        : the encoded blocks, once loaded by LoadEventColumns
+// -------------------------------------------------------------------------
+struct EventColumn {
+    string             name;
+    Int_t              encoding;
+    bool               particles;
+    vector< Long64_t > offsets;
+    vector< double >   block_min;
+    vector< double >   block_max;
+    vector< double >   block_error;
+    vector< Int_t >    block_bits;
+    vector< char >     data;
+};
+
+// -------------------------------------------------------------------------
+// An open store
+//      path           : the file it is read from, kept open in file
+//      cluster_column : the column the events are in the order of
+//      n_entries      : the number of events, as in the gst tree
+//      n_blocks       : the number of blocks, the last may be short
+//      block_particles: the number of particles in each block
+//      buffer         : the encoded block being read from the file
+// -------------------------------------------------------------------------
+struct EventStore {
+    string                path;
+    string                cluster_column;
+    Long64_t              n_entries;
+    Long64_t              n_blocks;
+    vector< Long64_t >    block_particles;
+    vector< EventColumn > columns;
+    ifstream             *file;
+    vector< char >        buffer;
+};
+
+// -------------------------------------------------------------------------
+// A range cut on a column of the store: value op cut_value, with op one
+// of <, <=, >, >= or ==. NaN values fail every cut, as in TTreeFormula
+// On a particle column it is a cut on each particle
+// -------------------------------------------------------------------------
+struct EventCut {
+    int    column;
+    string op;
+    double value;
+};
+
+// -------------------------------------------------------------------------
+// The file the store of a gst file is written to:
+//      path.event_store next to the gst file, or below $SBND_STORE_DIR if
+//      it is set, with the / of the gst path replaced by _
+// -------------------------------------------------------------------------
+string EventStorePath( const string &gst_path );
+
+// -------------------------------------------------------------------------
+// Write the store of the gst tree in gst_path, with the events in the
+// order of cluster_column. The branches are read one at a time, so only a
+// single column of the sample is held in memory
+// The columns which are not integers are written as doubles for
+// float_bits 64, as floats for 32 and in half precision for 16 where they
+// fit. Returns the number of entries written
+// -------------------------------------------------------------------------
+Long64_t WriteEventStore( const string &gst_path,
+                          const string &cluster_column = "Ev",
+                          int float_bits = 64 );
+
+// -------------------------------------------------------------------------
+// The store of a gst tree, or 0 if it has not been written or was written
+// from another version of the gst file. The zone maps are read when the
+// store is opened, once in each process, the values block by block
+// -------------------------------------------------------------------------
+EventStore *GstEventStore( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// The index of a column of the store, or -1 if it does not have it
+// -------------------------------------------------------------------------
+int EventStoreColumn( const EventStore &store,
+                      const string &name );
+
+// -------------------------------------------------------------------------
+// The number of events in a block
+// -------------------------------------------------------------------------
+inline Long64_t EventBlockEntries( const EventStore &store,
+                                   Long64_t block ){
+
+    Long64_t first = block * kEventBlockSize;
+    return first + kEventBlockSize < store.n_entries ? kEventBlockSize : store.n_entries - first;
+}
+
+// -------------------------------------------------------------------------
+// The number of values of a column in a block
+// -------------------------------------------------------------------------
+inline Long64_t EventColumnRows( const EventStore &store,
+                                 int column,
+                                 Long64_t block ){
+
+    return store.columns[column].particles ? store.block_particles[block] : EventBlockEntries( store, block );
+}
+
+// -------------------------------------------------------------------------
+// Read the encoded blocks of the named columns into memory, so that they
+// are decoded from there rather than read from the file. Returns the
+// number of bytes they hold
+// -------------------------------------------------------------------------
+Long64_t LoadEventColumns( EventStore &store,
+                           const vector< string > &names );
+
+// -------------------------------------------------------------------------
+// Read and decode the values of a column in a block
+// -------------------------------------------------------------------------
+void ReadEventBlock( EventStore &store,
+                     int column,
+                     Long64_t block,
+                     vector< double > &values );
+
+// -------------------------------------------------------------------------
+// The particles of the events of a block: those of event i of the block
+// are rows offsets[i] to offsets[i + 1] - 1 of the particle columns
+// -------------------------------------------------------------------------
+void ReadParticleOffsets( EventStore &store,
+                          Long64_t block,
+                          vector< Long64_t > &offsets );
+
+// -------------------------------------------------------------------------
+// Whether a value read back with at most the given error may pass a cut,
+// for error 0 whether it passes
+// -------------------------------------------------------------------------
+inline bool PassEventCut( const EventCut &cut,
+                          double value,
+                          double error = 0 ){
+
+    if( cut.op == "<" )  return value - error <  cut.value;
+    if( cut.op == "<=" ) return value - error <= cut.value;
+    if( cut.op == ">" )  return value + error >  cut.value;
+    if( cut.op == ">=" ) return value + error >= cut.value;
+    return value - error <= cut.value && cut.value <= value + error;
+}
+
+// -------------------------------------------------------------------------
+// Keep only the particles which may pass a cut, as PassEventCut, given the
+// values of its column and the error of the block. keep holds a 0 or 1
+// for each particle and is and-ed with the cut
+// -------------------------------------------------------------------------
+void CutParticles( const EventCut &cut,
+                   const vector< double > &values,
+                   double error,
+                   vector< unsigned char > &keep );
+
+// -------------------------------------------------------------------------
+// The number of kept particles of each event of a block, given its offsets
+// -------------------------------------------------------------------------
+void CountParticles( const vector< Long64_t > &offsets,
+                     const vector< unsigned char > &keep,
+                     vector< double > &counts );
+
+// -------------------------------------------------------------------------
+// Whether any event of a block may pass every one of the cuts, from the
+// zone maps alone
+// -------------------------------------------------------------------------
+bool EventBlockMayPass( const EventStore &store,
+                        Long64_t block,
+                        const vector< EventCut > &cuts );
+
+// -------------------------------------------------------------------------
+// Add the range cuts on store columns in a Draw selection to cuts. Only
+// the terms of a selection which is a conjunction are taken, each of the
+// form "Ev < 3" or "0.2 <= Q2", anything else is left to the selection
+// itself. Terms on the particle columns, "pdgf == 211", are cuts on the
+// particles as in TTreeFormula. Every event the selection passes passes
+// the other cuts and has a particle which passes all of the particle cuts
+// -------------------------------------------------------------------------
+void EventSelectionCuts( const EventStore &store,
+                         const string &selection,
+                         vector< EventCut > &cuts );
+
+// -------------------------------------------------------------------------
+// The entries of a gst tree which some fill may select, for fills given by
+// their topology masks, as in FlatFill, and Draw selections. The blocks
+// which the zone maps rule out for every fill are skipped, and in the
+// others the events are checked against the cuts and topologies, and
+// against the particle cuts for a particle which passes them all
+// Returns 0 if there is no store for the tree or a fill has neither cuts
+// nor a topology, otherwise a list which the caller deletes
+// -------------------------------------------------------------------------
+TEntryList *GstStoreEntries( TTree *event_tree,
+                             const vector< unsigned int > &topology_masks,
+                             const vector< string > &selections );
+
+// -------------------------------------------------------------------------
+
+#endif
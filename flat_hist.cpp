@@ -0,0 +1,728 @@
+/*
+ * Flat fixed-binning histograms and the single pass fill engine
+ *
+ * See flat_hist.h for the description of each function
+ *
+*/
+
+#include <cstdlib>
+#include "TTreeFormula.h"
+#include "TTreeFormulaManager.h"
+#include "TDirectory.h"
+#include "flat_hist.h"
+#include "gst_reader.h"
+#include "topologies.h"
+#include "jit_cuts.h"
+#include "rdf_fill.h"
+#include "skim_tree.h"
+#include "topology_index.h"
+#include "event_store.h"
+#include "universe_weights.h"
+#include "oscillation_grid.h"
+#include "bootstrap.h"
+#include "smearing.h"
+#include "event_kinematics.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The compiled formulas of a fill
+//      dims      : the variables, x first then y
+//      selection : 0 if there is no selection
+//      manager   : keeps the number of instances of the formulas in step,
+//                  as in TSelectorDraw
+// -------------------------------------------------------------------------
+struct FlatFormulas {
+    vector< TTreeFormula* > dims;
+    vector< bool >          dims_multiple;
+    TTreeFormula           *selection;
+    bool                    selection_multiple;
+    TTreeFormulaManager    *manager;
+};
+
+// -------------------------------------------------------------------------
+// Whether the fills use the compiled expressions of jit_cuts.h
+// -------------------------------------------------------------------------
+static bool flat_jit = getenv( "SBND_JIT_CUTS" ) && string( getenv( "SBND_JIT_CUTS" ) ) == "1";
+
+// Whether the fills run through the RDataFrame backend of rdf_fill.h
+static bool flat_rdf = getenv( "SBND_RDATAFRAME" ) && string( getenv( "SBND_RDATAFRAME" ) ) == "1";
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          compile a formula
+// -------------------------------------------------------------------------
+static TTreeFormula *FlatFormula( TTree *event_tree,
+                                  const string &expression ){
+
+    TTreeFormula *formula = new TTreeFormula( "flat_fill", expression.c_str(), event_tree );
+
+    if( formula->GetNdim() == 0 ){
+        cerr << " Could not compile the fill expression : " << expression << endl;
+        exit(1);
+    }
+
+    return formula;
+}
+
+// -------------------------------------------------------------------------
+//                          compiled expressions
+// -------------------------------------------------------------------------
+void SetFlatJit( bool use_jit ){
+
+    flat_jit = use_jit;
+}
+
+bool FlatJit(){
+
+    return flat_jit;
+}
+
+// -------------------------------------------------------------------------
+//                          RDataFrame backend
+// -------------------------------------------------------------------------
+void SetFlatRDF( bool use_rdf ){
+
+    flat_rdf = use_rdf;
+}
+
+bool FlatRDF(){
+
+    return flat_rdf;
+}
+
+// -------------------------------------------------------------------------
+// Whether any of the fills is split by channel
+// -------------------------------------------------------------------------
+static bool FlatChannelsSplit( const vector< FlatFill > &fills ){
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].channels.empty() ) return true;
+    }
+
+    return false;
+}
+
+// -------------------------------------------------------------------------
+// The most universes any of the fills needs, 0 if none has universes
+// -------------------------------------------------------------------------
+static int FlatUniverseCount( const vector< FlatFill > &fills ){
+
+    int n_universes = 0;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].universes.cells.empty() && fills[i].universes.n_universes > n_universes ){
+            n_universes = fills[i].universes.n_universes;
+        }
+    }
+
+    return n_universes;
+}
+
+// -------------------------------------------------------------------------
+// The most bootstrap replicas any of the fills needs, 0 if none has them
+// -------------------------------------------------------------------------
+static int FlatReplicaCount( const vector< FlatFill > &fills ){
+
+    int n_replicas = 0;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].replicas.cells.empty() && fills[i].replicas.n_universes > n_replicas ){
+            n_replicas = fills[i].replicas.n_universes;
+        }
+    }
+
+    return n_replicas;
+}
+
+// -------------------------------------------------------------------------
+// The smallest skim of skim_tree.h which holds every event the fills
+// select and the branches they need, or 0 if there is none
+// -------------------------------------------------------------------------
+static TTree *FlatSkim( TTree *event_tree,
+                        const vector< FlatFill > &fills ){
+
+    // The universe weights are a friend of the full tree only, and the
+    // bootstrap weights are drawn by its entry numbers
+    if( fills.empty() || FlatUniverseCount( fills ) > 0 || FlatReplicaCount( fills ) > 0 ) return 0;
+
+    unsigned int common_mask = ~0u;
+    vector< string > planned_fills;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        common_mask &= fills[i].topology_mask;
+        if( fills[i].kinematics.empty() ) planned_fills.push_back( fills[i].variable );
+        planned_fills.push_back( fills[i].selection );
+    }
+
+    if( !common_mask ) return 0;
+
+    planned_fills.push_back( kTopologyFill );
+    if( FlatChannelsSplit( fills ) ) planned_fills.push_back( kChannelFill );
+    if( FlatOscillationCount( fills ) > 0 ) planned_fills.push_back( "Ev" );
+    if( FlatKinematicsCount( fills ) > 0 ) planned_fills.push_back( kKinematicsFill );
+
+    s_branches branches;
+    GstBranchesFor( event_tree, planned_fills, branches );
+
+    TTree *skim = 0;
+    for( int t = 0; t < kNTopologies; ++t ){
+
+        if( !( common_mask & TopologyBit( t ) ) ) continue;
+
+        TTree *candidate = GstSkimFor( event_tree, t, branches );
+        if( candidate && ( !skim || candidate->GetEntries() < skim->GetEntries() ) ) skim = candidate;
+    }
+
+    return skim;
+}
+
+// -------------------------------------------------------------------------
+//                          single pass fill
+// -------------------------------------------------------------------------
+Long64_t FillFlat( TTree *event_tree,
+                   vector< FlatFill > &fills ){
+
+    // Smeared events are only seen by the compiled expressions, which read
+    // each entry into an event the smearing can change. Every entry is
+    // read since the skims, store and index select by the true topology
+    if( GstSmearing() ) return FillFlatJit( event_tree, fills, 0 );
+
+    // Fills which all select a skimmed topology only read the skim, and
+    // otherwise only visit the entries the event store finds they may
+    // select or, without a store, those in the index of any of their
+    // topologies. The fills of a batch need not select the same topology
+    TEntryList *entries = 0;
+
+    TTree *skim = FlatSkim( event_tree, fills );
+    if( skim ){
+        event_tree = skim;
+    }
+    else{
+        vector< unsigned int > topology_masks;
+        vector< string >       selections;
+        for( unsigned int i = 0; i < fills.size(); ++i ){
+            topology_masks.push_back( fills[i].topology_mask );
+            selections.push_back( fills[i].selection );
+        }
+        entries = GstStoreEntries( event_tree, topology_masks, selections );
+        if( !entries ) entries = GstTopologyUnion( event_tree, topology_masks );
+    }
+
+    if( flat_rdf && FlatUniverseCount( fills ) == 0 && FlatReplicaCount( fills ) == 0 && FlatOscillationCount( fills ) == 0
+        && FlatKinematicsCount( fills ) == 0 ){
+        delete entries;
+        return FillFlatRDF( event_tree, fills );
+    }
+    if( flat_jit ){
+        Long64_t n_read = FillFlatJit( event_tree, fills, entries );
+        delete entries;
+        return n_read;
+    }
+
+    vector< FlatFormulas > formulas( fills.size() );
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        vector< string > dims;
+        GstFillDimensions( fills[i].variable, dims );
+
+        int n_dims = fills[i].hist.y.n_bins > 0 ? 2 : 1;
+        if( int( dims.size() ) != n_dims ){
+            cerr << " The fill " << fills[i].variable << " does not have " << n_dims << " dimension(s) " << endl;
+            exit(1);
+        }
+
+        FlatFormulas &f = formulas[i];
+        f.manager = new TTreeFormulaManager;
+
+        // "y:x" is written y first, the fill takes x first. The kinematic
+        // fills only have a selection
+        for( int j = n_dims - 1; j >= 0 && fills[i].kinematics.empty(); --j ){
+            TTreeFormula *dim = FlatFormula( event_tree, GstDerivedColumn( event_tree, dims[j] ) );
+            f.dims.push_back( dim );
+            f.dims_multiple.push_back( dim->GetMultiplicity() != 0 );
+            f.manager->Add( dim );
+        }
+
+        f.selection          = 0;
+        f.selection_multiple = false;
+        if( fills[i].selection.find_first_not_of(" ") != string::npos ){
+            f.selection          = FlatFormula( event_tree, fills[i].selection );
+            f.selection_multiple = f.selection->GetMultiplicity() != 0;
+            f.manager->Add( f.selection );
+        }
+
+        // nor, without one, any formula
+        if( f.dims.empty() && !f.selection ){
+            delete f.manager;
+            f.manager = 0;
+            continue;
+        }
+
+        f.manager->Sync();
+    }
+
+    // The topologies are only read if a fill needs them
+    bool classify = false;
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( fills[i].topology_mask ) classify = true;
+    }
+
+    // The derived variables hold the topology of each entry when attached
+    TopologyLeaves leaves;
+    TopologyEvent  event;
+    TLeaf         *derived_topology = 0;
+    if( classify ){
+        if( event_tree->GetFriend( kGstDerivedTree ) ) derived_topology = event_tree->GetLeaf( "topology" );
+        if( !derived_topology ) GetTopologyLeaves( event_tree, leaves );
+    }
+
+    // The flags of the channels, only if a fill is split by them
+    const int   n_flags = 5;
+    const char* flag_names[n_flags] = { "qel", "mec", "res", "dis", "coh" };
+    TLeaf      *flags[n_flags];
+
+    bool split = FlatChannelsSplit( fills );
+    if( split ){
+        for( int f = 0; f < n_flags; ++f ) flags[f] = TopologyLeaf( event_tree, flag_names[f] );
+    }
+
+    // The weights of each universe, only if a fill has universes
+    vector< double > universe_weights( FlatUniverseCount( fills ) );
+    TLeaf *universe_leaf = universe_weights.empty() ? 0 : GstUniverseLeaf( event_tree );
+
+    // and of each bootstrap replica, only if a fill has replicas
+    vector< double > replica_weights( FlatReplicaCount( fills ) );
+    unsigned int model_key = replica_weights.empty() ? 0 : RngModelKey( event_tree );
+
+    // and at each point of the oscillation grid, only if a fill is over it
+    vector< double > oscillation_weights( FlatOscillationCount( fills ) );
+    const OscillationGrid *grid = oscillation_weights.empty() ? 0 : FlatOscillations();
+    TLeaf *energy_leaf = grid ? TopologyLeaf( event_tree, "Ev" ) : 0;
+
+    // and the kinematics, from an event the kernel branches are read into
+    KinematicsPass     kinematics;
+    GstEvent           kinematics_event;
+    vector< TBranch* > kinematics_branches;
+    vector< double >   kinematics_weights;
+
+    bool by_kinematics = BeginKinematicsPass( fills, kinematics );
+    if( by_kinematics ){
+        BranchKinematicsEvent( event_tree, kinematics_event, kinematics_branches );
+        kinematics_weights.resize( kinematics.fills.size() );
+    }
+
+    Long64_t n_entries = entries ? entries->GetN() : event_tree->GetEntries();
+
+    for( Long64_t i_entry = 0; i_entry < n_entries; ++i_entry ){
+
+        Long64_t entry = entries ? entries->GetEntry( i_entry ) : i_entry;
+
+        Long64_t local_entry = event_tree->LoadTree( entry );
+        if( local_entry < 0 ) break;
+
+        bool universes_read     = false;
+        bool replicas_drawn     = false;
+        bool oscillations_found = false;
+
+        unsigned int mask = 0;
+        if( derived_topology ){
+            derived_topology->GetBranch()->GetEntry( local_entry, 1 );
+            mask = (unsigned int) derived_topology->GetValue();
+        }
+        else if( classify ){
+            ReadTopologyEvent( leaves, local_entry, event );
+            mask = ClassifyTopology( event );
+        }
+
+        int channel = kChannelOther;
+        if( split ){
+            for( int f = 0; f < n_flags; ++f ) flags[f]->GetBranch()->GetEntry( local_entry, 1 );
+            channel = ClassifyChannel( flags[0]->GetValue() != 0, flags[1]->GetValue() != 0, flags[2]->GetValue() != 0,
+                                       flags[3]->GetValue() != 0, flags[4]->GetValue() != 0 );
+        }
+
+        // The weight of the entry in each kinematic fill, as a Draw of an
+        // event variable sums the selection over its instances
+        if( by_kinematics ){
+
+            bool selected = false;
+
+            for( unsigned int j = 0; j < kinematics.fills.size(); ++j ){
+
+                const FlatFill &fill = fills[ kinematics.fills[j] ];
+                FlatFormulas   &f    = formulas[ kinematics.fills[j] ];
+
+                kinematics_weights[j] = 0;
+                if( ( mask & fill.topology_mask ) != fill.topology_mask ) continue;
+
+                if( !f.selection ){
+                    kinematics_weights[j] = 1;
+                }
+                else{
+                    int n_data = f.manager->GetNdata();
+                    for( int k = 0; k < n_data; ++k ){
+                        kinematics_weights[j] += f.selection->EvalInstance( f.selection_multiple ? k : 0 );
+                    }
+                }
+                if( kinematics_weights[j] != 0 ) selected = true;
+            }
+
+            // The kernel branches are only read for the entries it needs
+            if( selected ){
+                ReadKinematicsEvent( kinematics_branches, kinematics_event, entry, local_entry );
+                AddKinematicsEvent( kinematics, fills, kinematics_event, mask, channel, &kinematics_weights[0] );
+            }
+        }
+
+        for( unsigned int i = 0; i < fills.size(); ++i ){
+
+            if( ( mask & fills[i].topology_mask ) != fills[i].topology_mask ) continue;
+            if( !fills[i].kinematics.empty() ) continue;
+
+            FlatFormulas &f = formulas[i];
+            bool by_channel  = !fills[i].channels.empty();
+            bool by_universe = !fills[i].universes.cells.empty();
+            bool by_replica  = !fills[i].replicas.cells.empty();
+            bool by_point    = !fills[i].oscillated.cells.empty();
+
+            // Read once the entry is selected by a fill with universes
+            if( by_universe && !universes_read ){
+                ReadUniverseWeights( universe_leaf, local_entry, universe_weights );
+                universes_read = true;
+            }
+            if( by_replica && !replicas_drawn ){
+                BootstrapWeights( model_key, entry, replica_weights );
+                replicas_drawn = true;
+            }
+            if( by_point && !oscillations_found ){
+                energy_leaf->GetBranch()->GetEntry( local_entry, 1 );
+                OscillationWeights( *grid, energy_leaf->GetValue(), &oscillation_weights[0] );
+                oscillations_found = true;
+            }
+
+            int n_data = f.manager->GetNdata();
+
+            for( int k = 0; k < n_data; ++k ){
+
+                double weight = 1;
+                if( f.selection ){
+                    weight = f.selection->EvalInstance( f.selection_multiple ? k : 0 );
+                    if( weight == 0 ) continue;
+                }
+
+                double x = f.dims[0]->EvalInstance( f.dims_multiple[0] ? k : 0 );
+
+                int cell = 0;
+                if( f.dims.size() == 1 ){
+                    if( by_universe || by_replica || by_point ) cell = FlatCell( fills[i].hist, x );
+                    FillFlatHist( fills[i].hist, x, weight );
+                    if( by_channel ) FillFlatHist( fills[i].channels[channel], x, weight );
+                }
+                else{
+                    double y = f.dims[1]->EvalInstance( f.dims_multiple[1] ? k : 0 );
+                    if( by_universe || by_replica || by_point ) cell = FlatCell( fills[i].hist, x, y );
+                    FillFlatHist( fills[i].hist, x, y, weight );
+                    if( by_channel ) FillFlatHist( fills[i].channels[channel], x, y, weight );
+                }
+
+                if( by_universe ) FillFlatUniverses( fills[i].universes, cell, weight, &universe_weights[0] );
+                if( by_replica )  FillFlatUniverses( fills[i].replicas, cell, weight, &replica_weights[0] );
+                if( by_point )    FillFlatUniverses( fills[i].oscillated, cell, weight, &oscillation_weights[0] );
+            }
+        }
+    }
+
+    if( by_kinematics ){
+        EndKinematicsPass( kinematics, fills );
+        for( unsigned int b = 0; b < kinematics_branches.size(); ++b ){
+            event_tree->ResetBranchAddress( kinematics_branches[b] );
+        }
+    }
+
+    for( unsigned int i = 0; i < formulas.size(); ++i ){
+        for( unsigned int j = 0; j < formulas[i].dims.size(); ++j ){
+            delete formulas[i].dims[j];
+        }
+        // The manager is deleted with the last of its formulas
+        delete formulas[i].selection;
+    }
+    delete entries;
+
+    return n_entries;
+}
+
+// -------------------------------------------------------------------------
+//                          TTree::Draw replacement
+// -------------------------------------------------------------------------
+static TH1 *FlatDrawTarget( const char* varexp,
+                            string &variable ){
+
+    string expression = varexp;
+    size_t target     = expression.find( ">>" );
+
+    if( target == string::npos ){
+        cerr << " FlatDraw needs a target histogram : " << expression << endl;
+        exit(1);
+    }
+
+    string name = expression.substr( target + 2 );
+    name.erase( 0, name.find_first_not_of(" ") );
+    name.erase( name.find_last_not_of(" ") + 1 );
+
+    TH1 *h = dynamic_cast< TH1* >( gDirectory->Get( name.c_str() ) );
+
+    if( !h ){
+        cerr << " FlatDraw could not find the histogram " << name << endl;
+        exit(1);
+    }
+
+    variable = expression.substr( 0, target );
+
+    return h;
+}
+
+static unsigned int FlatDrawTopology( int topology ){
+
+    if( topology < 0 || topology >= kNTopologies ){
+        cerr << " Unknown topology " << topology << endl;
+        exit(1);
+    }
+
+    return TopologyBit( topology );
+}
+
+static Long64_t FlatDrawFill( TTree *event_tree,
+                              const char* varexp,
+                              unsigned int topology_mask,
+                              const char* selection,
+                              const char* option ){
+
+    vector< FlatFill > fills( 1 );
+
+    TH1 *h = FlatDrawTarget( varexp, fills[0].variable );
+
+    fills[0].selection     = selection ? selection : "";
+    fills[0].topology_mask = topology_mask;
+    BookFlatHist( fills[0].hist, h );
+
+    FillFlat( event_tree, fills );
+    FlatToTH1( fills[0].hist, h );
+
+    string draw_option = option ? option : "";
+    if( !draw_option.empty() && draw_option != "goff" ) h->Draw( option );
+
+    return fills[0].hist.entries;
+}
+
+Long64_t FlatDraw( TTree *event_tree,
+                   const char* varexp,
+                   const char* selection,
+                   const char* option ){
+
+    return FlatDrawFill( event_tree, varexp, 0, selection, option );
+}
+
+Long64_t FlatDraw( TTree *event_tree,
+                   const char* varexp,
+                   int topology,
+                   const char* selection,
+                   const char* option ){
+
+    return FlatDrawFill( event_tree, varexp, FlatDrawTopology( topology ), selection, option );
+}
+
+// -------------------------------------------------------------------------
+//                          batches of fills
+// -------------------------------------------------------------------------
+static FlatFill &FlatBatchAdd( FlatBatch &batch,
+                               TTree *event_tree,
+                               const string &name,
+                               const FlatFill &fill,
+                               TH1 *h ){
+
+    unsigned int t = 0;
+    while( t < batch.trees.size() && batch.trees[t] != event_tree ) ++t;
+
+    if( t == batch.trees.size() ){
+        batch.trees.push_back( event_tree );
+        batch.fills.resize( t + 1 );
+        batch.targets.resize( t + 1 );
+        batch.names.resize( t + 1 );
+    }
+
+    batch.fills[t].push_back( fill );
+    batch.targets[t].push_back( h );
+    batch.names[t].push_back( name );
+
+    return batch.fills[t].back();
+}
+
+static FlatFill &FlatBookFill( FlatBatch &batch,
+                               TTree *event_tree,
+                               const char* varexp,
+                               unsigned int topology_mask,
+                               const char* selection ){
+
+    FlatFill fill;
+
+    TH1 *h = FlatDrawTarget( varexp, fill.variable );
+
+    fill.selection     = selection ? selection : "";
+    fill.topology_mask = topology_mask;
+    BookFlatHist( fill.hist, h );
+    BookFlatChannels( fill );
+
+    return FlatBatchAdd( batch, event_tree, h->GetName(), fill, h );
+}
+
+FlatFill &FlatBook( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* varexp,
+                    const char* selection ){
+
+    return FlatBookFill( batch, event_tree, varexp, 0, selection );
+}
+
+FlatFill &FlatBook( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* varexp,
+                    int topology,
+                    const char* selection ){
+
+    return FlatBookFill( batch, event_tree, varexp, FlatDrawTopology( topology ), selection );
+}
+
+FlatFill &FlatBookKinematics( FlatBatch &batch,
+                              TTree *event_tree,
+                              const char* name,
+                              int topology,
+                              int x,
+                              int y ){
+
+    TH1 *h = dynamic_cast< TH1* >( gDirectory->Get( name ) );
+
+    if( !h ){
+        cerr << " FlatBookKinematics could not find the histogram " << name << endl;
+        exit(1);
+    }
+
+    bool two_d = h->GetDimension() == 2;
+
+    if( x < 0 || x >= kNKinematics || y >= kNKinematics || two_d != ( y >= 0 ) ){
+        cerr << " Invalid kinematic fill of variables " << x << " and " << y << " for " << name << endl;
+        exit(1);
+    }
+
+    FlatFill fill;
+
+    fill.variable      = two_d ? string( KinematicName( y ) ) + ":" + KinematicName( x ) : KinematicName( x );
+    fill.topology_mask = FlatDrawTopology( topology );
+    fill.kinematics.push_back( x );
+    if( two_d ) fill.kinematics.push_back( y );
+    BookFlatHist( fill.hist, h );
+    BookFlatChannels( fill );
+
+    return FlatBatchAdd( batch, event_tree, name, fill, h );
+}
+
+FlatFill &FlatBook( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* name,
+                    const FlatFill &fill ){
+
+    FlatFill &booked = FlatBatchAdd( batch, event_tree, name, fill, 0 );
+    booked.channels.clear();
+
+    return booked;
+}
+
+Long64_t RunFlatBatch( FlatBatch &batch ){
+
+    Long64_t n_read = 0;
+
+    for( unsigned int t = 0; t < batch.trees.size(); ++t ){
+
+        n_read += FillFlat( batch.trees[t], batch.fills[t] );
+
+        for( unsigned int i = 0; i < batch.fills[t].size(); ++i ){
+            if( batch.targets[t][i] ) FlatToTH1( batch.fills[t][i].hist, batch.targets[t][i] );
+        }
+    }
+
+    return n_read;
+}
+
+const FlatFill &FlatBatchFill( const FlatBatch &batch,
+                               const char* name ){
+
+    for( unsigned int t = 0; t < batch.trees.size(); ++t ){
+        for( unsigned int i = 0; i < batch.names[t].size(); ++i ){
+            if( batch.names[t][i] == name ) return batch.fills[t][i];
+        }
+    }
+
+    cerr << " No fill was booked for the histogram " << name << endl;
+    exit(1);
+}
+
+void FlatBatchExpressions( const FlatBatch &batch,
+                           vector< string > &planned_fills ){
+
+    bool topologies   = false;
+    bool channels     = false;
+    bool oscillations = false;
+    bool kinematics   = false;
+
+    for( unsigned int t = 0; t < batch.trees.size(); ++t ){
+        for( unsigned int i = 0; i < batch.fills[t].size(); ++i ){
+
+            const FlatFill &fill = batch.fills[t][i];
+
+            // The variable of a kinematic fill only names it
+            if( fill.kinematics.empty() ) planned_fills.push_back( fill.variable );
+            if( !fill.selection.empty() ) planned_fills.push_back( fill.selection );
+
+            if( fill.topology_mask )             topologies   = true;
+            if( !fill.channels.empty() )         channels     = true;
+            if( !fill.oscillated.cells.empty() ) oscillations = true;
+            if( !fill.kinematics.empty() )       kinematics   = true;
+        }
+    }
+
+    if( topologies )   planned_fills.push_back( kTopologyFill );
+    if( channels )     planned_fills.push_back( kChannelFill );
+    if( oscillations ) planned_fills.push_back( "Ev" );
+    if( kinematics )   planned_fills.push_back( kKinematicsFill );
+}
+
+void WriteFlatBatchChannels( const FlatBatch &batch,
+                             TFile *file ){
+
+    for( unsigned int t = 0; t < batch.trees.size(); ++t ){
+        for( unsigned int i = 0; i < batch.fills[t].size(); ++i ){
+
+            const FlatFill &fill = batch.fills[t][i];
+
+            for( unsigned int c = 0; c < fill.channels.size(); ++c ){
+
+                string name = batch.names[t][i] + "_" + ChannelName( c );
+
+                // Written to the file whichever directory is current
+                TH1 *h = (TH1*) batch.targets[t][i]->Clone( name.c_str() );
+                h->SetDirectory( 0 );
+                FlatToTH1( fill.channels[c], h );
+                file->WriteTObject( h );
+                delete h;
+            }
+        }
+    }
+}
@@ -0,0 +1,559 @@
+/*
+ * Flat fixed-binning histograms for the hot fill path
+ *
+ * A FlatHist is a plain array of bin contents with uniform bins, laid out
+ * in the same global bin order as a TH1 or TH2, including the under and
+ * overflow. Filling one is a multiply and a bounds check, without the
+ * virtual calls, statistics and gDirectory bookkeeping of TH1::Fill, so all
+ * of the accumulation is done with them and they are only copied into the
+ * TH1D or TH2D which HistStacker and the canvases need at the end
+ *
+ * The fill engine evaluates any number of Draw style variable and
+ * selection pairs in a single pass over a gst tree. The macros book the
+ * fills of their histograms into a FlatBatch with FlatBook, as they would
+ * a Draw, and RunFlatBatch then fills all of those of a tree in one pass.
+ * FlatDraw is kept as a drop-in replacement for a single
+ * TTree::Draw( "var>>h", selection, option ), a pass of its own
+ *
+*/
+
+#ifndef FLAT_HIST_H
+#define FLAT_HIST_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include "TTree.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TH2.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// Within this distance of a bin edge, in units of the bin width, the bin
+// is found by the same division as TAxis::FindBin so that values on an
+// edge, the integer multiplicities for example, land in the same bin
+// -------------------------------------------------------------------------
+const double kFlatEdgeTolerance = 1e-9;
+
+// -------------------------------------------------------------------------
+// A uniform axis
+//      n_bins   : the number of bins, not counting the under and overflow
+//      min, max : the low edge of the first bin and high edge of the last
+//      scale    : n_bins / ( max - min ), the bin lookup is a multiply
+// -------------------------------------------------------------------------
+struct FlatAxis {
+    int    n_bins;
+    double min;
+    double max;
+    double scale;
+};
+
+// -------------------------------------------------------------------------
+// A histogram of 1 or 2 dimensions with uniform bins
+//      T       : the count or weight type, Long64_t for plain counts or
+//                double for weighted fills
+//      x, y    : the axes, y.n_bins is 0 for a 1D histogram
+//      entries : the number of fills
+//      cells   : the contents, ( x.n_bins + 2 ) * ( y.n_bins + 2 ) of them
+//                with cell = bin_x + ( x.n_bins + 2 ) * bin_y as in TH1::GetBin
+// -------------------------------------------------------------------------
+template< typename T >
+struct FlatHist {
+    FlatAxis    x;
+    FlatAxis    y;
+    Long64_t    entries;
+    vector< T > cells;
+};
+
+// -------------------------------------------------------------------------
+// Set up an axis
+// -------------------------------------------------------------------------
+inline void BookFlatAxis( FlatAxis &axis,
+                          int n_bins,
+                          double min,
+                          double max ){
+
+    axis.n_bins = n_bins;
+    axis.min    = min;
+    axis.max    = max;
+    axis.scale  = ( n_bins > 0 && max > min ) ? n_bins / ( max - min ) : 0;
+}
+
+// -------------------------------------------------------------------------
+// Book an empty histogram, n_y = 0 for 1D
+// -------------------------------------------------------------------------
+template< typename T >
+void BookFlatHist( FlatHist< T > &hist,
+                   int n_x, double x_min, double x_max,
+                   int n_y = 0, double y_min = 0, double y_max = 1 ){
+
+    if( n_x < 1 || !( x_max > x_min ) || n_y < 0 || ( n_y > 0 && !( y_max > y_min ) ) ){
+        cerr << " Invalid binning for a flat histogram " << endl;
+        exit(1);
+    }
+
+    BookFlatAxis( hist.x, n_x, x_min, x_max );
+    BookFlatAxis( hist.y, n_y, y_min, y_max );
+
+    hist.entries = 0;
+    hist.cells.assign( ( n_x + 2 ) * ( n_y + 2 ), T(0) );
+}
+
+// -------------------------------------------------------------------------
+// Book an empty histogram with the binning of a TH1D or TH2D
+// -------------------------------------------------------------------------
+template< typename T >
+void BookFlatHist( FlatHist< T > &hist,
+                   const TH1 *h ){
+
+    const TAxis *x_axis = h->GetXaxis();
+    const TAxis *y_axis = h->GetYaxis();
+
+    if( h->GetDimension() > 2 || x_axis->IsVariableBinSize() || y_axis->IsVariableBinSize() ){
+        cerr << " A flat histogram needs uniform bins in 1 or 2 dimensions : " << h->GetName() << endl;
+        exit(1);
+    }
+
+    if( h->GetDimension() == 1 ){
+        BookFlatHist( hist, x_axis->GetNbins(), x_axis->GetXmin(), x_axis->GetXmax() );
+    }
+    else{
+        BookFlatHist( hist, x_axis->GetNbins(), x_axis->GetXmin(), x_axis->GetXmax(),
+                            y_axis->GetNbins(), y_axis->GetXmin(), y_axis->GetXmax() );
+    }
+}
+
+// -------------------------------------------------------------------------
+// The bin of a value, 0 for the underflow and n_bins + 1 for the overflow
+// NaN goes to the overflow, as in TAxis::FindBin
+// -------------------------------------------------------------------------
+inline int FlatBin( const FlatAxis &axis,
+                    double value ){
+
+    if( value < axis.min )     return 0;
+    if( !( value < axis.max ) ) return axis.n_bins + 1;
+
+    double u   = ( value - axis.min ) * axis.scale;
+    int    bin = int( u );
+    double f   = u - bin;
+
+    if( f < kFlatEdgeTolerance || f > 1 - kFlatEdgeTolerance ){
+        bin = int( axis.n_bins * ( value - axis.min ) / ( axis.max - axis.min ) );
+    }
+
+    return bin + 1;
+}
+
+// -------------------------------------------------------------------------
+// Fill a 1D histogram
+// -------------------------------------------------------------------------
+template< typename T >
+inline void FillFlatHist( FlatHist< T > &hist,
+                          double x,
+                          T weight = T(1) ){
+
+    hist.cells[ FlatBin( hist.x, x ) ] += weight;
+    ++hist.entries;
+}
+
+// -------------------------------------------------------------------------
+// Fill a 2D histogram
+// -------------------------------------------------------------------------
+template< typename T >
+inline void FillFlatHist( FlatHist< T > &hist,
+                          double x,
+                          double y,
+                          T weight ){
+
+    hist.cells[ FlatBin( hist.x, x ) + ( hist.x.n_bins + 2 ) * FlatBin( hist.y, y ) ] += weight;
+    ++hist.entries;
+}
+
+// -------------------------------------------------------------------------
+// The cell a 1D or 2D fill lands in
+// -------------------------------------------------------------------------
+template< typename T >
+inline int FlatCell( const FlatHist< T > &hist,
+                     double x ){
+
+    return FlatBin( hist.x, x );
+}
+
+template< typename T >
+inline int FlatCell( const FlatHist< T > &hist,
+                     double x,
+                     double y ){
+
+    return FlatBin( hist.x, x ) + ( hist.x.n_bins + 2 ) * FlatBin( hist.y, y );
+}
+
+// -------------------------------------------------------------------------
+// Add the contents of one histogram to another with the same binning,
+// to merge the histograms filled on separate threads
+// -------------------------------------------------------------------------
+template< typename T >
+void AddFlatHist( FlatHist< T > &hist,
+                  const FlatHist< T > &other ){
+
+    if( hist.cells.size() != other.cells.size() ){
+        cerr << " Adding flat histograms with different binning " << endl;
+        exit(1);
+    }
+
+    for( unsigned int i = 0; i < hist.cells.size(); ++i ){
+        hist.cells[i] += other.cells[i];
+    }
+    hist.entries += other.entries;
+}
+
+// -------------------------------------------------------------------------
+// Copy the contents into a TH1D or TH2D with the same binning, replacing
+// anything already in it. The errors are left to ROOT, sqrt(N) unless
+// Sumw2 has been called on h
+// -------------------------------------------------------------------------
+template< typename T >
+void FlatToTH1( const FlatHist< T > &hist,
+                TH1 *h ){
+
+    if( h->GetNcells() != int( hist.cells.size() ) ){
+        cerr << " The binning of " << h->GetName() << " does not match the flat histogram " << endl;
+        exit(1);
+    }
+
+    h->Reset();
+
+    for( unsigned int i = 0; i < hist.cells.size(); ++i ){
+        if( hist.cells[i] != T(0) ) h->SetBinContent( i, double( hist.cells[i] ) );
+    }
+
+    h->SetEntries( double( hist.entries ) );
+}
+
+// -------------------------------------------------------------------------
+// The interaction channels of the gst flags, each event is in one of them
+// -------------------------------------------------------------------------
+enum InteractionChannel {
+    kChannelQEL,
+    kChannelMEC,
+    kChannelRES,
+    kChannelDIS,
+    kChannelCOH,
+    kChannelOther,
+    kNChannels
+};
+
+// The gst branches the channels are found from, as a Draw expression
+const char* const kChannelFill = "qel + mec + res + dis + coh";
+
+// -------------------------------------------------------------------------
+// The channel of an event from its flags, coherent first as GENIE also
+// sets the flag of the underlying process for some coherent events
+// -------------------------------------------------------------------------
+inline int ClassifyChannel( bool qel,
+                            bool mec,
+                            bool res,
+                            bool dis,
+                            bool coh ){
+
+    if( coh ) return kChannelCOH;
+    if( qel ) return kChannelQEL;
+    if( mec ) return kChannelMEC;
+    if( res ) return kChannelRES;
+    if( dis ) return kChannelDIS;
+    return kChannelOther;
+}
+
+// -------------------------------------------------------------------------
+// The name of each channel, for the legends
+// -------------------------------------------------------------------------
+inline const char* ChannelName( int channel ){
+
+    static const char* names[kNChannels] = { "QEL", "MEC", "RES", "DIS", "COH", "Other" };
+
+    return names[channel];
+}
+
+// -------------------------------------------------------------------------
+// The contents of a histogram in each of a set of reweighting universes,
+// or of bootstrap replicas
+//      n_universes : the number of universes or replicas
+//      entries     : the number of fills
+//      cells       : n_universes values for each cell of the histogram,
+//                    cell * n_universes + u, so that a fill adds to one
+//                    contiguous block
+// -------------------------------------------------------------------------
+struct FlatUniverses {
+    int              n_universes;
+    Long64_t         entries;
+    vector< double > cells;
+};
+
+// -------------------------------------------------------------------------
+// Fill a cell in every universe, universe_weights holding the weight of
+// the event in each of them
+// -------------------------------------------------------------------------
+inline void FillFlatUniverses( FlatUniverses &universes,
+                               int cell,
+                               double weight,
+                               const double *universe_weights ){
+
+    double *block = &universes.cells[ Long64_t( cell ) * universes.n_universes ];
+
+    for( int u = 0; u < universes.n_universes; ++u ){
+        block[u] += weight * universe_weights[u];
+    }
+    ++universes.entries;
+}
+
+// -------------------------------------------------------------------------
+// A fill for the engine:
+//      variable      : as for TTree::Draw, "x" or "y:x"
+//      selection     : as for TTree::Draw, the value is the weight of the
+//                      fill, may be empty
+//      topology_mask : the TopologyBit of each topology in topologies.h
+//                      the event must belong to, 0 for none
+//      hist          : the histogram to fill, booked before FillFlat is called
+//      channels      : empty, or after BookFlatChannels the same histogram
+//                      for each InteractionChannel, filled alongside hist
+//                      with the events of that channel
+//      universes     : empty, or after BookFlatUniverses the histogram in
+//                      each universe of universe_weights.h
+//      replicas      : empty, or after BookFlatReplicas the histogram in
+//                      each Poisson bootstrap replica of bootstrap.h
+//      oscillated    : empty, or after BookFlatOscillations the histogram
+//                      at each point of the grid of oscillation_grid.h
+//      kinematics    : empty, or the KinematicVariables of event_kinematics.h
+//                      the fill takes in place of variable, x first, which
+//                      then only names them
+// -------------------------------------------------------------------------
+struct FlatFill {
+    string                       variable;
+    string                       selection;
+    unsigned int                 topology_mask;
+    FlatHist< double >           hist;
+    vector< FlatHist< double > > channels;
+    FlatUniverses                universes;
+    FlatUniverses                replicas;
+    FlatUniverses                oscillated;
+    vector< int >                kinematics;
+};
+
+// -------------------------------------------------------------------------
+// Split a fill by interaction channel, with the binning of its histogram
+// -------------------------------------------------------------------------
+inline void BookFlatChannels( FlatFill &fill ){
+
+    fill.channels.assign( kNChannels, fill.hist );
+
+    for( int c = 0; c < kNChannels; ++c ){
+        fill.channels[c].entries = 0;
+        fill.channels[c].cells.assign( fill.hist.cells.size(), 0 );
+    }
+}
+
+// -------------------------------------------------------------------------
+// Fill a fill in the first n_universes universes of the weights attached
+// with AttachGstUniverses, with the binning of its histogram
+// -------------------------------------------------------------------------
+inline void BookFlatUniverses( FlatFill &fill,
+                               int n_universes ){
+
+    if( n_universes < 1 ){
+        cerr << " A fill needs at least one universe " << endl;
+        exit(1);
+    }
+
+    fill.universes.n_universes = n_universes;
+    fill.universes.entries     = 0;
+    fill.universes.cells.assign( fill.hist.cells.size() * n_universes, 0 );
+}
+
+// -------------------------------------------------------------------------
+// Fill a fill in n_replicas bootstrap replicas as well, each event with a
+// Poisson(1) weight in each replica
+// -------------------------------------------------------------------------
+inline void BookFlatReplicas( FlatFill &fill,
+                              int n_replicas ){
+
+    if( n_replicas < 2 ){
+        cerr << " A bootstrap needs at least two replicas " << endl;
+        exit(1);
+    }
+
+    fill.replicas.n_universes = n_replicas;
+    fill.replicas.entries     = 0;
+    fill.replicas.cells.assign( fill.hist.cells.size() * n_replicas, 0 );
+}
+
+// -------------------------------------------------------------------------
+// Fill each of the histograms in a single pass over the tree
+// Each entry is evaluated as TTree::Draw does, every instance of the
+// particle arrays (pf, cthf, pdgf, ...) which passes the selection is
+// filled. Its topology, channel, universe, bootstrap and oscillation
+// weights are found once for all of the fills which need them
+// The entries read are the first of these there is:
+//      - the skim of a topology every fill selects, see skim_tree.h,
+//        unless a fill has universes or replicas
+//      - those the event store finds may pass the fills, see event_store.h
+//      - those in the topology index of any of the fills, see
+//        topology_index.h
+// The fills with kinematics take their variables from the kernel of
+// event_kinematics.h, run on batches of the entries read
+// With a smearing set, see smearing.h, every entry is read and smeared
+// first, as its topology may change. Returns the number of entries read
+// -------------------------------------------------------------------------
+Long64_t FillFlat( TTree *event_tree,
+                   vector< FlatFill > &fills );
+
+// -------------------------------------------------------------------------
+// Evaluate the variables and selections of FillFlat, and so FlatDraw, with
+// the expressions compiled by jit_cuts.h rather than TTreeFormula
+// Off by default, or on if SBND_JIT_CUTS=1 is set in the environment
+// -------------------------------------------------------------------------
+void SetFlatJit( bool use_jit );
+
+// -------------------------------------------------------------------------
+// Whether FillFlat uses the compiled expressions
+// -------------------------------------------------------------------------
+bool FlatJit();
+
+// -------------------------------------------------------------------------
+// Run the fills of FillFlat, and so FlatDraw, as one RDataFrame graph
+// through rdf_fill.h. This takes precedence over SetFlatJit, except for
+// fills with universes, replicas, oscillations or kinematics which are
+// left to the other engines
+// Off by default, or on if SBND_RDATAFRAME=1 is set in the environment
+// -------------------------------------------------------------------------
+void SetFlatRDF( bool use_rdf );
+
+// -------------------------------------------------------------------------
+// Whether FillFlat runs through RDataFrame
+// -------------------------------------------------------------------------
+bool FlatRDF();
+
+// -------------------------------------------------------------------------
+// Fill an existing histogram as TTree::Draw( "var>>name", selection, option )
+// would, through a FlatHist
+// The histogram is found by name in the current directory. It is only
+// drawn if an option other than "goff" is given, "colz" for example.
+// Returns the number of fills
+// -------------------------------------------------------------------------
+Long64_t FlatDraw( TTree *event_tree,
+                   const char* varexp,
+                   const char* selection,
+                   const char* option = "" );
+
+// -------------------------------------------------------------------------
+// As above, for the events of a topology in topologies.h, with an optional
+// further selection, "pdgf == 211" for example
+// -------------------------------------------------------------------------
+Long64_t FlatDraw( TTree *event_tree,
+                   const char* varexp,
+                   int topology,
+                   const char* selection = "",
+                   const char* option = "" );
+
+// -------------------------------------------------------------------------
+// The fills of a macro, booked with FlatBook and run by RunFlatBatch with
+// one FillFlat pass for each tree
+//      trees   : the trees the fills are booked on
+//      fills   : the fills of each tree
+//      targets : the histogram of each of those fills, 0 for a fill
+//                booked without one
+//      names   : the name of each of those fills, that of its histogram
+//                if it has one
+// -------------------------------------------------------------------------
+struct FlatBatch {
+    vector< TTree* >             trees;
+    vector< vector< FlatFill > > fills;
+    vector< vector< TH1* > >     targets;
+    vector< vector< string > >   names;
+};
+
+// -------------------------------------------------------------------------
+// Book the fill FlatDraw( event_tree, varexp, selection ) would make of an
+// existing histogram, found by name in the current directory, split by
+// interaction channel as with BookFlatChannels. Nothing is filled until
+// RunFlatBatch
+// Returns the fill, until the next is booked, so that its replicas,
+// universes or oscillations are filled in the same pass:
+//      BookFlatReplicas( FlatBook( batch, gst, "Q2>>h", kCC0Pi ), 100 );
+// -------------------------------------------------------------------------
+FlatFill &FlatBook( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* varexp,
+                    const char* selection );
+
+// -------------------------------------------------------------------------
+// As above, for the events of a topology in topologies.h, with an optional
+// further selection
+// -------------------------------------------------------------------------
+FlatFill &FlatBook( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* varexp,
+                    int topology,
+                    const char* selection = "" );
+
+// -------------------------------------------------------------------------
+// Book the fill of an existing histogram with the KinematicVariables of
+// event_kinematics.h, x against y or x alone for y = -1, for the events of
+// a topology. The variables are computed by the kinematics kernel in the
+// same pass as the other fills, and it is split by channel as above
+// -------------------------------------------------------------------------
+FlatFill &FlatBookKinematics( FlatBatch &batch,
+                              TTree *event_tree,
+                              const char* name,
+                              int topology,
+                              int x,
+                              int y = -1 );
+
+// -------------------------------------------------------------------------
+// Book a copy of a fill with no histogram, a count or a covariance for
+// example, under a name for FlatBatchFill. It is not split by channel
+// -------------------------------------------------------------------------
+FlatFill &FlatBook( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* name,
+                    const FlatFill &fill );
+
+// -------------------------------------------------------------------------
+// Fill every fill of a batch, with one FillFlat for each tree, and copy
+// each into its histogram, which must not have been deleted since it was
+// booked. Returns the number of entries read
+// The fills of a tree with replicas, universes, oscillations or kinematic
+// fills are run by the TTreeFormula or compiled engines, even with
+// SetFlatRDF
+// -------------------------------------------------------------------------
+Long64_t RunFlatBatch( FlatBatch &batch );
+
+// -------------------------------------------------------------------------
+// The fill booked under a name, for its channels, replicas, universes or
+// oscillations after RunFlatBatch. Exits if there is none
+// -------------------------------------------------------------------------
+const FlatFill &FlatBatchFill( const FlatBatch &batch,
+                               const char* name );
+
+// -------------------------------------------------------------------------
+// Add the variable and selection of every fill of a batch to the planned
+// fills of OpenGstReader, with kTopologyFill, kChannelFill, Ev and
+// kKinematicsFill if they need them, so that the branches read follow the
+// fills booked
+// -------------------------------------------------------------------------
+void FlatBatchExpressions( const FlatBatch &batch,
+                           vector< string > &planned_fills );
+
+// -------------------------------------------------------------------------
+// Write each channel of every fill of a batch to a file, as a copy of the
+// histogram of the fill named <histogram>_<channel>, h1_Q2_abs_cc0pi_RES
+// for example. The histograms must not have been deleted since
+// RunFlatBatch
+// -------------------------------------------------------------------------
+void WriteFlatBatchChannels( const FlatBatch &batch,
+                             TFile *file );
+
+// -------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,547 @@
+/*
+ * A root macro to check that an optimised engine reproduces the legacy
+ * outputs of the model comparison macros
+ *
+ * For each model configuration both the legacy path (TTree::Draw on all
+ * branches, FSINumbers, RecoNuE and Norm as in the macros) and the
+ * chosen engine are run on the same input, and every
+ *      - normalisation
+ *      - FSI count, the numbers written to n_interactions.txt and the
+ *        FSI_MC_Table.tex and FSI_Reco_Table.tex tables
+ *      - histogram bin, including the under and overflow, of every
+ *        distribution drawn by the six macros
+ * is compared within the given tolerances. Any divergence is written to
+ * golden_comparison_report.txt and the number of divergences is returned
+ *
+ * The engines:
+ *      reader    : the helpers and TTree::Draw, reading only the
+ *                  planned branches through OpenGstReader with n_threads
+ *      flat_hist : as reader, with every distribution filled into a
+ *                  FlatHist in a single pass by FillFlat, selecting the
+ *                  events by the compiled topologies
+ *      jit       : as flat_hist, with the variables and selections
+ *                  compiled by jit_cuts.cpp rather than TTreeFormula
+ *      rdataframe : as flat_hist, with the fills run as one RDataFrame
+ *                  graph by rdf_fill.cpp
+ *
+ * The legacy FSI counts are taken with the TopologyCut strings, so that
+ * they check the compiled topologies used by FSINumbers
+ *
+ * The distributions select six topologies and the flat_hist and jit
+ * engines fill them all in one pass, which must only read the entries in
+ * the topology index of one of them, see topology_index.h. Reading more,
+ * or finding no index, is a divergence
+ *
+ * To check the reader with 4 threads on the synthetic sample:
+ *      export SBND_INPUT_DIR=$PWD/synthetic
+ *      root -l -b -q load_modules.cpp 'golden_comparison.cpp+("reader", 4)'
+ *
+*/
+
+// The helpers are the ones used by model_comparisons
+#include "model_comparisons.cpp"
+#include "topology_index.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// A distribution drawn by the macros
+//      name                : the name used in the report
+//      variable, selection : as passed to TTree::Draw
+//      n_x, x_min, x_max   : the x binning
+//      n_y, y_min, y_max   : the y binning, n_y = 0 for a TH1D
+// -------------------------------------------------------------------------
+struct GoldenFill {
+    const char* name;
+    const char* variable;
+    const char* selection;
+    int         n_x;
+    double      x_min;
+    double      x_max;
+    int         n_y;
+    double      y_min;
+    double      y_max;
+};
+
+const char* golden_cc0pi  = "cc && (nfpip + nfpim + nfpi0 == 0)";
+const char* golden_nc0pi  = "nc && (nfpip + nfpim + nfpi0 == 0)";
+const char* golden_cc1pip = "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )";
+const char* golden_cc1pi0 = "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )";
+const char* golden_nc1pi0 = "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 )";
+const char* golden_cc1pi  = "cc && (nfpip + nfpim + nfpi0 == 1)";
+
+// The topologies in topologies.h which the selections above are written for
+const int n_golden_topologies = 6;
+
+const char* golden_topology_cuts[n_golden_topologies] = { golden_cc0pi, golden_nc0pi, golden_cc1pip,
+                                                          golden_cc1pi0, golden_nc1pi0, golden_cc1pi };
+const int   golden_topologies[n_golden_topologies]    = { kCC0Pi, kNC0Pi, kCC1PiP,
+                                                          kCC1Pi0, kNC1Pi0, kCC1Pi };
+
+const int n_golden_fills = 39;
+
+const GoldenFill golden_fills[n_golden_fills] = {
+    { "Q2_cc0pi",         "Q2",           golden_cc0pi,  50,  0,   2.5, 0,  0, 0   },
+    { "Q2_cc1pip",        "Q2",           golden_cc1pip, 50,  0,   2.5, 0,  0, 0   },
+    { "Q2_cc1pi0",        "Q2",           golden_cc1pi0, 50,  0,   2.5, 0,  0, 0   },
+    { "Q2_nc1pi0",        "Q2",           golden_nc1pi0, 50,  0,   2.5, 0,  0, 0   },
+    { "Ev_cc0pi",         "Ev",           golden_cc0pi,  50,  0,   3,   0,  0, 0   },
+    { "Ev_cc1pip",        "Ev",           golden_cc1pip, 50,  0,   3,   0,  0, 0   },
+    { "Ev_cc1pi0",        "Ev",           golden_cc1pi0, 50,  0,   3,   0,  0, 0   },
+    { "Ev_nc1pi0",        "Ev",           golden_nc1pi0, 50,  0,   3,   0,  0, 0   },
+    { "CosThPi_cc1pip",   "cthf",         "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211", 40, -1, 1, 0, 0, 0 },
+    { "CosThPi_cc1pi0",   "cthf",         "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111", 40, -1, 1, 0, 0, 0 },
+    { "CosThPi_nc1pi0",   "cthf",         "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111", 40, -1, 1, 0, 0, 0 },
+    { "PPi_cc1pip",       "pf",           "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211", 40, 0, 1.5, 0, 0, 0 },
+    { "PPi_cc1pi0",       "pf",           "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111", 40, 0, 1.5, 0, 0, 0 },
+    { "PPi_nc1pi0",       "pf",           "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111", 40, 0, 1.5, 0, 0, 0 },
+    { "CosThMu_cc0pi",    "cthl",         golden_cc0pi,  40, -1,   1,   0,  0, 0   },
+    { "CosThMu_cc1pip",   "cthl",         golden_cc1pip, 40, -1,   1,   0,  0, 0   },
+    { "CosThMu_cc1pi0",   "cthl",         golden_cc1pi0, 40, -1,   1,   0,  0, 0   },
+    { "PMu_cc0pi",        "pl",           golden_cc0pi,  40,  0,   1.5, 0,  0, 0   },
+    { "PMu_cc1pip",       "pl",           golden_cc1pip, 40,  0,   1.5, 0,  0, 0   },
+    { "PMu_cc1pi0",       "pl",           golden_cc1pi0, 40,  0,   1.5, 0,  0, 0   },
+    { "Np_cc0pi",         "nfp",          golden_cc0pi,  15,  0,  15,   0,  0, 0   },
+    { "Np_nc0pi",         "nfp",          golden_nc0pi,  15,  0,  15,   0,  0, 0   },
+    { "Nn_cc0pi",         "nfn",          golden_cc0pi,  15,  0,  15,   0,  0, 0   },
+    { "Nn_nc0pi",         "nfn",          golden_nc0pi,  15,  0,  15,   0,  0, 0   },
+    { "NN_cc0pi",         "(nfp+nfn)",    golden_cc0pi,  25,  0,  25,   0,  0, 0   },
+    { "NN_nc0pi",         "(nfp+nfn)",    golden_nc0pi,  25,  0,  25,   0,  0, 0   },
+    { "Np_fine_cc0pi",    "nfp",          golden_cc0pi,  80,  0,  15,   0,  0, 0   },
+    { "Np_fine_nc0pi",    "nfp",          golden_nc0pi,  80,  0,  15,   0,  0, 0   },
+    { "Nn_fine_cc0pi",    "nfn",          golden_cc0pi,  80,  0,  15,   0,  0, 0   },
+    { "Nn_fine_nc0pi",    "nfn",          golden_nc0pi,  80,  0,  15,   0,  0, 0   },
+    { "NN_fine_cc0pi",    "(nfp+nfn)",    golden_cc0pi,  80,  0,  25,   0,  0, 0   },
+    { "NN_fine_nc0pi",    "(nfp+nfn)",    golden_nc0pi,  80,  0,  25,   0,  0, 0   },
+    { "NpNn_cc0pi",       "nfn:nfp",      golden_cc0pi,  10,  0,  10,   10, 0, 10  },
+    { "NpNn_nc0pi",       "nfn:nfp",      golden_nc0pi,  10,  0,  10,   10, 0, 10  },
+    { "NpKESum_cc0pi",    "sumKEf:nfp",   golden_cc0pi,  12,  0,  12,   50, 0, 2.5 },
+    { "NpKESum_nc0pi",    "sumKEf:nfp",   golden_nc0pi,  12,  0,  12,   50, 0, 2.5 },
+    { "avg_KE_p_cc0pi",   "(sumKEf/nfp)", golden_cc0pi,  50,  0,   2.5, 0,  0, 0   },
+    { "Ev_Inel_cc0pi",    "ys:EvRF",      golden_cc0pi,  40,  0,   2.5, 40, 0, 1   },
+    { "Ev_Inel_cc1pi",    "ys:EvRF",      golden_cc1pi,  40,  0,   2.5, 40, 0, 1   }
+};
+
+// -------------------------------------------------------------------------
+// The outputs of one engine for one model
+//      norm               : the normalisation from Norm
+//      n_*_fsi            : the FSI counts from FSINumbers
+//      bins               : the bin contents of each distribution, and of
+//                           the RecoNuE distributions, by name
+//      n_entries, n_read  : the entries of the tree, and those the fill
+//                           engine read for the distributions
+//      n_index            : the entries in the topology index of any of
+//                           the distributions, 0 without an index and -1
+//                           if the engine reads every entry
+// -------------------------------------------------------------------------
+struct GoldenOutputs {
+    double                          norm;
+    vector< double >                n_cc_fsi;
+    vector< double >                n_nc_fsi;
+    vector< double >                n_cc_mc_fsi;
+    vector< double >                n_nc_mc_fsi;
+    map< string, vector< double > > bins;
+    Long64_t                        n_entries;
+    Long64_t                        n_read;
+    Long64_t                        n_index;
+};
+
+// -------------------------------------------------------------------------
+// The contents of every cell of a histogram, including under and overflow
+// -------------------------------------------------------------------------
+vector< double > GoldenBins( TH1 *h ){
+
+    vector< double > bins( h->GetNcells() );
+
+    for( int i = 0; i < h->GetNcells(); ++i ){
+        bins[i] = h->GetBinContent(i);
+    }
+
+    return bins;
+}
+
+// -------------------------------------------------------------------------
+// Fill the RecoNuE distributions of KE_model_comparisons, from the full
+// gst tree for the legacy path and from the skims, if they have been
+// written, for the engines
+// -------------------------------------------------------------------------
+void GoldenRecoNuE( TTree *gst,
+                    GoldenOutputs &out,
+                    bool full_tree = false ){
+
+    vector< double > reco_cc, reco_nc, mc_reco_cc, mc_reco_nc;
+    RecoNuE( gst, reco_cc, reco_nc, mc_reco_cc, mc_reco_nc, full_tree );
+
+    TH1D h_reco_mc_cc( "golden_Ev_reco_CC", "", 50, -0.6, 0.6 );
+    TH1D h_reco_mc_nc( "golden_Ev_reco_NC", "", 50, -0.6, 0.6 );
+    TH1D h_reco_cc( "golden_reco_CC", "", 50, 0, 3 );
+    TH1D h_reco_nc( "golden_reco_NC", "", 50, 0, 3 );
+
+    for( unsigned int i = 0; i < mc_reco_cc.size(); ++i ) h_reco_mc_cc.Fill( mc_reco_cc[i] );
+    for( unsigned int i = 0; i < mc_reco_nc.size(); ++i ) h_reco_mc_nc.Fill( mc_reco_nc[i] );
+    for( unsigned int i = 0; i < reco_cc.size(); ++i )    h_reco_cc.Fill( reco_cc[i] );
+    for( unsigned int i = 0; i < reco_nc.size(); ++i )    h_reco_nc.Fill( reco_nc[i] );
+
+    out.bins["Ev_reco_CC"] = GoldenBins( &h_reco_mc_cc );
+    out.bins["Ev_reco_NC"] = GoldenBins( &h_reco_mc_nc );
+    out.bins["reco_CC"]    = GoldenBins( &h_reco_cc );
+    out.bins["reco_NC"]    = GoldenBins( &h_reco_nc );
+}
+
+// -------------------------------------------------------------------------
+// Draw every distribution the way the macros do
+// -------------------------------------------------------------------------
+void GoldenDraws( TTree *gst,
+                  GoldenOutputs &out ){
+
+    for( int i = 0; i < n_golden_fills; ++i ){
+
+        const GoldenFill &fill = golden_fills[i];
+        string h_name = string( "golden_" ) + fill.name;
+
+        TH1 *h = 0;
+        if( fill.n_y == 0 ){
+            h = new TH1D( h_name.c_str(), fill.name, fill.n_x, fill.x_min, fill.x_max );
+        }
+        else{
+            h = new TH2D( h_name.c_str(), fill.name, fill.n_x, fill.x_min, fill.x_max, fill.n_y, fill.y_min, fill.y_max );
+        }
+
+        gst->Draw( ( string( fill.variable ) + ">>" + h_name ).c_str(), fill.selection, "goff" );
+
+        out.bins[fill.name] = GoldenBins( h );
+
+        delete h;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Split a selection into its topology and any further cut on the particles
+// -------------------------------------------------------------------------
+void GoldenTopology( const string &selection,
+                     unsigned int &topology_mask,
+                     string &extra ){
+
+    for( int i = 0; i < n_golden_topologies; ++i ){
+
+        string cut = golden_topology_cuts[i];
+        if( selection.compare( 0, cut.size(), cut ) != 0 ) continue;
+
+        topology_mask = TopologyBit( golden_topologies[i] );
+        extra         = selection.substr( cut.size() );
+
+        size_t and_pos = extra.find( "&&" );
+        extra = and_pos == string::npos ? "" : extra.substr( and_pos + 2 );
+        return;
+    }
+
+    cerr << " No topology for the selection : " << selection << endl;
+    exit(1);
+}
+
+// -------------------------------------------------------------------------
+// The FSI counts of FSINumbers, counted with the topology cut strings
+// -------------------------------------------------------------------------
+void GoldenLegacyFSI( TTree *gst,
+                      double norm,
+                      GoldenOutputs &out ){
+
+    for( int i = 0; i < 2 * kNFSITopologies; ++i ){
+
+        double n = gst->GetEntries( TopologyCut(i) );
+
+        if( i < kNFSITopologies ){
+            out.n_cc_mc_fsi.push_back( n );
+            out.n_cc_fsi.push_back( TMath::Floor( norm * n ) );
+        }
+        else{
+            out.n_nc_mc_fsi.push_back( n );
+            out.n_nc_fsi.push_back( TMath::Floor( norm * n ) );
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// The legacy path: all branches, TTree::Draw, the topologies as cut
+// strings and the macros' helpers
+// -------------------------------------------------------------------------
+void GoldenLegacy( TTree *gst,
+                   TFile &xsec_file,
+                   TFile &flux_file,
+                   GoldenOutputs &out ){
+
+    SetGstThreads( 0 );
+    gst->SetBranchStatus( "*", 1 );
+
+    out.norm = Norm( 1000000, xsec_file, flux_file );
+    GoldenLegacyFSI( gst, out.norm, out );
+    GoldenRecoNuE( gst, out, true );
+    GoldenDraws( gst, out );
+}
+
+// -------------------------------------------------------------------------
+// The reader engine: the same helpers and Draws reading only the
+// planned branches, with n_threads
+// -------------------------------------------------------------------------
+void GoldenReader( TTree *gst,
+                   TFile &xsec_file,
+                   TFile &flux_file,
+                   unsigned int n_threads,
+                   GoldenOutputs &out ){
+
+    ostringstream sink;
+
+    vector< string > planned_fills;
+    for( int i = 0; i < n_golden_fills; ++i ){
+        planned_fills.push_back( golden_fills[i].variable );
+        planned_fills.push_back( golden_fills[i].selection );
+    }
+    planned_fills.push_back( "El + Ev + pl + cthl" );
+    planned_fills.push_back( "cc && nc && coh" );
+
+    SetGstThreads( n_threads );
+    OpenGstReader( gst, planned_fills, false );
+
+    out.norm = Norm( 1000000, xsec_file, flux_file );
+    FSINumbers( gst, sink, out.norm, out.n_cc_fsi, out.n_nc_fsi, out.n_cc_mc_fsi, out.n_nc_mc_fsi );
+    GoldenRecoNuE( gst, out );
+    GoldenDraws( gst, out );
+
+    CloseGstReader( gst );
+}
+
+// -------------------------------------------------------------------------
+// The flat_hist engine: the reader engine with the distributions filled
+// in a single pass through the fill engine
+// -------------------------------------------------------------------------
+void GoldenFlatHist( TTree *gst,
+                     TFile &xsec_file,
+                     TFile &flux_file,
+                     unsigned int n_threads,
+                     GoldenOutputs &out ){
+
+    ostringstream sink;
+
+    vector< string > planned_fills;
+    vector< FlatFill > fills( n_golden_fills );
+
+    for( int i = 0; i < n_golden_fills; ++i ){
+
+        const GoldenFill &fill = golden_fills[i];
+
+        planned_fills.push_back( fill.variable );
+        planned_fills.push_back( fill.selection );
+
+        fills[i].variable = fill.variable;
+        GoldenTopology( fill.selection, fills[i].topology_mask, fills[i].selection );
+        BookFlatHist( fills[i].hist, fill.n_x, fill.x_min, fill.x_max, fill.n_y, fill.y_min, fill.y_max );
+    }
+    planned_fills.push_back( "El + Ev + pl + cthl" );
+    planned_fills.push_back( kTopologyFill );
+
+    SetGstThreads( n_threads );
+    OpenGstReader( gst, planned_fills, false );
+
+    out.norm = Norm( 1000000, xsec_file, flux_file );
+    FSINumbers( gst, sink, out.norm, out.n_cc_fsi, out.n_nc_fsi, out.n_cc_mc_fsi, out.n_nc_mc_fsi );
+    GoldenRecoNuE( gst, out );
+
+    out.n_entries = gst->GetEntries();
+    out.n_read    = FillFlat( gst, fills );
+    out.n_index   = -1;
+
+    // The distributions select different topologies, the engine should
+    // still only read the entries in the index of one of them
+    if( !FlatRDF() ){
+        vector< unsigned int > topology_masks;
+        for( int i = 0; i < n_golden_fills; ++i ) topology_masks.push_back( fills[i].topology_mask );
+
+        TEntryList *index = GstTopologyUnion( gst, topology_masks );
+        out.n_index = index ? index->GetN() : 0;
+        delete index;
+    }
+
+    for( int i = 0; i < n_golden_fills; ++i ){
+        out.bins[golden_fills[i].name] = fills[i].hist.cells;
+    }
+
+    CloseGstReader( gst );
+}
+
+// -------------------------------------------------------------------------
+// Run the chosen engine
+// -------------------------------------------------------------------------
+void GoldenEngine( const string &engine,
+                   TTree *gst,
+                   TFile &xsec_file,
+                   TFile &flux_file,
+                   unsigned int n_threads,
+                   GoldenOutputs &out ){
+
+    if( engine == "reader" ){
+        GoldenReader( gst, xsec_file, flux_file, n_threads, out );
+    }
+    else if( engine == "flat_hist" ){
+        GoldenFlatHist( gst, xsec_file, flux_file, n_threads, out );
+    }
+    else if( engine == "jit" ){
+        bool use_jit = FlatJit();
+        SetFlatJit( true );
+        GoldenFlatHist( gst, xsec_file, flux_file, n_threads, out );
+        SetFlatJit( use_jit );
+    }
+    else if( engine == "rdataframe" ){
+        bool use_rdf = FlatRDF();
+        SetFlatRDF( true );
+        GoldenFlatHist( gst, xsec_file, flux_file, n_threads, out );
+        SetFlatRDF( use_rdf );
+    }
+    else{
+        cerr << " Unknown engine : " << engine << endl;
+        exit(1);
+    }
+}
+
+// -------------------------------------------------------------------------
+// Compare two numbers, writing any divergence to the report
+// They agree if |test - ref| <= abs_tol + rel_tol * |ref|
+// -------------------------------------------------------------------------
+int GoldenCompare( const string &what,
+                   double ref,
+                   double test,
+                   double abs_tol,
+                   double rel_tol,
+                   ostream &report ){
+
+    double diff = TMath::Abs( test - ref );
+
+    if( diff <= abs_tol + rel_tol * TMath::Abs( ref ) ) return 0;
+
+    report << setprecision(10) << " DIVERGED " << what << " : legacy " << ref << ", engine " << test << endl;
+
+    return 1;
+}
+
+// -------------------------------------------------------------------------
+// Compare two vectors element by element
+// -------------------------------------------------------------------------
+int GoldenCompare( const string &what,
+                   const vector< double > &ref,
+                   const vector< double > &test,
+                   double abs_tol,
+                   double rel_tol,
+                   ostream &report ){
+
+    if( ref.size() != test.size() ){
+        report << " DIVERGED " << what << " : legacy has " << ref.size()
+               << " entries, engine has " << test.size() << endl;
+        return 1;
+    }
+
+    int n_diverged = 0;
+    for( unsigned int i = 0; i < ref.size(); ++i ){
+        n_diverged += GoldenCompare( what + "[" + to_string(i) + "]", ref[i], test[i], abs_tol, rel_tol, report );
+    }
+
+    return n_diverged;
+}
+
+// -------------------------------------------------------------------------
+//                          The macro
+// -------------------------------------------------------------------------
+int golden_comparison( const char* engine = "reader",
+                       unsigned int n_threads = 2,
+                       double count_tol = 0,
+                       double bin_tol = 1e-9,
+                       double norm_tol = 1e-12 ){
+
+    const char* models[5] = { "Default", "Default+MEC", "G16_02b", "G16_01a", "G16_01b" };
+
+    string flux_path = InputPath( "/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root" );
+
+    TFile f_flux( flux_path.c_str() );
+    if( f_flux.IsZombie() ){
+        cerr << " Error opening the flux file " << endl;
+        exit(1);
+    }
+
+    ofstream report;
+    report.open( "golden_comparison_report.txt" );
+    report << " Engine    : " << engine << endl;
+    report << " Threads   : " << n_threads << endl;
+    report << setprecision(3) << " Tolerance : counts " << count_tol << ", bins " << bin_tol << ", norm " << norm_tol << endl;
+
+    int n_diverged = 0;
+
+    for( int m = 0; m < 5; ++m ){
+
+        string dir = string( "/hepstore/rjones/Exercises/Flavours/" ) + models[m];
+
+        TFile f_xsec( InputPath( ( dir + "/xsec_files/total_xsec.root" ).c_str() ).c_str() );
+
+        // Separate files so that neither engine sees the other's tree settings
+        TFile f_legacy( InputPath( ( dir + "/sbnd/1M/gntp.10000.gst.root" ).c_str() ).c_str() );
+        TFile f_engine( InputPath( ( dir + "/sbnd/1M/gntp.10000.gst.root" ).c_str() ).c_str() );
+
+        if( f_xsec.IsZombie() || f_legacy.IsZombie() || f_engine.IsZombie() ){
+            cerr << " Error opening the files for " << models[m] << endl;
+            exit(1);
+        }
+
+        GoldenOutputs legacy;
+        GoldenOutputs test;
+
+        test.n_index = -1;
+
+        GoldenLegacy( (TTree*) f_legacy.Get("gst"), f_xsec, f_flux, legacy );
+        GoldenEngine( engine, (TTree*) f_engine.Get("gst"), f_xsec, f_flux, n_threads, test );
+
+        report << " ------------------------- " << endl;
+        report << " " << models[m] << endl;
+        report << " ------------------------- " << endl;
+
+        int n_model = 0;
+
+        n_model += GoldenCompare( "norm", legacy.norm, test.norm, 0, norm_tol, report );
+        n_model += GoldenCompare( "n_cc_fsi", legacy.n_cc_fsi, test.n_cc_fsi, count_tol, 0, report );
+        n_model += GoldenCompare( "n_nc_fsi", legacy.n_nc_fsi, test.n_nc_fsi, count_tol, 0, report );
+        n_model += GoldenCompare( "n_cc_mc_fsi", legacy.n_cc_mc_fsi, test.n_cc_mc_fsi, count_tol, 0, report );
+        n_model += GoldenCompare( "n_nc_mc_fsi", legacy.n_nc_mc_fsi, test.n_nc_mc_fsi, count_tol, 0, report );
+
+        for( map< string, vector< double > >::const_iterator it = legacy.bins.begin(); it != legacy.bins.end(); ++it ){
+
+            map< string, vector< double > >::const_iterator it_test = test.bins.find( it->first );
+
+            if( it_test == test.bins.end() ){
+                report << " DIVERGED " << it->first << " : not filled by the engine " << endl;
+                ++n_model;
+                continue;
+            }
+
+            n_model += GoldenCompare( it->first, it->second, it_test->second, 0, bin_tol, report );
+        }
+
+        // The mixed batch of the flat_hist and jit engines uses the index
+        if( test.n_index >= 0 ){
+            report << " Entries read : " << test.n_read << " of " << test.n_entries
+                   << ", " << test.n_index << " in the index" << endl;
+
+            if( test.n_read > test.n_index ){
+                report << " DIVERGED entries read : the index of the distributions was not used " << endl;
+                ++n_model;
+            }
+        }
+
+        report << " " << n_model << " divergences " << endl;
+        cout << " " << models[m] << " : " << n_model << " divergences " << endl;
+
+        n_diverged += n_model;
+    }
+
+    report << " ------------------------- " << endl;
+    report << " Total : " << n_diverged << " divergences " << endl;
+
+    cout << " Total : " << n_diverged << " divergences, see golden_comparison_report.txt " << endl;
+
+    return n_diverged;
+}
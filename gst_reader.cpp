@@ -0,0 +1,670 @@
+/*
+ * Shared helpers for reading the GENIE gst trees
+ *
+ * See gst_reader.h for the description of each function
+ *
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include "TSystem.h"
+#include "TFriendElement.h"
+#include "TList.h"
+#include "TBasket.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+//                     The readers for each open gst tree
+// -------------------------------------------------------------------------
+static map< TTree*, GstReader* > gst_readers;
+
+// -------------------------------------------------------------------------
+// The Draw expressions held by the columns of the derived variables,
+// written without spaces or enclosing parentheses
+// -------------------------------------------------------------------------
+const int n_gst_derived_columns = 2;
+
+const char* gst_derived_expressions[n_gst_derived_columns] = { "sumKEf/nfp", "nfp+nfn" };
+const char* gst_derived_columns[n_gst_derived_columns]     = { "avg_KE_p",   "n_nucleons" };
+
+// The thread budget set by SetGstThreads
+static unsigned int gst_threads = 0;
+
+// Whether every reader keeps per-branch I/O statistics, with SBND_IO_STATS=1 in the environment
+static bool gst_io_stats = getenv( "SBND_IO_STATS" ) && string( getenv( "SBND_IO_STATS" ) ) == "1";
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          input file location
+// -------------------------------------------------------------------------
+string InputPath( const char* hepstore_path ){
+
+    string path   = hepstore_path;
+    string prefix = "/hepstore/rjones";
+
+    const char* input_dir = getenv( "SBND_INPUT_DIR" );
+
+    if( !input_dir || path.compare( 0, prefix.size(), prefix ) != 0 ) return path;
+
+    return string( input_dir ) + path.substr( prefix.size() );
+}
+
+// -------------------------------------------------------------------------
+//                      source of the sidecar files
+// -------------------------------------------------------------------------
+string GstSourceStamp( TTree *event_tree ){
+
+    TFile *gst_file = event_tree->GetCurrentFile();
+    if( !gst_file ) return "";
+
+    FileStat_t stat;
+    Long64_t size  = 0;
+    Long_t   mtime = 0;
+
+    if( gSystem->GetPathInfo( gst_file->GetName(), stat ) == 0 ){
+        size  = stat.fSize;
+        mtime = stat.fMtime;
+    }
+
+    return to_string( event_tree->GetEntries() ) + " " + to_string( size ) + " "
+         + to_string( mtime ) + " " + gst_file->GetUUID().AsString();
+}
+
+// -------------------------------------------------------------------------
+//                      derived variables file location
+// -------------------------------------------------------------------------
+string GstDerivedPath( const string &gst_path ){
+
+    string path = gst_path;
+
+    if( path.size() > 5 && path.compare( path.size() - 5, 5, ".root" ) == 0 ){
+        path.erase( path.size() - 5 );
+    }
+    path += ".derived.root";
+
+    const char* derived_dir = getenv( "SBND_DERIVED_DIR" );
+
+    if( !derived_dir ) return path;
+
+    for( unsigned int i = 0; i < path.size(); ++i ){
+        if( path[i] == '/' ) path[i] = '_';
+    }
+
+    return string( derived_dir ) + "/" + path;
+}
+
+// -------------------------------------------------------------------------
+//                      attach the derived variables
+// -------------------------------------------------------------------------
+bool AttachGstDerived( TTree *event_tree ){
+
+    if( event_tree->GetFriend( kGstDerivedTree ) ) return true;
+
+    TFile *gst_file = event_tree->GetCurrentFile();
+    if( !gst_file ) return false;
+
+    string gst_path     = gst_file->GetName();
+    string derived_path = GstDerivedPath( gst_path );
+
+    FileStat_t gst_stat, derived_stat;
+    if( gSystem->GetPathInfo( derived_path.c_str(), derived_stat ) != 0 ) return false;
+
+    // A file older than the gst file was written for an earlier sample
+    if( gSystem->GetPathInfo( gst_path.c_str(), gst_stat ) == 0 && derived_stat.fMtime < gst_stat.fMtime ){
+        cout << " The derived variables in " << derived_path << " are older than the gst file and are not used " << endl;
+        return false;
+    }
+
+    TFriendElement *element = event_tree->AddFriend( kGstDerivedTree, derived_path.c_str() );
+    TTree *derived = element ? element->GetTree() : 0;
+
+    if( !derived
+        || derived->GetEntries() != event_tree->GetEntries()
+        || string( derived->GetTitle() ) != kGstDerivedVersion ){
+
+        cout << " The derived variables in " << derived_path << " do not match the gst tree and are not used " << endl;
+
+        if( element ){
+            event_tree->GetListOfFriends()->Remove( element );
+            delete element;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------
+//                      derived column of an expression
+// -------------------------------------------------------------------------
+string GstDerivedColumn( TTree *event_tree,
+                         const string &expression ){
+
+    if( !event_tree->GetFriend( kGstDerivedTree ) ) return expression;
+
+    string bare;
+    for( unsigned int i = 0; i < expression.size(); ++i ){
+        if( expression[i] != ' ' ) bare += expression[i];
+    }
+
+    // Strip parentheses which enclose the whole expression, not (a)+(b)
+    while( bare.size() > 1 && bare[0] == '(' && bare[bare.size() - 1] == ')' ){
+
+        int  depth     = 0;
+        bool enclosing = true;
+        for( unsigned int i = 0; i + 1 < bare.size(); ++i ){
+            if( bare[i] == '(' ) ++depth;
+            if( bare[i] == ')' ) --depth;
+            if( depth == 0 ){
+                enclosing = false;
+                break;
+            }
+        }
+
+        if( !enclosing ) break;
+        bare = bare.substr( 1, bare.size() - 2 );
+    }
+
+    for( int i = 0; i < n_gst_derived_columns; ++i ){
+        if( bare == gst_derived_expressions[i] ) return gst_derived_columns[i];
+    }
+
+    return expression;
+}
+
+// -------------------------------------------------------------------------
+//                          gst tree branches
+// -------------------------------------------------------------------------
+void BranchGstEvent( TTree *event_tree,
+                     GstEvent &event ){
+
+    event_tree->Branch( "iev",     &event.iev,     "iev/I" );
+    event_tree->Branch( "neu",     &event.neu,     "neu/I" );
+    event_tree->Branch( "fspl",    &event.fspl,    "fspl/I" );
+    event_tree->Branch( "tgt",     &event.tgt,     "tgt/I" );
+    event_tree->Branch( "hitnuc",  &event.hitnuc,  "hitnuc/I" );
+    event_tree->Branch( "qel",     &event.qel,     "qel/O" );
+    event_tree->Branch( "mec",     &event.mec,     "mec/O" );
+    event_tree->Branch( "res",     &event.res,     "res/O" );
+    event_tree->Branch( "dis",     &event.dis,     "dis/O" );
+    event_tree->Branch( "coh",     &event.coh,     "coh/O" );
+    event_tree->Branch( "cc",      &event.cc,      "cc/O" );
+    event_tree->Branch( "nc",      &event.nc,      "nc/O" );
+    event_tree->Branch( "wght",    &event.wght,    "wght/D" );
+    event_tree->Branch( "x",       &event.x,       "x/D" );
+    event_tree->Branch( "y",       &event.y,       "y/D" );
+    event_tree->Branch( "W",       &event.W,       "W/D" );
+    event_tree->Branch( "Q2",      &event.Q2,      "Q2/D" );
+    event_tree->Branch( "xs",      &event.xs,      "xs/D" );
+    event_tree->Branch( "ys",      &event.ys,      "ys/D" );
+    event_tree->Branch( "Ws",      &event.Ws,      "Ws/D" );
+    event_tree->Branch( "Q2s",     &event.Q2s,     "Q2s/D" );
+    event_tree->Branch( "Ev",      &event.Ev,      "Ev/D" );
+    event_tree->Branch( "EvRF",    &event.EvRF,    "EvRF/D" );
+    event_tree->Branch( "El",      &event.El,      "El/D" );
+    event_tree->Branch( "pxl",     &event.pxl,     "pxl/D" );
+    event_tree->Branch( "pyl",     &event.pyl,     "pyl/D" );
+    event_tree->Branch( "pzl",     &event.pzl,     "pzl/D" );
+    event_tree->Branch( "pl",      &event.pl,      "pl/D" );
+    event_tree->Branch( "cthl",    &event.cthl,    "cthl/D" );
+    event_tree->Branch( "nfp",     &event.nfp,     "nfp/I" );
+    event_tree->Branch( "nfn",     &event.nfn,     "nfn/I" );
+    event_tree->Branch( "nfpip",   &event.nfpip,   "nfpip/I" );
+    event_tree->Branch( "nfpim",   &event.nfpim,   "nfpim/I" );
+    event_tree->Branch( "nfpi0",   &event.nfpi0,   "nfpi0/I" );
+    event_tree->Branch( "nfkp",    &event.nfkp,    "nfkp/I" );
+    event_tree->Branch( "nfkm",    &event.nfkm,    "nfkm/I" );
+    event_tree->Branch( "nfk0",    &event.nfk0,    "nfk0/I" );
+    event_tree->Branch( "nfem",    &event.nfem,    "nfem/I" );
+    event_tree->Branch( "nfother", &event.nfother, "nfother/I" );
+    event_tree->Branch( "sumKEf",  &event.sumKEf,  "sumKEf/D" );
+    event_tree->Branch( "nf",      &event.nf,      "nf/I" );
+    event_tree->Branch( "pdgf",    event.pdgf,     "pdgf[nf]/I" );
+    event_tree->Branch( "Ef",      event.Ef,       "Ef[nf]/D" );
+    event_tree->Branch( "pxf",     event.pxf,      "pxf[nf]/D" );
+    event_tree->Branch( "pyf",     event.pyf,      "pyf[nf]/D" );
+    event_tree->Branch( "pzf",     event.pzf,      "pzf[nf]/D" );
+    event_tree->Branch( "pf",      event.pf,       "pf[nf]/D" );
+    event_tree->Branch( "cthf",    event.cthf,     "cthf[nf]/D" );
+}
+
+// -------------------------------------------------------------------------
+//                          gst event fields
+// -------------------------------------------------------------------------
+void *GstEventField( GstEvent &event,
+                     const string &name,
+                     bool &is_array ){
+
+    is_array = false;
+
+    if( name == "iev" )     return &event.iev;
+    if( name == "neu" )     return &event.neu;
+    if( name == "fspl" )    return &event.fspl;
+    if( name == "tgt" )     return &event.tgt;
+    if( name == "hitnuc" )  return &event.hitnuc;
+    if( name == "qel" )     return &event.qel;
+    if( name == "mec" )     return &event.mec;
+    if( name == "res" )     return &event.res;
+    if( name == "dis" )     return &event.dis;
+    if( name == "coh" )     return &event.coh;
+    if( name == "cc" )      return &event.cc;
+    if( name == "nc" )      return &event.nc;
+    if( name == "wght" )    return &event.wght;
+    if( name == "x" )       return &event.x;
+    if( name == "y" )       return &event.y;
+    if( name == "W" )       return &event.W;
+    if( name == "Q2" )      return &event.Q2;
+    if( name == "xs" )      return &event.xs;
+    if( name == "ys" )      return &event.ys;
+    if( name == "Ws" )      return &event.Ws;
+    if( name == "Q2s" )     return &event.Q2s;
+    if( name == "Ev" )      return &event.Ev;
+    if( name == "EvRF" )    return &event.EvRF;
+    if( name == "El" )      return &event.El;
+    if( name == "pxl" )     return &event.pxl;
+    if( name == "pyl" )     return &event.pyl;
+    if( name == "pzl" )     return &event.pzl;
+    if( name == "pl" )      return &event.pl;
+    if( name == "cthl" )    return &event.cthl;
+    if( name == "nfp" )     return &event.nfp;
+    if( name == "nfn" )     return &event.nfn;
+    if( name == "nfpip" )   return &event.nfpip;
+    if( name == "nfpim" )   return &event.nfpim;
+    if( name == "nfpi0" )   return &event.nfpi0;
+    if( name == "nfkp" )    return &event.nfkp;
+    if( name == "nfkm" )    return &event.nfkm;
+    if( name == "nfk0" )    return &event.nfk0;
+    if( name == "nfem" )    return &event.nfem;
+    if( name == "nfother" ) return &event.nfother;
+    if( name == "sumKEf" )  return &event.sumKEf;
+    if( name == "nf" )      return &event.nf;
+
+    is_array = true;
+
+    if( name == "pdgf" )    return event.pdgf;
+    if( name == "Ef" )      return event.Ef;
+    if( name == "pxf" )     return event.pxf;
+    if( name == "pyf" )     return event.pyf;
+    if( name == "pzf" )     return event.pzf;
+    if( name == "pf" )      return event.pf;
+    if( name == "cthf" )    return event.cthf;
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------
+//                          gst thread budget
+// -------------------------------------------------------------------------
+void SetGstThreads( unsigned int n_threads ){
+
+    gst_threads = n_threads;
+
+    if( n_threads < 2 ){
+        if( ROOT::IsImplicitMTEnabled() ) ROOT::DisableImplicitMT();
+        TTreeCacheUnzip::SetParallelUnzip( TTreeCacheUnzip::kDisable );
+        return;
+    }
+
+    if( !ROOT::IsImplicitMTEnabled() ) ROOT::EnableImplicitMT( n_threads );
+
+    // The pool keeps the size it was first created with
+    if( ROOT::GetThreadPoolSize() != n_threads ){
+        cout << " ROOT is already running with " << ROOT::GetThreadPoolSize()
+             << " threads, " << n_threads << " were requested " << endl;
+        gst_threads = ROOT::GetThreadPoolSize();
+    }
+
+    TTreeCacheUnzip::SetParallelUnzip( TTreeCacheUnzip::kEnable );
+}
+
+// -------------------------------------------------------------------------
+//                     current gst thread budget
+// -------------------------------------------------------------------------
+unsigned int GstThreads(){
+
+    return gst_threads;
+}
+
+// -------------------------------------------------------------------------
+//                  dimensions of a Draw expression
+// -------------------------------------------------------------------------
+void GstFillDimensions( const string &fill,
+                        vector< string > &dims ){
+
+    dims.clear();
+
+    // Split on ':' but not on the '::' of a scope
+    size_t start = 0;
+    for( size_t pos = 0; pos <= fill.size(); ++pos ){
+        if( pos == fill.size()
+            || ( fill[pos] == ':'
+                 && ( pos + 1 >= fill.size() || fill[pos + 1] != ':' )
+                 && ( pos == 0 || fill[pos - 1] != ':' ) ) ){
+            dims.push_back( fill.substr( start, pos - start ) );
+            start = pos + 1;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+//                  branches needed by the planned fills
+// -------------------------------------------------------------------------
+void GstBranchesFor( TTree *event_tree,
+                     const vector< string > &planned_fills,
+                     s_branches &branches ){
+
+    for( unsigned int i = 0; i < planned_fills.size(); ++i ){
+
+        // Drop the target histogram from a Draw expression
+        string fill = planned_fills[i].substr( 0, planned_fills[i].find(">>") );
+
+        // Each dimension of "y:x" is compiled separately
+        vector< string > dims;
+        GstFillDimensions( fill, dims );
+
+        for( unsigned int j = 0; j < dims.size(); ++j ){
+
+            if( dims[j].find_first_not_of(" ") == string::npos ) continue;
+
+            TTreeFormula formula( "planned_fill", dims[j].c_str(), event_tree );
+
+            if( formula.GetNdim() == 0 ){
+                cerr << " Could not compile the planned fill : " << dims[j] << endl;
+                exit(1);
+            }
+
+            for( int k = 0; k < formula.GetNcodes(); ++k ){
+
+                TLeaf *leaf = formula.GetLeaf(k);
+                if( !leaf ) continue;
+
+                branches.insert( leaf->GetBranch()->GetName() );
+
+                // Variable-length arrays also need their counter
+                if( leaf->GetLeafCount() ){
+                    branches.insert( leaf->GetLeafCount()->GetBranch()->GetName() );
+                }
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          TTreeCache size
+// -------------------------------------------------------------------------
+Long64_t GstCacheSize( TTree *event_tree,
+                       const s_branches &branches,
+                       Long64_t max_cache ){
+
+    Long64_t min_cache = 1000000; // 1 MB
+    Long64_t n_entries = event_tree->GetEntries();
+    Long64_t auto_flush = event_tree->GetAutoFlush();
+
+    // Compressed size of the enabled branches over the whole tree
+    double zip_bytes = 0;
+    for( s_branches::const_iterator it = branches.begin(); it != branches.end(); ++it ){
+        TBranch *b = event_tree->GetBranch( it->c_str() );
+        if( b ) zip_bytes += b->GetZipBytes();
+    }
+
+    // One cluster of the enabled branches
+    //      auto_flush > 0 : the cluster size in entries
+    //      auto_flush < 0 : the cluster size in bytes of the whole tree
+    double cache = zip_bytes;
+    if( auto_flush > 0 && n_entries > auto_flush ){
+        cache = zip_bytes * double( auto_flush ) / double( n_entries );
+    }
+    else if( auto_flush < 0 && event_tree->GetZipBytes() > 0 ){
+        cache = double( -auto_flush ) * zip_bytes / double( event_tree->GetZipBytes() );
+    }
+
+    // Leave room for baskets which straddle the cluster boundaries
+    cache *= 1.2;
+
+    if( cache < min_cache ) cache = min_cache;
+    if( cache > max_cache ) cache = max_cache;
+
+    return Long64_t( cache );
+}
+
+// -------------------------------------------------------------------------
+//                          Open a gst reader
+// -------------------------------------------------------------------------
+void OpenGstReader( TTree *event_tree,
+                    const vector< string > &planned_fills,
+                    bool collect_stats ){
+
+    if( !event_tree ){
+        cerr << " The gst tree could not be found " << endl;
+        exit(1);
+    }
+
+    CloseGstReader( event_tree );
+
+    AttachGstDerived( event_tree );
+
+    s_branches branches;
+    GstBranchesFor( event_tree, planned_fills, branches );
+
+    // Only read the branches which are needed
+    event_tree->SetBranchStatus( "*", 0 );
+    for( s_branches::const_iterator it = branches.begin(); it != branches.end(); ++it ){
+        event_tree->SetBranchStatus( it->c_str(), 1 );
+    }
+
+    // Size the cache for them and skip the learning phase
+    GstReader *reader = new GstReader;
+    reader->tree       = event_tree;
+    reader->perf_stats = 0;
+    reader->cache_size = GstCacheSize( event_tree, branches );
+    reader->n_threads  = gst_threads;
+    reader->n_branches = branches.size();
+
+    // Read the branches of each entry in parallel
+    event_tree->SetImplicitMT( gst_threads > 1 );
+
+    event_tree->SetCacheSize( reader->cache_size );
+    // The derived variables are read from their own file, outside this cache
+    for( s_branches::const_iterator it = branches.begin(); it != branches.end(); ++it ){
+        if( event_tree->GetListOfBranches()->FindObject( it->c_str() ) ){
+            event_tree->AddBranchToCache( it->c_str(), kFALSE );
+        }
+    }
+    event_tree->StopCacheLearningPhase();
+
+    // The totals are cheap, the statistics of each branch are not
+    reader->perf_stats = new TTreePerfStats( "gst_perf_stats", event_tree );
+
+    if( collect_stats || gst_io_stats ){
+        for( s_branches::const_iterator it = branches.begin(); it != branches.end(); ++it ){
+            GstBranchIO io;
+            io.name           = *it;
+            io.branch         = event_tree->GetBranch( it->c_str() );
+            io.bytes_read     = 0;
+            io.zip_bytes_read = 0;
+            io.read_calls     = 0;
+            io.entries_read   = 0;
+            io.read_time      = 0;
+            io.load_time      = 0;
+            io.last_basket    = -1;
+            reader->branches.push_back( io );
+        }
+    }
+
+    gst_readers[event_tree] = reader;
+}
+
+// -------------------------------------------------------------------------
+//                          Find a gst reader
+// -------------------------------------------------------------------------
+GstReader *GstReaderFor( TTree *event_tree ){
+
+    map< TTree*, GstReader* >::iterator it = gst_readers.find( event_tree );
+
+    if( it == gst_readers.end() ) return 0;
+
+    return it->second;
+}
+
+// -------------------------------------------------------------------------
+//                          Read a gst entry
+// -------------------------------------------------------------------------
+Int_t ReadGstEntry( TTree *event_tree,
+                    Long64_t entry ){
+
+    GstReader *reader = GstReaderFor( event_tree );
+
+    if( !reader || reader->branches.empty() ){
+        return event_tree->GetEntry( entry );
+    }
+
+    // With implicit MT let ROOT read the branches together, and only
+    // count the baskets which were loaded for each branch
+    if( reader->n_threads > 1 ){
+
+        Int_t n_bytes = event_tree->GetEntry( entry );
+
+        for( unsigned int i = 0; i < reader->branches.size(); ++i ){
+
+            GstBranchIO &io = reader->branches[i];
+            ++io.entries_read;
+
+            // The bytes of each entry are only known for the whole tree,
+            // so those of the branch are those of the baskets it unzipped
+            Int_t basket = io.branch->GetReadBasket();
+            if( basket != io.last_basket ){
+                io.last_basket = basket;
+                if( basket >= 0 ){
+                    TBasket *loaded = io.branch->GetBasket( basket );
+                    io.zip_bytes_read += io.branch->GetBasketBytes()[basket];
+                    if( loaded ) io.bytes_read += loaded->GetObjlen();
+                }
+                ++io.read_calls;
+            }
+        }
+
+        return n_bytes;
+    }
+
+    typedef chrono::steady_clock read_clock;
+
+    // Let the cache know where we are
+    event_tree->LoadTree( entry );
+
+    Int_t n_bytes = 0;
+
+    for( unsigned int i = 0; i < reader->branches.size(); ++i ){
+
+        GstBranchIO &io = reader->branches[i];
+
+        read_clock::time_point start = read_clock::now();
+        Int_t bytes = io.branch->GetEntry( entry );
+        double time = chrono::duration< double >( read_clock::now() - start ).count();
+
+        n_bytes         += bytes;
+        io.bytes_read   += bytes;
+        io.read_time    += time;
+        ++io.entries_read;
+
+        // A new basket has been loaded
+        Int_t basket = io.branch->GetReadBasket();
+        if( basket != io.last_basket ){
+            io.last_basket     = basket;
+            if( basket >= 0 ) io.zip_bytes_read += io.branch->GetBasketBytes()[basket];
+            io.load_time      += time;
+            ++io.read_calls;
+        }
+    }
+
+    return n_bytes;
+}
+
+// -------------------------------------------------------------------------
+//                          Write the I/O report
+// -------------------------------------------------------------------------
+void GstIOReport( TTree *event_tree,
+                  const char* model,
+                  ostream &file ){
+
+    GstReader *reader = GstReaderFor( event_tree );
+
+    file << " ------------------------- " << endl;
+    file << " I/O : " << model << endl;
+    file << " ------------------------- " << endl;
+
+    if( !reader ){
+        file << " No reader was opened for this tree " << endl;
+        return;
+    }
+
+    file << " Cache size (bytes)  : " << reader->cache_size << endl;
+    file << " Enabled branches    : " << reader->n_branches << endl;
+    file << " Read threads        : " << ( reader->n_threads > 1 ? reader->n_threads : 1 ) << endl;
+
+    reader->perf_stats->Finish();
+
+    file << setprecision(5) << " Bytes read          : " << reader->perf_stats->GetBytesRead() << endl;
+    file << setprecision(5) << " Read calls          : " << reader->perf_stats->GetReadCalls() << endl;
+    file << setprecision(5) << " Unzip time (s)      : " << reader->perf_stats->GetUnzipTime() << endl;
+    file << setprecision(5) << " Disk time (s)       : " << reader->perf_stats->GetDiskTime() << endl;
+    file << setprecision(5) << " Real time (s)       : " << reader->perf_stats->GetRealTime() << endl;
+    file << " ------------------------- " << endl;
+
+    if( reader->branches.empty() ){
+        file << " No per-branch statistics were collected, set SBND_IO_STATS=1 " << endl;
+        file << " ------------------------- " << endl;
+        return;
+    }
+
+    if( reader->n_threads > 1 ){
+        file << " Branches are read in parallel, the bytes are those of " << endl;
+        file << " the baskets loaded and the times are not kept " << endl;
+    }
+    file << setw(10) << " Branch "
+         << setw(14) << " Bytes "
+         << setw(14) << " Zip bytes "
+         << setw(10) << " Calls "
+         << setw(12) << " Load (s) "
+         << setw(12) << " Read (s) " << endl;
+
+    for( unsigned int i = 0; i < reader->branches.size(); ++i ){
+
+        const GstBranchIO &io = reader->branches[i];
+
+        file << setw(10) << io.name
+             << setw(14) << io.bytes_read
+             << setw(14) << io.zip_bytes_read
+             << setw(10) << io.read_calls
+             << setw(12) << setprecision(4) << io.load_time
+             << setw(12) << setprecision(4) << io.read_time << endl;
+    }
+    file << " ------------------------- " << endl;
+}
+
+// -------------------------------------------------------------------------
+//                          Close a gst reader
+// -------------------------------------------------------------------------
+void CloseGstReader( TTree *event_tree ){
+
+    GstReader *reader = GstReaderFor( event_tree );
+
+    if( !reader ) return;
+
+    if( reader->perf_stats ){
+        event_tree->SetPerfStats( 0 );
+        delete reader->perf_stats;
+    }
+
+    delete reader;
+    gst_readers.erase( event_tree );
+}
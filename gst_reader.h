@@ -0,0 +1,312 @@
+/*
+ * Shared helpers for reading the GENIE gst trees
+ *
+ * The model comparison macros all read the same gst branches from
+ * files which live on the networked /hepstore area. These helpers
+ * restrict each tree to the branches the macro actually fills from,
+ * size the TTreeCache for those branches and keep the I/O statistics
+ * which are written to the run summary
+ *
+ * With a thread budget set by SetGstThreads, ROOT implicit multithreading
+ * reads the branches of each entry in parallel and the baskets are
+ * unzipped ahead of the event loop by the TTreeCacheUnzip
+ *
+ * Loaded with the other shared modules before the macros which use it:
+ *      root -l -b -q load_modules.cpp model_comparisons.cpp+
+ *
+*/
+
+#ifndef GST_READER_H
+#define GST_READER_H
+
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <iostream>
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TTreeFormula.h"
+#include "TTreePerfStats.h"
+#include "TTreeCacheUnzip.h"
+#include "TROOT.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+//                          Typedefs
+// -------------------------------------------------------------------------
+
+typedef set< string > s_branches;
+
+// -------------------------------------------------------------------------
+// The largest number of final state particles in a gst entry, as in GENIE
+// -------------------------------------------------------------------------
+const int kGstMaxParticles = 250;
+
+// -------------------------------------------------------------------------
+// The gst branches used by the macros, with the names and types of the
+// GENIE gst summary tree
+//      qel, mec, res, dis, coh, cc, nc : interaction flags
+//      Ev, El, pl, cthl, Q2, ys, EvRF  : neutrino and lepton kinematics
+//      nfp, nfn, nfpip, nfpim, nfpi0   : final state multiplicities
+//      sumKEf                          : summed kinetic energy of the final
+//                                        state hadrons
+//      nf, pdgf, Ef, pf, cthf, ...     : the final state particles
+// -------------------------------------------------------------------------
+struct GstEvent {
+    Int_t    iev;
+    Int_t    neu;
+    Int_t    fspl;
+    Int_t    tgt;
+    Int_t    hitnuc;
+    Bool_t   qel;
+    Bool_t   mec;
+    Bool_t   res;
+    Bool_t   dis;
+    Bool_t   coh;
+    Bool_t   cc;
+    Bool_t   nc;
+    Double_t wght;
+    Double_t x;
+    Double_t y;
+    Double_t W;
+    Double_t Q2;
+    Double_t xs;
+    Double_t ys;
+    Double_t Ws;
+    Double_t Q2s;
+    Double_t Ev;
+    Double_t EvRF;
+    Double_t El;
+    Double_t pxl;
+    Double_t pyl;
+    Double_t pzl;
+    Double_t pl;
+    Double_t cthl;
+    Int_t    nfp;
+    Int_t    nfn;
+    Int_t    nfpip;
+    Int_t    nfpim;
+    Int_t    nfpi0;
+    Int_t    nfkp;
+    Int_t    nfkm;
+    Int_t    nfk0;
+    Int_t    nfem;
+    Int_t    nfother;
+    Double_t sumKEf;
+    Int_t    nf;
+    Int_t    pdgf[kGstMaxParticles];
+    Double_t Ef[kGstMaxParticles];
+    Double_t pxf[kGstMaxParticles];
+    Double_t pyf[kGstMaxParticles];
+    Double_t pzf[kGstMaxParticles];
+    Double_t pf[kGstMaxParticles];
+    Double_t cthf[kGstMaxParticles];
+};
+
+// -------------------------------------------------------------------------
+// The statistics kept for each enabled branch when entries are read
+// through ReadGstEntry:
+//      bytes_read     : uncompressed bytes returned by TBranch::GetEntry,
+//                       with implicit MT the uncompressed size of the
+//                       baskets which were loaded
+//      zip_bytes_read : compressed size of the baskets which were loaded
+//      read_calls     : the number of baskets loaded from the file
+//      entries_read   : the number of entries read
+//      read_time      : total time spent in TBranch::GetEntry (s)
+//      load_time      : time spent in the calls which loaded a new basket,
+//                       reading, unzipping and streaming it (s). The unzip
+//                       time alone is only known for the whole tree, from
+//                       the TTreePerfStats. Neither time is kept with
+//                       implicit MT
+// -------------------------------------------------------------------------
+struct GstBranchIO {
+    string   name;
+    TBranch *branch;
+    Long64_t bytes_read;
+    Long64_t zip_bytes_read;
+    Long64_t read_calls;
+    Long64_t entries_read;
+    double   read_time;
+    double   load_time;
+    Int_t    last_basket;
+};
+
+// -------------------------------------------------------------------------
+// The reader state kept for each gst tree opened with OpenGstReader
+//      perf_stats : the TTreePerfStats totals of the tree, always kept
+//      n_branches : the number of enabled branches
+//      branches   : the statistics of each of them, only if they are kept
+// -------------------------------------------------------------------------
+struct GstReader {
+    TTree                 *tree;
+    TTreePerfStats        *perf_stats;
+    Long64_t               cache_size;
+    unsigned int           n_threads;
+    unsigned int           n_branches;
+    vector< GstBranchIO >  branches;
+};
+
+// -------------------------------------------------------------------------
+// The location of an input file
+// The macros refer to their inputs by the /hepstore/rjones paths. If the
+// SBND_INPUT_DIR environment variable is set, /hepstore/rjones is replaced
+// by it, so the same layout written by make_synthetic_gst.cpp can be used
+// off-site
+// -------------------------------------------------------------------------
+string InputPath( const char* hepstore_path );
+
+// -------------------------------------------------------------------------
+// What the sidecar files of a gst tree record of the file they were made
+// from: the number of entries, size, modification time and UUID of the
+// current file of the tree, as a single string. A sidecar recording
+// anything else was made from another version of the file
+// -------------------------------------------------------------------------
+string GstSourceStamp( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// The friend tree of derived variables written by derived_tree.cpp
+//      kGstDerivedTree    : the name of the tree, and of the friend
+//      kGstDerivedVersion : the title it is written with, a friend with
+//                           another title is out of date and not attached
+// -------------------------------------------------------------------------
+const char* const kGstDerivedTree    = "gst_derived";
+const char* const kGstDerivedVersion = "gst derived variables v1";
+
+// -------------------------------------------------------------------------
+// The file the derived variables of a gst file are written to:
+//      path.derived.root next to the gst file, or below $SBND_DERIVED_DIR
+//      if it is set, with the / of the gst path replaced by _
+// -------------------------------------------------------------------------
+string GstDerivedPath( const string &gst_path );
+
+// -------------------------------------------------------------------------
+// Attach the derived variables of a gst tree as a friend, if they have been
+// written, are up to date with the gst file and have the same number of
+// entries. Returns whether the friend is attached
+// -------------------------------------------------------------------------
+bool AttachGstDerived( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// The derived column which holds a Draw expression, "(sumKEf/nfp)" gives
+// "avg_KE_p" for example, if the derived variables are attached to the
+// tree. Otherwise, or for any other expression, the expression itself
+// -------------------------------------------------------------------------
+string GstDerivedColumn( TTree *event_tree,
+                         const string &expression );
+
+// -------------------------------------------------------------------------
+// Create the branches of a new gst tree for the given event
+// -------------------------------------------------------------------------
+void BranchGstEvent( TTree *event_tree,
+                     GstEvent &event );
+
+// -------------------------------------------------------------------------
+// The address of the field of an event which holds the gst branch name,
+// or 0 if the branch is not one of the GstEvent fields. is_array is set
+// for the final state particle arrays
+// -------------------------------------------------------------------------
+void *GstEventField( GstEvent &event,
+                     const string &name,
+                     bool &is_array );
+
+// -------------------------------------------------------------------------
+// Set the number of threads used to read and unzip the gst trees
+//      n_threads < 2 : the trees are read on the calling thread (default)
+//      n_threads > 1 : ROOT implicit multithreading is enabled with a pool
+//                      of n_threads and the baskets are unzipped in parallel
+// This must be called before OpenGstReader, the analysis loops themselves
+// are unchanged. The size of ROOT's thread pool is fixed the first time
+// it is enabled, so later calls can only switch it off and on again
+// -------------------------------------------------------------------------
+void SetGstThreads( unsigned int n_threads );
+
+// -------------------------------------------------------------------------
+// The current thread budget for reading the gst trees
+// -------------------------------------------------------------------------
+unsigned int GstThreads();
+
+// -------------------------------------------------------------------------
+// Split a Draw variable expression into its dimensions, "y:x" gives
+// { "y", "x" } in the order written
+// -------------------------------------------------------------------------
+void GstFillDimensions( const string &fill,
+                        vector< string > &dims );
+
+// -------------------------------------------------------------------------
+// Find the branches needed to evaluate a set of planned fills
+// The expressions are those passed to TTree::Draw, either the variable
+// or the selection, for example:
+//      "sumKEf:nfp"
+//      "cc && (nfpip + nfpim + nfpi0 == 0)"
+// Anything after ">>" is ignored and the counter branches of any
+// variable-length arrays (nf for pdgf, pf, cthf, ...) are included
+// -------------------------------------------------------------------------
+void GstBranchesFor( TTree *event_tree,
+                     const vector< string > &planned_fills,
+                     s_branches &branches );
+
+// -------------------------------------------------------------------------
+// The TTreeCache size needed to hold one cluster of baskets for the
+// given branches, limited to lie between 1 MB and max_cache bytes
+// -------------------------------------------------------------------------
+Long64_t GstCacheSize( TTree *event_tree,
+                       const s_branches &branches,
+                       Long64_t max_cache = 256000000 );
+
+// -------------------------------------------------------------------------
+// Prepare a gst tree to be read:
+//      - the derived variables are attached with AttachGstDerived
+//      - only the branches needed by the planned fills are enabled
+//      - the TTreeCache is sized for and primed with those branches
+//      - a TTreePerfStats is attached for the totals of the I/O report,
+//        which only costs a counter update for each basket read
+//      - if collect_stats is set, or SBND_IO_STATS=1 is set in the
+//        environment, the per-branch statistics are also kept by
+//        ReadGstEntry. This times every branch of every entry, so it is
+//        off by default and the entries are then read whole by
+//        TTree::GetEntry
+// The reader is kept until CloseGstReader is called for the tree
+// -------------------------------------------------------------------------
+void OpenGstReader( TTree *event_tree,
+                    const vector< string > &planned_fills,
+                    bool collect_stats = false );
+
+// -------------------------------------------------------------------------
+// The reader for a tree, or 0 if OpenGstReader has not been called on it
+// -------------------------------------------------------------------------
+GstReader *GstReaderFor( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// Read an entry of a gst tree
+// For a tree opened with OpenGstReader the enabled branches are read one
+// by one so that the per-branch statistics can be kept, otherwise this
+// is the same as TTree::GetEntry
+// With implicit MT the branches are read together by TTree::GetEntry so
+// that ROOT can read them in parallel, only the basket reads are then
+// counted for each branch
+// -------------------------------------------------------------------------
+Int_t ReadGstEntry( TTree *event_tree,
+                    Long64_t entry );
+
+// -------------------------------------------------------------------------
+// Write the I/O statistics for a tree to the run summary:
+//      - the TTreePerfStats totals, including the reads made by TTree::Draw
+//      - if they were kept, the bytes read, basket load time and read calls
+//        of each branch
+// -------------------------------------------------------------------------
+void GstIOReport( TTree *event_tree,
+                  const char* model,
+                  ostream &file );
+
+// -------------------------------------------------------------------------
+// Detach the perf stats and forget the reader for a tree
+// -------------------------------------------------------------------------
+void CloseGstReader( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+
+#endif
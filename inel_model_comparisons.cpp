@@ -24,7 +24,7 @@
 
 using namespace std; 
 
-int inel_model_comparisons() {
+int inel_model_comparisons( unsigned int n_threads = 0 ) {
 
     // -------------------------------------------------------------------------
     // Normalisation:
@@ -59,7 +59,7 @@ int inel_model_comparisons() {
     //                              Open flux file
     // -------------------------------------------------------------------------
     
-    TFile f_flux("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root");
+    TFile f_flux( InputPath("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root").c_str() );
     if (f_flux.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -73,7 +73,7 @@ int inel_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Default
-    TFile f1_xsec("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root");
+    TFile f1_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root").c_str() );
     if (f1_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -83,7 +83,7 @@ int inel_model_comparisons() {
     }
     
     // Default+MEC
-    TFile f2_xsec("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root");
+    TFile f2_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root").c_str() );
     if (f2_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -93,7 +93,7 @@ int inel_model_comparisons() {
     }
     
     // G16_02b
-    TFile f3_xsec("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root");
+    TFile f3_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root").c_str() );
     if (f3_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -103,7 +103,7 @@ int inel_model_comparisons() {
     }
     
     // G16_01a
-    TFile f4_xsec("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root");
+    TFile f4_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root").c_str() );
     if (f4_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -113,7 +113,7 @@ int inel_model_comparisons() {
     }
     
     // G16_01b
-    TFile f5_xsec("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root");
+    TFile f5_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root").c_str() );
     if (f5_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -127,7 +127,7 @@ int inel_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Open Default
-    TFile f1("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root");
+    TFile f1( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f1.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -137,7 +137,7 @@ int inel_model_comparisons() {
     }
 
     // Open Default+MEC
-    TFile f2("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root");
+    TFile f2( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f2.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -147,7 +147,7 @@ int inel_model_comparisons() {
     }
 
     // Open G16_02b
-    TFile f3("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root");
+    TFile f3( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f3.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -157,7 +157,7 @@ int inel_model_comparisons() {
     }
 
     // Open G16_01a
-    TFile f4("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root");
+    TFile f4( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f4.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -167,7 +167,7 @@ int inel_model_comparisons() {
     }
 
     // Open G16_01b
-    TFile f5("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root");
+    TFile f5( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f5.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -186,6 +186,57 @@ int inel_model_comparisons() {
     TTree *gst3 = (TTree*) f3.Get("gst");
     TTree *gst4 = (TTree*) f4.Get("gst");
     TTree *gst5 = (TTree*) f5.Get("gst");
+
+    // -------------------------------------------------------------------------
+    //                      Book the fills of the histograms
+    // -------------------------------------------------------------------------
+    // The histograms of the plots below are booked here, and all of the
+    // fills of a model are then run in one pass by RunFlatBatch
+    FlatBatch batch;
+
+    // Ev_Inel CC0Pi
+    TH2D *h1_Ev_Inel_cc0pi = new TH2D("h1_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity Default, CC0#pi",40,0,2.5,40,0,1);
+    TH2D *h2_Ev_Inel_cc0pi = new TH2D("h2_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity Default+MEC, CC0#pi",40,0,2.5,40,0,1);
+    TH2D *h3_Ev_Inel_cc0pi = new TH2D("h3_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity G17_02b, CC0#pi",40,0,2.5,40,0,1);
+    TH2D *h4_Ev_Inel_cc0pi = new TH2D("h4_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity G17_01a, CC0#pi",40,0,2.5,40,0,1);
+    TH2D *h5_Ev_Inel_cc0pi = new TH2D("h5_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity G17_01b, CC0#pi",40,0,2.5,40,0,1);
+
+    FlatBook( batch, gst1, "ys:EvRF>>h1_Ev_Inel_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "ys:EvRF>>h2_Ev_Inel_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "ys:EvRF>>h3_Ev_Inel_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "ys:EvRF>>h4_Ev_Inel_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "ys:EvRF>>h5_Ev_Inel_cc0pi", kCC0Pi );
+
+    // Ev_Inel CC1Pi
+    TH2D *h1_Ev_Inel_cc1pi = new TH2D("h1_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity Default, CC1#pi",40,0,2.5,40,0,1);
+    TH2D *h2_Ev_Inel_cc1pi = new TH2D("h2_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity Default+MEC, CC1#pi",40,0,2.5,40,0,1);
+    TH2D *h3_Ev_Inel_cc1pi = new TH2D("h3_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity G17_02b, CC1#pi",40,0,2.5,40,0,1);
+    TH2D *h4_Ev_Inel_cc1pi = new TH2D("h4_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity G17_01a, CC1#pi",40,0,2.5,40,0,1);
+    TH2D *h5_Ev_Inel_cc1pi = new TH2D("h5_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity G17_01b, CC1#pi",40,0,2.5,40,0,1);
+
+    FlatBook( batch, gst1, "ys:EvRF>>h1_Ev_Inel_cc1pi", kCC1Pi );
+    FlatBook( batch, gst2, "ys:EvRF>>h2_Ev_Inel_cc1pi", kCC1Pi );
+    FlatBook( batch, gst3, "ys:EvRF>>h3_Ev_Inel_cc1pi", kCC1Pi );
+    FlatBook( batch, gst4, "ys:EvRF>>h4_Ev_Inel_cc1pi", kCC1Pi );
+    FlatBook( batch, gst5, "ys:EvRF>>h5_Ev_Inel_cc1pi", kCC1Pi );
+
+    // -------------------------------------------------------------------------
+    //                     Set up the reads of the gst trees
+    // -------------------------------------------------------------------------
+    // Only the branches needed by the fills are read from the files
+    // With n_threads > 1 the branches are read and unzipped in parallel
+    vector< string > planned_fills;
+
+    // Those of the histograms booked above
+    FlatBatchExpressions( batch, planned_fills );
+
+    SetGstThreads( n_threads );
+
+    OpenGstReader( gst1, planned_fills );
+    OpenGstReader( gst2, planned_fills );
+    OpenGstReader( gst3, planned_fills );
+    OpenGstReader( gst4, planned_fills );
+    OpenGstReader( gst5, planned_fills );
    
     // -------------------------------------------------------------------------
     //                          Get the normalisations
@@ -198,6 +249,17 @@ int inel_model_comparisons() {
     norms.push_back( Norm(1000000, f4_xsec, f_flux) );
     norms.push_back( Norm(1000000, f5_xsec, f_flux) );
     
+    // -------------------------------------------------------------------------
+    //                      Fill the histograms of each model
+    // -------------------------------------------------------------------------
+    // Each histogram is split by interaction channel in the same pass, and
+    // the channels are written to inel_model_comparisons_channels.root
+    RunFlatBatch( batch );
+
+    TFile f_channels( "inel_model_comparisons_channels.root", "RECREATE" );
+    WriteFlatBatchChannels( batch, &f_channels );
+    f_channels.Close();
+
     // -------------------------------------------------------------------------
     //                          Canvases and histograms
     // -------------------------------------------------------------------------
@@ -217,8 +279,7 @@ int inel_model_comparisons() {
     // The Canvases and histograms for np vs KESum
     // Default
     TCanvas *c1_Ev_Inel_0Pi_CC = new TCanvas("c1_Ev_Inel_0Pi_CC","Default",800,600);
-    TH2D *h1_Ev_Inel_cc0pi = new TH2D("h1_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity Default, CC0#pi",40,0,2.5,40,0,1);
-    gst1->Draw("ys:EvRF>>h1_Ev_Inel_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h1_Ev_Inel_cc0pi->Draw("colz");
     
     h1_Ev_Inel_cc0pi->GetXaxis()->SetTitle("E_{#nu}");
     h1_Ev_Inel_cc0pi->GetYaxis()->SetTitle("Inelasticity");
@@ -229,8 +290,7 @@ int inel_model_comparisons() {
 
     // Default+MEC
     TCanvas *c2_Ev_Inel_0Pi_CC = new TCanvas("c2_Ev_Inel_0Pi_CC","Default+MEC",800,600);
-    TH2D *h2_Ev_Inel_cc0pi = new TH2D("h2_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity Default+MEC, CC0#pi",40,0,2.5,40,0,1);
-    gst2->Draw("ys:EvRF>>h2_Ev_Inel_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h2_Ev_Inel_cc0pi->Draw("colz");
     
     h2_Ev_Inel_cc0pi->GetXaxis()->SetTitle("E_{#nu}");
     h2_Ev_Inel_cc0pi->GetYaxis()->SetTitle("Inelasticity");  
@@ -241,8 +301,7 @@ int inel_model_comparisons() {
 
     // G16_02b
     TCanvas *c3_Ev_Inel_0Pi_CC = new TCanvas("c3_Ev_Inel_0Pi_CC","G17_02b",800,600);
-    TH2D *h3_Ev_Inel_cc0pi = new TH2D("h3_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity G17_02b, CC0#pi",40,0,2.5,40,0,1);
-    gst3->Draw("ys:EvRF>>h3_Ev_Inel_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h3_Ev_Inel_cc0pi->Draw("colz");
 
     h3_Ev_Inel_cc0pi->GetXaxis()->SetTitle("E_{#nu}");
     h3_Ev_Inel_cc0pi->GetYaxis()->SetTitle("Inelasticity");
@@ -254,8 +313,7 @@ int inel_model_comparisons() {
 
     // G16_01a
     TCanvas *c4_Ev_Inel_0Pi_CC = new TCanvas("c4_Ev_Inel_0Pi_CC","G17_01a",800,600);
-    TH2D *h4_Ev_Inel_cc0pi = new TH2D("h4_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity G17_01a, CC0#pi",40,0,2.5,40,0,1);
-    gst4->Draw("ys:EvRF>>h4_Ev_Inel_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h4_Ev_Inel_cc0pi->Draw("colz");
     
     h4_Ev_Inel_cc0pi->GetXaxis()->SetTitle("E_{#nu}");
     h4_Ev_Inel_cc0pi->GetYaxis()->SetTitle("Inelasticity");
@@ -267,8 +325,7 @@ int inel_model_comparisons() {
 
     // G17_01b
     TCanvas *c5_Ev_Inel_0Pi_CC = new TCanvas("c5_Ev_Inel_0Pi_CC","G17_01b",800,600);
-    TH2D *h5_Ev_Inel_cc0pi = new TH2D("h5_Ev_Inel_cc0pi","E_{#nu} vs Inelasticity G17_01b, CC0#pi",40,0,2.5,40,0,1);
-    gst5->Draw("ys:EvRF>>h5_Ev_Inel_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h5_Ev_Inel_cc0pi->Draw("colz");
 
     h5_Ev_Inel_cc0pi->GetXaxis()->SetTitle("E_{#nu}");
     h5_Ev_Inel_cc0pi->GetYaxis()->SetTitle("Inelasticity");
@@ -297,8 +354,7 @@ int inel_model_comparisons() {
     // The Canvases and histograms for np vs KESum
     // Default
     TCanvas *c1_Ev_Inel_1Pi_CC = new TCanvas("c1_Ev_Inel_1Pi_CC","Default",800,600);
-    TH2D *h1_Ev_Inel_cc1pi = new TH2D("h1_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity Default, CC1#pi",40,0,2.5,40,0,1);
-    gst1->Draw("ys:EvRF>>h1_Ev_Inel_cc1pi", "cc && (nfpip + nfpim + nfpi0 == 1) ","colz");
+    h1_Ev_Inel_cc1pi->Draw("colz");
     
     h1_Ev_Inel_cc1pi->GetXaxis()->SetTitle("E_{#nu}");
     h1_Ev_Inel_cc1pi->GetYaxis()->SetTitle("Inelasticity");
@@ -309,8 +365,7 @@ int inel_model_comparisons() {
 
     // Default+MEC
     TCanvas *c2_Ev_Inel_1Pi_CC = new TCanvas("c2_Ev_Inel_1Pi_CC","Default+MEC",800,600);
-    TH2D *h2_Ev_Inel_cc1pi = new TH2D("h2_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity Default+MEC, CC1#pi",40,0,2.5,40,0,1);
-    gst2->Draw("ys:EvRF>>h2_Ev_Inel_cc1pi", "cc && (nfpip + nfpim + nfpi0 == 1) ","colz");
+    h2_Ev_Inel_cc1pi->Draw("colz");
     
     h2_Ev_Inel_cc1pi->GetXaxis()->SetTitle("E_{#nu}");
     h2_Ev_Inel_cc1pi->GetYaxis()->SetTitle("Inelasticity");  
@@ -321,8 +376,7 @@ int inel_model_comparisons() {
 
     // G16_02b
     TCanvas *c3_Ev_Inel_1Pi_CC = new TCanvas("c3_Ev_Inel_1Pi_CC","G17_02b",800,600);
-    TH2D *h3_Ev_Inel_cc1pi = new TH2D("h3_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity G17_02b, CC1#pi",40,0,2.5,40,0,1);
-    gst3->Draw("ys:EvRF>>h3_Ev_Inel_cc1pi", "cc && (nfpip + nfpim + nfpi0 == 1) ","colz");
+    h3_Ev_Inel_cc1pi->Draw("colz");
 
     h3_Ev_Inel_cc1pi->GetXaxis()->SetTitle("E_{#nu}");
     h3_Ev_Inel_cc1pi->GetYaxis()->SetTitle("Inelasticity");
@@ -334,8 +388,7 @@ int inel_model_comparisons() {
 
     // G16_01a
     TCanvas *c4_Ev_Inel_1Pi_CC = new TCanvas("c4_Ev_Inel_1Pi_CC","G17_01a",800,600);
-    TH2D *h4_Ev_Inel_cc1pi = new TH2D("h4_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity G17_01a, CC1#pi",40,0,2.5,40,0,1);
-    gst4->Draw("ys:EvRF>>h4_Ev_Inel_cc1pi", "cc && (nfpip + nfpim + nfpi0 == 1) ","colz");
+    h4_Ev_Inel_cc1pi->Draw("colz");
     
     h4_Ev_Inel_cc1pi->GetXaxis()->SetTitle("E_{#nu}");
     h4_Ev_Inel_cc1pi->GetYaxis()->SetTitle("Inelasticity");
@@ -347,8 +400,7 @@ int inel_model_comparisons() {
 
     // G17_01b
     TCanvas *c5_Ev_Inel_1Pi_CC = new TCanvas("c5_Ev_Inel_1Pi_CC","G17_01b",800,600);
-    TH2D *h5_Ev_Inel_cc1pi = new TH2D("h5_Ev_Inel_cc1pi","E_{#nu} vs Inelasticity G17_01b, CC1#pi",40,0,2.5,40,0,1);
-    gst5->Draw("ys:EvRF>>h5_Ev_Inel_cc1pi", "cc && (nfpip + nfpim + nfpi0 == 1) ","colz");
+    h5_Ev_Inel_cc1pi->Draw("colz");
 
     h5_Ev_Inel_cc1pi->GetXaxis()->SetTitle("E_{#nu}");
     h5_Ev_Inel_cc1pi->GetYaxis()->SetTitle("Inelasticity");
@@ -370,6 +422,24 @@ int inel_model_comparisons() {
     delete h4_Ev_Inel_cc1pi;
     delete h5_Ev_Inel_cc1pi;
     
+    // -------------------------------------------------------------------------
+    //                          I/O run summary
+    // -------------------------------------------------------------------------
+    ofstream file_io;
+    file_io.open( "inel_model_comparisons_run_summary.txt" );
+
+    GstIOReport( gst1, "Default", file_io );
+    GstIOReport( gst2, "Default + MEC", file_io );
+    GstIOReport( gst3, "G17_02b", file_io );
+    GstIOReport( gst4, "G17_01a", file_io );
+    GstIOReport( gst5, "G17_01b", file_io );
+
+    CloseGstReader( gst1 );
+    CloseGstReader( gst2 );
+    CloseGstReader( gst3 );
+    CloseGstReader( gst4 );
+    CloseGstReader( gst5 );
+
     return 0;
 }
 
@@ -530,7 +600,8 @@ void RecoNuE( TTree *event_tree,
               vector< double > &reco_E_CC, 
               vector< double > &reco_E_NC,
               vector< double > &MC_reco_E_CC, 
-              vector< double > &MC_reco_E_NC ){
+              vector< double > &MC_reco_E_NC,
+              bool full_tree ){
 
     // Get the branches to calculate reconstructed energy and MC energy
     TBranch *b_mu_e  = event_tree->GetBranch("El");
@@ -553,7 +624,7 @@ void RecoNuE( TTree *event_tree,
     // Loop over the leaves and calculate the reconstructed energy
     for( int i = 0; i < n_values; ++i){
         
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
 
         double reco, reco_mc, e, p, cth;
         
@@ -639,7 +710,7 @@ void FSPNumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
         
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
      
         // Count #final state leptons
         if( b_fspl->GetLeaf("fspl")->GetValue() == 13 ){
@@ -771,7 +842,7 @@ void FSINumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
     
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
     
         // Charged current
         // CC0Pi
@@ -0,0 +1,493 @@
+/*
+ * JIT compiled cut and variable expressions
+ *
+ * See jit_cuts.h for the description of each function
+ *
+*/
+
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cctype>
+#include "TSystem.h"
+#include "jit_cuts.h"
+#include "topologies.h"
+#include "universe_weights.h"
+#include "oscillation_grid.h"
+#include "event_kinematics.h"
+#include "bootstrap.h"
+#include "smearing.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+//              The expressions compiled in this process
+// -------------------------------------------------------------------------
+static map< string, JitExpression > jit_expressions;
+
+// The directory holding jit_cuts.h, for the generated sources
+static string JitSourceDir(){
+
+    string file = __FILE__;
+    size_t slash = file.find_last_of( '/' );
+
+    return slash == string::npos ? "." : file.substr( 0, slash );
+}
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          cache location
+// -------------------------------------------------------------------------
+string JitCacheDir(){
+
+    const char* cache_dir = getenv( "SBND_JIT_CACHE" );
+
+    return cache_dir ? cache_dir : "jit_cache";
+}
+
+// -------------------------------------------------------------------------
+// The cache key, a 64 bit FNV-1a hash of the expression and the layout of
+// GstEvent, so that a change to the event invalidates the cache
+// -------------------------------------------------------------------------
+static string JitKey( const string &expression ){
+
+    ostringstream text;
+    text << expression << "|" << sizeof( GstEvent ) << "|" << kGstMaxParticles;
+
+    string key_text = text.str();
+
+    unsigned long long hash = 14695981039346656037ULL;
+    for( unsigned int i = 0; i < key_text.size(); ++i ){
+        hash ^= (unsigned char) key_text[i];
+        hash *= 1099511628211ULL;
+    }
+
+    ostringstream key;
+    key << hex << setw(16) << setfill('0') << hash;
+
+    return key.str();
+}
+
+// -------------------------------------------------------------------------
+// Rewrite an expression in terms of the GstEvent e and the instance i:
+//      scalars     : nfp   -> double( e.nfp )
+//      arrays      : pdgf  -> double( e.pdgf[i] ), unless an index is given
+//      division    : a/b   -> a / jit_divide / b
+// Anything else, numbers, operators and functions such as TMath::Abs or
+// sqrt, is left as it is
+// -------------------------------------------------------------------------
+static string JitTranslate( const string &expression,
+                            JitExpression &jit ){
+
+    GstEvent event;
+    string   code;
+    size_t   pos = 0;
+
+    while( pos < expression.size() ){
+
+        char c = expression[pos];
+
+        // Numbers, including exponents and suffixes
+        if( isdigit( c ) || ( c == '.' && pos + 1 < expression.size() && isdigit( expression[pos + 1] ) ) ){
+
+            size_t start = pos;
+            while( pos < expression.size()
+                   && ( isalnum( expression[pos] ) || expression[pos] == '.'
+                        || ( ( expression[pos] == '+' || expression[pos] == '-' )
+                             && ( expression[pos - 1] == 'e' || expression[pos - 1] == 'E' ) ) ) ){
+                ++pos;
+            }
+            code += expression.substr( start, pos - start );
+            continue;
+        }
+
+        if( c == '/' ){
+            code += " / jit_divide / ";
+            ++pos;
+            continue;
+        }
+
+        if( !isalpha( c ) && c != '_' ){
+            code += c;
+            ++pos;
+            continue;
+        }
+
+        size_t start = pos;
+        while( pos < expression.size() && ( isalnum( expression[pos] ) || expression[pos] == '_' ) ) ++pos;
+        string name = expression.substr( start, pos - start );
+
+        // Members and scopes, TMath::Abs for example, are not branches
+        size_t before = code.find_last_not_of( ' ' );
+        size_t after  = expression.find_first_not_of( ' ', pos );
+        bool   scoped = ( before != string::npos && ( code[before] == '.' || code[before] == ':' ) )
+                     || ( after  != string::npos && expression[after] == ':' );
+
+        bool is_array = false;
+        if( scoped || !GstEventField( event, name, is_array ) ){
+            code += name;
+            continue;
+        }
+
+        jit.branches.insert( name );
+
+        // TTreeFormula works in double, so nfp/2 must not be an integer division
+        if( !is_array ){
+            code += "double( e." + name + " )";
+        }
+        else{
+            jit.branches.insert( "nf" );
+            if( after == string::npos || expression[after] != '[' ){
+                code += "double( e." + name + "[i] )";
+                jit.uses_particles = true;
+            }
+            else{
+                code += "e." + name;
+            }
+        }
+    }
+
+    return code;
+}
+
+// -------------------------------------------------------------------------
+//                          compile an expression
+// -------------------------------------------------------------------------
+const JitExpression &JitCompile( const string &expression ){
+
+    map< string, JitExpression >::iterator it = jit_expressions.find( expression );
+    if( it != jit_expressions.end() ) return it->second;
+
+    JitExpression jit;
+    jit.expression     = expression;
+    jit.symbol         = "gst_jit_" + JitKey( expression );
+    jit.function       = 0;
+    jit.uses_particles = false;
+
+    string code = JitTranslate( expression, jit );
+
+    string cache_dir = JitCacheDir();
+    string source    = cache_dir + "/" + jit.symbol + ".cpp";
+
+    gSystem->mkdir( cache_dir.c_str(), kTRUE );
+
+    // The source is only written once, so ACLiC can reuse the library
+    if( gSystem->AccessPathName( source.c_str() ) ){
+
+        ofstream file( source.c_str() );
+        file << "// Generated by jit_cuts.cpp for the expression" << endl;
+        file << "//      " << expression << endl;
+        file << "#include <cmath>" << endl;
+        file << "#include \"TMath.h\"" << endl;
+        file << "#include \"jit_cuts.h\"" << endl;
+        file << endl;
+        file << "using namespace std;" << endl;
+        file << endl;
+        file << "extern \"C\" double " << jit.symbol << "( const GstEvent &e, int i ){" << endl;
+        file << "    (void) i;" << endl;
+        file << "    return double( " << code << " );" << endl;
+        file << "}" << endl;
+    }
+
+    string include = "-I" + JitSourceDir();
+    if( string( gSystem->GetIncludePath() ).find( include ) == string::npos ){
+        gSystem->AddIncludePath( include.c_str() );
+    }
+
+    // "k" keeps the library so that the next run only loads it
+    if( !gSystem->CompileMacro( source.c_str(), "k" ) ){
+        cerr << " Could not compile the expression : " << expression << endl;
+        exit(1);
+    }
+
+    jit.function = (GstJitFunction) gSystem->DynFindSymbol( "*", jit.symbol.c_str() );
+
+    if( !jit.function ){
+        cerr << " Could not find the compiled expression : " << expression << endl;
+        exit(1);
+    }
+
+    return jit_expressions.insert( make_pair( expression, jit ) ).first->second;
+}
+
+// -------------------------------------------------------------------------
+//                          JIT single pass fill
+// -------------------------------------------------------------------------
+Long64_t FillFlatJit( TTree *event_tree,
+                      vector< FlatFill > &fills,
+                      TEntryList *entries ){
+
+    // The compiled expressions of each fill, x first then y
+    vector< vector< const JitExpression* > > dims( fills.size() );
+    vector< const JitExpression* >           selections( fills.size(), (const JitExpression*) 0 );
+    vector< bool >                           particles( fills.size(), false );
+
+    s_branches branches;
+    bool classify = false;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        vector< string > dim_names;
+        GstFillDimensions( fills[i].variable, dim_names );
+
+        int n_dims = fills[i].hist.y.n_bins > 0 ? 2 : 1;
+        if( int( dim_names.size() ) != n_dims ){
+            cerr << " The fill " << fills[i].variable << " does not have " << n_dims << " dimension(s) " << endl;
+            exit(1);
+        }
+
+        // The kinematic fills only have a selection
+        for( int j = n_dims - 1; j >= 0 && fills[i].kinematics.empty(); --j ){
+            dims[i].push_back( &JitCompile( dim_names[j] ) );
+        }
+
+        if( fills[i].selection.find_first_not_of(" ") != string::npos ){
+            selections[i] = &JitCompile( fills[i].selection );
+        }
+
+        for( unsigned int j = 0; j < dims[i].size(); ++j ){
+            branches.insert( dims[i][j]->branches.begin(), dims[i][j]->branches.end() );
+            if( dims[i][j]->uses_particles ) particles[i] = true;
+        }
+        if( selections[i] ){
+            branches.insert( selections[i]->branches.begin(), selections[i]->branches.end() );
+            if( selections[i]->uses_particles ) particles[i] = true;
+        }
+
+        if( fills[i].topology_mask ) classify = true;
+    }
+
+    // The topologies are classified from fields of the same event
+    if( classify ){
+        const char* topology_branches[] = { "cc", "nc", "coh", "nfpip", "nfpim", "nfpi0" };
+        branches.insert( topology_branches, topology_branches + 6 );
+    }
+
+    // and so are the channels
+    bool split = false;
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].channels.empty() ) split = true;
+    }
+    if( split ){
+        const char* channel_branches[] = { "qel", "mec", "res", "dis", "coh" };
+        branches.insert( channel_branches, channel_branches + 5 );
+    }
+
+    // and the universe weights, from their friend
+    int n_universes = 0;
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].universes.cells.empty() && fills[i].universes.n_universes > n_universes ){
+            n_universes = fills[i].universes.n_universes;
+        }
+    }
+    vector< double > universe_weights( n_universes );
+    TLeaf *universe_leaf = n_universes > 0 ? GstUniverseLeaf( event_tree ) : 0;
+
+    // and the bootstrap weights, drawn from the model and entry number
+    int n_replicas = 0;
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].replicas.cells.empty() && fills[i].replicas.n_universes > n_replicas ){
+            n_replicas = fills[i].replicas.n_universes;
+        }
+    }
+    vector< double > replica_weights( n_replicas );
+    unsigned int model_key = n_replicas > 0 ? RngModelKey( event_tree ) : 0;
+
+    // and the oscillation weights, from the neutrino energy
+    vector< double > oscillation_weights( FlatOscillationCount( fills ) );
+    const OscillationGrid *grid = oscillation_weights.empty() ? 0 : FlatOscillations();
+    if( grid ) branches.insert( "Ev" );
+
+    // and the kinematics, from the same event
+    KinematicsPass   kinematics;
+    vector< double > kinematics_weights;
+
+    bool by_kinematics = BeginKinematicsPass( fills, kinematics );
+    if( by_kinematics ){
+        KinematicsBranches( branches );
+        kinematics_weights.resize( kinematics.fills.size() );
+    }
+
+    // and everything the smearing changes, before any of it is used
+    const SmearingConfig *smearing  = GstSmearing();
+    unsigned int          smear_key = smearing ? RngModelKey( event_tree ) : 0;
+    if( smearing ) SmearingBranches( branches );
+
+    // Read only the branches the expressions use, straight into the event,
+    // the count of the particle arrays first
+    GstEvent           event;
+    vector< string >   read_names;
+    vector< TBranch* > read;
+
+    bool count_first = branches.count( "nf" ) > 0;
+    if( count_first ){
+        branches.erase( "nf" );
+        read_names.push_back( "nf" );
+    }
+    for( s_branches::iterator it = branches.begin(); it != branches.end(); ++it ) read_names.push_back( *it );
+
+    for( vector< string >::iterator it = read_names.begin(); it != read_names.end(); ++it ){
+
+        bool is_array = false;
+        void *field   = GstEventField( event, *it, is_array );
+        TBranch *branch = event_tree->GetBranch( it->c_str() );
+
+        if( !field || !branch ){
+            cerr << " The gst tree has no branch " << *it << endl;
+            exit(1);
+        }
+
+        event_tree->SetBranchAddress( it->c_str(), field );
+    }
+
+    event.nf = 0;
+
+    TopologyEvent topology;
+    int      tree_number = -1;
+    Long64_t n_entries   = entries ? entries->GetN() : event_tree->GetEntries();
+
+    for( Long64_t i_entry = 0; i_entry < n_entries; ++i_entry ){
+
+        Long64_t entry = entries ? entries->GetEntry( i_entry ) : i_entry;
+
+        Long64_t local_entry = event_tree->LoadTree( entry );
+        if( local_entry < 0 ) break;
+
+        // The branches of a chain change with each of its trees
+        if( event_tree->GetTreeNumber() != tree_number ){
+            tree_number = event_tree->GetTreeNumber();
+            read.clear();
+            for( unsigned int b = 0; b < read_names.size(); ++b ){
+                read.push_back( event_tree->GetTree()->GetBranch( read_names[b].c_str() ) );
+            }
+        }
+
+        // The count first, so that the arrays are not read past their end
+        if( count_first ){
+            read[0]->GetEntry( local_entry, 1 );
+
+            if( event.nf > kGstMaxParticles ){
+                cerr << " Entry " << entry << " has " << event.nf << " final state particles, more than "
+                     << kGstMaxParticles << endl;
+                exit(1);
+            }
+        }
+
+        for( unsigned int b = count_first ? 1 : 0; b < read.size(); ++b ){
+            read[b]->GetEntry( local_entry, 1 );
+        }
+
+        if( smearing ) SmearGstEvent( *smearing, smear_key, entry, event );
+
+        unsigned int mask = 0;
+        if( classify ){
+            topology.cc    = event.cc;
+            topology.nc    = event.nc;
+            topology.coh   = event.coh;
+            topology.nfpip = event.nfpip;
+            topology.nfpim = event.nfpim;
+            topology.nfpi0 = event.nfpi0;
+            mask = ClassifyTopology( topology );
+        }
+
+        int channel = split ? ClassifyChannel( event.qel, event.mec, event.res, event.dis, event.coh ) : kChannelOther;
+
+        bool universes_read     = false;
+        bool replicas_drawn     = false;
+        bool oscillations_found = false;
+
+        // The weight of the entry in each kinematic fill, as a Draw of an
+        // event variable sums the selection over its instances
+        if( by_kinematics ){
+            for( unsigned int j = 0; j < kinematics.fills.size(); ++j ){
+
+                int i = kinematics.fills[j];
+
+                kinematics_weights[j] = 0;
+                if( ( mask & fills[i].topology_mask ) != fills[i].topology_mask ) continue;
+
+                if( !selections[i] ){
+                    kinematics_weights[j] = 1;
+                    continue;
+                }
+
+                int n_data = particles[i] ? event.nf : 1;
+                for( int k = 0; k < n_data; ++k ){
+                    kinematics_weights[j] += selections[i]->function( event, k );
+                }
+            }
+
+            AddKinematicsEvent( kinematics, fills, event, mask, channel, &kinematics_weights[0] );
+        }
+
+        for( unsigned int i = 0; i < fills.size(); ++i ){
+
+            if( ( mask & fills[i].topology_mask ) != fills[i].topology_mask ) continue;
+            if( !fills[i].kinematics.empty() ) continue;
+
+            int  n_data      = particles[i] ? event.nf : 1;
+            bool by_channel  = !fills[i].channels.empty();
+            bool by_universe = !fills[i].universes.cells.empty();
+            bool by_replica  = !fills[i].replicas.cells.empty();
+            bool by_point    = !fills[i].oscillated.cells.empty();
+
+            if( by_universe && !universes_read ){
+                ReadUniverseWeights( universe_leaf, local_entry, universe_weights );
+                universes_read = true;
+            }
+            if( by_replica && !replicas_drawn ){
+                BootstrapWeights( model_key, entry, replica_weights );
+                replicas_drawn = true;
+            }
+            if( by_point && !oscillations_found ){
+                OscillationWeights( *grid, event.Ev, &oscillation_weights[0] );
+                oscillations_found = true;
+            }
+
+            for( int k = 0; k < n_data; ++k ){
+
+                double weight = 1;
+                if( selections[i] ){
+                    weight = selections[i]->function( event, k );
+                    if( weight == 0 ) continue;
+                }
+
+                double x = dims[i][0]->function( event, k );
+
+                int cell = 0;
+                if( dims[i].size() == 1 ){
+                    if( by_universe || by_replica || by_point ) cell = FlatCell( fills[i].hist, x );
+                    FillFlatHist( fills[i].hist, x, weight );
+                    if( by_channel ) FillFlatHist( fills[i].channels[channel], x, weight );
+                }
+                else{
+                    double y = dims[i][1]->function( event, k );
+                    if( by_universe || by_replica || by_point ) cell = FlatCell( fills[i].hist, x, y );
+                    FillFlatHist( fills[i].hist, x, y, weight );
+                    if( by_channel ) FillFlatHist( fills[i].channels[channel], x, y, weight );
+                }
+
+                if( by_universe ) FillFlatUniverses( fills[i].universes, cell, weight, &universe_weights[0] );
+                if( by_replica )  FillFlatUniverses( fills[i].replicas, cell, weight, &replica_weights[0] );
+                if( by_point )    FillFlatUniverses( fills[i].oscillated, cell, weight, &oscillation_weights[0] );
+            }
+        }
+    }
+
+    if( by_kinematics ) EndKinematicsPass( kinematics, fills );
+
+    for( unsigned int b = 0; b < read_names.size(); ++b ){
+        event_tree->ResetBranchAddress( event_tree->GetBranch( read_names[b].c_str() ) );
+    }
+
+    return n_entries;
+}
@@ -0,0 +1,102 @@
+/*
+ * JIT compiled cut and variable expressions
+ *
+ * Free-form expressions in the syntax passed to TTree::Draw, for example
+ *      "cc && nfp >= 2 && pdgf == 2212"
+ *      "(sumKEf/nfp)"
+ * are otherwise interpreted by TTreeFormula for every entry. Here each
+ * distinct expression is rewritten in terms of the GstEvent fields and
+ * compiled once by ACLiC into a native function, which the event loop
+ * calls directly on the GstEvent the branches are read into
+ *
+ * The generated sources and libraries are kept in a cache directory,
+ * jit_cache by default or $SBND_JIT_CACHE, under a name made from a hash
+ * of the expression text, so later runs load them without compiling
+ *
+ * FillFlat uses these when SetFlatJit( true ) has been called, or when
+ * SBND_JIT_CUTS=1 is set in the environment
+ *
+*/
+
+#ifndef JIT_CUTS_H
+#define JIT_CUTS_H
+
+#include <vector>
+#include <string>
+#include "TTree.h"
+#include "TEntryList.h"
+#include "gst_reader.h"
+#include "flat_hist.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// A compiled expression, evaluated for one instance of the particle arrays
+// -------------------------------------------------------------------------
+typedef double (*GstJitFunction)( const GstEvent &event, int instance );
+
+// -------------------------------------------------------------------------
+// TTreeFormula gives 0 for a division by 0, so each / in an expression is
+// compiled as a / jit_divide / b, which keeps the precedence of / and
+// gives the same
+// -------------------------------------------------------------------------
+struct JitDivide {};
+
+struct JitNumerator {
+    double value;
+};
+
+const JitDivide jit_divide = JitDivide();
+
+inline JitNumerator operator/( double value, JitDivide ){
+
+    JitNumerator numerator = { value };
+    return numerator;
+}
+
+inline double operator/( JitNumerator numerator, double value ){
+
+    return value == 0 ? 0 : numerator.value / value;
+}
+
+// -------------------------------------------------------------------------
+// An expression and its compiled function
+//      expression     : the expression as written
+//      symbol         : the name of the compiled function
+//      function       : the compiled function
+//      uses_particles : the expression uses the final state particle
+//                       arrays without an index, so it is evaluated for
+//                       each of the nf particles as TTree::Draw does
+//      branches       : the gst branches the expression reads
+// -------------------------------------------------------------------------
+struct JitExpression {
+    string         expression;
+    string         symbol;
+    GstJitFunction function;
+    bool           uses_particles;
+    s_branches     branches;
+};
+
+// -------------------------------------------------------------------------
+// The directory the compiled expressions are cached in
+// -------------------------------------------------------------------------
+string JitCacheDir();
+
+// -------------------------------------------------------------------------
+// Compile an expression, or return it from the cache if it has been
+// compiled before in this process or in an earlier run
+// -------------------------------------------------------------------------
+const JitExpression &JitCompile( const string &expression );
+
+// -------------------------------------------------------------------------
+// FillFlat with the variables and selections of each fill compiled by
+// JitCompile, the branches they need are read into a GstEvent
+// Only the entries in the list are visited if one is given
+// -------------------------------------------------------------------------
+Long64_t FillFlatJit( TTree *event_tree,
+                      vector< FlatFill > &fills,
+                      TEntryList *entries = 0 );
+
+// -------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * A root macro to compile and load the shared modules used by the
+ * model comparison macros, in the order they depend on each other
+ *
+ * Run before the macro itself:
+ *      root -l -b -q load_modules.cpp 'model_comparisons.cpp+(4)'
+ *
+ * From another directory, give the location of the repository:
+ *      root -l -b -q '/path/to/repo/load_modules.cpp("/path/to/repo")' '/path/to/repo/model_comparisons.cpp+'
+ *
+*/
+
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include "TSystem.h"
+
+using namespace std;
+
+void load_modules( const char* repo_dir = "." ){
+
+    // The ROOT libraries the modules link against beyond those root loads
+    if( gSystem->Load( "libROOTDataFrame" ) < 0 ){
+        cerr << " Could not load libROOTDataFrame " << endl;
+        exit(1);
+    }
+
+    const int n_modules = 17;
+    const char* modules[n_modules] = { "gst_reader.cpp",
+                                       "derived_tree.cpp",
+                                       "skim_tree.cpp",
+                                       "topology_index.cpp",
+                                       "event_store.cpp",
+                                       "counter_rng.cpp",
+                                       "smearing.cpp",
+                                       "threshold_scan.cpp",
+                                       "event_kinematics.cpp",
+                                       "energy_migration.cpp",
+                                       "unfolding.cpp",
+                                       "universe_weights.cpp",
+                                       "bootstrap.cpp",
+                                       "oscillation_grid.cpp",
+                                       "jit_cuts.cpp",
+                                       "rdf_fill.cpp",
+                                       "flat_hist.cpp" };
+
+    for( int i = 0; i < n_modules; ++i ){
+
+        string module = string( repo_dir ) + "/" + modules[i];
+
+        // CompileMacro returns 0 if the module could not be built or loaded
+        if( !gSystem->CompileMacro( module.c_str(), "k" ) ){
+            cerr << " Could not load " << module << endl;
+            exit(1);
+        }
+    }
+}
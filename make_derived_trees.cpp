@@ -0,0 +1,46 @@
+/*
+ * A root macro to write the friend trees of derived variables for the
+ * gst files of the five model configurations, see derived_tree.h
+ *
+ * Each file is computed over n_threads and written to GstDerivedPath of
+ * the gst file, next to it or below $SBND_DERIVED_DIR. Once written, the
+ * macros attach them through OpenGstReader
+ *
+ * Run from the top of the repository:
+ *      root -l -b -q load_modules.cpp 'make_derived_trees.cpp+(4)'
+ *
+ * With SBND_INPUT_DIR set the files of that sample are used instead
+ *
+*/
+
+#include <iostream>
+#include <string>
+#include "TStopwatch.h"
+#include "gst_reader.h"
+#include "derived_tree.h"
+
+using namespace std;
+
+int make_derived_trees( unsigned int n_threads = 0 ){
+
+    const int n_models = 5;
+    const char* models[n_models] = { "Default", "Default+MEC", "G16_02b", "G16_01a", "G16_01b" };
+
+    SetGstThreads( n_threads );
+
+    for( int i = 0; i < n_models; ++i ){
+
+        string gst_path = InputPath( ( string( "/hepstore/rjones/Exercises/Flavours/" ) + models[i]
+                                       + "/sbnd/1M/gntp.10000.gst.root" ).c_str() );
+
+        TStopwatch timer;
+        timer.Start();
+        Long64_t n_entries = WriteGstDerived( gst_path );
+        timer.Stop();
+
+        cout << " " << models[i] << " : " << n_entries << " entries written to "
+             << GstDerivedPath( gst_path ) << " in " << timer.RealTime() << " s " << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * A root macro to write the columnar event stores of the gst files of the
+ * five model configurations, see event_store.h
+ *
+ * The events of each store are in the order of cluster_column, Ev unless
+ * another is given, and it is written to EventStorePath of the gst file,
+ * next to it or below $SBND_STORE_DIR. FillFlat reads them from then on
+ *
+ * The kinematic columns are kept exactly unless float_bits is 32 or 16,
+ * which rounds them to float or half precision for the large tune scans
+ *
+ * Run from the top of the repository:
+ *      root -l -b -q load_modules.cpp make_event_stores.cpp+
+ *      root -l -b -q load_modules.cpp 'make_event_stores.cpp+("Q2", 16)'
+ *
+ * With SBND_INPUT_DIR set the files of that sample are used instead
+ *
+*/
+
+#include <iostream>
+#include <string>
+#include "TStopwatch.h"
+#include "gst_reader.h"
+#include "event_store.h"
+
+using namespace std;
+
+int make_event_stores( const char* cluster_column = "Ev",
+                       int float_bits = 64 ){
+
+    const int n_models = 5;
+    const char* models[n_models] = { "Default", "Default+MEC", "G16_02b", "G16_01a", "G16_01b" };
+
+    for( int i = 0; i < n_models; ++i ){
+
+        string gst_path = InputPath( ( string( "/hepstore/rjones/Exercises/Flavours/" ) + models[i]
+                                       + "/sbnd/1M/gntp.10000.gst.root" ).c_str() );
+
+        TStopwatch timer;
+        timer.Start();
+        Long64_t n_entries = WriteEventStore( gst_path, cluster_column, float_bits );
+        timer.Stop();
+
+        cout << " " << models[i] << " : " << n_entries << " entries written to "
+             << EventStorePath( gst_path ) << " in " << timer.RealTime() << " s " << endl;
+    }
+
+    return 0;
+}
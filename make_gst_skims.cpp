@@ -0,0 +1,65 @@
+/*
+ * A root macro to write the per-topology skims of the gst files of the
+ * five model configurations, see skim_tree.h
+ *
+ * The skims are of the topologies the distributions select, CC0pi,
+ * CC1pi+, CC1pi0, NC0pi, NC1pi0 and CC1pi, with the branches the six
+ * macros fill from. Each is written to GstSkimPath of the gst file, next
+ * to it or below $SBND_SKIM_DIR, and FillFlat and RecoNuE read them
+ * from then on
+ *
+ * Run from the top of the repository:
+ *      root -l -b -q load_modules.cpp make_gst_skims.cpp+
+ *
+ * With SBND_INPUT_DIR set the files of that sample are used instead
+ *
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "TStopwatch.h"
+#include "gst_reader.h"
+#include "topologies.h"
+#include "skim_tree.h"
+#include "flat_hist.h"
+
+using namespace std;
+
+int make_gst_skims(){
+
+    const int n_models = 5;
+    const char* models[n_models] = { "Default", "Default+MEC", "G16_02b", "G16_01a", "G16_01b" };
+
+    vector< int > topologies;
+    topologies.push_back( kCC0Pi );
+    topologies.push_back( kCC1PiP );
+    topologies.push_back( kCC1Pi0 );
+    topologies.push_back( kNC0Pi );
+    topologies.push_back( kNC1Pi0 );
+    topologies.push_back( kCC1Pi );
+
+    // The branches of the distributions, of RecoNuE and of the channels
+    vector< string > planned_fills;
+    planned_fills.push_back( "Q2 + Ev + EvRF + ys" );
+    planned_fills.push_back( "El + pl + cthl" );
+    planned_fills.push_back( "nfp + nfn + sumKEf" );
+    planned_fills.push_back( "pdgf + pf + cthf + Ef" );
+    planned_fills.push_back( kChannelFill );
+
+    for( int i = 0; i < n_models; ++i ){
+
+        string gst_path = InputPath( ( string( "/hepstore/rjones/Exercises/Flavours/" ) + models[i]
+                                       + "/sbnd/1M/gntp.10000.gst.root" ).c_str() );
+
+        TStopwatch timer;
+        timer.Start();
+        Long64_t n_entries = WriteGstSkims( gst_path, topologies, planned_fills );
+        timer.Stop();
+
+        cout << " " << models[i] << " : " << n_entries << " entries skimmed into "
+             << topologies.size() << " topologies in " << timer.RealTime() << " s " << endl;
+    }
+
+    return 0;
+}
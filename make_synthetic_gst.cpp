@@ -0,0 +1,543 @@
+/*
+ * A root macro to write synthetic gst files for local testing and
+ * benchmarking of the model comparison macros
+ *
+ * The real inputs live on /hepstore and are not available off-site,
+ * so this writes, for each of the five model configurations:
+ *      - a gst tree with the branch names and types the macros use
+ *      - a total cross section file with nu_mu_Ar40/tot_cc and tot_nc
+ * and a single flux file with flux_pos_pol_numu, all in the same layout
+ * as /hepstore/rjones, below out_dir
+ *
+ * The events are a toy of the MiniBooNE-flux numu Ar40 sample:
+ *      - Ev follows the flux x cross section
+ *      - QEL, MEC, RES, DIS and COH channels, CC and NC
+ *      - pion production, absorption and nucleon knock-out which vary
+ *        between the model configurations
+ *      - lepton and hadron kinematics which respect the energy transfer
+ * The numbers are realistic in shape, not in detail
+ *
+ * To make 100k events per model and run a macro on them:
+ *      root -l -b -q load_modules.cpp 'make_synthetic_gst.cpp+(100000, "synthetic")'
+ *      export SBND_INPUT_DIR=$PWD/synthetic
+ *      root -l -b -q load_modules.cpp 'model_comparisons.cpp+'
+ *
+ * With n_universes > 0, the weights of each event in that many toy
+ * reweighting universes are written next to each gst file:
+ *      root -l -b -q load_modules.cpp 'make_synthetic_gst.cpp+(100000, "synthetic", 1, 100)'
+ *
+ * The gst files are always written to sbnd/1M/gntp.10000.gst.root since
+ * that is where the macros look for them, whatever the number of events
+ *
+*/
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include "TFile.h"
+#include "TTree.h"
+#include "TH1.h"
+#include "TGraph.h"
+#include "TDirectory.h"
+#include "TRandom3.h"
+#include "TMath.h"
+#include "TSystem.h"
+#include "TString.h"
+#include "gst_reader.h"
+#include "universe_weights.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The parameters which differ between the synthetic model configurations
+//      name          : the directory name used on /hepstore
+//      f_mec         : MEC rate relative to QEL
+//      f_res         : RES rate relative to QEL, above threshold
+//      f_dis         : DIS rate relative to QEL, per GeV above 0.8 GeV
+//      f_coh         : COH rate relative to QEL
+//      pi_absorption : probability each pion is absorbed in the nucleus
+//      knock_out     : mean number of extra nucleons knocked out by FSI
+//      xsec_scale    : scale of the total cross section
+// -------------------------------------------------------------------------
+struct SyntheticModel {
+    const char* name;
+    double      f_mec;
+    double      f_res;
+    double      f_dis;
+    double      f_coh;
+    double      pi_absorption;
+    double      knock_out;
+    double      xsec_scale;
+};
+
+const int n_synthetic_models = 5;
+
+const SyntheticModel synthetic_models[n_synthetic_models] = {
+    { "Default",     0.00, 0.55, 0.20, 0.015, 0.20, 0.45, 1.00 },
+    { "Default+MEC", 0.18, 0.55, 0.20, 0.015, 0.20, 0.45, 1.07 },
+    { "G16_02b",     0.22, 0.50, 0.18, 0.010, 0.25, 0.60, 1.05 },
+    { "G16_01a",     0.20, 0.48, 0.18, 0.012, 0.27, 0.55, 1.04 },
+    { "G16_01b",     0.20, 0.48, 0.18, 0.012, 0.23, 0.50, 1.04 }
+};
+
+// -------------------------------------------------------------------------
+// Masses, GeV
+// -------------------------------------------------------------------------
+const double m_p   = 0.93827;
+const double m_n   = 0.93957;
+const double m_N   = 0.93892;
+const double m_mu  = 0.10566;
+const double m_pic = 0.13957;
+const double m_pi0 = 0.13498;
+
+// -------------------------------------------------------------------------
+// The shape of the flux, peaking at ~0.65 GeV like the MiniBooNE flux
+// -------------------------------------------------------------------------
+double SyntheticFluxShape( double e ){
+    return e * e * exp( -e / 0.33 );
+}
+
+// -------------------------------------------------------------------------
+// The total CC cross section on Ar40, 1e-38 cm^2
+// Linear at high energy and suppressed near threshold
+// -------------------------------------------------------------------------
+double SyntheticXSecCC( double e, double scale ){
+    return scale * 40 * 0.70 * e * ( 1 - exp( -e / 0.3 ) );
+}
+
+// -------------------------------------------------------------------------
+// Add a final state particle with kinetic energy ke, direction drawn
+// with a forward bias, to the event
+// -------------------------------------------------------------------------
+void AddSyntheticParticle( TRandom3 &rand,
+                           GstEvent &event,
+                           int pdg,
+                           double mass,
+                           double ke ){
+
+    if( event.nf >= kGstMaxParticles ) return;
+
+    int i = event.nf;
+
+    double e   = ke + mass;
+    double p   = sqrt( TMath::Max( e * e - mass * mass, 0. ) );
+    double cth = 2 * sqrt( rand.Uniform() ) - 1;
+    double sth = sqrt( TMath::Max( 1 - cth * cth, 0. ) );
+    double phi = rand.Uniform( 0, 2 * TMath::Pi() );
+
+    event.pdgf[i] = pdg;
+    event.Ef[i]   = e;
+    event.pf[i]   = p;
+    event.cthf[i] = cth;
+    event.pxf[i]  = p * sth * cos( phi );
+    event.pyf[i]  = p * sth * sin( phi );
+    event.pzf[i]  = p * cth;
+
+    ++event.nf;
+}
+
+// -------------------------------------------------------------------------
+// Generate one synthetic gst event for the given model
+// -------------------------------------------------------------------------
+void GenerateSyntheticEvent( TRandom3 &rand,
+                             const SyntheticModel &model,
+                             int iev,
+                             GstEvent &event ){
+
+    // Neutrino energy, flux x cross section ~ E^3 exp(-E/0.33)
+    double ev = 0;
+    do {
+        ev = -0.33 * log( rand.Uniform() * rand.Uniform() * rand.Uniform() * rand.Uniform() );
+    } while( ev < 0.2 || ev > 6 );
+
+    bool cc = rand.Uniform() < 0.73;
+
+    // Interaction channel
+    double w_qel = 1;
+    double w_mec = model.f_mec;
+    double w_res = ev > 0.3 ? model.f_res * ( 1 - exp( -( ev - 0.3 ) / 0.4 ) ) : 0;
+    double w_dis = ev > 0.8 ? model.f_dis * ( ev - 0.8 ) : 0;
+    double w_coh = model.f_coh;
+    double w_tot = w_qel + w_mec + w_res + w_dis + w_coh;
+
+    double u = rand.Uniform( w_tot );
+    int channel = 0; // 0 QEL, 1 MEC, 2 RES, 3 DIS, 4 COH
+    if(      u < w_qel )                         channel = 0;
+    else if( u < w_qel + w_mec )                 channel = 1;
+    else if( u < w_qel + w_mec + w_res )         channel = 2;
+    else if( u < w_qel + w_mec + w_res + w_dis ) channel = 3;
+    else                                         channel = 4;
+
+    double m_l = cc ? m_mu : 0;
+
+    // Energy transfer and invariant mass
+    double q2 = 0, nu = 0, w = m_N;
+    for( int attempt = 0; attempt < 100; ++attempt ){
+
+        if( channel == 0 ){
+            q2 = rand.Exp( 0.25 );
+            w  = m_N;
+            nu = q2 / ( 2 * m_N );
+        }
+        else if( channel == 1 ){
+            q2 = rand.Exp( 0.30 );
+            w  = m_N;
+            nu = q2 / ( 2 * m_N ) + rand.Uniform( 0.03, 0.25 );
+        }
+        else if( channel == 2 ){
+            q2 = rand.Exp( 0.35 );
+            w  = TMath::Min( TMath::Max( rand.Gaus( 1.232, 0.09 ), 1.08 ), 1.8 );
+            nu = ( w * w - m_N * m_N + q2 ) / ( 2 * m_N );
+        }
+        else if( channel == 3 ){
+            q2 = rand.Exp( 0.6 );
+            w  = rand.Uniform( 1.4, TMath::Max( sqrt( m_N * m_N + 2 * m_N * ev ), 1.41 ) );
+            nu = ( w * w - m_N * m_N + q2 ) / ( 2 * m_N );
+        }
+        else{
+            q2 = rand.Exp( 0.04 );
+            w  = m_N;
+            nu = ev * rand.Uniform( 0.1, 0.6 );
+        }
+
+        if( nu < ev - m_l - 0.005 && nu > 0 ) break;
+
+        // Give up and take the smallest transfer
+        if( attempt == 99 ){
+            q2 = 0.001;
+            nu = TMath::Min( q2 / ( 2 * m_N ) + 0.001, ev - m_l - 0.005 );
+            w  = m_N;
+            if( channel != 4 ) channel = 0;
+        }
+    }
+
+    // Lepton kinematics, Q2 is recalculated if the angle has to be clamped
+    double el   = ev - nu;
+    double pl   = sqrt( TMath::Max( el * el - m_l * m_l, 0. ) );
+    double cthl = pl > 0 ? ( 2 * ev * el - m_l * m_l - q2 ) / ( 2 * ev * pl ) : 1;
+    if( cthl > 1 || cthl < -1 ){
+        cthl = TMath::Max( TMath::Min( cthl, 1. ), -1. );
+        q2   = TMath::Max( 2 * ev * ( el - pl * cthl ) - m_l * m_l, 0. );
+    }
+    double sthl = sqrt( TMath::Max( 1 - cthl * cthl, 0. ) );
+    double phil = rand.Uniform( 0, 2 * TMath::Pi() );
+
+    event.iev     = iev;
+    event.neu     = 14;
+    event.fspl    = cc ? 13 : 14;
+    event.tgt     = 1000180400;
+    event.hitnuc  = rand.Uniform() < 22. / 40. ? 2112 : 2212;
+    event.qel     = channel == 0;
+    event.mec     = channel == 1;
+    event.res     = channel == 2;
+    event.dis     = channel == 3;
+    event.coh     = channel == 4;
+    event.cc      = cc;
+    event.nc      = !cc;
+    event.wght    = 1;
+    event.Q2      = q2;
+    event.W       = w;
+    event.x       = nu > 0 ? q2 / ( 2 * m_N * nu ) : 0;
+    event.y       = nu / ev;
+    event.Q2s     = event.Q2;
+    event.Ws      = event.W;
+    event.xs      = event.x;
+    event.ys      = event.y;
+    event.Ev      = ev;
+    event.EvRF    = ev * ( 1 + rand.Gaus( 0, 0.02 ) );
+    event.El      = el;
+    event.pl      = pl;
+    event.cthl    = cthl;
+    event.pxl     = pl * sthl * cos( phil );
+    event.pyl     = pl * sthl * sin( phil );
+    event.pzl     = pl * cthl;
+
+    // Hadrons before FSI, as pdg codes
+    vector< int > hadrons;
+
+    if( channel == 0 ){
+        if( cc ) hadrons.push_back( 2212 );
+        else     hadrons.push_back( rand.Uniform() < 0.5 ? 2212 : 2112 );
+    }
+    else if( channel == 1 ){
+        hadrons.push_back( 2212 );
+        hadrons.push_back( rand.Uniform() < 0.6 ? 2112 : 2212 );
+    }
+    else if( channel == 2 ){
+        double c = rand.Uniform();
+        if( cc ){
+            hadrons.push_back( c < 0.75 ? 211 : 111 );
+            hadrons.push_back( c < 0.60 ? 2212 : 2112 );
+        }
+        else{
+            hadrons.push_back( c < 0.5 ? 111 : ( c < 0.75 ? 211 : -211 ) );
+            hadrons.push_back( c < 0.5 ? 2212 : 2112 );
+        }
+    }
+    else if( channel == 3 ){
+        int n_pi = 1 + rand.Poisson( 0.9 * ( w - 1.2 ) );
+        for( int i = 0; i < n_pi; ++i ){
+            double c = rand.Uniform();
+            hadrons.push_back( c < 0.40 ? 211 : ( c < 0.75 ? 111 : -211 ) );
+        }
+        hadrons.push_back( rand.Uniform() < 0.5 ? 2212 : 2112 );
+    }
+    else{
+        hadrons.push_back( cc ? 211 : 111 );
+    }
+
+    // FSI: pion absorption and nucleon knock-out
+    vector< int > final_state;
+    for( unsigned int i = 0; i < hadrons.size(); ++i ){
+        bool pion = hadrons[i] == 211 || hadrons[i] == -211 || hadrons[i] == 111;
+        if( pion && channel != 4 && rand.Uniform() < model.pi_absorption ){
+            final_state.push_back( rand.Uniform() < 0.5 ? 2212 : 2112 );
+        }
+        else{
+            final_state.push_back( hadrons[i] );
+        }
+    }
+    if( channel != 4 ){
+        int n_knock = rand.Poisson( model.knock_out * TMath::Min( nu / 0.3, 2. ) );
+        for( int i = 0; i < n_knock; ++i ){
+            final_state.push_back( rand.Uniform() < 0.45 ? 2212 : 2112 );
+        }
+    }
+
+    // Share the energy transfer, less the binding and pion masses, between
+    // the final state hadrons
+    double e_avail = nu - 0.025;
+    for( unsigned int i = 0; i < final_state.size(); ++i ){
+        if( final_state[i] == 111 )              e_avail -= m_pi0;
+        else if( abs( final_state[i] ) == 211 ) e_avail -= m_pic;
+    }
+    if( e_avail < 0 ) e_avail = 0;
+
+    vector< double > shares( final_state.size() );
+    double share_sum = 0;
+    for( unsigned int i = 0; i < final_state.size(); ++i ){
+        shares[i]  = rand.Exp( 1 );
+        share_sum += shares[i];
+    }
+
+    event.nf      = 0;
+    event.nfp     = 0;
+    event.nfn     = 0;
+    event.nfpip   = 0;
+    event.nfpim   = 0;
+    event.nfpi0   = 0;
+    event.nfkp    = 0;
+    event.nfkm    = 0;
+    event.nfk0    = 0;
+    event.nfem    = 0;
+    event.nfother = 0;
+    event.sumKEf  = 0;
+
+    for( unsigned int i = 0; i < final_state.size(); ++i ){
+
+        double ke = share_sum > 0 ? e_avail * shares[i] / share_sum : 0;
+        int pdg   = final_state[i];
+
+        // Every particle here is a hadron
+        event.sumKEf += ke;
+
+        if( pdg == 2212 ){
+            AddSyntheticParticle( rand, event, pdg, m_p, ke );
+            ++event.nfp;
+        }
+        else if( pdg == 2112 ){
+            AddSyntheticParticle( rand, event, pdg, m_n, ke );
+            ++event.nfn;
+        }
+        else if( pdg == 211 ){
+            AddSyntheticParticle( rand, event, pdg, m_pic, ke );
+            ++event.nfpip;
+        }
+        else if( pdg == -211 ){
+            AddSyntheticParticle( rand, event, pdg, m_pic, ke );
+            ++event.nfpim;
+        }
+        else if( pdg == 111 ){
+            AddSyntheticParticle( rand, event, pdg, m_pi0, ke );
+            ++event.nfpi0;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// Write the flux file
+// -------------------------------------------------------------------------
+void WriteSyntheticFlux( const string &path ){
+
+    TFile f( path.c_str(), "RECREATE" );
+
+    // 0.05 GeV bins, as assumed by Norm
+    TH1D *h_flux = new TH1D( "flux_pos_pol_numu", "Synthetic numu flux", 200, 0, 10 );
+
+    // Normalised to ~5e-10 numu / cm^2 / POT in total
+    double shape_sum = 0;
+    for( int i = 1; i <= 200; ++i ){
+        shape_sum += SyntheticFluxShape( h_flux->GetBinCenter(i) );
+    }
+    for( int i = 1; i <= 200; ++i ){
+        h_flux->SetBinContent( i, 5e-10 * SyntheticFluxShape( h_flux->GetBinCenter(i) ) / shape_sum );
+    }
+
+    h_flux->Write();
+    f.Close();
+}
+
+// -------------------------------------------------------------------------
+// Write the total cross section file for a model
+// -------------------------------------------------------------------------
+void WriteSyntheticXSec( const string &path,
+                         const SyntheticModel &model ){
+
+    TFile f( path.c_str(), "RECREATE" );
+    TDirectory *dir = f.mkdir( "nu_mu_Ar40" );
+    dir->cd();
+
+    int n_points = 100;
+    TGraph *g_cc = new TGraph( n_points );
+    TGraph *g_nc = new TGraph( n_points );
+
+    for( int i = 0; i < n_points; ++i ){
+        double e = 0.01 + i * 0.1;
+        g_cc->SetPoint( i, e, SyntheticXSecCC( e, model.xsec_scale ) );
+        g_nc->SetPoint( i, e, 0.37 * SyntheticXSecCC( e, model.xsec_scale ) );
+    }
+
+    g_cc->Write( "tot_cc" );
+    g_nc->Write( "tot_nc" );
+    f.Close();
+}
+
+// -------------------------------------------------------------------------
+// The weight of an event in a toy reweighting universe, shifted by
+// shifts[0], [1], [2] and [3] standard deviations in the MEC, RES, DIS
+// and COH normalisations of 30, 20, 10 and 50 % and by shifts[4] in the
+// slope of the QEL Q2 spectrum
+// -------------------------------------------------------------------------
+double SyntheticUniverseWeight( const GstEvent &event,
+                                const double *shifts ){
+
+    double weight = 1;
+
+    if( event.coh )      weight = 1 + 0.5 * shifts[3];
+    else if( event.qel ) weight = 1 + 0.2 * shifts[4] * ( event.Q2 - 0.3 );
+    else if( event.mec ) weight = 1 + 0.3 * shifts[0];
+    else if( event.res ) weight = 1 + 0.2 * shifts[1];
+    else if( event.dis ) weight = 1 + 0.1 * shifts[2];
+
+    return weight > 0 ? weight : 0;
+}
+
+// -------------------------------------------------------------------------
+// Write the gst file for a model, and with n_universes > 0 the weights of
+// each event in that many toy reweighting universes next to it, as
+// universe_weights.h reads them
+// -------------------------------------------------------------------------
+void WriteSyntheticGst( const string &path,
+                        const SyntheticModel &model,
+                        Long64_t n_events,
+                        unsigned int seed,
+                        int n_universes ){
+
+    TFile f( path.c_str(), "RECREATE" );
+    TTree *gst = new TTree( "gst", "GENIE Summary Event Tree" );
+
+    GstEvent event;
+    BranchGstEvent( gst, event );
+
+    TRandom3 rand( seed );
+
+    // The universes, each a set of shifts drawn once
+    const int        n_shifts = 5;
+    vector< double > shifts( n_universes * n_shifts );
+    vector< double > universe_weights( n_universes > 0 ? n_universes : 1 );
+
+    TRandom3 universe_rand( seed + 1000 );
+    for( unsigned int u = 0; u < shifts.size(); ++u ) shifts[u] = universe_rand.Gaus();
+
+    TFile *universe_file = 0;
+    TTree *universes     = 0;
+    Int_t  n_weights     = n_universes;
+
+    if( n_universes > 0 ){
+        universe_file = new TFile( GstUniversePath( path ).c_str(), "RECREATE" );
+        universes     = new TTree( kGstUniverseTree, "toy reweighting universes" );
+        universes->Branch( kGstUniverseCount, &n_weights, Form( "%s/I", kGstUniverseCount ) );
+        universes->Branch( kGstUniverseBranch, &universe_weights[0], Form( "%s[%s]/D", kGstUniverseBranch, kGstUniverseCount ) );
+    }
+
+    for( Long64_t i = 0; i < n_events; ++i ){
+
+        GenerateSyntheticEvent( rand, model, int(i), event );
+        gst->Fill();
+
+        if( universes ){
+            for( int u = 0; u < n_universes; ++u ){
+                universe_weights[u] = SyntheticUniverseWeight( event, &shifts[ u * n_shifts ] );
+            }
+            universes->Fill();
+        }
+
+        if( n_events >= 10 && ( i + 1 ) % ( n_events / 10 ) == 0 ){
+            cout << " " << model.name << " : " << i + 1 << " / " << n_events << " events " << endl;
+        }
+    }
+
+    f.cd();
+    gst->Write();
+    f.Close();
+
+    // The weights record the stamp of the gst file once it is written,
+    // which AttachGstUniverses checks them against
+    if( universe_file ){
+        TFile gst_file( path.c_str() );
+        TTree *written = (TTree*) gst_file.Get( "gst" );
+
+        universe_file->cd();
+        universes->Write();
+        WriteGstUniverseSource( written );
+        universe_file->Close();
+        delete universe_file;
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          The macro
+// -------------------------------------------------------------------------
+int make_synthetic_gst( Long64_t n_events = 1000000,
+                        const char* out_dir = "synthetic",
+                        unsigned int seed = 1,
+                        int n_universes = 0 ){
+
+    if( n_events < 1 ){
+        cerr << " The number of events should be positive " << endl;
+        exit(1);
+    }
+
+    string base = out_dir;
+
+    string flux_dir = base + "/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone";
+    gSystem->mkdir( flux_dir.c_str(), kTRUE );
+    WriteSyntheticFlux( flux_dir + "/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root" );
+
+    cout << " Synthetic flux file written " << endl;
+
+    for( int i = 0; i < n_synthetic_models; ++i ){
+
+        string model_dir = base + "/Exercises/Flavours/" + synthetic_models[i].name;
+
+        gSystem->mkdir( ( model_dir + "/xsec_files" ).c_str(), kTRUE );
+        gSystem->mkdir( ( model_dir + "/sbnd/1M" ).c_str(), kTRUE );
+
+        WriteSyntheticXSec( model_dir + "/xsec_files/total_xsec.root", synthetic_models[i] );
+        WriteSyntheticGst( model_dir + "/sbnd/1M/gntp.10000.gst.root", synthetic_models[i], n_events, 100 * seed + i, n_universes );
+
+        cout << " " << synthetic_models[i].name << " files written " << endl;
+    }
+
+    return 0;
+}
@@ -24,7 +24,7 @@
 
 using namespace std; 
 
-int model_comparisons() {
+int model_comparisons( unsigned int n_threads = 0 ) {
 
     // -------------------------------------------------------------------------
     // Normalisation:
@@ -59,7 +59,7 @@ int model_comparisons() {
     //                              Open flux file
     // -------------------------------------------------------------------------
     
-    TFile f_flux("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root");
+    TFile f_flux( InputPath("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root").c_str() );
     if (f_flux.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -73,7 +73,7 @@ int model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Default
-    TFile f1_xsec("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root");
+    TFile f1_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root").c_str() );
     if (f1_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -83,7 +83,7 @@ int model_comparisons() {
     }
     
     // Default+MEC
-    TFile f2_xsec("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root");
+    TFile f2_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root").c_str() );
     if (f2_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -93,7 +93,7 @@ int model_comparisons() {
     }
     
     // G16_02b
-    TFile f3_xsec("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root");
+    TFile f3_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root").c_str() );
     if (f3_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -103,7 +103,7 @@ int model_comparisons() {
     }
     
     // G16_01a
-    TFile f4_xsec("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root");
+    TFile f4_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root").c_str() );
     if (f4_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -113,7 +113,7 @@ int model_comparisons() {
     }
     
     // G16_01b
-    TFile f5_xsec("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root");
+    TFile f5_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root").c_str() );
     if (f5_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -127,7 +127,7 @@ int model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Open Default
-    TFile f1("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root");
+    TFile f1( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f1.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -137,7 +137,7 @@ int model_comparisons() {
     }
 
     // Open Default+MEC
-    TFile f2("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root");
+    TFile f2( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f2.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -147,7 +147,7 @@ int model_comparisons() {
     }
 
     // Open G16_02b
-    TFile f3("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root");
+    TFile f3( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f3.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -157,7 +157,7 @@ int model_comparisons() {
     }
 
     // Open G16_01a
-    TFile f4("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root");
+    TFile f4( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f4.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -167,7 +167,7 @@ int model_comparisons() {
     }
 
     // Open G16_01b
-    TFile f5("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root");
+    TFile f5( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f5.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -186,6 +186,628 @@ int model_comparisons() {
     TTree *gst3 = (TTree*) f3.Get("gst");
     TTree *gst4 = (TTree*) f4.Get("gst");
     TTree *gst5 = (TTree*) f5.Get("gst");
+
+    // -------------------------------------------------------------------------
+    //                      Book the fills of the histograms
+    // -------------------------------------------------------------------------
+    // The histograms of the plots below are booked here, and all of the
+    // fills of a model are then run in one pass by RunFlatBatch
+    FlatBatch batch;
+
+    // Q2 Absolute norm CC0pi
+    TH1D *h1_Q2_abs_cc0pi = new TH1D("h1_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
+    TH1D *h2_Q2_abs_cc0pi = new TH1D("h2_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
+    TH1D *h3_Q2_abs_cc0pi = new TH1D("h3_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
+    TH1D *h4_Q2_abs_cc0pi = new TH1D("h4_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
+    TH1D *h5_Q2_abs_cc0pi = new TH1D("h5_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_abs_cc0pi", kCC0Pi );
+
+    // Q2 Absolute norm CC1pip
+    TH1D *h1_Q2_abs_cc1pip = new TH1D("h1_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
+    TH1D *h2_Q2_abs_cc1pip = new TH1D("h2_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
+    TH1D *h3_Q2_abs_cc1pip = new TH1D("h3_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
+    TH1D *h4_Q2_abs_cc1pip = new TH1D("h4_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
+    TH1D *h5_Q2_abs_cc1pip = new TH1D("h5_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_abs_cc1pip", kCC1PiP );
+
+    // Q2 Absolute norm CC1pi0
+    TH1D *h1_Q2_abs_cc1pi0 = new TH1D("h1_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
+    TH1D *h2_Q2_abs_cc1pi0 = new TH1D("h2_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
+    TH1D *h3_Q2_abs_cc1pi0 = new TH1D("h3_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
+    TH1D *h4_Q2_abs_cc1pi0 = new TH1D("h4_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
+    TH1D *h5_Q2_abs_cc1pi0 = new TH1D("h5_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_abs_cc1pi0", kCC1Pi0 );
+
+    // Q2 Absolute norm NC1pi0
+    TH1D *h1_Q2_abs_nc1pi0 = new TH1D("h1_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
+    TH1D *h2_Q2_abs_nc1pi0 = new TH1D("h2_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
+    TH1D *h3_Q2_abs_nc1pi0 = new TH1D("h3_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
+    TH1D *h4_Q2_abs_nc1pi0 = new TH1D("h4_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
+    TH1D *h5_Q2_abs_nc1pi0 = new TH1D("h5_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_abs_nc1pi0", kNC1Pi0 );
+
+    // Q2 Area norm CC0pi
+    TH1D *h1_Q2_area_cc0pi = new TH1D("h1_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
+    TH1D *h2_Q2_area_cc0pi = new TH1D("h2_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
+    TH1D *h3_Q2_area_cc0pi = new TH1D("h3_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
+    TH1D *h4_Q2_area_cc0pi = new TH1D("h4_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
+    TH1D *h5_Q2_area_cc0pi = new TH1D("h5_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_area_cc0pi", kCC0Pi );
+
+    // Q2 Area norm CC1pip
+    TH1D *h1_Q2_area_cc1pip = new TH1D("h1_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
+    TH1D *h2_Q2_area_cc1pip = new TH1D("h2_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
+    TH1D *h3_Q2_area_cc1pip = new TH1D("h3_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
+    TH1D *h4_Q2_area_cc1pip = new TH1D("h4_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
+    TH1D *h5_Q2_area_cc1pip = new TH1D("h5_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_area_cc1pip", kCC1PiP );
+
+    // Q2 Area norm CC1pi0
+    TH1D *h1_Q2_area_cc1pi0 = new TH1D("h1_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
+    TH1D *h2_Q2_area_cc1pi0 = new TH1D("h2_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
+    TH1D *h3_Q2_area_cc1pi0 = new TH1D("h3_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
+    TH1D *h4_Q2_area_cc1pi0 = new TH1D("h4_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
+    TH1D *h5_Q2_area_cc1pi0 = new TH1D("h5_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_area_cc1pi0", kCC1Pi0 );
+
+    // Q2 Area norm NC1pi0
+    TH1D *h1_Q2_area_nc1pi0 = new TH1D("h1_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
+    TH1D *h2_Q2_area_nc1pi0 = new TH1D("h2_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
+    TH1D *h3_Q2_area_nc1pi0 = new TH1D("h3_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
+    TH1D *h4_Q2_area_nc1pi0 = new TH1D("h4_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
+    TH1D *h5_Q2_area_nc1pi0 = new TH1D("h5_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
+
+    FlatBook( batch, gst1, "Q2>>h1_Q2_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst2, "Q2>>h2_Q2_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst3, "Q2>>h3_Q2_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst4, "Q2>>h4_Q2_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst5, "Q2>>h5_Q2_area_nc1pi0", kNC1Pi0 );
+
+    // Ev Absolute norm CC0pi
+    TH1D *h1_Ev_abs_cc0pi = new TH1D("h1_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
+    TH1D *h2_Ev_abs_cc0pi = new TH1D("h2_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
+    TH1D *h3_Ev_abs_cc0pi = new TH1D("h3_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
+    TH1D *h4_Ev_abs_cc0pi = new TH1D("h4_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
+    TH1D *h5_Ev_abs_cc0pi = new TH1D("h5_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_abs_cc0pi", kCC0Pi );
+
+    // Ev Absolute norm CC1pip
+    TH1D *h1_Ev_abs_cc1pip = new TH1D("h1_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
+    TH1D *h2_Ev_abs_cc1pip = new TH1D("h2_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
+    TH1D *h3_Ev_abs_cc1pip = new TH1D("h3_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
+    TH1D *h4_Ev_abs_cc1pip = new TH1D("h4_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
+    TH1D *h5_Ev_abs_cc1pip = new TH1D("h5_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_abs_cc1pip", kCC1PiP );
+
+    // Ev Absolute norm CC1pi0
+    TH1D *h1_Ev_abs_cc1pi0 = new TH1D("h1_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
+    TH1D *h2_Ev_abs_cc1pi0 = new TH1D("h2_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
+    TH1D *h3_Ev_abs_cc1pi0 = new TH1D("h3_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
+    TH1D *h4_Ev_abs_cc1pi0 = new TH1D("h4_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
+    TH1D *h5_Ev_abs_cc1pi0 = new TH1D("h5_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_abs_cc1pi0", kCC1Pi0 );
+
+    // Ev Absolute norm NC1pi0
+    TH1D *h1_Ev_abs_nc1pi0 = new TH1D("h1_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
+    TH1D *h2_Ev_abs_nc1pi0 = new TH1D("h2_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
+    TH1D *h3_Ev_abs_nc1pi0 = new TH1D("h3_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
+    TH1D *h4_Ev_abs_nc1pi0 = new TH1D("h4_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
+    TH1D *h5_Ev_abs_nc1pi0 = new TH1D("h5_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_abs_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_abs_nc1pi0", kNC1Pi0 );
+
+    // Ev Area norm CC0pi
+    TH1D *h1_Ev_area_cc0pi = new TH1D("h1_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
+    TH1D *h2_Ev_area_cc0pi = new TH1D("h2_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
+    TH1D *h3_Ev_area_cc0pi = new TH1D("h3_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
+    TH1D *h4_Ev_area_cc0pi = new TH1D("h4_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
+    TH1D *h5_Ev_area_cc0pi = new TH1D("h5_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_area_cc0pi", kCC0Pi );
+
+    // Ev Area norm CC1pip
+    TH1D *h1_Ev_area_cc1pip = new TH1D("h1_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
+    TH1D *h2_Ev_area_cc1pip = new TH1D("h2_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
+    TH1D *h3_Ev_area_cc1pip = new TH1D("h3_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
+    TH1D *h4_Ev_area_cc1pip = new TH1D("h4_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
+    TH1D *h5_Ev_area_cc1pip = new TH1D("h5_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_area_cc1pip", kCC1PiP );
+
+    // Ev Area norm CC1pi0
+    TH1D *h1_Ev_area_cc1pi0 = new TH1D("h1_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
+    TH1D *h2_Ev_area_cc1pi0 = new TH1D("h2_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
+    TH1D *h3_Ev_area_cc1pi0 = new TH1D("h3_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
+    TH1D *h4_Ev_area_cc1pi0 = new TH1D("h4_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
+    TH1D *h5_Ev_area_cc1pi0 = new TH1D("h5_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_area_cc1pi0", kCC1Pi0 );
+
+    // Ev Area norm NC1pi0
+    TH1D *h1_Ev_area_nc1pi0 = new TH1D("h1_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
+    TH1D *h2_Ev_area_nc1pi0 = new TH1D("h2_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
+    TH1D *h3_Ev_area_nc1pi0 = new TH1D("h3_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
+    TH1D *h4_Ev_area_nc1pi0 = new TH1D("h4_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
+    TH1D *h5_Ev_area_nc1pi0 = new TH1D("h5_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
+
+    FlatBook( batch, gst1, "Ev>>h1_Ev_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst2, "Ev>>h2_Ev_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst3, "Ev>>h3_Ev_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst4, "Ev>>h4_Ev_area_nc1pi0", kNC1Pi0 );
+    FlatBook( batch, gst5, "Ev>>h5_Ev_area_nc1pi0", kNC1Pi0 );
+
+    // CosThetaPi Absolute norm CC1pip
+    TH1D *h1_CosThPi_abs_cc1pip = new TH1D("h1_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h2_CosThPi_abs_cc1pip = new TH1D("h2_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h3_CosThPi_abs_cc1pip = new TH1D("h3_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h4_CosThPi_abs_cc1pip = new TH1D("h4_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h5_CosThPi_abs_cc1pip = new TH1D("h5_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthf>>h1_CosThPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst2, "cthf>>h2_CosThPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst3, "cthf>>h3_CosThPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst4, "cthf>>h4_CosThPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst5, "cthf>>h5_CosThPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+
+    // CosThetaPi Absolute norm CC1pi0
+    TH1D *h1_CosThPi_abs_cc1pi0 = new TH1D("h1_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h2_CosThPi_abs_cc1pi0 = new TH1D("h2_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h3_CosThPi_abs_cc1pi0 = new TH1D("h3_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h4_CosThPi_abs_cc1pi0 = new TH1D("h4_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h5_CosThPi_abs_cc1pi0 = new TH1D("h5_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthf>>h1_CosThPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "cthf>>h2_CosThPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "cthf>>h3_CosThPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "cthf>>h4_CosThPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "cthf>>h5_CosThPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+
+    // CosThetaPi Absolute norm NC1pi0
+    TH1D *h1_CosThPi_abs_nc1pi0 = new TH1D("h1_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
+    TH1D *h2_CosThPi_abs_nc1pi0 = new TH1D("h2_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
+    TH1D *h3_CosThPi_abs_nc1pi0 = new TH1D("h3_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
+    TH1D *h4_CosThPi_abs_nc1pi0 = new TH1D("h4_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
+    TH1D *h5_CosThPi_abs_nc1pi0 = new TH1D("h5_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthf>>h1_CosThPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "cthf>>h2_CosThPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "cthf>>h3_CosThPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "cthf>>h4_CosThPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "cthf>>h5_CosThPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+
+    // CosThetaPi Area norm CC1pip
+    TH1D *h1_CosThPi_area_cc1pip = new TH1D("h1_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h2_CosThPi_area_cc1pip = new TH1D("h2_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h3_CosThPi_area_cc1pip = new TH1D("h3_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h4_CosThPi_area_cc1pip = new TH1D("h4_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h5_CosThPi_area_cc1pip = new TH1D("h5_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthf>>h1_CosThPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst2, "cthf>>h2_CosThPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst3, "cthf>>h3_CosThPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst4, "cthf>>h4_CosThPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst5, "cthf>>h5_CosThPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+
+    // CosThetaPi Area norm CC1pi0
+    TH1D *h1_CosThPi_area_cc1pi0 = new TH1D("h1_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h2_CosThPi_area_cc1pi0 = new TH1D("h2_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h3_CosThPi_area_cc1pi0 = new TH1D("h3_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h4_CosThPi_area_cc1pi0 = new TH1D("h4_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h5_CosThPi_area_cc1pi0 = new TH1D("h5_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthf>>h1_CosThPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "cthf>>h2_CosThPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "cthf>>h3_CosThPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "cthf>>h4_CosThPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "cthf>>h5_CosThPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+
+    // CosTheta Area norm NC1pi0
+    TH1D *h1_CosThPi_area_nc1pi0 = new TH1D("h1_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
+    TH1D *h2_CosThPi_area_nc1pi0 = new TH1D("h2_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
+    TH1D *h3_CosThPi_area_nc1pi0 = new TH1D("h3_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
+    TH1D *h4_CosThPi_area_nc1pi0 = new TH1D("h4_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
+    TH1D *h5_CosThPi_area_nc1pi0 = new TH1D("h5_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthf>>h1_CosThPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "cthf>>h2_CosThPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "cthf>>h3_CosThPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "cthf>>h4_CosThPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "cthf>>h5_CosThPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+
+    // PPi Absolute norm CC1pip
+    TH1D *h1_PPi_abs_cc1pip = new TH1D("h1_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h2_PPi_abs_cc1pip = new TH1D("h2_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h3_PPi_abs_cc1pip = new TH1D("h3_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h4_PPi_abs_cc1pip = new TH1D("h4_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h5_PPi_abs_cc1pip = new TH1D("h5_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pf>>h1_PPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst2, "pf>>h2_PPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst3, "pf>>h3_PPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst4, "pf>>h4_PPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst5, "pf>>h5_PPi_abs_cc1pip", kCC1PiP, "pdgf == 211" );
+
+    // PPi Absolute norm CC1pi0
+    TH1D *h1_PPi_abs_cc1pi0 = new TH1D("h1_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h2_PPi_abs_cc1pi0 = new TH1D("h2_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h3_PPi_abs_cc1pi0 = new TH1D("h3_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h4_PPi_abs_cc1pi0 = new TH1D("h4_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h5_PPi_abs_cc1pi0 = new TH1D("h5_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pf>>h1_PPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "pf>>h2_PPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "pf>>h3_PPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "pf>>h4_PPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "pf>>h5_PPi_abs_cc1pi0", kCC1Pi0, "pdgf == 111" );
+
+    // PPi Absolute norm NC1pi0
+    TH1D *h1_PPi_abs_nc1pi0 = new TH1D("h1_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
+    TH1D *h2_PPi_abs_nc1pi0 = new TH1D("h2_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
+    TH1D *h3_PPi_abs_nc1pi0 = new TH1D("h3_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
+    TH1D *h4_PPi_abs_nc1pi0 = new TH1D("h4_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
+    TH1D *h5_PPi_abs_nc1pi0 = new TH1D("h5_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pf>>h1_PPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "pf>>h2_PPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "pf>>h3_PPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "pf>>h4_PPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "pf>>h5_PPi_abs_nc1pi0", kNC1Pi0, "pdgf == 111" );
+
+    // PPi Area norm CC1pip
+    TH1D *h1_PPi_area_cc1pip = new TH1D("h1_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h2_PPi_area_cc1pip = new TH1D("h2_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h3_PPi_area_cc1pip = new TH1D("h3_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h4_PPi_area_cc1pip = new TH1D("h4_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h5_PPi_area_cc1pip = new TH1D("h5_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pf>>h1_PPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst2, "pf>>h2_PPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst3, "pf>>h3_PPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst4, "pf>>h4_PPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+    FlatBook( batch, gst5, "pf>>h5_PPi_area_cc1pip", kCC1PiP, "pdgf == 211" );
+
+    // PPi Area norm CC1pi0
+    TH1D *h1_PPi_area_cc1pi0 = new TH1D("h1_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h2_PPi_area_cc1pi0 = new TH1D("h2_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h3_PPi_area_cc1pi0 = new TH1D("h3_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h4_PPi_area_cc1pi0 = new TH1D("h4_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h5_PPi_area_cc1pi0 = new TH1D("h5_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pf>>h1_PPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "pf>>h2_PPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "pf>>h3_PPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "pf>>h4_PPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "pf>>h5_PPi_area_cc1pi0", kCC1Pi0, "pdgf == 111" );
+
+    // CosTheta Area norm NC1pi0
+    TH1D *h1_PPi_area_nc1pi0 = new TH1D("h1_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
+    TH1D *h2_PPi_area_nc1pi0 = new TH1D("h2_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
+    TH1D *h3_PPi_area_nc1pi0 = new TH1D("h3_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
+    TH1D *h4_PPi_area_nc1pi0 = new TH1D("h4_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
+    TH1D *h5_PPi_area_nc1pi0 = new TH1D("h5_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pf>>h1_PPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst2, "pf>>h2_PPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst3, "pf>>h3_PPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst4, "pf>>h4_PPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+    FlatBook( batch, gst5, "pf>>h5_PPi_area_nc1pi0", kNC1Pi0, "pdgf == 111" );
+
+    // CosThetaMu Absolute norm cc0pi
+    TH1D *h1_CosThMu_abs_cc0pi = new TH1D("h1_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
+    TH1D *h2_CosThMu_abs_cc0pi = new TH1D("h2_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
+    TH1D *h3_CosThMu_abs_cc0pi = new TH1D("h3_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
+    TH1D *h4_CosThMu_abs_cc0pi = new TH1D("h4_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
+    TH1D *h5_CosThMu_abs_cc0pi = new TH1D("h5_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
+
+    FlatBook( batch, gst1, "cthl>>h1_CosThMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "cthl>>h2_CosThMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "cthl>>h3_CosThMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "cthl>>h4_CosThMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "cthl>>h5_CosThMu_abs_cc0pi", kCC0Pi );
+
+    // CosThetaMu Absolute norm CC1pip
+    TH1D *h1_CosThMu_abs_cc1pip = new TH1D("h1_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h2_CosThMu_abs_cc1pip = new TH1D("h2_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h3_CosThMu_abs_cc1pip = new TH1D("h3_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h4_CosThMu_abs_cc1pip = new TH1D("h4_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+    TH1D *h5_CosThMu_abs_cc1pip = new TH1D("h5_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthl>>h1_CosThMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "cthl>>h2_CosThMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "cthl>>h3_CosThMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "cthl>>h4_CosThMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "cthl>>h5_CosThMu_abs_cc1pip", kCC1PiP );
+
+    // CosThetaMu Absolute norm CC1pi0
+    TH1D *h1_CosThMu_abs_cc1pi0 = new TH1D("h1_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h2_CosThMu_abs_cc1pi0 = new TH1D("h2_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h3_CosThMu_abs_cc1pi0 = new TH1D("h3_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h4_CosThMu_abs_cc1pi0 = new TH1D("h4_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+    TH1D *h5_CosThMu_abs_cc1pi0 = new TH1D("h5_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthl>>h1_CosThMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "cthl>>h2_CosThMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "cthl>>h3_CosThMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "cthl>>h4_CosThMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "cthl>>h5_CosThMu_abs_cc1pi0", kCC1Pi0 );
+
+    // CosTheta Area norm cc0pi
+    TH1D *h1_CosThMu_area_cc0pi = new TH1D("h1_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
+    TH1D *h2_CosThMu_area_cc0pi = new TH1D("h2_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
+    TH1D *h3_CosThMu_area_cc0pi = new TH1D("h3_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
+    TH1D *h4_CosThMu_area_cc0pi = new TH1D("h4_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
+    TH1D *h5_CosThMu_area_cc0pi = new TH1D("h5_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
+
+    FlatBook( batch, gst1, "cthl>>h1_CosThMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "cthl>>h2_CosThMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "cthl>>h3_CosThMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "cthl>>h4_CosThMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "cthl>>h5_CosThMu_area_cc0pi", kCC0Pi );
+
+    // CosThetaMu Area norm CC1pip
+    TH1D *h1_CosThMu_area_cc1pip = new TH1D("h1_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h2_CosThMu_area_cc1pip = new TH1D("h2_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h3_CosThMu_area_cc1pip = new TH1D("h3_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h4_CosThMu_area_cc1pip = new TH1D("h4_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    TH1D *h5_CosThMu_area_cc1pip = new TH1D("h5_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthl>>h1_CosThMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "cthl>>h2_CosThMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "cthl>>h3_CosThMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "cthl>>h4_CosThMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "cthl>>h5_CosThMu_area_cc1pip", kCC1PiP );
+
+    // CosThetaMu Area norm CC1pi0
+    TH1D *h1_CosThMu_area_cc1pi0 = new TH1D("h1_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h2_CosThMu_area_cc1pi0 = new TH1D("h2_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h3_CosThMu_area_cc1pi0 = new TH1D("h3_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h4_CosThMu_area_cc1pi0 = new TH1D("h4_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
+    TH1D *h5_CosThMu_area_cc1pi0 = new TH1D("h5_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
+
+    FlatBook( batch, gst1, "cthl>>h1_CosThMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "cthl>>h2_CosThMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "cthl>>h3_CosThMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "cthl>>h4_CosThMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "cthl>>h5_CosThMu_area_cc1pi0", kCC1Pi0 );
+
+    // PMu Absolute norm cc0pi
+    TH1D *h1_PMu_abs_cc0pi = new TH1D("h1_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
+    TH1D *h2_PMu_abs_cc0pi = new TH1D("h2_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
+    TH1D *h3_PMu_abs_cc0pi = new TH1D("h3_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
+    TH1D *h4_PMu_abs_cc0pi = new TH1D("h4_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
+    TH1D *h5_PMu_abs_cc0pi = new TH1D("h5_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
+
+    FlatBook( batch, gst1, "pl>>h1_PMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "pl>>h2_PMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "pl>>h3_PMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "pl>>h4_PMu_abs_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "pl>>h5_PMu_abs_cc0pi", kCC0Pi );
+
+    // PMu Absolute norm CC1pip
+    TH1D *h1_PMu_abs_cc1pip = new TH1D("h1_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h2_PMu_abs_cc1pip = new TH1D("h2_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h3_PMu_abs_cc1pip = new TH1D("h3_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h4_PMu_abs_cc1pip = new TH1D("h4_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+    TH1D *h5_PMu_abs_cc1pip = new TH1D("h5_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pl>>h1_PMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "pl>>h2_PMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "pl>>h3_PMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "pl>>h4_PMu_abs_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "pl>>h5_PMu_abs_cc1pip", kCC1PiP );
+
+    // PMu Absolute norm CC1pi0
+    TH1D *h1_PMu_abs_cc1pi0 = new TH1D("h1_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h2_PMu_abs_cc1pi0 = new TH1D("h2_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h3_PMu_abs_cc1pi0 = new TH1D("h3_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h4_PMu_abs_cc1pi0 = new TH1D("h4_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+    TH1D *h5_PMu_abs_cc1pi0 = new TH1D("h5_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pl>>h1_PMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "pl>>h2_PMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "pl>>h3_PMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "pl>>h4_PMu_abs_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "pl>>h5_PMu_abs_cc1pi0", kCC1Pi0 );
+
+    // PMu Area norm cc0pi
+    TH1D *h1_PMu_area_cc0pi = new TH1D("h1_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
+    TH1D *h2_PMu_area_cc0pi = new TH1D("h2_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
+    TH1D *h3_PMu_area_cc0pi = new TH1D("h3_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
+    TH1D *h4_PMu_area_cc0pi = new TH1D("h4_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
+    TH1D *h5_PMu_area_cc0pi = new TH1D("h5_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
+
+    FlatBook( batch, gst1, "pl>>h1_PMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "pl>>h2_PMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "pl>>h3_PMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "pl>>h4_PMu_area_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "pl>>h5_PMu_area_cc0pi", kCC0Pi );
+
+    // PMu Area norm CC1pip
+    TH1D *h1_PMu_area_cc1pip = new TH1D("h1_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h2_PMu_area_cc1pip = new TH1D("h2_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h3_PMu_area_cc1pip = new TH1D("h3_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h4_PMu_area_cc1pip = new TH1D("h4_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
+    TH1D *h5_PMu_area_cc1pip = new TH1D("h5_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pl>>h1_PMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst2, "pl>>h2_PMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst3, "pl>>h3_PMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst4, "pl>>h4_PMu_area_cc1pip", kCC1PiP );
+    FlatBook( batch, gst5, "pl>>h5_PMu_area_cc1pip", kCC1PiP );
+
+    // PMu Area norm CC1pi0
+    TH1D *h1_PMu_area_cc1pi0 = new TH1D("h1_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h2_PMu_area_cc1pi0 = new TH1D("h2_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h3_PMu_area_cc1pi0 = new TH1D("h3_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h4_PMu_area_cc1pi0 = new TH1D("h4_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
+    TH1D *h5_PMu_area_cc1pi0 = new TH1D("h5_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
+
+    FlatBook( batch, gst1, "pl>>h1_PMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst2, "pl>>h2_PMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst3, "pl>>h3_PMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst4, "pl>>h4_PMu_area_cc1pi0", kCC1Pi0 );
+    FlatBook( batch, gst5, "pl>>h5_PMu_area_cc1pi0", kCC1Pi0 );
+
+    // The trees of the models, for the fills booked in turn for each
+    TTree *model_trees[5] = { gst1, gst2, gst3, gst4, gst5 };
+
+    // Bootstrap errors of the FSI counts, fsi1_CC0Pi to fsi5_NCCOH
+    for( int i = 0; i < 5; ++i ){
+        BookFSIErrors( batch, model_trees[i], Form( "fsi%d", i + 1 ), kBootstrapReplicas );
+    }
+
+    // Q2 with bootstrap statistical errors, CC0pi
+    TH1D *h_Q2_stat_cc0pi[5];
+
+    for( int i = 0; i < 5; ++i ){
+        h_Q2_stat_cc0pi[i] = new TH1D( Form( "h%d_Q2_stat_cc0pi", i + 1 ), "Q^{2} with statistical errors, CC0#pi", 40, 0, 2 );
+        BookFlatReplicas( FlatBook( batch, model_trees[i], Form( "Q2>>h%d_Q2_stat_cc0pi", i + 1 ), kCC0Pi ), kBootstrapReplicas );
+    }
+
+    // W, TKI and hadronic energy, CC0pi, from the fused kinematics kernel
+    const int n_kinematic_plots = 4;
+    int         kinematic_vars[n_kinematic_plots]   = { kKinW, kKinDpT, kKinDalphaT, kKinEHad };
+    int         kinematic_bins[n_kinematic_plots]   = { 40, 40, 36, 40 };
+    double      kinematic_max[n_kinematic_plots]    = { 2, 1, TMath::Pi(), 2 };
+    const char* kinematic_titles[n_kinematic_plots] = { "W Absolute Normalisation, CC0#pi", "#delta p_{T} Absolute Normalisation, CC0#pi",
+                                                        "#delta #alpha_{T} Absolute Normalisation, CC0#pi", "E_{had} Absolute Normalisation, CC0#pi" };
+    const char* kinematic_files[n_kinematic_plots]  = { "W_CC0Pi_Plot.png", "dpT_CC0Pi_Plot.png", "dalphaT_CC0Pi_Plot.png", "Ehad_CC0Pi_Plot.png" };
+    const char* kinematic_axes[n_kinematic_plots]   = { "W", "#delta p_{T}", "#delta #alpha_{T}", "E_{had}" };
+
+    vector< vector< TH1D* > > kinematic_stacks( n_kinematic_plots );
+
+    for( int j = 0; j < n_kinematic_plots; ++j ){
+        for( int i = 0; i < 5; ++i ){
+            const char* name = Form( "h%d_%s_cc0pi", i + 1, KinematicName( kinematic_vars[j] ) );
+            kinematic_stacks[j].push_back( new TH1D( name, kinematic_titles[j], kinematic_bins[j], 0, kinematic_max[j] ) );
+            FlatBookKinematics( batch, model_trees[i], kinematic_stacks[j].back()->GetName(), kCC0Pi, kinematic_vars[j] );
+        }
+    }
+
+    // Q2 in each reweighting universe, CC0pi, only for the models with
+    // universe weights written next to the gst file
+    bool with_universes[5];
+
+    for( int i = 0; i < 5; ++i ){
+
+        with_universes[i] = AttachGstUniverses( model_trees[i] );
+        if( !with_universes[i] ) continue;
+
+        FlatFill universe_fill;
+        universe_fill.variable      = "Q2";
+        universe_fill.topology_mask = TopologyBit( kCC0Pi );
+        BookFlatHist( universe_fill.hist, 40, 0, 2 );
+        BookFlatUniverses( universe_fill, GstUniverseCount( model_trees[i] ) );
+
+        FlatBook( batch, model_trees[i], Form( "universes%d_Q2_cc0pi", i + 1 ), universe_fill );
+    }
+
+    // Ev of the CC events at every point of the 3+1 grid, the grid being set
+    // for the batch pass and cleared once the sensitivities are read
+    OscillationGrid sterile_grid;
+    BookOscillationGrid( sterile_grid, kOscDisappearance, 40, 0.1, 100, 40, 1e-3, 1 );
+    SetFlatOscillations( &sterile_grid );
+
+    for( int i = 0; i < 5; ++i ){
+
+        FlatFill sterile_fill;
+        sterile_fill.variable  = "Ev";
+        sterile_fill.selection = "cc";
+        BookFlatHist( sterile_fill.hist, 60, 0, 3 );
+        BookFlatOscillations( sterile_fill );
+
+        FlatBook( batch, model_trees[i], Form( "sterile%d_Ev_cc", i + 1 ), sterile_fill );
+    }
+
+    // -------------------------------------------------------------------------
+    //                     Set up the reads of the gst trees
+    // -------------------------------------------------------------------------
+    // Only the branches needed by the fills are read from the files
+    // With n_threads > 1 the branches are read and unzipped in parallel
+    vector< string > planned_fills;
+
+    // Those of the histograms booked above, then those of the FSI counts
+    // and of the Q2 and Ev fills further down
+    FlatBatchExpressions( batch, planned_fills );
+    planned_fills.push_back( "Q2" );
+    planned_fills.push_back( "Ev" );
+    planned_fills.push_back( "cc && coh" );
+    planned_fills.push_back( "nc && coh" );
+    planned_fills.push_back( kTopologyFill );
+
+    SetGstThreads( n_threads );
+
+    OpenGstReader( gst1, planned_fills );
+    OpenGstReader( gst2, planned_fills );
+    OpenGstReader( gst3, planned_fills );
+    OpenGstReader( gst4, planned_fills );
+    OpenGstReader( gst5, planned_fills );
     
     // -------------------------------------------------------------------------
     //                          Get the normalisations
@@ -293,7 +915,46 @@ int model_comparisons() {
     ofstream file_mc;
     file_mc.open( "FSI_MC_Table.tex" );
     MakeTable( cc_mc_model_ints, nc_mc_model_ints, FHS, file_mc );
-    
+
+    // -------------------------------------------------------------------------
+    //                      Fill the histograms of each model
+    // -------------------------------------------------------------------------
+    // Each histogram is split by interaction channel in the same pass, and
+    // the channels are written to model_comparisons_channels.root
+    RunFlatBatch( batch );
+
+    TFile f_channels( "model_comparisons_channels.root", "RECREATE" );
+    WriteFlatBatchChannels( batch, &f_channels );
+    f_channels.Close();
+
+    // The statistical errors of the counts, from the replicas filled with
+    // the histograms, in tables of the same layout
+    m_outer cc_mc_model_errs;
+    m_outer nc_mc_model_errs;
+    m_outer cc_reco_model_errs;
+    m_outer nc_reco_model_errs;
+
+    const char* fsi_names[5] = { "Default", "Default + MEC", "G17\\_02b", "G17\\_01a", "G17\\_01b" };
+
+    for( int i = 0; i < 5; ++i ){
+
+        vector< double > n_cc_fsi_err, n_nc_fsi_err, n_cc_mc_fsi_err, n_nc_mc_fsi_err;
+        FSIErrors( batch, Form( "fsi%d", i + 1 ), norms[i], n_cc_fsi_err, n_nc_fsi_err, n_cc_mc_fsi_err, n_nc_mc_fsi_err );
+
+        cc_reco_model_errs.insert( pair< string, vector< double > >( fsi_names[i], n_cc_fsi_err ) );
+        nc_reco_model_errs.insert( pair< string, vector< double > >( fsi_names[i], n_nc_fsi_err ) );
+        cc_mc_model_errs.insert( pair< string, vector< double > >( fsi_names[i], n_cc_mc_fsi_err ) );
+        nc_mc_model_errs.insert( pair< string, vector< double > >( fsi_names[i], n_nc_mc_fsi_err ) );
+    }
+
+    ofstream file_reco_err;
+    file_reco_err.open( "FSI_Reco_Errors_Table.tex" );
+    MakeTable( cc_reco_model_errs, nc_reco_model_errs, FHS, file_reco_err );
+
+    ofstream file_mc_err;
+    file_mc_err.open( "FSI_MC_Errors_Table.tex" );
+    MakeTable( cc_mc_model_errs, nc_mc_model_errs, FHS, file_mc_err );
+
     // -------------------------------------------------------------------------
     //                          Canvases and histograms
     // -------------------------------------------------------------------------
@@ -313,19 +974,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Q2_abs_cc0pi_stack;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_abs_cc0pi = new TH1D("h1_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
-    TH1D *h2_Q2_abs_cc0pi = new TH1D("h2_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
-    TH1D *h3_Q2_abs_cc0pi = new TH1D("h3_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
-    TH1D *h4_Q2_abs_cc0pi = new TH1D("h4_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
-    TH1D *h5_Q2_abs_cc0pi = new TH1D("h5_Q2_abs_cc0pi","Q^{2} Absolute Normalisation, CC0#pi",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("Q2>>h2_Q2_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("Q2>>h3_Q2_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("Q2>>h4_Q2_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("Q2>>h5_Q2_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    
     // Push them onto the vector
     Q2_abs_cc0pi_stack.push_back(h1_Q2_abs_cc0pi);
     Q2_abs_cc0pi_stack.push_back(h2_Q2_abs_cc0pi);
@@ -348,19 +996,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Q2_abs_cc1pip_stack;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_abs_cc1pip = new TH1D("h1_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
-    TH1D *h2_Q2_abs_cc1pip = new TH1D("h2_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
-    TH1D *h3_Q2_abs_cc1pip = new TH1D("h3_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
-    TH1D *h4_Q2_abs_cc1pip = new TH1D("h4_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
-    TH1D *h5_Q2_abs_cc1pip = new TH1D("h5_Q2_abs_cc1pip","Q^{2} Absolute Normalisation, CC1#pi^{+}",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst2->Draw("Q2>>h2_Q2_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst3->Draw("Q2>>h3_Q2_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst4->Draw("Q2>>h4_Q2_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst5->Draw("Q2>>h5_Q2_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    
     // Push them onto the vector
     Q2_abs_cc1pip_stack.push_back(h1_Q2_abs_cc1pip);
     Q2_abs_cc1pip_stack.push_back(h2_Q2_abs_cc1pip);
@@ -383,19 +1018,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Q2_abs_cc1pi0_stack;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_abs_cc1pi0 = new TH1D("h1_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
-    TH1D *h2_Q2_abs_cc1pi0 = new TH1D("h2_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
-    TH1D *h3_Q2_abs_cc1pi0 = new TH1D("h3_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
-    TH1D *h4_Q2_abs_cc1pi0 = new TH1D("h4_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
-    TH1D *h5_Q2_abs_cc1pi0 = new TH1D("h5_Q2_abs_cc1pi0","Q^{2} Absolute Normalisation, CC1#pi^{0}",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Q2>>h2_Q2_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Q2>>h3_Q2_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Q2>>h4_Q2_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Q2>>h5_Q2_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    
     // Push them onto the vector
     Q2_abs_cc1pi0_stack.push_back(h1_Q2_abs_cc1pi0);
     Q2_abs_cc1pi0_stack.push_back(h2_Q2_abs_cc1pi0);
@@ -418,19 +1040,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Q2_abs_nc1pi0_stack;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_abs_nc1pi0 = new TH1D("h1_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
-    TH1D *h2_Q2_abs_nc1pi0 = new TH1D("h2_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
-    TH1D *h3_Q2_abs_nc1pi0 = new TH1D("h3_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
-    TH1D *h4_Q2_abs_nc1pi0 = new TH1D("h4_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
-    TH1D *h5_Q2_abs_nc1pi0 = new TH1D("h5_Q2_abs_nc1pi0","Q^{2} Absolute Normalisation, NC1#pi^{0}",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Q2>>h2_Q2_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Q2>>h3_Q2_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Q2>>h4_Q2_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Q2>>h5_Q2_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    
     // Push them onto the vector
     Q2_abs_nc1pi0_stack.push_back(h1_Q2_abs_nc1pi0);
     Q2_abs_nc1pi0_stack.push_back(h2_Q2_abs_nc1pi0);
@@ -454,19 +1063,6 @@ int model_comparisons() {
     vector< TH1D* > Q2_area_cc0pi_stack;
     vector< double > int_Q2_cc0pi;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_area_cc0pi = new TH1D("h1_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
-    TH1D *h2_Q2_area_cc0pi = new TH1D("h2_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
-    TH1D *h3_Q2_area_cc0pi = new TH1D("h3_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
-    TH1D *h4_Q2_area_cc0pi = new TH1D("h4_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
-    TH1D *h5_Q2_area_cc0pi = new TH1D("h5_Q2_area_cc0pi","Q^{2} Area Normalised, CC0#pi",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("Q2>>h2_Q2_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("Q2>>h3_Q2_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("Q2>>h4_Q2_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("Q2>>h5_Q2_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    
     // Push back the scaling
     double int1_Q2_cc0pi, int2_Q2_cc0pi, int3_Q2_cc0pi, int4_Q2_cc0pi, int5_Q2_cc0pi;
 
@@ -505,19 +1101,6 @@ int model_comparisons() {
     vector< TH1D* > Q2_area_cc1pip_stack;
     vector< double > int_Q2_cc1pip;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_area_cc1pip = new TH1D("h1_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
-    TH1D *h2_Q2_area_cc1pip = new TH1D("h2_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
-    TH1D *h3_Q2_area_cc1pip = new TH1D("h3_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
-    TH1D *h4_Q2_area_cc1pip = new TH1D("h4_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
-    TH1D *h5_Q2_area_cc1pip = new TH1D("h5_Q2_area_cc1pip","Q^{2} Area Normalised, CC1#pi^{+}",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst2->Draw("Q2>>h2_Q2_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst3->Draw("Q2>>h3_Q2_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst4->Draw("Q2>>h4_Q2_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst5->Draw("Q2>>h5_Q2_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-     
     // Push back the scaling
     double int1_Q2_cc1pip, int2_Q2_cc1pip, int3_Q2_cc1pip, int4_Q2_cc1pip, int5_Q2_cc1pip;
 
@@ -556,19 +1139,6 @@ int model_comparisons() {
     vector< TH1D* > Q2_area_cc1pi0_stack;
     vector< double > int_Q2_cc1pi0;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_area_cc1pi0 = new TH1D("h1_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
-    TH1D *h2_Q2_area_cc1pi0 = new TH1D("h2_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
-    TH1D *h3_Q2_area_cc1pi0 = new TH1D("h3_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
-    TH1D *h4_Q2_area_cc1pi0 = new TH1D("h4_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
-    TH1D *h5_Q2_area_cc1pi0 = new TH1D("h5_Q2_area_cc1pi0","Q^{2} Area Normalised, CC1#pi^{0}",50,0,2.5);
-    
-    gst1->Draw("Q2>>h1_Q2_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Q2>>h2_Q2_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Q2>>h3_Q2_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Q2>>h4_Q2_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Q2>>h5_Q2_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-     
     // Push back the scaling
     double int1_Q2_cc1pi0, int2_Q2_cc1pi0, int3_Q2_cc1pi0, int4_Q2_cc1pi0, int5_Q2_cc1pi0;
 
@@ -607,19 +1177,6 @@ int model_comparisons() {
     vector< TH1D* > Q2_area_nc1pi0_stack;
     vector< double > int_Q2_nc1pi0;
 
-    // The Q2 histograms
-    TH1D *h1_Q2_area_nc1pi0 = new TH1D("h1_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
-    TH1D *h2_Q2_area_nc1pi0 = new TH1D("h2_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
-    TH1D *h3_Q2_area_nc1pi0 = new TH1D("h3_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
-    TH1D *h4_Q2_area_nc1pi0 = new TH1D("h4_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
-    TH1D *h5_Q2_area_nc1pi0 = new TH1D("h5_Q2_area_nc1pi0","Q^{2} Area Normalised, NC1#pi^{0}",50,0,2.5);
-
-    gst1->Draw("Q2>>h1_Q2_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Q2>>h2_Q2_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Q2>>h3_Q2_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Q2>>h4_Q2_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Q2>>h5_Q2_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    
     // Push back the scaling
     double int1_Q2_nc1pi0, int2_Q2_nc1pi0, int3_Q2_nc1pi0, int4_Q2_nc1pi0, int5_Q2_nc1pi0;
 
@@ -657,19 +1214,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Ev_abs_cc0pi_stack;
 
-    // The Ev histograms
-    TH1D *h1_Ev_abs_cc0pi = new TH1D("h1_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
-    TH1D *h2_Ev_abs_cc0pi = new TH1D("h2_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
-    TH1D *h3_Ev_abs_cc0pi = new TH1D("h3_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
-    TH1D *h4_Ev_abs_cc0pi = new TH1D("h4_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
-    TH1D *h5_Ev_abs_cc0pi = new TH1D("h5_Ev_abs_cc0pi","E_{#nu} Absolute Normalisation, CC0#pi",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("Ev>>h2_Ev_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("Ev>>h3_Ev_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("Ev>>h4_Ev_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("Ev>>h5_Ev_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    
     // Push them onto the vector
     Ev_abs_cc0pi_stack.push_back(h1_Ev_abs_cc0pi);
     Ev_abs_cc0pi_stack.push_back(h2_Ev_abs_cc0pi);
@@ -692,19 +1236,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Ev_abs_cc1pip_stack;
 
-    // The Ev histograms
-    TH1D *h1_Ev_abs_cc1pip = new TH1D("h1_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
-    TH1D *h2_Ev_abs_cc1pip = new TH1D("h2_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
-    TH1D *h3_Ev_abs_cc1pip = new TH1D("h3_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
-    TH1D *h4_Ev_abs_cc1pip = new TH1D("h4_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
-    TH1D *h5_Ev_abs_cc1pip = new TH1D("h5_Ev_abs_cc1pip","E_{#nu} Absolute Normalisation, CC1#pi^{+}",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst2->Draw("Ev>>h2_Ev_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst3->Draw("Ev>>h3_Ev_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst4->Draw("Ev>>h4_Ev_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst5->Draw("Ev>>h5_Ev_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    
     // Push them onto the vector
     Ev_abs_cc1pip_stack.push_back(h1_Ev_abs_cc1pip);
     Ev_abs_cc1pip_stack.push_back(h2_Ev_abs_cc1pip);
@@ -727,19 +1258,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Ev_abs_cc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_Ev_abs_cc1pi0 = new TH1D("h1_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
-    TH1D *h2_Ev_abs_cc1pi0 = new TH1D("h2_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
-    TH1D *h3_Ev_abs_cc1pi0 = new TH1D("h3_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
-    TH1D *h4_Ev_abs_cc1pi0 = new TH1D("h4_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
-    TH1D *h5_Ev_abs_cc1pi0 = new TH1D("h5_Ev_abs_cc1pi0","E_{#nu} Absolute Normalisation, CC1#pi^{0}",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Ev>>h2_Ev_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Ev>>h3_Ev_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Ev>>h4_Ev_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Ev>>h5_Ev_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-
     // Push them onto the vector
     Ev_abs_cc1pi0_stack.push_back(h1_Ev_abs_cc1pi0);
     Ev_abs_cc1pi0_stack.push_back(h2_Ev_abs_cc1pi0);
@@ -762,19 +1280,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > Ev_abs_nc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_Ev_abs_nc1pi0 = new TH1D("h1_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
-    TH1D *h2_Ev_abs_nc1pi0 = new TH1D("h2_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
-    TH1D *h3_Ev_abs_nc1pi0 = new TH1D("h3_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
-    TH1D *h4_Ev_abs_nc1pi0 = new TH1D("h4_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
-    TH1D *h5_Ev_abs_nc1pi0 = new TH1D("h5_Ev_abs_nc1pi0","E_{#nu} Absolute Normalisation, NC1#pi^{0}",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Ev>>h2_Ev_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Ev>>h3_Ev_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Ev>>h4_Ev_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Ev>>h5_Ev_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    
     // Push them onto the vector
     Ev_abs_nc1pi0_stack.push_back(h1_Ev_abs_nc1pi0);
     Ev_abs_nc1pi0_stack.push_back(h2_Ev_abs_nc1pi0);
@@ -798,19 +1303,6 @@ int model_comparisons() {
     vector< TH1D* > Ev_area_cc0pi_stack;
     vector< double > int_Ev_cc0pi;
 
-    // The Ev histograms
-    TH1D *h1_Ev_area_cc0pi = new TH1D("h1_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
-    TH1D *h2_Ev_area_cc0pi = new TH1D("h2_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
-    TH1D *h3_Ev_area_cc0pi = new TH1D("h3_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
-    TH1D *h4_Ev_area_cc0pi = new TH1D("h4_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
-    TH1D *h5_Ev_area_cc0pi = new TH1D("h5_Ev_area_cc0pi","E_{#nu} Area Normalised, CC0#pi",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("Ev>>h2_Ev_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("Ev>>h3_Ev_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("Ev>>h4_Ev_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("Ev>>h5_Ev_area_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    
     // Push back the scaling
     double int1_Ev_cc0pi, int2_Ev_cc0pi, int3_Ev_cc0pi, int4_Ev_cc0pi, int5_Ev_cc0pi;
 
@@ -849,19 +1341,6 @@ int model_comparisons() {
     vector< TH1D* > Ev_area_cc1pip_stack;
     vector< double > int_Ev_cc1pip;
 
-    // The Ev histograms
-    TH1D *h1_Ev_area_cc1pip = new TH1D("h1_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
-    TH1D *h2_Ev_area_cc1pip = new TH1D("h2_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
-    TH1D *h3_Ev_area_cc1pip = new TH1D("h3_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
-    TH1D *h4_Ev_area_cc1pip = new TH1D("h4_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
-    TH1D *h5_Ev_area_cc1pip = new TH1D("h5_Ev_area_cc1pip","E_{#nu} Area Normalised, CC1#pi^{+}",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst2->Draw("Ev>>h2_Ev_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst3->Draw("Ev>>h3_Ev_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst4->Draw("Ev>>h4_Ev_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-    gst5->Draw("Ev>>h5_Ev_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) ");
-     
     // Push back the scaling
     double int1_Ev_cc1pip, int2_Ev_cc1pip, int3_Ev_cc1pip, int4_Ev_cc1pip, int5_Ev_cc1pip;
 
@@ -900,19 +1379,6 @@ int model_comparisons() {
     vector< TH1D* > Ev_area_cc1pi0_stack;
     vector< double > int_Ev_cc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_Ev_area_cc1pi0 = new TH1D("h1_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
-    TH1D *h2_Ev_area_cc1pi0 = new TH1D("h2_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
-    TH1D *h3_Ev_area_cc1pi0 = new TH1D("h3_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
-    TH1D *h4_Ev_area_cc1pi0 = new TH1D("h4_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
-    TH1D *h5_Ev_area_cc1pi0 = new TH1D("h5_Ev_area_cc1pi0","E_{#nu} Area Normalised, CC1#pi^{0}",50,0,3);
-    
-    gst1->Draw("Ev>>h1_Ev_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Ev>>h2_Ev_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Ev>>h3_Ev_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Ev>>h4_Ev_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Ev>>h5_Ev_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-     
     // Push back the scaling
     double int1_Ev_cc1pi0, int2_Ev_cc1pi0, int3_Ev_cc1pi0, int4_Ev_cc1pi0, int5_Ev_cc1pi0;
 
@@ -951,19 +1417,6 @@ int model_comparisons() {
     vector< TH1D* > Ev_area_nc1pi0_stack;
     vector< double > int_Ev_nc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_Ev_area_nc1pi0 = new TH1D("h1_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
-    TH1D *h2_Ev_area_nc1pi0 = new TH1D("h2_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
-    TH1D *h3_Ev_area_nc1pi0 = new TH1D("h3_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
-    TH1D *h4_Ev_area_nc1pi0 = new TH1D("h4_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
-    TH1D *h5_Ev_area_nc1pi0 = new TH1D("h5_Ev_area_nc1pi0","E_{#nu} Area Normalised, NC1#pi^{0}",50,0,3);
-
-    gst1->Draw("Ev>>h1_Ev_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst2->Draw("Ev>>h2_Ev_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst3->Draw("Ev>>h3_Ev_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst4->Draw("Ev>>h4_Ev_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    gst5->Draw("Ev>>h5_Ev_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) ");
-    
     // Push back the scaling
     double int1_Ev_nc1pi0, int2_Ev_nc1pi0, int3_Ev_nc1pi0, int4_Ev_nc1pi0, int5_Ev_nc1pi0;
 
@@ -1000,19 +1453,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > CosThPi_abs_cc1pip_stack;
 
-    // The Ev histograms
-    TH1D *h1_CosThPi_abs_cc1pip = new TH1D("h1_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h2_CosThPi_abs_cc1pip = new TH1D("h2_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h3_CosThPi_abs_cc1pip = new TH1D("h3_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h4_CosThPi_abs_cc1pip = new TH1D("h4_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h5_CosThPi_abs_cc1pip = new TH1D("h5_CosThPi_abs_cc1pip","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-
-    gst1->Draw("cthf>>h1_CosThPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst2->Draw("cthf>>h2_CosThPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst3->Draw("cthf>>h3_CosThPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst4->Draw("cthf>>h4_CosThPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst5->Draw("cthf>>h5_CosThPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    
     // Push them onto the vector
     CosThPi_abs_cc1pip_stack.push_back(h1_CosThPi_abs_cc1pip);
     CosThPi_abs_cc1pip_stack.push_back(h2_CosThPi_abs_cc1pip);
@@ -1035,19 +1475,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > CosThPi_abs_cc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_CosThPi_abs_cc1pi0 = new TH1D("h1_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h2_CosThPi_abs_cc1pi0 = new TH1D("h2_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h3_CosThPi_abs_cc1pi0 = new TH1D("h3_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h4_CosThPi_abs_cc1pi0 = new TH1D("h4_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h5_CosThPi_abs_cc1pi0 = new TH1D("h5_CosThPi_abs_cc1pi0","cos(#theta_{#pi}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-
-    gst1->Draw("cthf>>h1_CosThPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst2->Draw("cthf>>h2_CosThPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst3->Draw("cthf>>h3_CosThPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst4->Draw("cthf>>h4_CosThPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst5->Draw("cthf>>h5_CosThPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    
     // Push them onto the vector
     CosThPi_abs_cc1pi0_stack.push_back(h1_CosThPi_abs_cc1pi0);
     CosThPi_abs_cc1pi0_stack.push_back(h2_CosThPi_abs_cc1pi0);
@@ -1070,19 +1497,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > CosThPi_abs_nc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_CosThPi_abs_nc1pi0 = new TH1D("h1_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
-    TH1D *h2_CosThPi_abs_nc1pi0 = new TH1D("h2_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
-    TH1D *h3_CosThPi_abs_nc1pi0 = new TH1D("h3_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
-    TH1D *h4_CosThPi_abs_nc1pi0 = new TH1D("h4_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
-    TH1D *h5_CosThPi_abs_nc1pi0 = new TH1D("h5_CosThPi_abs_nc1pi0","cos(#theta_{#pi}) Absolute Normalisation, NC1#pi^{0}",40,-1,1);
-
-    gst1->Draw("cthf>>h1_CosThPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst2->Draw("cthf>>h2_CosThPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst3->Draw("cthf>>h3_CosThPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst4->Draw("cthf>>h4_CosThPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst5->Draw("cthf>>h5_CosThPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    
     // Push them onto the vector
     CosThPi_abs_nc1pi0_stack.push_back(h1_CosThPi_abs_nc1pi0);
     CosThPi_abs_nc1pi0_stack.push_back(h2_CosThPi_abs_nc1pi0);
@@ -1106,19 +1520,6 @@ int model_comparisons() {
     vector< TH1D* > CosThPi_area_cc1pip_stack;
     vector< double > int_cth_pi_cc1pip;
 
-    // The Ev histograms
-    TH1D *h1_CosThPi_area_cc1pip = new TH1D("h1_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h2_CosThPi_area_cc1pip = new TH1D("h2_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h3_CosThPi_area_cc1pip = new TH1D("h3_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h4_CosThPi_area_cc1pip = new TH1D("h4_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h5_CosThPi_area_cc1pip = new TH1D("h5_CosThPi_area_cc1pip","cos(#theta_{#pi}) Area Normalised, CC1#pi^{+}",40,-1,1);
-
-    gst1->Draw("cthf>>h1_CosThPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211 ");
-    gst2->Draw("cthf>>h2_CosThPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst3->Draw("cthf>>h3_CosThPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst4->Draw("cthf>>h4_CosThPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst5->Draw("cthf>>h5_CosThPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-     
     // Push back the scaling
     double int1_cth_pi_cc1pip, int2_cth_pi_cc1pip, int3_cth_pi_cc1pip, int4_cth_pi_cc1pip, int5_cth_pi_cc1pip;
 
@@ -1157,19 +1558,6 @@ int model_comparisons() {
     vector< TH1D* > CosThPi_area_cc1pi0_stack;
     vector< double > int_cth_pi_cc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_CosThPi_area_cc1pi0 = new TH1D("h1_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h2_CosThPi_area_cc1pi0 = new TH1D("h2_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h3_CosThPi_area_cc1pi0 = new TH1D("h3_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h4_CosThPi_area_cc1pi0 = new TH1D("h4_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h5_CosThPi_area_cc1pi0 = new TH1D("h5_CosThPi_area_cc1pi0","cos(#theta_{#pi}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    
-    gst1->Draw("cthf>>h1_CosThPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst2->Draw("cthf>>h2_CosThPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst3->Draw("cthf>>h3_CosThPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst4->Draw("cthf>>h4_CosThPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst5->Draw("cthf>>h5_CosThPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-     
     // Push back the scaling
     double int1_cth_pi_cc1pi0, int2_cth_pi_cc1pi0, int3_cth_pi_cc1pi0, int4_cth_pi_cc1pi0, int5_cth_pi_cc1pi0;
 
@@ -1208,19 +1596,6 @@ int model_comparisons() {
     vector< TH1D* > CosThPi_area_nc1pi0_stack;
     vector< double > int_cth_pi_nc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_CosThPi_area_nc1pi0 = new TH1D("h1_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
-    TH1D *h2_CosThPi_area_nc1pi0 = new TH1D("h2_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
-    TH1D *h3_CosThPi_area_nc1pi0 = new TH1D("h3_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
-    TH1D *h4_CosThPi_area_nc1pi0 = new TH1D("h4_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
-    TH1D *h5_CosThPi_area_nc1pi0 = new TH1D("h5_CosThPi_area_nc1pi0","cos(#theta_{#pi}) Area Normalised, NC1#pi^{0}",40,-1,1);
-
-    gst1->Draw("cthf>>h1_CosThPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst2->Draw("cthf>>h2_CosThPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst3->Draw("cthf>>h3_CosThPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst4->Draw("cthf>>h4_CosThPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst5->Draw("cthf>>h5_CosThPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    
     // Push back the scaling
     double int1_cth_pi_nc1pi0, int2_cth_pi_nc1pi0, int3_cth_pi_nc1pi0, int4_cth_pi_nc1pi0, int5_cth_pi_nc1pi0;
 
@@ -1258,19 +1633,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > PPi_abs_cc1pip_stack;
 
-    // The Ev histograms
-    TH1D *h1_PPi_abs_cc1pip = new TH1D("h1_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h2_PPi_abs_cc1pip = new TH1D("h2_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h3_PPi_abs_cc1pip = new TH1D("h3_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h4_PPi_abs_cc1pip = new TH1D("h4_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h5_PPi_abs_cc1pip = new TH1D("h5_PPi_abs_cc1pip","P_{#pi} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-
-    gst1->Draw("pf>>h1_PPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst2->Draw("pf>>h2_PPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst3->Draw("pf>>h3_PPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst4->Draw("pf>>h4_PPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst5->Draw("pf>>h5_PPi_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    
     // Push them onto the vector
     PPi_abs_cc1pip_stack.push_back(h1_PPi_abs_cc1pip);
     PPi_abs_cc1pip_stack.push_back(h2_PPi_abs_cc1pip);
@@ -1293,19 +1655,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > PPi_abs_cc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_PPi_abs_cc1pi0 = new TH1D("h1_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h2_PPi_abs_cc1pi0 = new TH1D("h2_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h3_PPi_abs_cc1pi0 = new TH1D("h3_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h4_PPi_abs_cc1pi0 = new TH1D("h4_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h5_PPi_abs_cc1pi0 = new TH1D("h5_PPi_abs_cc1pi0","P_{#pi} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-
-    gst1->Draw("pf>>h1_PPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst2->Draw("pf>>h2_PPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst3->Draw("pf>>h3_PPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst4->Draw("pf>>h4_PPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst5->Draw("pf>>h5_PPi_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    
     // Push them onto the vector
     PPi_abs_cc1pi0_stack.push_back(h1_PPi_abs_cc1pi0);
     PPi_abs_cc1pi0_stack.push_back(h2_PPi_abs_cc1pi0);
@@ -1328,19 +1677,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > PPi_abs_nc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_PPi_abs_nc1pi0 = new TH1D("h1_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
-    TH1D *h2_PPi_abs_nc1pi0 = new TH1D("h2_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
-    TH1D *h3_PPi_abs_nc1pi0 = new TH1D("h3_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
-    TH1D *h4_PPi_abs_nc1pi0 = new TH1D("h4_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
-    TH1D *h5_PPi_abs_nc1pi0 = new TH1D("h5_PPi_abs_nc1pi0","P_{#pi} Absolute Normalisation, NC1#pi^{0}",40,0,1.5);
-
-    gst1->Draw("pf>>h1_PPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst2->Draw("pf>>h2_PPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst3->Draw("pf>>h3_PPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst4->Draw("pf>>h4_PPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst5->Draw("pf>>h5_PPi_abs_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    
     // Push them onto the vector
     PPi_abs_nc1pi0_stack.push_back(h1_PPi_abs_nc1pi0);
     PPi_abs_nc1pi0_stack.push_back(h2_PPi_abs_nc1pi0);
@@ -1364,19 +1700,6 @@ int model_comparisons() {
     vector< TH1D* > PPi_area_cc1pip_stack;
     vector< double > int_p_pi_cc1pip;
 
-    // The Ev histograms
-    TH1D *h1_PPi_area_cc1pip = new TH1D("h1_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h2_PPi_area_cc1pip = new TH1D("h2_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h3_PPi_area_cc1pip = new TH1D("h3_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h4_PPi_area_cc1pip = new TH1D("h4_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h5_PPi_area_cc1pip = new TH1D("h5_PPi_area_cc1pip","P_{#pi} Area Normalised, CC1#pi^{+}",40,0,1.5);
-
-    gst1->Draw("pf>>h1_PPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211 ");
-    gst2->Draw("pf>>h2_PPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst3->Draw("pf>>h3_PPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst4->Draw("pf>>h4_PPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-    gst5->Draw("pf>>h5_PPi_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 ) && pdgf == 211  ");
-     
     // Push back the scaling
     double int1_p_pi_cc1pip, int2_p_pi_cc1pip, int3_p_pi_cc1pip, int4_p_pi_cc1pip, int5_p_pi_cc1pip;
 
@@ -1415,19 +1738,6 @@ int model_comparisons() {
     vector< TH1D* > PPi_area_cc1pi0_stack;
     vector< double > int_p_pi_cc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_PPi_area_cc1pi0 = new TH1D("h1_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h2_PPi_area_cc1pi0 = new TH1D("h2_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h3_PPi_area_cc1pi0 = new TH1D("h3_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h4_PPi_area_cc1pi0 = new TH1D("h4_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h5_PPi_area_cc1pi0 = new TH1D("h5_PPi_area_cc1pi0","P_{#pi} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    
-    gst1->Draw("pf>>h1_PPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst2->Draw("pf>>h2_PPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst3->Draw("pf>>h3_PPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst4->Draw("pf>>h4_PPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-    gst5->Draw("pf>>h5_PPi_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111 ");
-     
     // Push back the scaling
     double int1_p_pi_cc1pi0, int2_p_pi_cc1pi0, int3_p_pi_cc1pi0, int4_p_pi_cc1pi0, int5_p_pi_cc1pi0;
 
@@ -1466,19 +1776,6 @@ int model_comparisons() {
     vector< TH1D* > PPi_area_nc1pi0_stack;
     vector< double > int_p_pi_nc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_PPi_area_nc1pi0 = new TH1D("h1_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
-    TH1D *h2_PPi_area_nc1pi0 = new TH1D("h2_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
-    TH1D *h3_PPi_area_nc1pi0 = new TH1D("h3_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
-    TH1D *h4_PPi_area_nc1pi0 = new TH1D("h4_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
-    TH1D *h5_PPi_area_nc1pi0 = new TH1D("h5_PPi_area_nc1pi0","P_{#pi} Area Normalised, NC1#pi^{0}",40,0,1.5);
-
-    gst1->Draw("pf>>h1_PPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst2->Draw("pf>>h2_PPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst3->Draw("pf>>h3_PPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst4->Draw("pf>>h4_PPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    gst5->Draw("pf>>h5_PPi_area_nc1pi0", "nc && nfpi0 == 1 && ( nfpim + nfpip == 0 ) && pdgf == 111");
-    
     // Push back the scaling
     double int1_p_pi_nc1pi0, int2_p_pi_nc1pi0, int3_p_pi_nc1pi0, int4_p_pi_nc1pi0, int5_p_pi_nc1pi0;
 
@@ -1515,19 +1812,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > CosThMu_abs_cc0pi_stack;
 
-    // The Ev histograms
-    TH1D *h1_CosThMu_abs_cc0pi = new TH1D("h1_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
-    TH1D *h2_CosThMu_abs_cc0pi = new TH1D("h2_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
-    TH1D *h3_CosThMu_abs_cc0pi = new TH1D("h3_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
-    TH1D *h4_CosThMu_abs_cc0pi = new TH1D("h4_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
-    TH1D *h5_CosThMu_abs_cc0pi = new TH1D("h5_CosThMu_abs_cc0pi","cos(#theta_{#mu}) Absolute Normalisation, CC0#pi",40,-1,1);
-
-    gst1->Draw("cthl>>h1_CosThMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst2->Draw("cthl>>h2_CosThMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst3->Draw("cthl>>h3_CosThMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst4->Draw("cthl>>h4_CosThMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst5->Draw("cthl>>h5_CosThMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    
     // Push them onto the vector
     CosThMu_abs_cc0pi_stack.push_back(h1_CosThMu_abs_cc0pi);
     CosThMu_abs_cc0pi_stack.push_back(h2_CosThMu_abs_cc0pi);
@@ -1549,19 +1833,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > CosThMu_abs_cc1pip_stack;
 
-    // The Ev histograms
-    TH1D *h1_CosThMu_abs_cc1pip = new TH1D("h1_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h2_CosThMu_abs_cc1pip = new TH1D("h2_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h3_CosThMu_abs_cc1pip = new TH1D("h3_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h4_CosThMu_abs_cc1pip = new TH1D("h4_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-    TH1D *h5_CosThMu_abs_cc1pip = new TH1D("h5_CosThMu_abs_cc1pip","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{+}",40,-1,1);
-
-    gst1->Draw("cthl>>h1_CosThMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst2->Draw("cthl>>h2_CosThMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst3->Draw("cthl>>h3_CosThMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst4->Draw("cthl>>h4_CosThMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst5->Draw("cthl>>h5_CosThMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    
     // Push them onto the vector
     CosThMu_abs_cc1pip_stack.push_back(h1_CosThMu_abs_cc1pip);
     CosThMu_abs_cc1pip_stack.push_back(h2_CosThMu_abs_cc1pip);
@@ -1584,19 +1855,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > CosThMu_abs_cc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_CosThMu_abs_cc1pi0 = new TH1D("h1_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h2_CosThMu_abs_cc1pi0 = new TH1D("h2_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h3_CosThMu_abs_cc1pi0 = new TH1D("h3_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h4_CosThMu_abs_cc1pi0 = new TH1D("h4_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-    TH1D *h5_CosThMu_abs_cc1pi0 = new TH1D("h5_CosThMu_abs_cc1pi0","cos(#theta_{#mu}) Absolute Normalisation, CC1#pi^{0}",40,-1,1);
-
-    gst1->Draw("cthl>>h1_CosThMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst2->Draw("cthl>>h2_CosThMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst3->Draw("cthl>>h3_CosThMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst4->Draw("cthl>>h4_CosThMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst5->Draw("cthl>>h5_CosThMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    
     // Push them onto the vector
     CosThMu_abs_cc1pi0_stack.push_back(h1_CosThMu_abs_cc1pi0);
     CosThMu_abs_cc1pi0_stack.push_back(h2_CosThMu_abs_cc1pi0);
@@ -1619,19 +1877,6 @@ int model_comparisons() {
     vector< TH1D* > CosThMu_area_cc0pi_stack;
     vector< double > int_cth_mu_cc0pi;
 
-    // The Ev histograms
-    TH1D *h1_CosThMu_area_cc0pi = new TH1D("h1_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
-    TH1D *h2_CosThMu_area_cc0pi = new TH1D("h2_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
-    TH1D *h3_CosThMu_area_cc0pi = new TH1D("h3_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
-    TH1D *h4_CosThMu_area_cc0pi = new TH1D("h4_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
-    TH1D *h5_CosThMu_area_cc0pi = new TH1D("h5_CosThMu_area_cc0pi","cos(#theta_{#mu}) Area Normalised, CC0#pi",40,-1,1);
-
-    gst1->Draw("cthl>>h1_CosThMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst2->Draw("cthl>>h2_CosThMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst3->Draw("cthl>>h3_CosThMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst4->Draw("cthl>>h4_CosThMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst5->Draw("cthl>>h5_CosThMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    
     // Push back the scaling
     double int1_cth_mu_cc0pi, int2_cth_mu_cc0pi, int3_cth_mu_cc0pi, int4_cth_mu_cc0pi, int5_cth_mu_cc0pi;
 
@@ -1664,24 +1909,11 @@ int model_comparisons() {
     // -------------------------------------------------------------------------
     //                      CosThetaMu Area norm CC1pip
     // -------------------------------------------------------------------------
-    
-    // Vector of histograms and strings to pass to the stacking function
-    vector< TH1D* > CosThMu_area_cc1pip_stack;
-    vector< double > int_cth_mu_cc1pip;
-
-    // The Ev histograms
-    TH1D *h1_CosThMu_area_cc1pip = new TH1D("h1_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h2_CosThMu_area_cc1pip = new TH1D("h2_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h3_CosThMu_area_cc1pip = new TH1D("h3_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h4_CosThMu_area_cc1pip = new TH1D("h4_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
-    TH1D *h5_CosThMu_area_cc1pip = new TH1D("h5_CosThMu_area_cc1pip","cos(#theta_{#mu}) Area Normalised, CC1#pi^{+}",40,-1,1);
+    
+    // Vector of histograms and strings to pass to the stacking function
+    vector< TH1D* > CosThMu_area_cc1pip_stack;
+    vector< double > int_cth_mu_cc1pip;
 
-    gst1->Draw("cthl>>h1_CosThMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )  ");
-    gst2->Draw("cthl>>h2_CosThMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst3->Draw("cthl>>h3_CosThMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst4->Draw("cthl>>h4_CosThMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst5->Draw("cthl>>h5_CosThMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-     
     // Push back the scaling
     double int1_cth_mu_cc1pip, int2_cth_mu_cc1pip, int3_cth_mu_cc1pip, int4_cth_mu_cc1pip, int5_cth_mu_cc1pip;
 
@@ -1720,19 +1952,6 @@ int model_comparisons() {
     vector< TH1D* > CosThMu_area_cc1pi0_stack;
     vector< double > int_cth_mu_cc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_CosThMu_area_cc1pi0 = new TH1D("h1_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h2_CosThMu_area_cc1pi0 = new TH1D("h2_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h3_CosThMu_area_cc1pi0 = new TH1D("h3_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h4_CosThMu_area_cc1pi0 = new TH1D("h4_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    TH1D *h5_CosThMu_area_cc1pi0 = new TH1D("h5_CosThMu_area_cc1pi0","cos(#theta_{#mu}) Area Normalised, CC1#pi^{0}",40,-1,1);
-    
-    gst1->Draw("cthl>>h1_CosThMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst2->Draw("cthl>>h2_CosThMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst3->Draw("cthl>>h3_CosThMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst4->Draw("cthl>>h4_CosThMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst5->Draw("cthl>>h5_CosThMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-     
     // Push back the scaling
     double int1_cth_mu_cc1pi0, int2_cth_mu_cc1pi0, int3_cth_mu_cc1pi0, int4_cth_mu_cc1pi0, int5_cth_mu_cc1pi0;
 
@@ -1769,19 +1988,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > PMu_abs_cc0pi_stack;
 
-    // The Ev histograms
-    TH1D *h1_PMu_abs_cc0pi = new TH1D("h1_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
-    TH1D *h2_PMu_abs_cc0pi = new TH1D("h2_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
-    TH1D *h3_PMu_abs_cc0pi = new TH1D("h3_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
-    TH1D *h4_PMu_abs_cc0pi = new TH1D("h4_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
-    TH1D *h5_PMu_abs_cc0pi = new TH1D("h5_PMu_abs_cc0pi","P_{#mu} Absolute Normalisation, CC0#pi",40,0,1.5);
-
-    gst1->Draw("pl>>h1_PMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst2->Draw("pl>>h2_PMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst3->Draw("pl>>h3_PMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst4->Draw("pl>>h4_PMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    gst5->Draw("pl>>h5_PMu_abs_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 )  ");
-    
     // Push them onto the vector
     PMu_abs_cc0pi_stack.push_back(h1_PMu_abs_cc0pi);
     PMu_abs_cc0pi_stack.push_back(h2_PMu_abs_cc0pi);
@@ -1803,19 +2009,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > PMu_abs_cc1pip_stack;
 
-    // The Ev histograms
-    TH1D *h1_PMu_abs_cc1pip = new TH1D("h1_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h2_PMu_abs_cc1pip = new TH1D("h2_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h3_PMu_abs_cc1pip = new TH1D("h3_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h4_PMu_abs_cc1pip = new TH1D("h4_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-    TH1D *h5_PMu_abs_cc1pip = new TH1D("h5_PMu_abs_cc1pip","P_{#mu} Absolute Normalisation, CC1#pi^{+}",40,0,1.5);
-
-    gst1->Draw("pl>>h1_PMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst2->Draw("pl>>h2_PMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst3->Draw("pl>>h3_PMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst4->Draw("pl>>h4_PMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst5->Draw("pl>>h5_PMu_abs_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    
     // Push them onto the vector
     PMu_abs_cc1pip_stack.push_back(h1_PMu_abs_cc1pip);
     PMu_abs_cc1pip_stack.push_back(h2_PMu_abs_cc1pip);
@@ -1838,19 +2031,6 @@ int model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > PMu_abs_cc1pi0_stack;
 
-    // The Ev histograms
-    TH1D *h1_PMu_abs_cc1pi0 = new TH1D("h1_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h2_PMu_abs_cc1pi0 = new TH1D("h2_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h3_PMu_abs_cc1pi0 = new TH1D("h3_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h4_PMu_abs_cc1pi0 = new TH1D("h4_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-    TH1D *h5_PMu_abs_cc1pi0 = new TH1D("h5_PMu_abs_cc1pi0","P_{#mu} Absolute Normalisation, CC1#pi^{0}",40,0,1.5);
-
-    gst1->Draw("pl>>h1_PMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst2->Draw("pl>>h2_PMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst3->Draw("pl>>h3_PMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst4->Draw("pl>>h4_PMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst5->Draw("pl>>h5_PMu_abs_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    
     // Push them onto the vector
     PMu_abs_cc1pi0_stack.push_back(h1_PMu_abs_cc1pi0);
     PMu_abs_cc1pi0_stack.push_back(h2_PMu_abs_cc1pi0);
@@ -1874,19 +2054,6 @@ int model_comparisons() {
     vector< TH1D* > PMu_area_cc0pi_stack;
     vector< double > int_p_mu_cc0pi;
 
-    // The Ev histograms
-    TH1D *h1_PMu_area_cc0pi = new TH1D("h1_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
-    TH1D *h2_PMu_area_cc0pi = new TH1D("h2_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
-    TH1D *h3_PMu_area_cc0pi = new TH1D("h3_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
-    TH1D *h4_PMu_area_cc0pi = new TH1D("h4_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
-    TH1D *h5_PMu_area_cc0pi = new TH1D("h5_PMu_area_cc0pi","P_{#mu} Area Normalised, CC0#pi",40,0,1.5);
-
-    gst1->Draw("pl>>h1_PMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst2->Draw("pl>>h2_PMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst3->Draw("pl>>h3_PMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst4->Draw("pl>>h4_PMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    gst4->Draw("pl>>h5_PMu_area_cc0pi", "cc && ( nfpi0 + nfpim + nfpip == 0 ) ");
-    
     // Push back the scaling
     double int1_p_mu_cc0pi, int2_p_mu_cc0pi, int3_p_mu_cc0pi, int4_p_mu_cc0pi, int5_p_mu_cc0pi;
 
@@ -1925,19 +2092,6 @@ int model_comparisons() {
     vector< TH1D* > PMu_area_cc1pip_stack;
     vector< double > int_p_mu_cc1pip;
 
-    // The Ev histograms
-    TH1D *h1_PMu_area_cc1pip = new TH1D("h1_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h2_PMu_area_cc1pip = new TH1D("h2_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h3_PMu_area_cc1pip = new TH1D("h3_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h4_PMu_area_cc1pip = new TH1D("h4_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
-    TH1D *h5_PMu_area_cc1pip = new TH1D("h5_PMu_area_cc1pip","P_{#mu} Area Normalised, CC1#pi^{+}",40,0,1.5);
-
-    gst1->Draw("pl>>h1_PMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )  ");
-    gst2->Draw("pl>>h2_PMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst3->Draw("pl>>h3_PMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst4->Draw("pl>>h4_PMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-    gst5->Draw("pl>>h5_PMu_area_cc1pip", "cc && nfpip == 1 && ( nfpim + nfpi0 == 0 )   ");
-     
     // Push back the scaling
     double int1_p_mu_cc1pip, int2_p_mu_cc1pip, int3_p_mu_cc1pip, int4_p_mu_cc1pip, int5_p_mu_cc1pip;
 
@@ -1976,19 +2130,6 @@ int model_comparisons() {
     vector< TH1D* > PMu_area_cc1pi0_stack;
     vector< double > int_p_mu_cc1pi0;
 
-    // The Ev histograms
-    TH1D *h1_PMu_area_cc1pi0 = new TH1D("h1_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h2_PMu_area_cc1pi0 = new TH1D("h2_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h3_PMu_area_cc1pi0 = new TH1D("h3_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h4_PMu_area_cc1pi0 = new TH1D("h4_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    TH1D *h5_PMu_area_cc1pi0 = new TH1D("h5_PMu_area_cc1pi0","P_{#mu} Area Normalised, CC1#pi^{0}",40,0,1.5);
-    
-    gst1->Draw("pl>>h1_PMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst2->Draw("pl>>h2_PMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst3->Draw("pl>>h3_PMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst4->Draw("pl>>h4_PMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-    gst5->Draw("pl>>h5_PMu_area_cc1pi0", "cc && nfpi0 == 1 && ( nfpim + nfpip == 0 )  ");
-     
     // Push back the scaling
     double int1_p_mu_cc1pi0, int2_p_mu_cc1pi0, int3_p_mu_cc1pi0, int4_p_mu_cc1pi0, int5_p_mu_cc1pi0;
 
@@ -2018,7 +2159,177 @@ int model_comparisons() {
     delete h3_PMu_area_cc1pi0;
     delete h4_PMu_area_cc1pi0;
     delete h5_PMu_area_cc1pi0;
-    
+
+    // -------------------------------------------------------------------------
+    //                  Q2 by interaction channel, CC0pi and CC1pip
+    // -------------------------------------------------------------------------
+    // The channels of the Q2 fills of each model, filled with the rest
+    const char* channel_models[5]  = { "Default", "DefaultMEC", "G17_02b", "G17_01a", "G17_01b" };
+
+    for( int i = 0; i < 5; ++i ){
+
+        const char* fills[2]  = { "cc0pi", "cc1pip" };
+        const char* labels[2] = { "CC0Pi", "CC1PiP" };
+        const char* titles[2] = { "CC0#pi", "CC1#pi^{+}" };
+
+        for( int j = 0; j < 2; ++j ){
+
+            const FlatFill &channel_fill = FlatBatchFill( batch, Form( "h%d_Q2_abs_%s", i + 1, fills[j] ) );
+
+            vector< TH1D* > channel_stack;
+
+            for( int k = 0; k < kNChannels; ++k ){
+                TH1D *h = new TH1D( Form( "h%d_Q2_%s_%s", i + 1, labels[j], ChannelName( k ) ), "", 50, 0, 2.5 );
+                FlatToTH1( channel_fill.channels[k], h );
+                channel_stack.push_back( h );
+            }
+
+            HistStacker(channel_stack, norms[i], Form( "Q2 by channel, %s, %s", titles[j], channel_models[i] ),
+                        Form( "Q2_%s_Channels_%s_Plot.png", labels[j], channel_models[i] ), "Q^{2}", "Number of SBND events");
+
+            for( int k = 0; k < kNChannels; ++k ){
+                delete channel_stack[k];
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    //          Q2 covariance over the reweighting universes, CC0pi
+    // -------------------------------------------------------------------------
+    // The universes were filled with the histograms
+    TFile *universe_file = 0;
+
+    for( int i = 0; i < 5; ++i ){
+
+        if( !with_universes[i] ) continue;
+
+        const FlatFill &universe_fill = FlatBatchFill( batch, Form( "universes%d_Q2_cc0pi", i + 1 ) );
+
+        vector< double > universe_mean, universe_covariance;
+        FlatUniverseCovariance( universe_fill, universe_mean, universe_covariance );
+
+        for( unsigned int j = 0; j < universe_covariance.size(); ++j ){
+            universe_covariance[j] *= norms[i] * norms[i];
+        }
+
+        if( !universe_file ) universe_file = new TFile( "universe_covariances.root", "RECREATE" );
+        universe_file->cd();
+
+        TH2D *h_covariance = new TH2D( Form( "h%d_Q2_CC0Pi_covariance", i + 1 ), Form( "Q2 covariance, CC0#pi, %s", channel_models[i] ), 40, 0, 40, 40, 0, 40 );
+        CovarianceToTH2( universe_covariance, h_covariance );
+        h_covariance->Write();
+
+        double universe_total = 0, universe_variance = 0;
+        for( unsigned int j = 0; j < universe_mean.size(); ++j ){
+            universe_total += universe_mean[j] * norms[i];
+            for( unsigned int k = 0; k < universe_mean.size(); ++k ){
+                universe_variance += universe_covariance[ j * universe_mean.size() + k ];
+            }
+        }
+
+        cout << " " << channel_models[i] << " CC0pi events over " << universe_fill.universes.n_universes << " universes : "
+             << universe_total << " +/- " << sqrt( universe_variance ) << endl;
+
+        delete h_covariance;
+    }
+
+    if( universe_file ){
+        universe_file->Close();
+        delete universe_file;
+    }
+
+    // -------------------------------------------------------------------------
+    //              Q2 with bootstrap statistical errors, CC0pi
+    // -------------------------------------------------------------------------
+    // The replicas were filled with the histograms
+    vector< TH1D* > Q2_stat_cc0pi_stack;
+
+    for( int i = 0; i < 5; ++i ){
+
+        TH1D *h = h_Q2_stat_cc0pi[i];
+        const FlatFill &stat_fill = FlatBatchFill( batch, h->GetName() );
+
+        BootstrapErrorsToTH1( stat_fill, h );
+        Q2_stat_cc0pi_stack.push_back( h );
+
+        vector< double > stat_errors;
+        double stat_error = FlatBootstrapErrors( stat_fill, stat_errors );
+
+        cout << " " << channel_models[i] << " CC0pi events : " << h->Integral() * norms[i]
+             << " +/- " << stat_error * norms[i] << " (stat.) " << endl;
+    }
+
+    HistStacker(Q2_stat_cc0pi_stack, leg_entries, norms, "Q^{2} with statistical errors, CC0#pi", "Q2_Stat_CC0Pi_Plot.png", "Q^{2}", "Number of SBND events");
+
+    for( int i = 0; i < 5; ++i ){
+        delete Q2_stat_cc0pi_stack[i];
+    }
+
+    // -------------------------------------------------------------------------
+    //              nu_mu CC disappearance sensitivity, 3+1
+    // -------------------------------------------------------------------------
+    // Every point of the grid was filled with the histograms
+    // Bin edges half way, in log, between the points
+    vector< double > sin2_edges, dm2_edges;
+    for( int j = 0; j <= 40; ++j ) sin2_edges.push_back( 1e-3 * pow( 1e3, ( j - 0.5 ) / 39 ) );
+    for( int j = 0; j <= 40; ++j ) dm2_edges.push_back( 0.1 * pow( 1e3, ( j - 0.5 ) / 39 ) );
+
+    TFile sterile_file( "sterile_sensitivity.root", "RECREATE" );
+
+    for( int i = 0; i < 5; ++i ){
+
+        vector< double > sterile_chi2;
+        OscillationChi2( FlatBatchFill( batch, Form( "sterile%d_Ev_cc", i + 1 ) ), norms[i], sterile_chi2 );
+
+        int n_excluded = 0;
+        for( unsigned int j = 0; j < sterile_chi2.size(); ++j ){
+            if( sterile_chi2[j] > 4.61 ) ++n_excluded;
+        }
+
+        sterile_file.cd();
+        TH2D h_sterile( Form( "h%d_sterile_chi2", i + 1 ), Form( "#nu_{#mu} CC disappearance #chi^{2}, %s", channel_models[i] ),
+                        40, &sin2_edges[0], 40, &dm2_edges[0] );
+        OscillationGridToTH2( sterile_grid, sterile_chi2, &h_sterile );
+        h_sterile.Write();
+
+        cout << " " << channel_models[i] << " nu_mu CC disappearance : " << n_excluded << " of "
+             << sterile_chi2.size() << " grid points excluded at 90% CL (stat. only) " << endl;
+    }
+
+    sterile_file.Close();
+    SetFlatOscillations( 0 );
+
+    // -------------------------------------------------------------------------
+    //                  W, TKI and hadronic energy, CC0pi
+    // -------------------------------------------------------------------------
+    // Filled in the batch pass above from the arrays of the fused kernel
+    for( int j = 0; j < n_kinematic_plots; ++j ){
+
+        HistStacker(kinematic_stacks[j], leg_entries, norms, kinematic_titles[j], kinematic_files[j], kinematic_axes[j], "Number of SBND events");
+
+        for( unsigned int i = 0; i < kinematic_stacks[j].size(); ++i ){
+            delete kinematic_stacks[j][i];
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    //                          I/O run summary
+    // -------------------------------------------------------------------------
+    ofstream file_io;
+    file_io.open( "model_comparisons_run_summary.txt" );
+
+    GstIOReport( gst1, "Default", file_io );
+    GstIOReport( gst2, "Default + MEC", file_io );
+    GstIOReport( gst3, "G17_02b", file_io );
+    GstIOReport( gst4, "G17_01a", file_io );
+    GstIOReport( gst5, "G17_01b", file_io );
+
+    CloseGstReader( gst1 );
+    CloseGstReader( gst2 );
+    CloseGstReader( gst3 );
+    CloseGstReader( gst4 );
+    CloseGstReader( gst5 );
+
     return 0;
 }
 
@@ -2104,6 +2415,10 @@ void HistStacker ( vector< TH1D* >   &hists,
         exit(1);
     }
     
+    // Histograms given errors, the bootstrap errors of bootstrap.h for
+    // example, are drawn with them
+    bool draw_errors = hists[0]->GetSumw2N() > 0;
+
     // Loop over the histograms 
     for ( int i = 0; i < n_hists; ++i ) {
 
@@ -2178,15 +2493,13 @@ void HistStacker ( vector< TH1D* >   &hists,
     gStyle->SetErrorX(0);
 */
     // Draw the histograms
-    //hists[0]->Draw( "e1" );
-    hists[0]->Draw();
+    hists[0]->Draw( draw_errors ? "e1" : "" );
     for ( int i = 1; i < n_hists; ++i ) {        
      
         // For now, don't draw G17_01b
         if( i != 4 ){
             // Draw the histograms 
-            //hists[i]->Draw( "samee1" );
-            hists[i]->Draw( "same" );
+            hists[i]->Draw( draw_errors ? "samee1" : "same" );
         }
 
     }
@@ -2205,6 +2518,55 @@ void HistStacker ( vector< TH1D* >   &hists,
         
 }
 
+// -------------------------------------------------------------------------
+//                  hist stacking function, by channel
+// -------------------------------------------------------------------------
+void HistStacker ( vector< TH1D* >   &hists,
+                   double            norm,
+                   const char* title,
+                   const char* file_name,
+                   const char* x_axis,
+                   const char* y_axis ){
+
+    if ( int( hists.size() ) != kNChannels ) {
+        cerr << " There should be a histogram for each of the " << kNChannels << " channels " << endl;
+        exit(1);
+    }
+
+    TCanvas *c     = new TCanvas( "c", title, 800, 600 );
+    TLegend *leg   = new TLegend( 0.68, 0.63, 0.88, 0.88 );
+    THStack *stack = new THStack( "channel_stack", title );
+
+    const int colours[kNChannels] = { 2, 4, 3, 6, 7, 15 };
+
+    for ( int i = 0; i < kNChannels; ++i ) {
+
+        hists[i]->SetLineColor( colours[i] );
+        hists[i]->SetFillColor( colours[i] );
+        hists[i]->SetLineWidth( 1 );
+        hists[i]->Scale( norm );
+
+        stack->Add( hists[i] );
+    }
+
+    // The legend from the top of the stack down
+    for ( int i = kNChannels - 1; i >= 0; --i ) {
+        leg->AddEntry( hists[i], ChannelName( i ), "f" );
+    }
+
+    stack->Draw( "hist" );
+    stack->GetXaxis()->SetTitle(x_axis);
+    stack->GetYaxis()->SetTitle(y_axis);
+    stack->GetYaxis()->SetTitleOffset(1.5);
+
+    leg->Draw();
+    c->SaveAs(file_name);
+
+    delete c;
+    delete leg;
+    delete stack;
+}
+
 // -------------------------------------------------------------------------
 //                    reconstructed energy calculation
 // -------------------------------------------------------------------------
@@ -2212,71 +2574,90 @@ void RecoNuE( TTree *event_tree,
               vector< double > &reco_E_CC, 
               vector< double > &reco_E_NC,
               vector< double > &MC_reco_E_CC, 
-              vector< double > &MC_reco_E_NC ){
+              vector< double > &MC_reco_E_NC,
+              bool full_tree ){
 
-    // Get the branches to calculate reconstructed energy and MC energy
-    TBranch *b_mu_e  = event_tree->GetBranch("El");
-    TBranch *b_nu_e  = event_tree->GetBranch("Ev");
-    TBranch *b_mu_p  = event_tree->GetBranch("pl");
-    TBranch *b_theta = event_tree->GetBranch("cthl");
-    TBranch *b_nfpi0 = event_tree->GetBranch("nfpi0");
-    TBranch *b_nfpip = event_tree->GetBranch("nfpip");
-    TBranch *b_nfpim = event_tree->GetBranch("nfpim");
-    TBranch *b_cc    = event_tree->GetBranch("cc");
-    TBranch *b_nc    = event_tree->GetBranch("nc");
+    // The CC0pi and NC0pi skims hold every event used here, when written,
+    // unless the full tree is asked for
+    vector< int > reco_topologies;
+    reco_topologies.push_back( kCC0Pi );
+    reco_topologies.push_back( kNC0Pi );
+
+    s_branches reco_branches;
+    const char* reco_names[9] = { "El", "Ev", "pl", "cthl", "nfpi0", "nfpip", "nfpim", "cc", "nc" };
+    reco_branches.insert( reco_names, reco_names + 9 );
+
+    vector< TTree* > reco_trees( 1, event_tree );
+    if( !full_tree ) GstSkimTrees( event_tree, reco_topologies, reco_branches, reco_trees );
+
+    for( unsigned int t = 0; t < reco_trees.size(); ++t ){
+
+        TTree *reco_tree = reco_trees[t];
+
+        // Get the branches to calculate reconstructed energy and MC energy
+        TBranch *b_mu_e  = reco_tree->GetBranch("El");
+        TBranch *b_nu_e  = reco_tree->GetBranch("Ev");
+        TBranch *b_mu_p  = reco_tree->GetBranch("pl");
+        TBranch *b_theta = reco_tree->GetBranch("cthl");
+        TBranch *b_nfpi0 = reco_tree->GetBranch("nfpi0");
+        TBranch *b_nfpip = reco_tree->GetBranch("nfpip");
+        TBranch *b_nfpim = reco_tree->GetBranch("nfpim");
+        TBranch *b_cc    = reco_tree->GetBranch("cc");
+        TBranch *b_nc    = reco_tree->GetBranch("nc");
     
-    // The variables from the branches and get the leaves
-    double m_n   = 0.93828;   // Nucleon mass, GeV
-    double m_mu  = 0.10566;   // Muon mass, GeV
+        // The variables from the branches and get the leaves
+        double m_n   = 0.93828;   // Nucleon mass, GeV
+        double m_mu  = 0.10566;   // Muon mass, GeV
 
-    int n_values = event_tree->GetEntries(); // Number of entries to loop over
+        int n_values = reco_tree->GetEntries(); // Number of entries to loop over
     
-    // Loop over the leaves and calculate the reconstructed energy
-    for( int i = 0; i < n_values; ++i){
+        // Loop over the leaves and calculate the reconstructed energy
+        for( int i = 0; i < n_values; ++i){
         
-        event_tree->GetEntry(i);
+            ReadGstEntry( reco_tree, i );
 
-        double reco, reco_mc, e, p, cth;
+            double reco, reco_mc, e, p, cth;
         
-        // For CC0pi
-        if( b_cc->GetLeaf("cc")->GetValue() != 0 
-            && b_nfpip->GetLeaf("nfpip")->GetValue()
-             + b_nfpim->GetLeaf("nfpim")->GetValue()
-             + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
+            // For CC0pi
+            if( b_cc->GetLeaf("cc")->GetValue() != 0 
+                && b_nfpip->GetLeaf("nfpip")->GetValue()
+                 + b_nfpim->GetLeaf("nfpim")->GetValue()
+                 + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
          
-                // Get the values needed
-                e   = b_mu_e->GetLeaf("El")->GetValue();
-                p   = b_mu_p->GetLeaf("pl")->GetValue();
-                cth = b_theta->GetLeaf("cthl")->GetValue(); 
+                    // Get the values needed
+                    e   = b_mu_e->GetLeaf("El")->GetValue();
+                    p   = b_mu_p->GetLeaf("pl")->GetValue();
+                    cth = b_theta->GetLeaf("cthl")->GetValue(); 
             
-                reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
+                    reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
         
-                reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
-
-                // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
-                MC_reco_E_CC.push_back(reco_mc);
-                reco_E_CC.push_back(reco);
-
-        }
-        // For NC0pi
-        else if( b_nc->GetLeaf("nc")->GetValue() != 0 
-                 && b_nfpip->GetLeaf("nfpip")->GetValue()
-                  + b_nfpim->GetLeaf("nfpim")->GetValue()
-                  + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
+                    reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
+
+                    // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
+                    MC_reco_E_CC.push_back(reco_mc);
+                    reco_E_CC.push_back(reco);
+
+            }
+            // For NC0pi
+            else if( b_nc->GetLeaf("nc")->GetValue() != 0 
+                     && b_nfpip->GetLeaf("nfpip")->GetValue()
+                      + b_nfpim->GetLeaf("nfpim")->GetValue()
+                      + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
               
-                // Get the values
-                e   = b_mu_e->GetLeaf("El")->GetValue();
-                p   = b_mu_p->GetLeaf("pl")->GetValue();
-                cth = b_theta->GetLeaf("cthl")->GetValue(); 
+                    // Get the values
+                    e   = b_mu_e->GetLeaf("El")->GetValue();
+                    p   = b_mu_p->GetLeaf("pl")->GetValue();
+                    cth = b_theta->GetLeaf("cthl")->GetValue(); 
             
-                reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
+                    reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
         
-                reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
+                    reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
 
-                // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
-                MC_reco_E_NC.push_back(reco_mc);
-                reco_E_NC.push_back(reco);
+                    // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
+                    MC_reco_E_NC.push_back(reco_mc);
+                    reco_E_NC.push_back(reco);
 
+            }
         }
     }
 }
@@ -2320,7 +2701,7 @@ void FSPNumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
         
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
      
         // Count #final state leptons
         if( b_fspl->GetLeaf("fspl")->GetValue() == 13 ){
@@ -2408,42 +2789,12 @@ void FSINumbers( TTree *event_tree,
     //      - nc3pi
     //      - nccoh
     //
-    // Set the branch addresses for these leaves
-    TBranch *b_pdg = event_tree->GetBranch("pdgf");
-    TBranch *b_cc  = event_tree->GetBranch("cc");
-    TBranch *b_nc  = event_tree->GetBranch("nc");
-    TBranch *b_coh = event_tree->GetBranch("coh");
-    TBranch *b_pi0 = event_tree->GetBranch("nfpi0");
-    TBranch *b_pip = event_tree->GetBranch("nfpip");
-    TBranch *b_pim = event_tree->GetBranch("nfpim");
-
-    // Charged current counters
-    int ncc0pi    = 0;
-    int ncc1pip   = 0;
-    int ncc1pim   = 0;
-    int ncc1pi0   = 0;
-    int ncc2pip   = 0;
-    int ncc2pim   = 0;
-    int ncc2pi0   = 0;
-    int nccpippim = 0;
-    int nccpippi0 = 0;
-    int nccpimpi0 = 0;
-    int ncc3pi    = 0;
-    int ncccoh    = 0;
+    // The topologies are defined in topologies.h and classified together
+    TopologyLeaves leaves;
+    GetTopologyLeaves( event_tree, leaves );
 
-    // Neutral current counters
-    int nnc0pi    = 0;
-    int nnc1pip   = 0;
-    int nnc1pim   = 0;
-    int nnc1pi0   = 0;
-    int nnc2pip   = 0;
-    int nnc2pim   = 0;
-    int nnc2pi0   = 0;
-    int nncpippim = 0;
-    int nncpippi0 = 0;
-    int nncpimpi0 = 0;
-    int nnc3pi    = 0;
-    int nnccoh    = 0;
+    TopologyEvent event;
+    vector< int > n_topology( kNTopologies, 0 );
 
     // Get the number of events which contain final state muons
     int n_values = event_tree->GetEntries(); // Number of entries to loop over
@@ -2452,224 +2803,43 @@ void FSINumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
     
         // Get the current entry
-        event_tree->GetEntry(i);
-    
-        // Charged current
-        // CC0Pi
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++ncc0pi;
-        }
+        ReadGstEntry( event_tree, i );
 
-        // CC1Pi+
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 1 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++ncc1pip;
-        }
-     
-        // CC1Pi-
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 1 ){
-            
-            ++ncc1pim;
-        }
-        
-        // CC1Pi0
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 1 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++ncc1pi0;
-        }
-        
-        // CC2Pi+
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 2 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++ncc2pip;
-        }
-     
-        // CC2Pi-
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 2 ){
-            
-            ++ncc2pim;
-        }
-        
-        // CC2Pi0
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 2 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++ncc2pi0;
-        }
-        
-        // CCPi+Pi-
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 1 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 1 ){
-            
-            ++nccpippim;
-        }
-     
-        // CCPi+Pi0
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 1 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 1 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nccpippi0;
-        }
-        
-        // CCPi-Pi0
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 1 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 1 ){
-            
-            ++nccpimpi0;
-        }
-        
-        // CC >3Pi
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && ( b_pi0->GetLeaf("nfpi0")->GetValue() 
-                + b_pip->GetLeaf("nfpip")->GetValue()
-                + b_pim->GetLeaf("nfpim")->GetValue() ) >= 3 ){
-            
-            ++ncc3pi;
-        }
-        
-        // CCCOH
-        if ( b_cc->GetLeaf("cc")->GetValue() != 0 
-             && b_coh->GetLeaf("coh")->GetValue() !=0 ){
-            
-            ++ncccoh;
-        }
-       
-        //----------------------------------------------------------
-        // Neutral current
-        // NC0Pi
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nnc0pi;
-        }
+        TopologyEventFrom( leaves, event );
+        unsigned int mask = ClassifyTopology( event );
 
-        // nc1Pi+
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 1 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nnc1pip;
-        }
-     
-        // nc1Pi-
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 1 ){
-            
-            ++nnc1pim;
-        }
-        
-        // nc1Pi0
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 1 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nnc1pi0;
-        }
-        
-        // nc2Pi+
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 2 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nnc2pip;
-        }
-     
-        // nc2Pi-
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 2 ){
-            
-            ++nnc2pim;
-        }
-        
-        // nc2Pi0
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 2 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nnc2pi0;
-        }
-        
-        // ncPi+Pi-
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 0 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 1 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 1 ){
-            
-            ++nncpippim;
-        }
-     
-        // ncPi+Pi0
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 1 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 1 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 0 ){
-            
-            ++nncpippi0;
-        }
-        
-        // ncPi-Pi0
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_pi0->GetLeaf("nfpi0")->GetValue() == 1 
-             && b_pip->GetLeaf("nfpip")->GetValue() == 0 
-             && b_pim->GetLeaf("nfpim")->GetValue() == 1 ){
-            
-            ++nncpimpi0;
-        }
-        
-        // nc >3Pi
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && ( b_pi0->GetLeaf("nfpi0")->GetValue() 
-                + b_pip->GetLeaf("nfpip")->GetValue()
-                + b_pim->GetLeaf("nfpim")->GetValue() ) >= 3 ){
-            
-            ++nnc3pi;
-        }
-        
-        // NCCOH
-        if ( b_nc->GetLeaf("nc")->GetValue() != 0 
-             && b_coh->GetLeaf("coh")->GetValue() !=0 ){
-            
-            ++nnccoh;
+        for( int j = 0; j < kNTopologies; ++j ){
+            if( mask & TopologyBit( j ) ) ++n_topology[j];
         }
     }
 
+    // Charged current counters
+    int ncc0pi    = n_topology[kCC0Pi];
+    int ncc1pip   = n_topology[kCC1PiP];
+    int ncc1pim   = n_topology[kCC1PiM];
+    int ncc1pi0   = n_topology[kCC1Pi0];
+    int ncc2pip   = n_topology[kCC2PiP];
+    int ncc2pim   = n_topology[kCC2PiM];
+    int ncc2pi0   = n_topology[kCC2Pi0];
+    int nccpippim = n_topology[kCCPiPPiM];
+    int nccpippi0 = n_topology[kCCPiPPi0];
+    int nccpimpi0 = n_topology[kCCPiMPi0];
+    int ncc3pi    = n_topology[kCC3Pi];
+    int ncccoh    = n_topology[kCCCoh];
+
+    // Neutral current counters
+    int nnc0pi    = n_topology[kNC0Pi];
+    int nnc1pip   = n_topology[kNC1PiP];
+    int nnc1pim   = n_topology[kNC1PiM];
+    int nnc1pi0   = n_topology[kNC1Pi0];
+    int nnc2pip   = n_topology[kNC2PiP];
+    int nnc2pim   = n_topology[kNC2PiM];
+    int nnc2pi0   = n_topology[kNC2Pi0];
+    int nncpippim = n_topology[kNCPiPPiM];
+    int nncpippi0 = n_topology[kNCPiPPi0];
+    int nncpimpi0 = n_topology[kNCPiMPi0];
+    int nnc3pi    = n_topology[kNC3Pi];
+    int nnccoh    = n_topology[kNCCoh];
 
     // Now fill the map with the values
     // Do this in such a way that the key can be printed straight into a table
@@ -2784,6 +2954,53 @@ void FSINumbers( TTree *event_tree,
     file << " ------------------------- " << endl;
 }
 
+// -------------------------------------------------------------------------
+//                      Bootstrap errors of the FSI counts
+// -------------------------------------------------------------------------
+void BookFSIErrors( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* name,
+                    int n_replicas ){
+
+    // A one bin count of each of the CC and NC topologies
+    for( int t = 0; t < 2 * kNFSITopologies; ++t ){
+
+        FlatFill fill;
+        fill.variable      = "0";
+        fill.topology_mask = TopologyBit( kCC0Pi + t );
+        BookFlatHist( fill.hist, 1, -0.5, 0.5 );
+        BookFlatReplicas( fill, n_replicas );
+
+        FlatBook( batch, event_tree, Form( "%s_%s", name, TopologyName( kCC0Pi + t ) ), fill );
+    }
+}
+
+void FSIErrors( const FlatBatch &batch,
+                const char* name,
+                double norm,
+                vector< double > &n_cc_fsi_err,
+                vector< double > &n_nc_fsi_err,
+                vector< double > &n_cc_mc_fsi_err,
+                vector< double > &n_nc_mc_fsi_err ){
+
+    for( int t = 0; t < 2 * kNFSITopologies; ++t ){
+
+        const FlatFill &fill = FlatBatchFill( batch, Form( "%s_%s", name, TopologyName( kCC0Pi + t ) ) );
+
+        vector< double > errors;
+        double error = FlatBootstrapErrors( fill, errors );
+
+        if( t < kNFSITopologies ){
+            n_cc_mc_fsi_err.push_back( error );
+            n_cc_fsi_err.push_back( norm * error );
+        }
+        else{
+            n_nc_mc_fsi_err.push_back( error );
+            n_nc_fsi_err.push_back( norm * error );
+        }
+    }
+}
+
 // -------------------------------------------------------------------------
 //                      Make final state tables
 // -------------------------------------------------------------------------
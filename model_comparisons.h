@@ -24,9 +24,22 @@
 #include "TGraph.h"
 #include "TCanvas.h"
 #include "TLegend.h"
+#include "THStack.h"
 #include "TLatex.h"
 #include "TStyle.h"
 #include "TObjArray.h"
+#include "TString.h"
+#include "gst_reader.h"
+#include "flat_hist.h"
+#include "topologies.h"
+#include "skim_tree.h"
+#include "threshold_scan.h"
+#include "event_kinematics.h"
+#include "energy_migration.h"
+#include "unfolding.h"
+#include "universe_weights.h"
+#include "bootstrap.h"
+#include "oscillation_grid.h"
 
 // -------------------------------------------------------------------------
 //                          Typedefs 
@@ -81,15 +94,33 @@ void HistStacker ( vector< TH1D* >   &hists,
                    const char* x_axis,
                    const char* y_axis );
 
+// -------------------------------------------------------------------------
+// The stacked-by-channel mode of the stacking function, for one model:
+//      hists : the histograms of each InteractionChannel of flat_hist.h,
+//              as filled by FillFlat for a fill split by BookFlatChannels
+//      norm  : the normalisation of the model
+// The channels are drawn filled, one on top of the other, so the top of
+// the stack is the distribution of the model
+// -------------------------------------------------------------------------
+void HistStacker ( vector< TH1D* >   &hists,
+                   double            norm,
+                   const char* title,
+                   const char* file_name,
+                   const char* x_axis,
+                   const char* y_axis );
+
 // -------------------------------------------------------------------------
 // Calculating the reconstructed energy of the neutrinos to compare with the 
 // MC value
+// The CC0pi and NC0pi skims of skim_tree.h are read in place of the gst
+// tree when they have been written, unless full_tree is set
 // -------------------------------------------------------------------------
 void RecoNuE( TTree *event_tree,
               vector< double > &reco_E_CC, 
               vector< double > &reco_E_NC,
               vector< double > &MC_reco_E_CC, 
-              vector< double > &MC_reco_E_NC );
+              vector< double > &MC_reco_E_NC,
+              bool full_tree = false );
 
 // -------------------------------------------------------------------------
 // Make a map of the number of final state particles in each model
@@ -110,6 +141,28 @@ void FSINumbers( TTree *event_tree,
                  vector< double > &n_cc_mc_fsi,
                  vector< double > &n_nc_mc_fsi );
 
+// -------------------------------------------------------------------------
+// Book a one bin count of each of the topologies of FSINumbers, with
+// n_replicas Poisson bootstrap replicas of the events, into a batch under
+// <name>_<topology>, so that they are filled with its histograms
+// -------------------------------------------------------------------------
+void BookFSIErrors( FlatBatch &batch,
+                    TTree *event_tree,
+                    const char* name,
+                    int n_replicas );
+
+// -------------------------------------------------------------------------
+// The bootstrap statistical errors of the counts of FSINumbers, in the
+// same order, from those booked by BookFSIErrors after RunFlatBatch
+// -------------------------------------------------------------------------
+void FSIErrors( const FlatBatch &batch,
+                const char* name,
+                double norm,
+                vector< double > &n_cc_fsi_err,
+                vector< double > &n_nc_fsi_err,
+                vector< double > &n_cc_mc_fsi_err,
+                vector< double > &n_nc_mc_fsi_err );
+
 // -------------------------------------------------------------------------
 // Make a table to compare the number of different final state particles
 // and interactions in each model configuration
@@ -0,0 +1,322 @@
+/*
+ * 3+1 sterile neutrino oscillation weights over a grid of parameters
+ *
+ * See oscillation_grid.h for the description of each function
+ *
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include "oscillation_grid.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The grid of the fills booked with BookFlatOscillations, set by
+// SetFlatOscillations
+// -------------------------------------------------------------------------
+static OscillationGrid flat_oscillation_grid;
+static bool            flat_oscillations = false;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+// The phases of a grid from its mass splittings and baselines
+// -------------------------------------------------------------------------
+static void OscillationPhases( OscillationGrid &grid ){
+
+    int n_baselines = grid.baselines.size();
+
+    grid.phases.assign( grid.dm2.size() * n_baselines, 0 );
+
+    for( unsigned int i = 0; i < grid.dm2.size(); ++i ){
+        for( int l = 0; l < n_baselines; ++l ){
+            grid.phases[ i * n_baselines + l ] = 1.267 * grid.dm2[i] * grid.baselines[l];
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// n values spaced evenly in log from min to max
+// -------------------------------------------------------------------------
+static void OscillationLogSpaced( int n,
+                                  double min,
+                                  double max,
+                                  vector< double > &values ){
+
+    values.resize( n );
+
+    for( int k = 0; k < n; ++k ){
+        values[k] = n > 1 ? min * pow( max / min, double( k ) / ( n - 1 ) ) : min;
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          book a grid
+// -------------------------------------------------------------------------
+void BookOscillationGrid( OscillationGrid &grid,
+                          int channel,
+                          int n_dm2,
+                          double dm2_min,
+                          double dm2_max,
+                          int n_sin2,
+                          double sin2_min,
+                          double sin2_max ){
+
+    if( n_dm2 < 1 || n_sin2 < 1 || !( dm2_min > 0 ) || dm2_max < dm2_min
+                  || !( sin2_min > 0 ) || sin2_max < sin2_min || sin2_max > 1 ){
+        cerr << " Invalid oscillation grid " << endl;
+        exit(1);
+    }
+
+    if( channel != kOscDisappearance && channel != kOscAppearance ){
+        cerr << " Unknown oscillation channel " << channel << endl;
+        exit(1);
+    }
+
+    grid.channel = channel;
+    OscillationLogSpaced( n_dm2,  dm2_min,  dm2_max,  grid.dm2 );
+    OscillationLogSpaced( n_sin2, sin2_min, sin2_max, grid.sin2_2theta );
+
+    SetOscillationBaseline( grid, kSbndBaseline );
+}
+
+// -------------------------------------------------------------------------
+//                          baselines
+// -------------------------------------------------------------------------
+void SetOscillationBaseline( OscillationGrid &grid,
+                             double baseline ){
+
+    if( baseline < 0 ){
+        cerr << " A baseline cannot be negative : " << baseline << endl;
+        exit(1);
+    }
+
+    grid.baselines.assign( 1, baseline );
+    grid.baseline_weights.assign( 1, 1 );
+
+    OscillationPhases( grid );
+}
+
+void SetOscillationBaselines( OscillationGrid &grid,
+                              const TH1 *distribution ){
+
+    grid.baselines.clear();
+    grid.baseline_weights.clear();
+
+    double total = 0;
+
+    for( int bin = 1; bin <= distribution->GetNbinsX(); ++bin ){
+
+        double content = distribution->GetBinContent( bin );
+        if( content <= 0 ) continue;
+
+        double baseline = distribution->GetXaxis()->GetBinCenter( bin );
+        if( baseline < 0 ){
+            cerr << " The baselines of " << distribution->GetName() << " cannot be negative " << endl;
+            exit(1);
+        }
+
+        grid.baselines.push_back( baseline );
+        grid.baseline_weights.push_back( content );
+        total += content;
+    }
+
+    if( total <= 0 ){
+        cerr << " The baseline distribution " << distribution->GetName() << " is empty " << endl;
+        exit(1);
+    }
+
+    for( unsigned int l = 0; l < grid.baseline_weights.size(); ++l ){
+        grid.baseline_weights[l] /= total;
+    }
+
+    OscillationPhases( grid );
+}
+
+// -------------------------------------------------------------------------
+//                          weights of an event
+// -------------------------------------------------------------------------
+void OscillationWeights( const OscillationGrid &grid,
+                         double Ev,
+                         double *weights ){
+
+    int n_dm2       = grid.dm2.size();
+    int n_sin2      = grid.sin2_2theta.size();
+    int n_baselines = grid.baselines.size();
+
+    const double *sin2     = &grid.sin2_2theta[0];
+    const double *fraction = &grid.baseline_weights[0];
+
+    double inverse_E = Ev > 0 ? 1 / Ev : 0;
+
+    for( int i = 0; i < n_dm2; ++i ){
+
+        // The mean of sin^2 over the baselines, or a half, its mean over
+        // the phase, for an event without a neutrino energy. Where the
+        // phase is fast each event still takes its own value, which the
+        // many energies of the events in a bin average over
+        const double *phase = &grid.phases[ i * n_baselines ];
+
+        double mean = 0.5;
+        if( Ev > 0 ){
+            mean = 0;
+            for( int l = 0; l < n_baselines; ++l ){
+                double s = sin( phase[l] * inverse_E );
+                mean += fraction[l] * s * s;
+            }
+        }
+
+        // then every amplitude of this dm2 at once
+        double *block = &weights[ i * n_sin2 ];
+
+        if( grid.channel == kOscDisappearance ){
+            for( int j = 0; j < n_sin2; ++j ) block[j] = 1 - sin2[j] * mean;
+        }
+        else{
+            for( int j = 0; j < n_sin2; ++j ) block[j] = sin2[j] * mean;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          grid of the fills
+// -------------------------------------------------------------------------
+void SetFlatOscillations( const OscillationGrid *grid ){
+
+    flat_oscillations = grid != 0;
+    if( grid ) flat_oscillation_grid = *grid;
+}
+
+const OscillationGrid *FlatOscillations(){
+
+    return flat_oscillations ? &flat_oscillation_grid : 0;
+}
+
+void BookFlatOscillations( FlatFill &fill ){
+
+    if( !flat_oscillations ){
+        cerr << " Set an oscillation grid with SetFlatOscillations before booking " << fill.variable << endl;
+        exit(1);
+    }
+
+    fill.oscillated.n_universes = OscillationPoints( flat_oscillation_grid );
+    fill.oscillated.entries     = 0;
+    fill.oscillated.cells.assign( fill.hist.cells.size() * fill.oscillated.n_universes, 0 );
+}
+
+int FlatOscillationCount( const vector< FlatFill > &fills ){
+
+    int n_points = 0;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        if( fills[i].oscillated.cells.empty() ) continue;
+
+        if( !flat_oscillations || fills[i].oscillated.n_universes != OscillationPoints( flat_oscillation_grid ) ){
+            cerr << " The fill " << fills[i].variable << " was booked for another oscillation grid " << endl;
+            exit(1);
+        }
+        n_points = fills[i].oscillated.n_universes;
+    }
+
+    return n_points;
+}
+
+// -------------------------------------------------------------------------
+//                          spectrum at a point
+// -------------------------------------------------------------------------
+void OscillatedToTH1( const FlatFill &fill,
+                      int point,
+                      TH1 *h ){
+
+    const FlatUniverses &oscillated = fill.oscillated;
+
+    if( oscillated.cells.empty() || point < 0 || point >= oscillated.n_universes ){
+        cerr << " The fill " << fill.variable << " has no oscillation point " << point << endl;
+        exit(1);
+    }
+
+    if( h->GetNcells() != int( fill.hist.cells.size() ) ){
+        cerr << " The binning of " << h->GetName() << " does not match the flat histogram " << endl;
+        exit(1);
+    }
+
+    h->Reset();
+
+    for( unsigned int i = 0; i < fill.hist.cells.size(); ++i ){
+        double content = oscillated.cells[ Long64_t( i ) * oscillated.n_universes + point ];
+        if( content != 0 ) h->SetBinContent( i, content );
+    }
+
+    h->SetEntries( double( fill.hist.entries ) );
+}
+
+// -------------------------------------------------------------------------
+//                          sensitivity
+// -------------------------------------------------------------------------
+void OscillationChi2( const FlatFill &fill,
+                      double norm,
+                      vector< double > &chi2 ){
+
+    const FlatUniverses &oscillated = fill.oscillated;
+
+    if( oscillated.cells.empty() || !flat_oscillations ){
+        cerr << " The fill " << fill.variable << " was not filled over an oscillation grid " << endl;
+        exit(1);
+    }
+
+    bool appearance = flat_oscillation_grid.channel == kOscAppearance;
+    int  n_points   = oscillated.n_universes;
+    int  n_cells    = fill.hist.cells.size();
+    int  n_x        = fill.hist.x.n_bins;
+    int  n_y        = fill.hist.y.n_bins;
+
+    chi2.assign( n_points, 0 );
+
+    for( int cell = 0; cell < n_cells; ++cell ){
+
+        // The under and overflow are left out
+        int bin_x = cell % ( n_x + 2 );
+        int bin_y = cell / ( n_x + 2 );
+        if( bin_x < 1 || bin_x > n_x ) continue;
+        if( n_y > 0 && ( bin_y < 1 || bin_y > n_y ) ) continue;
+
+        double expected = fill.hist.cells[cell] * norm;
+        if( expected <= 0 ) continue;
+
+        const double *block = &oscillated.cells[ Long64_t( cell ) * n_points ];
+
+        for( int p = 0; p < n_points; ++p ){
+            double difference = appearance ? block[p] * norm : block[p] * norm - expected;
+            chi2[p] += difference * difference / expected;
+        }
+    }
+}
+
+void OscillationGridToTH2( const OscillationGrid &grid,
+                           const vector< double > &values,
+                           TH2 *h ){
+
+    int n_dm2  = grid.dm2.size();
+    int n_sin2 = grid.sin2_2theta.size();
+
+    if( int( values.size() ) != n_dm2 * n_sin2 || h->GetNbinsX() != n_sin2 || h->GetNbinsY() != n_dm2 ){
+        cerr << " The binning of " << h->GetName() << " does not match the oscillation grid " << endl;
+        exit(1);
+    }
+
+    h->Reset();
+
+    for( int i = 0; i < n_dm2; ++i ){
+        for( int j = 0; j < n_sin2; ++j ){
+            h->SetBinContent( j + 1, i + 1, values[ i * n_sin2 + j ] );
+        }
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * 3+1 sterile neutrino oscillation weights over a grid of parameters
+ *
+ * In the short baseline approximation the probabilities of a 3+1 model
+ * depend on one mass splitting and one amplitude,
+ *      P( nu_mu -> nu_mu ) = 1 - sin^2 2theta_mumu sin^2( 1.267 dm2 L / E )
+ *      P( nu_mu -> nu_e  ) =     sin^2 2theta_mue  sin^2( 1.267 dm2 L / E )
+ * with dm2 in eV^2, L in km and E in GeV. An OscillationGrid holds a grid
+ * of ( dm2, sin^2 2theta ) points and the baselines of the neutrinos, so
+ * the weights of an event at every point of the grid are found at once:
+ * the sines once for each dm2 and baseline, then a multiply and add for
+ * each amplitude, the points of a dm2 next to each other
+ *
+ * The fills of flat_hist.h booked with BookFlatOscillations are filled at
+ * every point of the grid set by SetFlatOscillations in the same pass,
+ * and OscillationChi2 compares each oscillated spectrum with the one
+ * without oscillations for a sensitivity over the whole grid
+ *
+*/
+
+#ifndef OSCILLATION_GRID_H
+#define OSCILLATION_GRID_H
+
+#include <vector>
+#include "TH1.h"
+#include "TH2.h"
+#include "flat_hist.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The baseline of SBND from the BNB target (km), as in the (450/110)^2
+// scaling of Norm
+// -------------------------------------------------------------------------
+const double kSbndBaseline = 0.110;
+
+// -------------------------------------------------------------------------
+// The probability an OscillationGrid gives
+// -------------------------------------------------------------------------
+enum OscillationChannel {
+    kOscDisappearance,
+    kOscAppearance
+};
+
+// -------------------------------------------------------------------------
+// A grid of 3+1 oscillation parameters
+//      channel          : an OscillationChannel
+//      dm2              : the mass splittings (eV^2)
+//      sin2_2theta      : the amplitudes
+//      baselines        : the baselines of the neutrinos (km)
+//      baseline_weights : the fraction of the neutrinos at each baseline
+//      phases           : 1.267 dm2 L for each dm2 and baseline,
+//                         dm2 * n_baselines + baseline
+// The point of dm2[i] and sin2_2theta[j] is i * sin2_2theta.size() + j
+// -------------------------------------------------------------------------
+struct OscillationGrid {
+    int              channel;
+    vector< double > dm2;
+    vector< double > sin2_2theta;
+    vector< double > baselines;
+    vector< double > baseline_weights;
+    vector< double > phases;
+};
+
+// -------------------------------------------------------------------------
+// Set up a grid with n_dm2 mass splittings and n_sin2 amplitudes, each
+// spaced evenly in log between its limits, at the SBND baseline
+// -------------------------------------------------------------------------
+void BookOscillationGrid( OscillationGrid &grid,
+                          int channel,
+                          int n_dm2,
+                          double dm2_min,
+                          double dm2_max,
+                          int n_sin2,
+                          double sin2_min,
+                          double sin2_max );
+
+// -------------------------------------------------------------------------
+// Put all of the neutrinos of a grid at one baseline (km)
+// -------------------------------------------------------------------------
+void SetOscillationBaseline( OscillationGrid &grid,
+                             double baseline );
+
+// -------------------------------------------------------------------------
+// Spread the neutrinos of a grid over the baselines of a histogram (km),
+// the distance from each decay in the beamline for example, each bin
+// centre weighted by its content. The weights of an event cost a sine for
+// each dm2 and non-empty bin
+// -------------------------------------------------------------------------
+void SetOscillationBaselines( OscillationGrid &grid,
+                              const TH1 *distribution );
+
+// -------------------------------------------------------------------------
+// The number of points of a grid
+// -------------------------------------------------------------------------
+inline int OscillationPoints( const OscillationGrid &grid ){
+
+    return grid.dm2.size() * grid.sin2_2theta.size();
+}
+
+// -------------------------------------------------------------------------
+// The weight of a neutrino of energy Ev (GeV) at each point of a grid,
+// weights holding OscillationPoints( grid ) values
+// -------------------------------------------------------------------------
+void OscillationWeights( const OscillationGrid &grid,
+                         double Ev,
+                         double *weights );
+
+// -------------------------------------------------------------------------
+// Set the grid the fills booked with BookFlatOscillations are filled
+// over, or 0 for none. The grid is copied
+// -------------------------------------------------------------------------
+void SetFlatOscillations( const OscillationGrid *grid );
+
+// -------------------------------------------------------------------------
+// The grid set with SetFlatOscillations, 0 if none is
+// -------------------------------------------------------------------------
+const OscillationGrid *FlatOscillations();
+
+// -------------------------------------------------------------------------
+// Fill a fill at every point of the grid set with SetFlatOscillations as
+// well, with the binning of its histogram, each event weighted by its
+// probability from its Ev
+// -------------------------------------------------------------------------
+void BookFlatOscillations( FlatFill &fill );
+
+// -------------------------------------------------------------------------
+// The number of points the fills booked with BookFlatOscillations are
+// filled at, 0 if none is. Exits if they do not match the grid set
+// -------------------------------------------------------------------------
+int FlatOscillationCount( const vector< FlatFill > &fills );
+
+// -------------------------------------------------------------------------
+// Copy the spectrum of a fill at one point of the grid into a TH1D or
+// TH2D with the binning of its histogram
+// -------------------------------------------------------------------------
+void OscillatedToTH1( const FlatFill &fill,
+                      int point,
+                      TH1 *h );
+
+// -------------------------------------------------------------------------
+// The chi^2 of a fill at each point of the grid against no oscillations,
+// from the statistical errors of the events after scaling by norm, over
+// the bins without the under and overflow. For disappearance the spectrum
+// at each point is compared with that of the fill, for appearance the
+// events which appear are added to the spectrum of the fill, taken as the
+// background. A point is excluded at 90% CL with chi^2 above 4.61 in the
+// two parameters of the grid
+// -------------------------------------------------------------------------
+void OscillationChi2( const FlatFill &fill,
+                      double norm,
+                      vector< double > &chi2 );
+
+// -------------------------------------------------------------------------
+// Copy a value for each point of a grid, the chi^2 for example, into a
+// TH2 with sin^2 2theta on x and dm2 on y, a bin for each point
+// -------------------------------------------------------------------------
+void OscillationGridToTH2( const OscillationGrid &grid,
+                           const vector< double > &values,
+                           TH2 *h );
+
+// -------------------------------------------------------------------------
+
+#endif
@@ -24,7 +24,7 @@
 
 using namespace std; 
 
-int other_model_comparisons() {
+int other_model_comparisons( unsigned int n_threads = 0 ) {
 
     // -------------------------------------------------------------------------
     // Normalisation:
@@ -59,7 +59,7 @@ int other_model_comparisons() {
     //                              Open flux file
     // -------------------------------------------------------------------------
     
-    TFile f_flux("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root");
+    TFile f_flux( InputPath("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root").c_str() );
     if (f_flux.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -73,7 +73,7 @@ int other_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Default
-    TFile f1_xsec("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root");
+    TFile f1_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root").c_str() );
     if (f1_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -83,7 +83,7 @@ int other_model_comparisons() {
     }
     
     // Default+MEC
-    TFile f2_xsec("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root");
+    TFile f2_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root").c_str() );
     if (f2_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -93,7 +93,7 @@ int other_model_comparisons() {
     }
     
     // G16_02b
-    TFile f3_xsec("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root");
+    TFile f3_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root").c_str() );
     if (f3_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -103,7 +103,7 @@ int other_model_comparisons() {
     }
     
     // G16_01a
-    TFile f4_xsec("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root");
+    TFile f4_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root").c_str() );
     if (f4_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -113,7 +113,7 @@ int other_model_comparisons() {
     }
     
     // G16_01b
-    TFile f5_xsec("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root");
+    TFile f5_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root").c_str() );
     if (f5_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -126,7 +126,7 @@ int other_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Open Default
-    TFile f1("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root");
+    TFile f1( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f1.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -136,7 +136,7 @@ int other_model_comparisons() {
     }
 
     // Open Default+MEC
-    TFile f2("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root");
+    TFile f2( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f2.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -146,7 +146,7 @@ int other_model_comparisons() {
     }
 
     // Open G16_02b
-    TFile f3("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root");
+    TFile f3( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f3.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -156,7 +156,7 @@ int other_model_comparisons() {
     }
 
     // Open G16_01a
-    TFile f4("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root");
+    TFile f4( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f4.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -166,7 +166,7 @@ int other_model_comparisons() {
     }
 
     // Open G16_01b
-    TFile f5("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root");
+    TFile f5( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f5.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -185,6 +185,57 @@ int other_model_comparisons() {
     TTree *gst3 = (TTree*) f3.Get("gst");
     TTree *gst4 = (TTree*) f4.Get("gst");
     TTree *gst5 = (TTree*) f5.Get("gst");
+
+    // -------------------------------------------------------------------------
+    //                      Book the fills of the histograms
+    // -------------------------------------------------------------------------
+    // The histograms of the plots below are booked here, and all of the
+    // fills of a model are then run in one pass by RunFlatBatch
+    FlatBatch batch;
+
+    // CC0pi Np:Nn
+    TH2D *h1_NpNn_cc0pi = new TH2D("h1_NpNn_cc0pi","N_{p} vs N_{n} Default, CC0#pi",10,0,10,10,0,10);
+    TH2D *h2_NpNn_cc0pi = new TH2D("h2_NpNn_cc0pi","N_{p} vs N_{n} Default+MEC, CC0#pi",10,0,10,10,0,10);
+    TH2D *h3_NpNn_cc0pi = new TH2D("h3_NpNn_cc0pi","N_{p} vs N_{n} G17_02b, CC0#pi",10,0,10,10,0,10);
+    TH2D *h4_NpNn_cc0pi = new TH2D("h4_NpNn_cc0pi","N_{p} vs N_{n} G17_01a, CC0#pi",10,0,10,10,0,10);
+    TH2D *h5_NpNn_cc0pi = new TH2D("h5_NpNn_cc0pi","N_{p} vs N_{n} G17_01b, CC0#pi",10,0,10,10,0,10);
+
+    FlatBook( batch, gst1, "nfn:nfp>>h1_NpNn_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "nfn:nfp>>h2_NpNn_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "nfn:nfp>>h3_NpNn_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "nfn:nfp>>h4_NpNn_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "nfn:nfp>>h5_NpNn_cc0pi", kCC0Pi );
+
+    // NC0pi Np:Nn
+    TH2D *h1_NpNn_nc0pi = new TH2D("h1_NpNn_nc0pi","N_{p} vs N_{n} Default, NC0#pi",10,0,10,10,0,10);
+    TH2D *h2_NpNn_nc0pi = new TH2D("h2_NpNn_nc0pi","N_{p} vs N_{n} Default+MEC, NC0#pi",10,0,10,10,0,10);
+    TH2D *h3_NpNn_nc0pi = new TH2D("h3_NpNn_nc0pi","N_{p} vs N_{n} G17_02b, NC0#pi",10,0,10,10,0,10);
+    TH2D *h4_NpNn_nc0pi = new TH2D("h4_NpNn_nc0pi","N_{p} vs N_{n} G17_01a, NC0#pi",10,0,10,10,0,10);
+    TH2D *h5_NpNn_nc0pi = new TH2D("h5_NpNn_nc0pi","N_{p} vs N_{n} G17_01b, NC0#pi",10,0,10,10,0,10);
+
+    FlatBook( batch, gst1, "nfn:nfp>>h1_NpNn_nc0pi", kNC0Pi );
+    FlatBook( batch, gst2, "nfn:nfp>>h2_NpNn_nc0pi", kNC0Pi );
+    FlatBook( batch, gst3, "nfn:nfp>>h3_NpNn_nc0pi", kNC0Pi );
+    FlatBook( batch, gst4, "nfn:nfp>>h4_NpNn_nc0pi", kNC0Pi );
+    FlatBook( batch, gst5, "nfn:nfp>>h5_NpNn_nc0pi", kNC0Pi );
+
+    // -------------------------------------------------------------------------
+    //                     Set up the reads of the gst trees
+    // -------------------------------------------------------------------------
+    // Only the branches needed by the fills are read from the files
+    // With n_threads > 1 the branches are read and unzipped in parallel
+    vector< string > planned_fills;
+
+    // Those of the histograms booked above
+    FlatBatchExpressions( batch, planned_fills );
+
+    SetGstThreads( n_threads );
+
+    OpenGstReader( gst1, planned_fills );
+    OpenGstReader( gst2, planned_fills );
+    OpenGstReader( gst3, planned_fills );
+    OpenGstReader( gst4, planned_fills );
+    OpenGstReader( gst5, planned_fills );
    
     // -------------------------------------------------------------------------
     //                          Get the normalisations
@@ -197,6 +248,17 @@ int other_model_comparisons() {
     norms.push_back( Norm(1000000, f4_xsec, f_flux) );
     norms.push_back( Norm(1000000, f5_xsec, f_flux) );
     
+    // -------------------------------------------------------------------------
+    //                      Fill the histograms of each model
+    // -------------------------------------------------------------------------
+    // Each histogram is split by interaction channel in the same pass, and
+    // the channels are written to other_model_comparisons_channels.root
+    RunFlatBatch( batch );
+
+    TFile f_channels( "other_model_comparisons_channels.root", "RECREATE" );
+    WriteFlatBatchChannels( batch, &f_channels );
+    f_channels.Close();
+
     // -------------------------------------------------------------------------
     //                          Canvases and histograms
     // -------------------------------------------------------------------------
@@ -225,11 +287,11 @@ int other_model_comparisons() {
     TH1D *h4_NN_abs_cc0pi = new TH1D("h4_NN_abs_cc0pi","N_{N} , CC0#pi",80,0,25);
     TH1D *h5_NN_abs_cc0pi = new TH1D("h5_NN_abs_cc0pi","N_{N} , CC0#pi",80,0,25);
 
-    gst1->Draw("(nfp+nfn)>>h1_NN_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("(nfp+nfn)>>h2_NN_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("(nfp+nfn)>>h3_NN_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("(nfp+nfn)>>h4_NN_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("(nfp+nfn)>>h5_NN_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
+    FlatDraw( gst1, "(nfp+nfn)>>h1_NN_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst2, "(nfp+nfn)>>h2_NN_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst3, "(nfp+nfn)>>h3_NN_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst4, "(nfp+nfn)>>h4_NN_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst5, "(nfp+nfn)>>h5_NN_abs_cc0pi", kCC0Pi );
     
     // Push them onto the vector
     NN_abs_cc0pi_stack.push_back(h1_NN_abs_cc0pi);
@@ -260,11 +322,11 @@ int other_model_comparisons() {
     TH1D *h4_NN_abs_nc0pi = new TH1D("h4_NN_abs_nc0pi","N_{N} , NC0#pi",80,0,25);
     TH1D *h5_NN_abs_nc0pi = new TH1D("h5_NN_abs_nc0pi","N_{N} , NC0#pi",80,0,25);
 
-    gst1->Draw("(nfp+nfn)>>h1_NN_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("(nfp+nfn)>>h2_NN_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("(nfp+nfn)>>h3_NN_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("(nfp+nfn)>>h4_NN_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("(nfp+nfn)>>h5_NN_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
+    FlatDraw( gst1, "(nfp+nfn)>>h1_NN_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst2, "(nfp+nfn)>>h2_NN_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst3, "(nfp+nfn)>>h3_NN_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst4, "(nfp+nfn)>>h4_NN_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst5, "(nfp+nfn)>>h5_NN_abs_nc0pi", kNC0Pi );
     
     // Push them onto the vector
     NN_abs_nc0pi_stack.push_back(h1_NN_abs_nc0pi);
@@ -295,11 +357,11 @@ int other_model_comparisons() {
     TH1D *h4_Np_abs_cc0pi = new TH1D("h4_Np_abs_cc0pi","N_{p} , CC0#pi",80,0,15);
     TH1D *h5_Np_abs_cc0pi = new TH1D("h5_Np_abs_cc0pi","N_{p} , CC0#pi",80,0,15);
 
-    gst1->Draw("nfp>>h1_Np_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("nfp>>h2_Np_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("nfp>>h3_Np_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("nfp>>h4_Np_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("nfp>>h5_Np_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
+    FlatDraw( gst1, "nfp>>h1_Np_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst2, "nfp>>h2_Np_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst3, "nfp>>h3_Np_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst4, "nfp>>h4_Np_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst5, "nfp>>h5_Np_abs_cc0pi", kCC0Pi );
     
     // Push them onto the vector
     Np_abs_cc0pi_stack.push_back(h1_Np_abs_cc0pi);
@@ -330,11 +392,11 @@ int other_model_comparisons() {
     TH1D *h4_Np_abs_nc0pi = new TH1D("h4_Np_abs_nc0pi","N_{p} , NC0#pi",80,0,15);
     TH1D *h5_Np_abs_nc0pi = new TH1D("h5_Np_abs_nc0pi","N_{p} , NC0#pi",80,0,15);
 
-    gst1->Draw("nfp>>h1_Np_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("nfp>>h2_Np_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("nfp>>h3_Np_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("nfp>>h4_Np_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("nfp>>h5_Np_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
+    FlatDraw( gst1, "nfp>>h1_Np_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst2, "nfp>>h2_Np_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst3, "nfp>>h3_Np_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst4, "nfp>>h4_Np_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst5, "nfp>>h5_Np_abs_nc0pi", kNC0Pi );
     
     // Push them onto the vector
     Np_abs_nc0pi_stack.push_back(h1_Np_abs_nc0pi);
@@ -365,11 +427,11 @@ int other_model_comparisons() {
     TH1D *h4_Nn_abs_cc0pi = new TH1D("h4_Nn_abs_cc0pi","N_{n} , CC0#pi",80,0,15);
     TH1D *h5_Nn_abs_cc0pi = new TH1D("h5_Nn_abs_cc0pi","N_{n} , CC0#pi",80,0,15);
 
-    gst1->Draw("nfn>>h1_Nn_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("nfn>>h2_Nn_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("nfn>>h3_Nn_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("nfn>>h4_Nn_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("nfn>>h5_Nn_abs_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
+    FlatDraw( gst1, "nfn>>h1_Nn_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst2, "nfn>>h2_Nn_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst3, "nfn>>h3_Nn_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst4, "nfn>>h4_Nn_abs_cc0pi", kCC0Pi );
+    FlatDraw( gst5, "nfn>>h5_Nn_abs_cc0pi", kCC0Pi );
     
     // Push them onto the vector
     Nn_abs_cc0pi_stack.push_back(h1_Nn_abs_cc0pi);
@@ -400,11 +462,11 @@ int other_model_comparisons() {
     TH1D *h4_Nn_abs_nc0pi = new TH1D("h4_Nn_abs_nc0pi","N_{n} , NC0#pi",80,0,15);
     TH1D *h5_Nn_abs_nc0pi = new TH1D("h5_Nn_abs_nc0pi","N_{n} , NC0#pi",80,0,15);
 
-    gst1->Draw("nfn>>h1_Nn_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("nfn>>h2_Nn_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("nfn>>h3_Nn_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("nfn>>h4_Nn_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("nfn>>h5_Nn_abs_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
+    FlatDraw( gst1, "nfn>>h1_Nn_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst2, "nfn>>h2_Nn_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst3, "nfn>>h3_Nn_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst4, "nfn>>h4_Nn_abs_nc0pi", kNC0Pi );
+    FlatDraw( gst5, "nfn>>h5_Nn_abs_nc0pi", kNC0Pi );
     
     // Push them onto the vector
     Nn_abs_nc0pi_stack.push_back(h1_Nn_abs_nc0pi);
@@ -429,8 +491,7 @@ int other_model_comparisons() {
     // The Canvases and histograms for np vs nn
     // Default
     TCanvas *c1_NpNn_CC = new TCanvas("c1_NpNn_CC","Default",800,600);
-    TH2D *h1_NpNn_cc0pi = new TH2D("h1_NpNn_cc0pi","N_{p} vs N_{n} Default, CC0#pi",10,0,10,10,0,10);
-    gst1->Draw("nfn:nfp>>h1_NpNn_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h1_NpNn_cc0pi->Draw("colz");
     
     h1_NpNn_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h1_NpNn_cc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -441,8 +502,7 @@ int other_model_comparisons() {
 
     // Default+MEC
     TCanvas *c2_NpNn_CC = new TCanvas("c2_NpNn_CC","Default+MEC",800,600);
-    TH2D *h2_NpNn_cc0pi = new TH2D("h2_NpNn_cc0pi","N_{p} vs N_{n} Default+MEC, CC0#pi",10,0,10,10,0,10);
-    gst2->Draw("nfn:nfp>>h2_NpNn_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h2_NpNn_cc0pi->Draw("colz");
     
     h2_NpNn_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h2_NpNn_cc0pi->GetYaxis()->SetTitle("N_{n}");  
@@ -453,8 +513,7 @@ int other_model_comparisons() {
 
     // G16_02b
     TCanvas *c3_NpNn_CC = new TCanvas("c3_NpNn_CC","G17_02b",800,600);
-    TH2D *h3_NpNn_cc0pi = new TH2D("h3_NpNn_cc0pi","N_{p} vs N_{n} G17_02b, CC0#pi",10,0,10,10,0,10);
-    gst3->Draw("nfn:nfp>>h3_NpNn_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h3_NpNn_cc0pi->Draw("colz");
 
     h3_NpNn_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h3_NpNn_cc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -466,8 +525,7 @@ int other_model_comparisons() {
 
     // G16_01a
     TCanvas *c4_NpNn_CC = new TCanvas("c4_NpNn_CC","G17_01a",800,600);
-    TH2D *h4_NpNn_cc0pi = new TH2D("h4_NpNn_cc0pi","N_{p} vs N_{n} G17_01a, CC0#pi",10,0,10,10,0,10);
-    gst4->Draw("nfn:nfp>>h4_NpNn_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h4_NpNn_cc0pi->Draw("colz");
     
     h4_NpNn_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h4_NpNn_cc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -479,8 +537,7 @@ int other_model_comparisons() {
 
     // G17_01b
     TCanvas *c5_NpNn_CC = new TCanvas("c5_NpNn_CC","G17_01b",800,600);
-    TH2D *h5_NpNn_cc0pi = new TH2D("h5_NpNn_cc0pi","N_{p} vs N_{n} G17_01b, CC0#pi",10,0,10,10,0,10);
-    gst5->Draw("nfn:nfp>>h5_NpNn_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h5_NpNn_cc0pi->Draw("colz");
 
     h5_NpNn_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h5_NpNn_cc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -510,8 +567,7 @@ int other_model_comparisons() {
     // The Canvases and histograms for np vs nn
     // Default
     TCanvas *c1_NpNn_NC = new TCanvas("c1_NpNn_NC","Default",800,600);
-    TH2D *h1_NpNn_nc0pi = new TH2D("h1_NpNn_nc0pi","N_{p} vs N_{n} Default, NC0#pi",10,0,10,10,0,10);
-    gst1->Draw("nfn:nfp>>h1_NpNn_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h1_NpNn_nc0pi->Draw("colz");
     
     h1_NpNn_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h1_NpNn_nc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -521,8 +577,7 @@ int other_model_comparisons() {
 
     // Default+MEC
     TCanvas *c2_NpNn_NC = new TCanvas("c2_NpNn_NC","Default+MEC",800,600);
-    TH2D *h2_NpNn_nc0pi = new TH2D("h2_NpNn_nc0pi","N_{p} vs N_{n} Default+MEC, NC0#pi",10,0,10,10,0,10);
-    gst2->Draw("nfn:nfp>>h2_NpNn_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h2_NpNn_nc0pi->Draw("colz");
     
     h2_NpNn_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h2_NpNn_nc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -534,8 +589,7 @@ int other_model_comparisons() {
 
     // G16_02b
     TCanvas *c3_NpNn_NC = new TCanvas("c3_NpNn_NC","G16_02b",800,600);
-    TH2D *h3_NpNn_nc0pi = new TH2D("h3_NpNn_nc0pi","N_{p} vs N_{n} G17_02b, NC0#pi",10,0,10,10,0,10);
-    gst3->Draw("nfn:nfp>>h3_NpNn_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h3_NpNn_nc0pi->Draw("colz");
 
     h3_NpNn_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h3_NpNn_nc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -547,8 +601,7 @@ int other_model_comparisons() {
 
     // G16_01a
     TCanvas *c4_NpNn_NC = new TCanvas("c4_NpNn_NC","G17_01a",800,600);
-    TH2D *h4_NpNn_nc0pi = new TH2D("h4_NpNn_nc0pi","N_{p} vs N_{n} G17_01a, NC0#pi",10,0,10,10,0,10);
-    gst4->Draw("nfn:nfp>>h4_NpNn_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h4_NpNn_nc0pi->Draw("colz");
     
     h4_NpNn_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h4_NpNn_nc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -560,8 +613,7 @@ int other_model_comparisons() {
 
     // G17_01b
     TCanvas *c5_NpNn_NC = new TCanvas("c5_NpNn_NC","G17_01b",800,600);
-    TH2D *h5_NpNn_nc0pi = new TH2D("h5_NpNn_nc0pi","N_{p} vs N_{n} G17_01b, NC0#pi",10,0,10,10,0,10);
-    gst5->Draw("nfn:nfp>>h5_NpNn_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h5_NpNn_nc0pi->Draw("colz");
 
     h5_NpNn_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h5_NpNn_nc0pi->GetYaxis()->SetTitle("N_{n}");
@@ -583,6 +635,24 @@ int other_model_comparisons() {
     delete h4_NpNn_nc0pi;
     delete h5_NpNn_nc0pi;
 
+    // -------------------------------------------------------------------------
+    //                          I/O run summary
+    // -------------------------------------------------------------------------
+    ofstream file_io;
+    file_io.open( "other_model_comparisons_run_summary.txt" );
+
+    GstIOReport( gst1, "Default", file_io );
+    GstIOReport( gst2, "Default + MEC", file_io );
+    GstIOReport( gst3, "G17_02b", file_io );
+    GstIOReport( gst4, "G17_01a", file_io );
+    GstIOReport( gst5, "G17_01b", file_io );
+
+    CloseGstReader( gst1 );
+    CloseGstReader( gst2 );
+    CloseGstReader( gst3 );
+    CloseGstReader( gst4 );
+    CloseGstReader( gst5 );
+
     return 0;
 }
 
@@ -745,7 +815,8 @@ void RecoNuE( TTree *event_tree,
               vector< double > &reco_E_CC, 
               vector< double > &reco_E_NC,
               vector< double > &MC_reco_E_CC, 
-              vector< double > &MC_reco_E_NC ){
+              vector< double > &MC_reco_E_NC,
+              bool full_tree ){
 
     // Get the branches to calculate reconstructed energy and MC energy
     TBranch *b_mu_e  = event_tree->GetBranch("El");
@@ -768,7 +839,7 @@ void RecoNuE( TTree *event_tree,
     // Loop over the leaves and calculate the reconstructed energy
     for( int i = 0; i < n_values; ++i){
         
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
 
         double reco, reco_mc, e, p, cth;
         
@@ -856,7 +927,7 @@ void FSPNumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
         
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
      
         // Count #final state leptons
         if( b_fspl->GetLeaf("fspl")->GetValue() == 13 ){
@@ -988,7 +1059,7 @@ void FSINumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
     
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
     
         // Charged current
         // CC0Pi
@@ -24,7 +24,7 @@
 
 using namespace std; 
 
-int proton_model_comparisons() {
+int proton_model_comparisons( unsigned int n_threads = 0 ) {
 
     // -------------------------------------------------------------------------
     // Normalisation:
@@ -59,7 +59,7 @@ int proton_model_comparisons() {
     //                              Open flux file
     // -------------------------------------------------------------------------
     
-    TFile f_flux("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root");
+    TFile f_flux( InputPath("/hepstore/rjones/Software/Genie/comparisons/builds/SL6.x86_64/vtrunk/data/fluxes/miniboone/miniboone_april07_baseline_rgen610.6_flux_pospolarity_fluxes.root").c_str() );
     if (f_flux.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -73,7 +73,7 @@ int proton_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Default
-    TFile f1_xsec("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root");
+    TFile f1_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default/xsec_files/total_xsec.root").c_str() );
     if (f1_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -83,7 +83,7 @@ int proton_model_comparisons() {
     }
     
     // Default+MEC
-    TFile f2_xsec("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root");
+    TFile f2_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/xsec_files/total_xsec.root").c_str() );
     if (f2_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -93,7 +93,7 @@ int proton_model_comparisons() {
     }
     
     // G16_02b
-    TFile f3_xsec("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root");
+    TFile f3_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/xsec_files/total_xsec.root").c_str() );
     if (f3_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -103,7 +103,7 @@ int proton_model_comparisons() {
     }
     
     // G16_01a
-    TFile f4_xsec("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root");
+    TFile f4_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/xsec_files/total_xsec.root").c_str() );
     if (f4_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -113,7 +113,7 @@ int proton_model_comparisons() {
     }
     
     // G16_01b
-    TFile f5_xsec("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root");
+    TFile f5_xsec( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/xsec_files/total_xsec.root").c_str() );
     if (f5_xsec.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -127,7 +127,7 @@ int proton_model_comparisons() {
     // -------------------------------------------------------------------------
     
     // Open Default
-    TFile f1("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root");
+    TFile f1( InputPath("/hepstore/rjones/Exercises/Flavours/Default/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f1.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -137,7 +137,7 @@ int proton_model_comparisons() {
     }
 
     // Open Default+MEC
-    TFile f2("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root");
+    TFile f2( InputPath("/hepstore/rjones/Exercises/Flavours/Default+MEC/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f2.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -147,7 +147,7 @@ int proton_model_comparisons() {
     }
 
     // Open G16_02b
-    TFile f3("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root");
+    TFile f3( InputPath("/hepstore/rjones/Exercises/Flavours/G16_02b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f3.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -157,7 +157,7 @@ int proton_model_comparisons() {
     }
 
     // Open G16_01a
-    TFile f4("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root");
+    TFile f4( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01a/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f4.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -167,7 +167,7 @@ int proton_model_comparisons() {
     }
 
     // Open G16_01b
-    TFile f5("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root");
+    TFile f5( InputPath("/hepstore/rjones/Exercises/Flavours/G16_01b/sbnd/1M/gntp.10000.gst.root").c_str() );
     if (f5.IsZombie()) {
        cout << " Error opening file " << endl;
        exit(-1);
@@ -186,6 +186,90 @@ int proton_model_comparisons() {
     TTree *gst3 = (TTree*) f3.Get("gst");
     TTree *gst4 = (TTree*) f4.Get("gst");
     TTree *gst5 = (TTree*) f5.Get("gst");
+
+    // -------------------------------------------------------------------------
+    //                      Book the fills of the histograms
+    // -------------------------------------------------------------------------
+    // The histograms of the plots below are booked here, and all of the
+    // fills of a model are then run in one pass by RunFlatBatch
+    FlatBatch batch;
+
+    // Np vs KESum CC
+    TH2D *h1_NpKESum_cc0pi = new TH2D("h1_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} Default, CC0#pi",12,0,12,50,0,2.5);
+    TH2D *h2_NpKESum_cc0pi = new TH2D("h2_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} Default+MEC, CC0#pi",12,0,12,50,0,2.5);
+    TH2D *h3_NpKESum_cc0pi = new TH2D("h3_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} G17_02b, CC0#pi",12,0,12,50,0,2.5);
+    TH2D *h4_NpKESum_cc0pi = new TH2D("h4_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} G17_01a, CC0#pi",12,0,12,50,0,2.5);
+    TH2D *h5_NpKESum_cc0pi = new TH2D("h5_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} G17_01b, CC0#pi",12,0,12,50,0,2.5);
+
+    FlatBook( batch, gst1, "sumKEf:nfp>>h1_NpKESum_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "sumKEf:nfp>>h2_NpKESum_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "sumKEf:nfp>>h3_NpKESum_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "sumKEf:nfp>>h4_NpKESum_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "sumKEf:nfp>>h5_NpKESum_cc0pi", kCC0Pi );
+
+    // Np vs KESum NC
+    TH2D *h1_NpKESum_nc0pi = new TH2D("h1_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} Default, NC0#pi",12,0,12,50,0,2.5);
+    TH2D *h2_NpKESum_nc0pi = new TH2D("h2_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} Default+MEC, NC0#pi",12,0,12,50,0,2.5);
+    TH2D *h3_NpKESum_nc0pi = new TH2D("h3_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} G17_02b, NC0#pi",12,0,12,50,0,2.5);
+    TH2D *h4_NpKESum_nc0pi = new TH2D("h4_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} G17_01a, NC0#pi",12,0,12,50,0,2.5);
+    TH2D *h5_NpKESum_nc0pi = new TH2D("h5_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} G17_01b, NC0#pi",12,0,12,50,0,2.5);
+
+    FlatBook( batch, gst1, "sumKEf:nfp>>h1_NpKESum_nc0pi", kNC0Pi );
+    FlatBook( batch, gst2, "sumKEf:nfp>>h2_NpKESum_nc0pi", kNC0Pi );
+    FlatBook( batch, gst3, "sumKEf:nfp>>h3_NpKESum_nc0pi", kNC0Pi );
+    FlatBook( batch, gst4, "sumKEf:nfp>>h4_NpKESum_nc0pi", kNC0Pi );
+    FlatBook( batch, gst5, "sumKEf:nfp>>h5_NpKESum_nc0pi", kNC0Pi );
+
+    // CC0pi Avg KEp
+    TH1D *h1_avg_KE_p_cc0pi = new TH1D("h1_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
+    TH1D *h2_avg_KE_p_cc0pi = new TH1D("h2_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
+    TH1D *h3_avg_KE_p_cc0pi = new TH1D("h3_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
+    TH1D *h4_avg_KE_p_cc0pi = new TH1D("h4_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
+    TH1D *h5_avg_KE_p_cc0pi = new TH1D("h5_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
+
+    FlatBook( batch, gst1, "(sumKEf/nfp)>>h1_avg_KE_p_cc0pi", kCC0Pi );
+    FlatBook( batch, gst2, "(sumKEf/nfp)>>h2_avg_KE_p_cc0pi", kCC0Pi );
+    FlatBook( batch, gst3, "(sumKEf/nfp)>>h3_avg_KE_p_cc0pi", kCC0Pi );
+    FlatBook( batch, gst4, "(sumKEf/nfp)>>h4_avg_KE_p_cc0pi", kCC0Pi );
+    FlatBook( batch, gst5, "(sumKEf/nfp)>>h5_avg_KE_p_cc0pi", kCC0Pi );
+
+    // NC0pi Avg KEn
+    TH1D *h1_avg_KE_p_nc0pi = new TH1D("h1_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
+    TH1D *h2_avg_KE_p_nc0pi = new TH1D("h2_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
+    TH1D *h3_avg_KE_p_nc0pi = new TH1D("h3_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
+    TH1D *h4_avg_KE_p_nc0pi = new TH1D("h4_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
+    TH1D *h5_avg_KE_p_nc0pi = new TH1D("h5_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
+
+    FlatBook( batch, gst1, "(sumKEf/nfp)>>h1_avg_KE_p_nc0pi", kNC0Pi );
+    FlatBook( batch, gst2, "(sumKEf/nfp)>>h2_avg_KE_p_nc0pi", kNC0Pi );
+    FlatBook( batch, gst3, "(sumKEf/nfp)>>h3_avg_KE_p_nc0pi", kNC0Pi );
+    FlatBook( batch, gst4, "(sumKEf/nfp)>>h4_avg_KE_p_nc0pi", kNC0Pi );
+    FlatBook( batch, gst5, "(sumKEf/nfp)>>h5_avg_KE_p_nc0pi", kNC0Pi );
+
+    // -------------------------------------------------------------------------
+    //                     Set up the reads of the gst trees
+    // -------------------------------------------------------------------------
+    // Only the branches needed by the fills are read from the files
+    // With n_threads > 1 the branches are read and unzipped in parallel
+    vector< string > planned_fills;
+
+    // Those of the histograms booked above, then those of RecoNuE
+    FlatBatchExpressions( batch, planned_fills );
+    planned_fills.push_back( "El" );
+    planned_fills.push_back( "Ev" );
+    planned_fills.push_back( "pl" );
+    planned_fills.push_back( "cthl" );
+    planned_fills.push_back( "cc && (nfpip + nfpim + nfpi0 == 0)" );
+    planned_fills.push_back( "nc && (nfpip + nfpim + nfpi0 == 0)" );
+    planned_fills.push_back( kTopologyFill );
+
+    SetGstThreads( n_threads );
+
+    OpenGstReader( gst1, planned_fills );
+    OpenGstReader( gst2, planned_fills );
+    OpenGstReader( gst3, planned_fills );
+    OpenGstReader( gst4, planned_fills );
+    OpenGstReader( gst5, planned_fills );
    
     // Vector of doubles for the reconstructed energy
     vector< double > MC_reco_1_CC;
@@ -227,6 +311,17 @@ int proton_model_comparisons() {
     norms.push_back( Norm(1000000, f4_xsec, f_flux) );
     norms.push_back( Norm(1000000, f5_xsec, f_flux) );
     
+    // -------------------------------------------------------------------------
+    //                      Fill the histograms of each model
+    // -------------------------------------------------------------------------
+    // Each histogram is split by interaction channel in the same pass, and
+    // the channels are written to proton_model_comparisons_channels.root
+    RunFlatBatch( batch );
+
+    TFile f_channels( "proton_model_comparisons_channels.root", "RECREATE" );
+    WriteFlatBatchChannels( batch, &f_channels );
+    f_channels.Close();
+
     // -------------------------------------------------------------------------
     //                          Canvases and histograms
     // -------------------------------------------------------------------------
@@ -246,8 +341,7 @@ int proton_model_comparisons() {
     // The Canvases and histograms for np vs KESum
     // Default
     TCanvas *c1_NpKESum_CC = new TCanvas("c1_NpKESum_CC","Default",800,600);
-    TH2D *h1_NpKESum_cc0pi = new TH2D("h1_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} Default, CC0#pi",12,0,12,50,0,2.5);
-    gst1->Draw("sumKEf:nfp>>h1_NpKESum_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h1_NpKESum_cc0pi->Draw("colz");
     
     h1_NpKESum_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h1_NpKESum_cc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -258,8 +352,7 @@ int proton_model_comparisons() {
 
     // Default+MEC
     TCanvas *c2_NpKESum_CC = new TCanvas("c2_NpKESum_CC","Default+MEC",800,600);
-    TH2D *h2_NpKESum_cc0pi = new TH2D("h2_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} Default+MEC, CC0#pi",12,0,12,50,0,2.5);
-    gst2->Draw("sumKEf:nfp>>h2_NpKESum_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h2_NpKESum_cc0pi->Draw("colz");
     
     h2_NpKESum_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h2_NpKESum_cc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");  
@@ -270,8 +363,7 @@ int proton_model_comparisons() {
 
     // G16_02b
     TCanvas *c3_NpKESum_CC = new TCanvas("c3_NpKESum_CC","G17_02b",800,600);
-    TH2D *h3_NpKESum_cc0pi = new TH2D("h3_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} G17_02b, CC0#pi",12,0,12,50,0,2.5);
-    gst3->Draw("sumKEf:nfp>>h3_NpKESum_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h3_NpKESum_cc0pi->Draw("colz");
 
     h3_NpKESum_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h3_NpKESum_cc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -283,8 +375,7 @@ int proton_model_comparisons() {
 
     // G16_01a
     TCanvas *c4_NpKESum_CC = new TCanvas("c4_NpKESum_CC","G17_01a",800,600);
-    TH2D *h4_NpKESum_cc0pi = new TH2D("h4_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} G17_01a, CC0#pi",12,0,12,50,0,2.5);
-    gst4->Draw("sumKEf:nfp>>h4_NpKESum_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h4_NpKESum_cc0pi->Draw("colz");
     
     h4_NpKESum_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h4_NpKESum_cc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -296,8 +387,7 @@ int proton_model_comparisons() {
 
     // G17_01b
     TCanvas *c5_NpKESum_CC = new TCanvas("c5_NpKESum_CC","G17_01b",800,600);
-    TH2D *h5_NpKESum_cc0pi = new TH2D("h5_NpKESum_cc0pi","N_{p} vs #SigmaE_{K} G17_01b, CC0#pi",12,0,12,50,0,2.5);
-    gst5->Draw("sumKEf:nfp>>h5_NpKESum_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h5_NpKESum_cc0pi->Draw("colz");
 
     h5_NpKESum_cc0pi->GetXaxis()->SetTitle("N_{p}");
     h5_NpKESum_cc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -325,8 +415,7 @@ int proton_model_comparisons() {
     // The Canvases and histograms for np vs nn
     // Default
     TCanvas *c1_NpKESum_NC = new TCanvas("c1_NpKESum_NC","Default",800,600);
-    TH2D *h1_NpKESum_nc0pi = new TH2D("h1_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} Default, NC0#pi",12,0,12,50,0,2.5);
-    gst1->Draw("sumKEf:nfp>>h1_NpKESum_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h1_NpKESum_nc0pi->Draw("colz");
     
     h1_NpKESum_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h1_NpKESum_nc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -336,8 +425,7 @@ int proton_model_comparisons() {
 
     // Default+MEC
     TCanvas *c2_NpKESum_NC = new TCanvas("c2_NpKESum_NC","Default+MEC",800,600);
-    TH2D *h2_NpKESum_nc0pi = new TH2D("h2_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} Default+MEC, NC0#pi",12,0,12,50,0,2.5);
-    gst2->Draw("sumKEf:nfp>>h2_NpKESum_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h2_NpKESum_nc0pi->Draw("colz");
     
     h2_NpKESum_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h2_NpKESum_nc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -349,8 +437,7 @@ int proton_model_comparisons() {
 
     // G16_02b
     TCanvas *c3_NpKESum_NC = new TCanvas("c3_NpKESum_NC","G16_02b",800,600);
-    TH2D *h3_NpKESum_nc0pi = new TH2D("h3_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} G17_02b, NC0#pi",12,0,12,50,0,2.5);
-    gst3->Draw("sumKEf:nfp>>h3_NpKESum_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h3_NpKESum_nc0pi->Draw("colz");
 
     h3_NpKESum_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h3_NpKESum_nc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -362,8 +449,7 @@ int proton_model_comparisons() {
 
     // G16_01a
     TCanvas *c4_NpKESum_NC = new TCanvas("c4_NpKESum_NC","G17_01a",800,600);
-    TH2D *h4_NpKESum_nc0pi = new TH2D("h4_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} G17_01a, NC0#pi",12,0,12,50,0,2.5);
-    gst4->Draw("sumKEf:nfp>>h4_NpKESum_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h4_NpKESum_nc0pi->Draw("colz");
     
     h4_NpKESum_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h4_NpKESum_nc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -375,8 +461,7 @@ int proton_model_comparisons() {
 
     // G17_01b
     TCanvas *c5_NpKESum_NC = new TCanvas("c5_NpKESum_NC","G17_01b",800,600);
-    TH2D *h5_NpKESum_nc0pi = new TH2D("h5_NpKESum_nc0pi","N_{p} vs #SigmaE_{K} G17_01b, NC0#pi",12,0,12,50,0,2.5);
-    gst5->Draw("sumKEf:nfp>>h5_NpKESum_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ","colz");
+    h5_NpKESum_nc0pi->Draw("colz");
 
     h5_NpKESum_nc0pi->GetXaxis()->SetTitle("N_{p}");
     h5_NpKESum_nc0pi->GetYaxis()->SetTitle("#SigmaE_{K}");
@@ -405,19 +490,6 @@ int proton_model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > avg_KE_p_cc0pi_stack;
 
-    // The avg_KE_p histograms
-    TH1D *h1_avg_KE_p_cc0pi = new TH1D("h1_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
-    TH1D *h2_avg_KE_p_cc0pi = new TH1D("h2_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
-    TH1D *h3_avg_KE_p_cc0pi = new TH1D("h3_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
-    TH1D *h4_avg_KE_p_cc0pi = new TH1D("h4_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
-    TH1D *h5_avg_KE_p_cc0pi = new TH1D("h5_avg_KE_p_cc0pi","Avg KE_{p} , CC0#pi",50,0,2.5);
-
-    gst1->Draw("(sumKEf/nfp)>>h1_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("(sumKEf/nfp)>>h2_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("(sumKEf/nfp)>>h3_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("(sumKEf/nfp)>>h4_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("(sumKEf/nfp)>>h5_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    
     // Push them onto the vector
     avg_KE_p_cc0pi_stack.push_back(h1_avg_KE_p_cc0pi);
     avg_KE_p_cc0pi_stack.push_back(h2_avg_KE_p_cc0pi);
@@ -440,33 +512,80 @@ int proton_model_comparisons() {
     // Vector of histograms and strings to pass to the stacking function
     vector< TH1D* > avg_KE_p_nc0pi_stack;
 
-    // The avg_KE_p histograms
-    TH1D *h1_avg_KE_p_nc0pi = new TH1D("h1_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
-    TH1D *h2_avg_KE_p_nc0pi = new TH1D("h2_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
-    TH1D *h3_avg_KE_p_nc0pi = new TH1D("h3_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
-    TH1D *h4_avg_KE_p_nc0pi = new TH1D("h4_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
-    TH1D *h5_avg_KE_p_nc0pi = new TH1D("h5_avg_KE_p_nc0pi","Avg KE_{p} , NC0#pi",50,0,2.5);
-
-    gst1->Draw("(sumKEf/nfp)>>h1_avg_KE_p_nc0pi", "nc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst2->Draw("(sumKEf/nfp)>>h2_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst3->Draw("(sumKEf/nfp)>>h3_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst4->Draw("(sumKEf/nfp)>>h4_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    gst5->Draw("(sumKEf/nfp)>>h5_avg_KE_p_cc0pi", "cc && (nfpip + nfpim + nfpi0 == 0) ");
-    
     // Push them onto the vector
-    avg_KE_p_cc0pi_stack.push_back(h1_avg_KE_p_cc0pi);
-    avg_KE_p_cc0pi_stack.push_back(h2_avg_KE_p_cc0pi);
-    avg_KE_p_cc0pi_stack.push_back(h3_avg_KE_p_cc0pi);
-    avg_KE_p_cc0pi_stack.push_back(h4_avg_KE_p_cc0pi);
-    avg_KE_p_cc0pi_stack.push_back(h5_avg_KE_p_cc0pi);
+    avg_KE_p_nc0pi_stack.push_back(h1_avg_KE_p_nc0pi);
+    avg_KE_p_nc0pi_stack.push_back(h2_avg_KE_p_nc0pi);
+    avg_KE_p_nc0pi_stack.push_back(h3_avg_KE_p_nc0pi);
+    avg_KE_p_nc0pi_stack.push_back(h4_avg_KE_p_nc0pi);
+    avg_KE_p_nc0pi_stack.push_back(h5_avg_KE_p_nc0pi);
 
-    HistStacker(avg_KE_p_cc0pi_stack, leg_entries, norms, "Average proton KE, CC0#pi", "avg_KE_p_CC0Pi_Plot.png", "Avg KE_{p}", "Number of SBND events");
+    HistStacker(avg_KE_p_nc0pi_stack, leg_entries, norms, "Average proton KE, NC0#pi", "avg_KE_p_NC0Pi_Plot.png", "Avg KE_{p}", "Number of SBND events");
 
-    delete h1_avg_KE_p_cc0pi;
-    delete h2_avg_KE_p_cc0pi;
-    delete h3_avg_KE_p_cc0pi;
-    delete h4_avg_KE_p_cc0pi;
-    delete h5_avg_KE_p_cc0pi;
+    delete h1_avg_KE_p_nc0pi;
+    delete h2_avg_KE_p_nc0pi;
+    delete h3_avg_KE_p_nc0pi;
+    delete h4_avg_KE_p_nc0pi;
+    delete h5_avg_KE_p_nc0pi;
+
+    // -------------------------------------------------------------------------
+    //                      Proton KE threshold scans
+    // -------------------------------------------------------------------------
+    // 21 thresholds from 0 to 100 MeV in 5 MeV steps, CC0pi and NC0pi for
+    // each model in one pass. It is kept out of the batch since with an
+    // event store it reads only the topology, pdgf and KEf columns of the
+    // store, where in the batch it would read the particle arrays of the
+    // gst tree
+    TTree *threshold_trees[5] = { gst1, gst2, gst3, gst4, gst5 };
+
+    TFile f_threshold( "proton_threshold_scan.root", "RECREATE" );
+
+    vector< TH1D* > threshold_cc0pi_stack;
+
+    for( int i = 0; i < 5; ++i ){
+
+        vector< ThresholdScan > scans( 2 );
+        BookThresholdScan( scans[0], 21, 0.005, TopologyBit( kCC0Pi ), 12, 12, 50, 2.5 );
+        BookThresholdScan( scans[1], 21, 0.005, TopologyBit( kNC0Pi ), 12, 12, 50, 2.5 );
+
+        RunThresholdScans( threshold_trees[i], scans );
+
+        TH3D *cube_cc0pi = ThresholdCube( scans[0], Form( "h%d_threshold_cc0pi", i + 1 ), "N_{p} vs #Sigma KE_{p} vs threshold, CC0#pi" );
+        TH3D *cube_nc0pi = ThresholdCube( scans[1], Form( "h%d_threshold_nc0pi", i + 1 ), "N_{p} vs #Sigma KE_{p} vs threshold, NC0#pi" );
+        cube_cc0pi->Write();
+        cube_nc0pi->Write();
+
+        // Events with at least one proton above each threshold
+        TH1D *h_above_cc0pi = new TH1D( Form( "h%d_above_cc0pi", i + 1 ), "Events with a proton above threshold, CC0#pi", 21, -0.0025, 0.1025 );
+        h_above_cc0pi->SetDirectory( 0 );
+        ThresholdEventsAbove( scans[0], 1, h_above_cc0pi );
+        threshold_cc0pi_stack.push_back( h_above_cc0pi );
+    }
+
+    f_threshold.Close();
+
+    HistStacker(threshold_cc0pi_stack, leg_entries, norms, "Events with a proton above threshold, CC0#pi", "proton_threshold_CC0Pi_Plot.png", "KE_{p} threshold [GeV]", "Number of SBND events");
+
+    for( unsigned int i = 0; i < threshold_cc0pi_stack.size(); ++i ){
+        delete threshold_cc0pi_stack[i];
+    }
+
+    // -------------------------------------------------------------------------
+    //                          I/O run summary
+    // -------------------------------------------------------------------------
+    ofstream file_io;
+    file_io.open( "proton_model_comparisons_run_summary.txt" );
+
+    GstIOReport( gst1, "Default", file_io );
+    GstIOReport( gst2, "Default + MEC", file_io );
+    GstIOReport( gst3, "G17_02b", file_io );
+    GstIOReport( gst4, "G17_01a", file_io );
+    GstIOReport( gst5, "G17_01b", file_io );
+
+    CloseGstReader( gst1 );
+    CloseGstReader( gst2 );
+    CloseGstReader( gst3 );
+    CloseGstReader( gst4 );
+    CloseGstReader( gst5 );
 
     return 0;
 }
@@ -628,72 +747,91 @@ void RecoNuE( TTree *event_tree,
               vector< double > &reco_E_CC, 
               vector< double > &reco_E_NC,
               vector< double > &MC_reco_E_CC, 
-              vector< double > &MC_reco_E_NC ){
-
-    // Get the branches to calculate reconstructed energy and MC energy
-    TBranch *b_mu_e  = event_tree->GetBranch("El");
-    TBranch *b_nu_e  = event_tree->GetBranch("Ev");
-    TBranch *b_mu_p  = event_tree->GetBranch("pl");
-    TBranch *b_theta = event_tree->GetBranch("cthl");
-    TBranch *b_nfpi0 = event_tree->GetBranch("nfpi0");
-    TBranch *b_nfpip = event_tree->GetBranch("nfpip");
-    TBranch *b_nfpim = event_tree->GetBranch("nfpim");
-    TBranch *b_cc    = event_tree->GetBranch("cc");
-    TBranch *b_nc    = event_tree->GetBranch("nc");
-    TBranch *b_pdgf  = event_tree->GetBranch("pdgf");
+              vector< double > &MC_reco_E_NC,
+              bool full_tree ){
+
+    // The CC0pi and NC0pi skims hold every event used here, when written,
+    // unless the full tree is asked for
+    vector< int > reco_topologies;
+    reco_topologies.push_back( kCC0Pi );
+    reco_topologies.push_back( kNC0Pi );
+
+    s_branches reco_branches;
+    const char* reco_names[9] = { "El", "Ev", "pl", "cthl", "nfpi0", "nfpip", "nfpim", "cc", "nc" };
+    reco_branches.insert( reco_names, reco_names + 9 );
+
+    vector< TTree* > reco_trees( 1, event_tree );
+    if( !full_tree ) GstSkimTrees( event_tree, reco_topologies, reco_branches, reco_trees );
+
+    for( unsigned int t = 0; t < reco_trees.size(); ++t ){
+
+        TTree *reco_tree = reco_trees[t];
+
+        // Get the branches to calculate reconstructed energy and MC energy
+        TBranch *b_mu_e  = reco_tree->GetBranch("El");
+        TBranch *b_nu_e  = reco_tree->GetBranch("Ev");
+        TBranch *b_mu_p  = reco_tree->GetBranch("pl");
+        TBranch *b_theta = reco_tree->GetBranch("cthl");
+        TBranch *b_nfpi0 = reco_tree->GetBranch("nfpi0");
+        TBranch *b_nfpip = reco_tree->GetBranch("nfpip");
+        TBranch *b_nfpim = reco_tree->GetBranch("nfpim");
+        TBranch *b_cc    = reco_tree->GetBranch("cc");
+        TBranch *b_nc    = reco_tree->GetBranch("nc");
+        TBranch *b_pdgf  = reco_tree->GetBranch("pdgf");
     
-    // The variables from the branches and get the leaves
-    double m_n   = 0.93828;   // Nucleon mass, GeV
-    double m_mu  = 0.10566;   // Muon mass, GeV
+        // The variables from the branches and get the leaves
+        double m_n   = 0.93828;   // Nucleon mass, GeV
+        double m_mu  = 0.10566;   // Muon mass, GeV
 
-    int n_values = event_tree->GetEntries(); // Number of entries to loop over
+        int n_values = reco_tree->GetEntries(); // Number of entries to loop over
     
-    // Loop over the leaves and calculate the reconstructed energy
-    for( int i = 0; i < n_values; ++i){
+        // Loop over the leaves and calculate the reconstructed energy
+        for( int i = 0; i < n_values; ++i){
         
-        event_tree->GetEntry(i);
+            ReadGstEntry( reco_tree, i );
 
-        double reco, reco_mc, e, p, cth;
+            double reco, reco_mc, e, p, cth;
         
-        // For CC0pi
-        if( b_cc->GetLeaf("cc")->GetValue() != 0 
-            && b_nfpip->GetLeaf("nfpip")->GetValue()
-             + b_nfpim->GetLeaf("nfpim")->GetValue()
-             + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){ 
+            // For CC0pi
+            if( b_cc->GetLeaf("cc")->GetValue() != 0 
+                && b_nfpip->GetLeaf("nfpip")->GetValue()
+                 + b_nfpim->GetLeaf("nfpim")->GetValue()
+                 + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){ 
          
-                // Get the values needed
-                e   = b_mu_e->GetLeaf("El")->GetValue();
-                p   = b_mu_p->GetLeaf("pl")->GetValue();
-                cth = b_theta->GetLeaf("cthl")->GetValue(); 
+                    // Get the values needed
+                    e   = b_mu_e->GetLeaf("El")->GetValue();
+                    p   = b_mu_p->GetLeaf("pl")->GetValue();
+                    cth = b_theta->GetLeaf("cthl")->GetValue(); 
             
-                reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
+                    reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
         
-                reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
+                    reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
                 
-                // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
-                MC_reco_E_CC.push_back(reco_mc);
-                reco_E_CC.push_back(reco);
-
-        }
-        // For NC0pi
-        else if( b_nc->GetLeaf("nc")->GetValue() != 0 
-                 && b_nfpip->GetLeaf("nfpip")->GetValue()
-                  + b_nfpim->GetLeaf("nfpim")->GetValue()
-                  + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
+                    // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
+                    MC_reco_E_CC.push_back(reco_mc);
+                    reco_E_CC.push_back(reco);
+
+            }
+            // For NC0pi
+            else if( b_nc->GetLeaf("nc")->GetValue() != 0 
+                     && b_nfpip->GetLeaf("nfpip")->GetValue()
+                      + b_nfpim->GetLeaf("nfpim")->GetValue()
+                      + b_nfpi0->GetLeaf("nfpi0")->GetValue() == 0 ){
               
-                // Get the values
-                e   = b_mu_e->GetLeaf("El")->GetValue();
-                p   = b_mu_p->GetLeaf("pl")->GetValue();
-                cth = b_theta->GetLeaf("cthl")->GetValue(); 
+                    // Get the values
+                    e   = b_mu_e->GetLeaf("El")->GetValue();
+                    p   = b_mu_p->GetLeaf("pl")->GetValue();
+                    cth = b_theta->GetLeaf("cthl")->GetValue(); 
             
-                reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
+                    reco = ( 1 / ( 1 - ( ( 1 / m_n ) * ( e - p*cth ) ) ) ) * ( e - ( 1 / ( 2 * m_n) ) * m_mu * m_mu  ); 
         
-                reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
+                    reco_mc = TMath::Abs( reco - double(b_nu_e->GetLeaf("Ev")->GetValue()) );
 
-                // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
-                MC_reco_E_NC.push_back(reco_mc);
-                reco_E_NC.push_back(reco);
+                    // Make the vectors of reconstructed and reconstructed-MC energy for CC0pi
+                    MC_reco_E_NC.push_back(reco_mc);
+                    reco_E_NC.push_back(reco);
 
+            }
         }
     }
 }
@@ -737,7 +875,7 @@ void FSPNumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
         
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
      
         // Count #final state leptons
         if( b_fspl->GetLeaf("fspl")->GetValue() == 13 ){
@@ -869,7 +1007,7 @@ void FSINumbers( TTree *event_tree,
     for( int i = 0; i < n_values; ++i){
     
         // Get the current entry
-        event_tree->GetEntry(i);
+        ReadGstEntry( event_tree, i );
     
         // Charged current
         // CC0Pi
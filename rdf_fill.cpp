@@ -0,0 +1,332 @@
+/*
+ * RDataFrame backend for the fill engine
+ *
+ * See rdf_fill.h for the description of each function
+ *
+*/
+
+#include <map>
+#include <cstdlib>
+#include <stdexcept>
+#include "TInterpreter.h"
+#include "ROOT/RDataFrame.hxx"
+#include "rdf_fill.h"
+#include "gst_reader.h"
+#include "topologies.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// A column defined for an expression
+//      name     : the column of doubles, or of RVec< double > for the
+//                 particle arrays
+//      is_array : the expression uses the particle arrays
+// -------------------------------------------------------------------------
+struct RDFColumn {
+    string name;
+    bool   is_array;
+};
+
+// -------------------------------------------------------------------------
+// The division of jit_cuts.h, which gives 0 for a division by 0 as
+// TTreeFormula does, declared to the interpreter for the Define expressions
+// -------------------------------------------------------------------------
+static const char* rdf_divide_code =
+    "struct RDFDivide {};\n"
+    "struct RDFNumerator { double value; };\n"
+    "const RDFDivide rdf_divide = RDFDivide();\n"
+    "inline RDFNumerator operator/( double value, RDFDivide ){ RDFNumerator n = { value }; return n; }\n"
+    "inline double operator/( RDFNumerator n, double value ){ return value == 0 ? 0 : n.value / value; }\n";
+
+static bool rdf_divide_declared = false;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+// Define the columns of an expression once, on the node before any filter
+// so that every fill can share them
+// -------------------------------------------------------------------------
+static const RDFColumn &RDFExpression( ROOT::RDF::RNode &node,
+                                       map< string, RDFColumn > &columns,
+                                       const string &expression ){
+
+    map< string, RDFColumn >::iterator it = columns.find( expression );
+    if( it != columns.end() ) return it->second;
+
+    string code;
+    for( unsigned int i = 0; i < expression.size(); ++i ){
+        if( expression[i] == '/' ) code += " / rdf_divide / ";
+        else                       code += expression[i];
+    }
+
+    string   raw = "flat_raw_" + to_string( columns.size() );
+    RDFColumn column;
+    column.name     = "flat_column_" + to_string( columns.size() );
+    column.is_array = false;
+
+    try{
+        node = node.Define( raw, code );
+
+        column.is_array = node.GetColumnType( raw ).find( "RVec" ) != string::npos;
+
+        if( column.is_array ){
+            node = node.Define( column.name, "ROOT::VecOps::RVec< double >( " + raw + ".begin(), " + raw + ".end() )" );
+        }
+        else{
+            node = node.Define( column.name, "double( " + raw + " )" );
+        }
+    }
+    catch( const exception &error ){
+        cerr << " Could not compile the fill expression : " << expression << endl;
+        cerr << " " << error.what() << endl;
+        exit(1);
+    }
+
+    return columns.insert( make_pair( expression, column ) ).first->second;
+}
+
+// -------------------------------------------------------------------------
+// The shared Filter node of the events in each of the topologies of a mask
+// -------------------------------------------------------------------------
+static ROOT::RDF::RNode RDFTopologyNode( ROOT::RDF::RNode &node,
+                                        map< unsigned int, ROOT::RDF::RNode > &topology_nodes,
+                                        unsigned int topology_mask ){
+
+    if( !topology_mask ) return node;
+
+    map< unsigned int, ROOT::RDF::RNode >::iterator it = topology_nodes.find( topology_mask );
+    if( it != topology_nodes.end() ) return it->second;
+
+    ROOT::RDF::RNode filter = node.Filter( [topology_mask]( unsigned int topology ){
+                                               return ( topology & topology_mask ) == topology_mask;
+                                           },
+                                           { "gst_topology" },
+                                           "topology_" + to_string( topology_mask ) );
+
+    return topology_nodes.insert( make_pair( topology_mask, filter ) ).first->second;
+}
+
+// -------------------------------------------------------------------------
+// Add the contents of a histogram filled by RDataFrame to a flat histogram
+// -------------------------------------------------------------------------
+static void AddRDFHist( TH1 *h,
+                        const string &variable,
+                        FlatHist< double > &hist ){
+
+    if( h->GetNcells() != int( hist.cells.size() ) ){
+        cerr << " The RDataFrame histogram of " << variable << " does not match its flat histogram " << endl;
+        exit(1);
+    }
+
+    for( unsigned int j = 0; j < hist.cells.size(); ++j ){
+        hist.cells[j] += h->GetBinContent( j );
+    }
+    hist.entries += Long64_t( h->GetEntries() );
+}
+
+// -------------------------------------------------------------------------
+//                          RDataFrame fill
+// -------------------------------------------------------------------------
+Long64_t FillFlatRDF( TTree *event_tree,
+                      vector< FlatFill > &fills ){
+
+    if( !rdf_divide_declared ){
+        gInterpreter->Declare( rdf_divide_code );
+        rdf_divide_declared = true;
+    }
+
+    ROOT::RDataFrame frame( *event_tree );
+    ROOT::RDF::RNode root = frame;
+
+    bool classify = false;
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( fills[i].topology_mask ) classify = true;
+    }
+
+    if( classify ){
+        root = root.Define( "gst_topology",
+                            []( bool cc, bool nc, bool coh, int nfpip, int nfpim, int nfpi0 ){
+                                TopologyEvent event;
+                                event.cc    = cc;
+                                event.nc    = nc;
+                                event.coh   = coh;
+                                event.nfpip = nfpip;
+                                event.nfpim = nfpim;
+                                event.nfpi0 = nfpi0;
+                                return ClassifyTopology( event );
+                            },
+                            { "cc", "nc", "coh", "nfpip", "nfpim", "nfpi0" } );
+    }
+
+    // The channel of each event, for the fills split by channel
+    bool split = false;
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+        if( !fills[i].channels.empty() ) split = true;
+    }
+
+    if( split ){
+        root = root.Define( "gst_channel",
+                            []( bool qel, bool mec, bool res, bool dis, bool coh ){
+                                return ClassifyChannel( qel, mec, res, dis, coh );
+                            },
+                            { "qel", "mec", "res", "dis", "coh" } );
+    }
+
+    // The columns of every expression, x first then y, then the selection
+    map< string, RDFColumn >      columns;
+    vector< vector< RDFColumn > > fill_columns( fills.size() );
+    vector< bool >                fill_selected( fills.size(), false );
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        vector< string > dims;
+        GstFillDimensions( fills[i].variable, dims );
+
+        int n_dims = fills[i].hist.y.n_bins > 0 ? 2 : 1;
+        if( int( dims.size() ) != n_dims ){
+            cerr << " The fill " << fills[i].variable << " does not have " << n_dims << " dimension(s) " << endl;
+            exit(1);
+        }
+
+        for( int j = n_dims - 1; j >= 0; --j ){
+            fill_columns[i].push_back( RDFExpression( root, columns, dims[j] ) );
+        }
+
+        if( fills[i].selection.find_first_not_of(" ") != string::npos ){
+            fill_columns[i].push_back( RDFExpression( root, columns, fills[i].selection ) );
+            fill_selected[i] = true;
+        }
+    }
+
+    ROOT::RDF::RResultPtr< ULong64_t > n_entries = root.Count();
+
+    map< unsigned int, ROOT::RDF::RNode > topology_nodes;
+    map< string, ROOT::RDF::RNode >       selection_nodes;
+
+    vector< ROOT::RDF::RResultPtr< TH1D > > hists_1d( fills.size() );
+    vector< ROOT::RDF::RResultPtr< TH2D > > hists_2d( fills.size() );
+
+    // and those of each channel, for the fills split by channel
+    vector< vector< ROOT::RDF::RResultPtr< TH1D > > > channels_1d( fills.size() );
+    vector< vector< ROOT::RDF::RResultPtr< TH2D > > > channels_2d( fills.size() );
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        const vector< RDFColumn > &fc = fill_columns[i];
+        unsigned int n_dims = fills[i].hist.y.n_bins > 0 ? 2 : 1;
+
+        ROOT::RDF::RNode node = RDFTopologyNode( root, topology_nodes, fills[i].topology_mask );
+
+        bool is_array = false;
+        for( unsigned int j = 0; j < fc.size(); ++j ){
+            if( fc[j].is_array ) is_array = true;
+        }
+
+        vector< string > values;
+        string weight;
+
+        if( !is_array ){
+
+            for( unsigned int j = 0; j < n_dims; ++j ) values.push_back( fc[j].name );
+
+            // Events with a selection of 0 are not filled, as in TTree::Draw
+            if( fill_selected[i] ){
+
+                weight = fc[n_dims].name;
+
+                string key = to_string( fills[i].topology_mask ) + ":" + weight;
+                map< string, ROOT::RDF::RNode >::iterator it = selection_nodes.find( key );
+
+                if( it == selection_nodes.end() ){
+                    ROOT::RDF::RNode selected = node.Filter( []( double w ){ return w != 0; }, { weight } );
+                    it = selection_nodes.insert( make_pair( key, selected ) ).first;
+                }
+                node = it->second;
+            }
+        }
+        else{
+
+            // The single values are repeated for each of the nf particles,
+            // and only the particles with a selection other than 0 are kept
+            string fill = "flat_fill_" + to_string( i );
+
+            vector< string > particles;
+            for( unsigned int j = 0; j < fc.size(); ++j ){
+                particles.push_back( fc[j].is_array ? fc[j].name
+                                                    : "ROOT::VecOps::RVec< double >( size_t( nf ), " + fc[j].name + " )" );
+            }
+
+            string keep;
+            if( fill_selected[i] ){
+                node = node.Define( fill + "_keep", particles[n_dims] + " != 0" );
+                keep = "[" + fill + "_keep]";
+            }
+
+            const char* axes[2] = { "_x", "_y" };
+            for( unsigned int j = 0; j < n_dims; ++j ){
+                node = node.Define( fill + axes[j], particles[j] + keep );
+                values.push_back( fill + axes[j] );
+            }
+
+            if( fill_selected[i] ){
+                weight = fill + "_w";
+                node   = node.Define( weight, particles[n_dims] + keep );
+            }
+        }
+
+        const FlatHist< double > &hist = fills[i].hist;
+        string name = "flat_rdf_" + to_string( i );
+
+        if( n_dims == 1 ){
+            ROOT::RDF::TH1DModel model( name.c_str(), "", hist.x.n_bins, hist.x.min, hist.x.max );
+            hists_1d[i] = weight.empty() ? node.Histo1D( model, values[0] )
+                                         : node.Histo1D( model, values[0], weight );
+        }
+        else{
+            ROOT::RDF::TH2DModel model( name.c_str(), "", hist.x.n_bins, hist.x.min, hist.x.max,
+                                                          hist.y.n_bins, hist.y.min, hist.y.max );
+            hists_2d[i] = weight.empty() ? node.Histo2D( model, values[0], values[1] )
+                                         : node.Histo2D( model, values[0], values[1], weight );
+        }
+
+        for( int c = 0; c < int( fills[i].channels.size() ); ++c ){
+
+            ROOT::RDF::RNode channel = node.Filter( [c]( int event_channel ){ return event_channel == c; }, { "gst_channel" } );
+            string channel_name = name + "_" + ChannelName( c );
+
+            if( n_dims == 1 ){
+                ROOT::RDF::TH1DModel model( channel_name.c_str(), "", hist.x.n_bins, hist.x.min, hist.x.max );
+                channels_1d[i].push_back( weight.empty() ? channel.Histo1D( model, values[0] )
+                                                         : channel.Histo1D( model, values[0], weight ) );
+            }
+            else{
+                ROOT::RDF::TH2DModel model( channel_name.c_str(), "", hist.x.n_bins, hist.x.min, hist.x.max,
+                                                                      hist.y.n_bins, hist.y.min, hist.y.max );
+                channels_2d[i].push_back( weight.empty() ? channel.Histo2D( model, values[0], values[1] )
+                                                         : channel.Histo2D( model, values[0], values[1], weight ) );
+            }
+        }
+    }
+
+    // The first result runs the event loop for the whole graph
+    Long64_t n_read = *n_entries;
+
+    for( unsigned int i = 0; i < fills.size(); ++i ){
+
+        bool two_d = fills[i].hist.y.n_bins > 0;
+
+        AddRDFHist( two_d ? (TH1*) hists_2d[i].GetPtr() : (TH1*) hists_1d[i].GetPtr(), fills[i].variable, fills[i].hist );
+
+        for( unsigned int c = 0; c < fills[i].channels.size(); ++c ){
+            AddRDFHist( two_d ? (TH1*) channels_2d[i][c].GetPtr() : (TH1*) channels_1d[i][c].GetPtr(), fills[i].variable, fills[i].channels[c] );
+        }
+    }
+
+    return n_read;
+}
@@ -0,0 +1,44 @@
+/*
+ * RDataFrame backend for the fill engine
+ *
+ * The fills given to FillFlat are expressed as one lazy ROOT::RDataFrame
+ * graph over the gst tree:
+ *      - a Define of the compiled topology mask of each event, and one
+ *        shared Filter node for each topology the fills select
+ *      - a Define for each distinct variable or selection expression,
+ *        sumKEf/nfp for example, shared by every fill which uses it
+ *      - a Histo1D or Histo2D for each fill
+ * The graph is run once, on ROOT's implicit multithreading pool when it
+ * has been enabled by SetGstThreads, and the histograms are copied back
+ * into the FlatHists of the fills
+ *
+ * As with TTree::Draw, the particle arrays are filled once per particle
+ * which passes the selection, and a division by 0 gives 0. Divisions are
+ * only supported between single values, not the particle arrays
+ *
+ * FillFlat uses this backend when SetFlatRDF( true ) has been called, or
+ * when SBND_RDATAFRAME=1 is set in the environment
+ *
+*/
+
+#ifndef RDF_FILL_H
+#define RDF_FILL_H
+
+#include <vector>
+#include "TTree.h"
+#include "flat_hist.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// FillFlat through a single RDataFrame graph, returns the number of
+// entries read
+// The branches the fills use must be enabled, as they are when they have
+// been planned for OpenGstReader
+// -------------------------------------------------------------------------
+Long64_t FillFlatRDF( TTree *event_tree,
+                      vector< FlatFill > &fills );
+
+// -------------------------------------------------------------------------
+
+#endif
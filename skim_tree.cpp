@@ -0,0 +1,224 @@
+/*
+ * Per-topology skims of the gst files
+ *
+ * See skim_tree.h for the description of each function
+ *
+*/
+
+#include <map>
+#include <cstdlib>
+#include "TFile.h"
+#include "TSystem.h"
+#include "TNamed.h"
+#include "skim_tree.h"
+#include "topologies.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The skims opened so far, by file name, 0 for those which are not usable
+// -------------------------------------------------------------------------
+static map< string, TTree* > gst_skims;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          skim file location
+// -------------------------------------------------------------------------
+string GstSkimPath( const string &gst_path,
+                    int topology ){
+
+    if( topology < 0 || topology >= kNTopologies ){
+        cerr << " Unknown topology " << topology << endl;
+        exit(1);
+    }
+
+    string name;
+    for( const char* c = TopologyName( topology ); *c; ++c ){
+        if(      *c == '+' ) name += 'p';
+        else if( *c == '-' ) name += 'm';
+        else if( *c == '>' ) name += "gt";
+        else                 name += *c;
+    }
+
+    string path = gst_path;
+
+    if( path.size() > 5 && path.compare( path.size() - 5, 5, ".root" ) == 0 ){
+        path.erase( path.size() - 5 );
+    }
+    path += ".skim_" + name + ".root";
+
+    const char* skim_dir = getenv( "SBND_SKIM_DIR" );
+
+    if( !skim_dir ) return path;
+
+    for( unsigned int i = 0; i < path.size(); ++i ){
+        if( path[i] == '/' ) path[i] = '_';
+    }
+
+    return string( skim_dir ) + "/" + path;
+}
+
+// -------------------------------------------------------------------------
+//                          write the skims
+// -------------------------------------------------------------------------
+Long64_t WriteGstSkims( const string &gst_path,
+                        const vector< int > &topologies,
+                        const vector< string > &planned_fills ){
+
+    TFile gst_file( gst_path.c_str() );
+    TTree *event_tree = gst_file.IsZombie() ? 0 : (TTree*) gst_file.Get("gst");
+
+    if( !event_tree ){
+        cerr << " Could not read the gst tree in " << gst_path << endl;
+        exit(1);
+    }
+
+    vector< string > fills = planned_fills;
+    fills.push_back( kTopologyFill );
+
+    s_branches branches;
+    GstBranchesFor( event_tree, fills, branches );
+
+    event_tree->SetBranchStatus( "*", 0 );
+    for( s_branches::const_iterator it = branches.begin(); it != branches.end(); ++it ){
+        event_tree->SetBranchStatus( it->c_str(), 1 );
+    }
+
+    TopologyLeaves leaves;
+    GetTopologyLeaves( event_tree, leaves );
+
+    // The clones only have the enabled branches, and share their buffers
+    // with the gst tree
+    Long64_t gst_entry = 0;
+    string   source    = GstSourceStamp( event_tree );
+
+    vector< TFile* > skim_files( topologies.size() );
+    vector< TTree* > skims( topologies.size() );
+
+    for( unsigned int i = 0; i < topologies.size(); ++i ){
+
+        string skim_path = GstSkimPath( gst_path, topologies[i] );
+        skim_files[i] = new TFile( skim_path.c_str(), "RECREATE" );
+
+        if( skim_files[i]->IsZombie() ){
+            cerr << " Could not write " << skim_path << endl;
+            exit(1);
+        }
+
+        skims[i] = event_tree->CloneTree( 0 );
+        skims[i]->SetTitle( kGstSkimVersion );
+        skims[i]->Branch( "gst_entry", &gst_entry, "gst_entry/L" );
+    }
+
+    TopologyEvent event;
+    Long64_t n_entries = event_tree->GetEntries();
+
+    for( gst_entry = 0; gst_entry < n_entries; ++gst_entry ){
+
+        event_tree->GetEntry( gst_entry );
+
+        TopologyEventFrom( leaves, event );
+        unsigned int mask = ClassifyTopology( event );
+
+        for( unsigned int i = 0; i < topologies.size(); ++i ){
+            if( mask & TopologyBit( topologies[i] ) ) skims[i]->Fill();
+        }
+    }
+
+    for( unsigned int i = 0; i < topologies.size(); ++i ){
+        skim_files[i]->cd();
+        skims[i]->Write();
+
+        TNamed recorded( "gst_source", source.c_str() );
+        recorded.Write();
+        skim_files[i]->Close();
+        delete skim_files[i];
+    }
+
+    return n_entries;
+}
+
+// -------------------------------------------------------------------------
+//                          find a skim
+// -------------------------------------------------------------------------
+TTree *GstSkimFor( TTree *event_tree,
+                   int topology,
+                   const s_branches &branches ){
+
+    TFile *gst_file = event_tree->GetCurrentFile();
+    if( !gst_file ) return 0;
+
+    string gst_path  = gst_file->GetName();
+    string skim_path = GstSkimPath( gst_path, topology );
+
+    map< string, TTree* >::iterator it = gst_skims.find( skim_path );
+
+    if( it == gst_skims.end() ){
+
+        TTree *skim = 0;
+
+        FileStat_t skim_stat;
+        if( gSystem->GetPathInfo( skim_path.c_str(), skim_stat ) == 0 ){
+
+            TFile *skim_file = new TFile( skim_path.c_str() );
+            skim = skim_file->IsZombie() ? 0 : (TTree*) skim_file->Get("gst");
+
+            // A skim made from another version of the gst file, even one
+            // written since, records another stamp
+            TNamed *recorded = skim_file->IsZombie() ? 0 : (TNamed*) skim_file->Get( "gst_source" );
+
+            if( !skim || string( skim->GetTitle() ) != kGstSkimVersion ){
+                cout << " The skim " << skim_path << " is not a current skim and is not used " << endl;
+                skim = 0;
+            }
+            else if( !recorded || GstSourceStamp( event_tree ) != recorded->GetTitle() ){
+                cout << " The skim " << skim_path << " was not made from the current gst file and is not used " << endl;
+                skim = 0;
+            }
+
+            if( !skim ) delete skim_file;
+        }
+
+        it = gst_skims.insert( make_pair( skim_path, skim ) ).first;
+    }
+
+    TTree *skim = it->second;
+    if( !skim ) return 0;
+
+    for( s_branches::const_iterator b = branches.begin(); b != branches.end(); ++b ){
+        if( !skim->GetBranch( b->c_str() ) ) return 0;
+    }
+
+    return skim;
+}
+
+// -------------------------------------------------------------------------
+//                          trees for a set of topologies
+// -------------------------------------------------------------------------
+void GstSkimTrees( TTree *event_tree,
+                   const vector< int > &topologies,
+                   const s_branches &branches,
+                   vector< TTree* > &trees ){
+
+    trees.clear();
+
+    for( unsigned int i = 0; i < topologies.size(); ++i ){
+
+        TTree *skim = GstSkimFor( event_tree, topologies[i], branches );
+
+        if( !skim ){
+            trees.assign( 1, event_tree );
+            return;
+        }
+        trees.push_back( skim );
+    }
+
+    if( trees.empty() ) trees.push_back( event_tree );
+}
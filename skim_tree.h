@@ -0,0 +1,77 @@
+/*
+ * Per-topology skims of the gst files
+ *
+ * Most distributions only use the events of one topology, CC0pi for
+ * example, which are a small fraction of each gst file. A skim is a copy
+ * of those events with only the branches the distributions need, written
+ * once next to the gst file, so that the fills and RecoNuE read the skim
+ * and their I/O shrinks by the selection efficiency
+ *
+ * Each skim tree is called gst, like the tree it was made from, and has a
+ * gst_entry branch with the entry of each event in the gst tree. FillFlat
+ * reads a skim in place of the gst tree whenever every fill selects its
+ * topology and the skim has the branches they need
+ *
+ * To write the skims of the five models:
+ *      root -l -b -q load_modules.cpp make_gst_skims.cpp+
+ *
+*/
+
+#ifndef SKIM_TREE_H
+#define SKIM_TREE_H
+
+#include <vector>
+#include <string>
+#include "TTree.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The title the skims are written with, a skim with another title is out
+// of date and not used
+// -------------------------------------------------------------------------
+const char* const kGstSkimVersion = "gst skim v1";
+
+// -------------------------------------------------------------------------
+// The file the skim of a topology in topologies.h is written to:
+//      path.skim_CC1Pip.root next to the gst file, or below $SBND_SKIM_DIR
+//      if it is set, with the / of the gst path replaced by _
+// The + and - of the topology names are written p and m
+// -------------------------------------------------------------------------
+string GstSkimPath( const string &gst_path,
+                    int topology );
+
+// -------------------------------------------------------------------------
+// Write the skims of the given topologies for the gst tree in gst_path in a
+// single pass, with the branches needed by the planned fills and those
+// needed to classify the topologies, and the GstSourceStamp of the gst
+// file as the gst_source TNamed. Returns the number of entries read
+// -------------------------------------------------------------------------
+Long64_t WriteGstSkims( const string &gst_path,
+                        const vector< int > &topologies,
+                        const vector< string > &planned_fills );
+
+// -------------------------------------------------------------------------
+// The skim of a topology for a gst tree, or 0 if it has not been written,
+// was made from another version of the gst file, by the GstSourceStamp
+// recorded with it, or does not have all of the branches given.
+// The skims are opened once and kept for the rest of the process
+// -------------------------------------------------------------------------
+TTree *GstSkimFor( TTree *event_tree,
+                   int topology,
+                   const s_branches &branches );
+
+// -------------------------------------------------------------------------
+// The trees to read for the events of a set of topologies which do not
+// overlap, CC0pi and NC0pi for example: their skims if every one of them
+// is usable, otherwise the gst tree itself
+// -------------------------------------------------------------------------
+void GstSkimTrees( TTree *event_tree,
+                   const vector< int > &topologies,
+                   const s_branches &branches,
+                   vector< TTree* > &trees );
+
+// -------------------------------------------------------------------------
+
+#endif
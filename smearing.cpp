@@ -0,0 +1,226 @@
+/*
+ * A parametric detector smearing of the gst events
+ *
+ * See smearing.h for the description of each function
+ *
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include "TMath.h"
+#include "smearing.h"
+#include "counter_rng.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The smearing of the event loops, set by SetGstSmearing
+// -------------------------------------------------------------------------
+static SmearingConfig gst_smearing_config = SbndSmearing();
+
+// Off by default, or the SBND response if SBND_SMEARING=1 is set in the environment
+static bool gst_smearing = getenv( "SBND_SMEARING" ) && string( getenv( "SBND_SMEARING" ) ) == "1";
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          SBND response
+// -------------------------------------------------------------------------
+SmearingConfig SbndSmearing(){
+
+    SmearingConfig config;
+
+    //                                   threshold  momentum  energy  angle
+    config.species[kSmearMuon]        = { 0,      0.04,  0,     0.01 };
+    config.species[kSmearElectron]    = { 0.03,   0,     0.15,  0.02 };
+    config.species[kSmearProton]      = { 0.021,  0.05,  0,     0.02 };
+    config.species[kSmearNeutron]     = { 1e30,   0,     0,     0    };
+    config.species[kSmearChargedPion] = { 0.01,   0.10,  0,     0.03 };
+    config.species[kSmearNeutralPion] = { 0,      0,     0.15,  0.05 };
+    config.species[kSmearPhoton]      = { 0.03,   0,     0.15,  0.03 };
+    config.species[kSmearOther]       = { 0.03,   0.10,  0,     0.03 };
+
+    return config;
+}
+
+// -------------------------------------------------------------------------
+//                          species of a particle
+// -------------------------------------------------------------------------
+int SmearingSpeciesOf( int pdg ){
+
+    switch( abs( pdg ) ){
+        case 13   : return kSmearMuon;
+        case 11   : return kSmearElectron;
+        case 2212 : return kSmearProton;
+        case 2112 : return kSmearNeutron;
+        case 211  : return kSmearChargedPion;
+        case 111  : return kSmearNeutralPion;
+        case 22   : return kSmearPhoton;
+        default   : return kSmearOther;
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          smearing of the event loops
+// -------------------------------------------------------------------------
+void SetGstSmearing( const SmearingConfig *config ){
+
+    gst_smearing = config != 0;
+    if( config ) gst_smearing_config = *config;
+}
+
+const SmearingConfig *GstSmearing(){
+
+    return gst_smearing ? &gst_smearing_config : 0;
+}
+
+// -------------------------------------------------------------------------
+//                          branches of the smearing
+// -------------------------------------------------------------------------
+void SmearingBranches( s_branches &branches ){
+
+    const int n_branches = 26;
+    const char* names[n_branches] = { "nf", "fspl", "El", "pl", "cthl", "pxl", "pyl", "pzl",
+                                      "pdgf", "Ef", "pxf", "pyf", "pzf", "pf", "cthf",
+                                      "nfp", "nfn", "nfpip", "nfpim", "nfpi0", "nfkp", "nfkm", "nfk0",
+                                      "nfem", "nfother", "sumKEf" };
+
+    branches.insert( names, names + n_branches );
+}
+
+// -------------------------------------------------------------------------
+// Smear the four momentum of a particle with the response to its species,
+// g holding three Gaussians for it
+// -------------------------------------------------------------------------
+static inline void SmearMomentum( const SpeciesResponse &response,
+                                  const double *g,
+                                  double &E,
+                                  double &px,
+                                  double &py,
+                                  double &pz ){
+
+    double p  = sqrt( px * px + py * py + pz * pz );
+    double m2 = E * E - p * p;
+    if( m2 < 0 ) m2 = 0;
+
+    // Showers by their energy, tracks by their momentum
+    double p_smeared;
+    if( response.energy_resolution > 0 ){
+        double E_smeared = E > 0 ? E * ( 1 + response.energy_resolution / sqrt( E ) * g[0] ) : 0;
+        if( E_smeared * E_smeared < m2 ) E_smeared = sqrt( m2 );
+        p_smeared = sqrt( E_smeared * E_smeared - m2 );
+    }
+    else{
+        p_smeared = p * ( 1 + response.momentum_resolution * g[0] );
+        if( p_smeared < 0 ) p_smeared = 0;
+    }
+
+    double theta = p > 0 ? acos( pz / p ) : 0;
+    double phi   = atan2( py, px );
+
+    theta += response.angle_resolution * g[1];
+    phi   += response.angle_resolution * g[2];
+
+    // Back into [0, pi]
+    if( theta < 0 ){
+        theta = -theta;
+        phi  += TMath::Pi();
+    }
+    if( theta > TMath::Pi() ){
+        theta = 2 * TMath::Pi() - theta;
+        phi  += TMath::Pi();
+    }
+
+    px = p_smeared * sin( theta ) * cos( phi );
+    py = p_smeared * sin( theta ) * sin( phi );
+    pz = p_smeared * cos( theta );
+    E  = sqrt( p_smeared * p_smeared + m2 );
+}
+
+// -------------------------------------------------------------------------
+//                          smear an event
+// -------------------------------------------------------------------------
+void SmearGstEvent( const SmearingConfig &config,
+                    unsigned int model_key,
+                    Long64_t entry,
+                    GstEvent &event ){
+
+    int n_particles = event.nf;
+
+    // Three Gaussians each for the lepton and the particles, in one batch
+    double g[ 3 * ( kGstMaxParticles + 1 ) ];
+
+    CounterRng rng = MakeCounterRng( model_key, entry, kRngSmearing );
+    RngGaussians( rng, g, 3 * ( n_particles + 1 ) );
+
+    // The charged lepton is always kept, the neutrino of an NC event is
+    // never seen and left as it is
+    int lepton = abs( event.fspl );
+    if( lepton != 12 && lepton != 14 && lepton != 16 ){
+
+        SmearMomentum( config.species[ SmearingSpeciesOf( event.fspl ) ], g, event.El, event.pxl, event.pyl, event.pzl );
+
+        event.pl   = sqrt( event.pxl * event.pxl + event.pyl * event.pyl + event.pzl * event.pzl );
+        event.cthl = event.pl > 0 ? event.pzl / event.pl : 0;
+    }
+
+    // The particles above threshold, moved down over those which are not
+    int n_seen = 0;
+
+    event.nfp = event.nfn = event.nfpip = event.nfpim = event.nfpi0 = 0;
+    event.nfkp = event.nfkm = event.nfk0 = event.nfem = event.nfother = 0;
+    event.sumKEf = 0;
+
+    for( int k = 0; k < n_particles; ++k ){
+
+        const SpeciesResponse &response = config.species[ SmearingSpeciesOf( event.pdgf[k] ) ];
+
+        double E  = event.Ef[k];
+        double px = event.pxf[k];
+        double py = event.pyf[k];
+        double pz = event.pzf[k];
+        double p  = sqrt( px * px + py * py + pz * pz );
+        double m  = E * E > p * p ? sqrt( E * E - p * p ) : 0;
+
+        if( E - m < response.threshold ) continue;
+
+        SmearMomentum( response, &g[ 3 * ( k + 1 ) ], E, px, py, pz );
+
+        int pdg = event.pdgf[k];
+        p       = sqrt( px * px + py * py + pz * pz );
+
+        event.pdgf[n_seen] = pdg;
+        event.Ef[n_seen]   = E;
+        event.pxf[n_seen]  = px;
+        event.pyf[n_seen]  = py;
+        event.pzf[n_seen]  = pz;
+        event.pf[n_seen]   = p;
+        event.cthf[n_seen] = p > 0 ? pz / p : 0;
+        ++n_seen;
+
+        // The kinetic energy of every hadron which is seen, as in the gst
+        if( abs( pdg ) > 100 && abs( pdg ) < 1000000000 ) event.sumKEf += E - m;
+
+        switch( pdg ){
+            case 2212 : ++event.nfp;   break;
+            case 2112 : ++event.nfn;   break;
+            case 211  : ++event.nfpip; break;
+            case -211 : ++event.nfpim; break;
+            case 111  : ++event.nfpi0; break;
+            case 321  : ++event.nfkp;  break;
+            case -321 : ++event.nfkm;  break;
+            case 311  : case -311 : case 130 : case 310 : ++event.nfk0; break;
+            case 11   : case -11  : case 22  : ++event.nfem; break;
+            default   : ++event.nfother; break;
+        }
+    }
+
+    event.nf = n_seen;
+}
@@ -0,0 +1,105 @@
+/*
+ * A parametric detector smearing of the gst events
+ *
+ * The gst trees hold the true kinematics of GENIE. With a smearing set by
+ * SetGstSmearing, or SBND_SMEARING=1 in the environment, each event is
+ * given a simple detector response in the event loops of FillFlat and the
+ * event kinematics before anything is filled from it:
+ *      - particles below the kinetic energy threshold of their species are
+ *        not seen, and are removed from the final state arrays and counts,
+ *        and sumKEf is summed again over the hadrons which are left
+ *      - the momentum of tracks, or the energy of showers, and the angles
+ *        of the lepton and each particle left are smeared by Gaussians
+ * so every plot made through them is at reco level. The numbers of each
+ * event come from its kRngSmearing stream of counter_rng.h, the same
+ * however the events are read
+ *
+ * The generator level variables, Ev, Q2, W, x and y, are left as they are
+ *
+*/
+
+#ifndef SMEARING_H
+#define SMEARING_H
+
+#include "TTree.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The species with their own response
+// -------------------------------------------------------------------------
+enum SmearingSpecies {
+    kSmearMuon,
+    kSmearElectron,
+    kSmearProton,
+    kSmearNeutron,
+    kSmearChargedPion,
+    kSmearNeutralPion,
+    kSmearPhoton,
+    kSmearOther,
+    kNSmearSpecies
+};
+
+// -------------------------------------------------------------------------
+// The response to a species
+//      threshold           : the true kinetic energy below which it is not
+//                            seen (GeV)
+//      momentum_resolution : the fractional width of the momentum of a track
+//      energy_resolution   : a in sigma_E / E = a / sqrt( E / GeV ) for a
+//                            shower, 0 for a track
+//      angle_resolution    : the width of the polar and azimuthal angles (rad)
+// -------------------------------------------------------------------------
+struct SpeciesResponse {
+    double threshold;
+    double momentum_resolution;
+    double energy_resolution;
+    double angle_resolution;
+};
+
+// -------------------------------------------------------------------------
+// The response to each SmearingSpecies
+// -------------------------------------------------------------------------
+struct SmearingConfig {
+    SpeciesResponse species[kNSmearSpecies];
+};
+
+// -------------------------------------------------------------------------
+// A simple parametrisation of the SBND liquid argon TPC: tracks by range
+// and multiple scattering, showers calorimetrically, neutrons not seen,
+// protons above 21 MeV, about 2 cm of track, and charged pions above 10 MeV
+// -------------------------------------------------------------------------
+SmearingConfig SbndSmearing();
+
+// -------------------------------------------------------------------------
+// The species of a PDG code
+// -------------------------------------------------------------------------
+int SmearingSpeciesOf( int pdg );
+
+// -------------------------------------------------------------------------
+// Smear the events of the event loops with a response, or with 0 go back
+// to the true kinematics. The response is copied
+// -------------------------------------------------------------------------
+void SetGstSmearing( const SmearingConfig *config );
+
+// -------------------------------------------------------------------------
+// The response the events are smeared with, 0 if they are not
+// -------------------------------------------------------------------------
+const SmearingConfig *GstSmearing();
+
+// -------------------------------------------------------------------------
+// The gst branches the smearing reads and writes, to add to those read
+// -------------------------------------------------------------------------
+void SmearingBranches( s_branches &branches );
+
+// -------------------------------------------------------------------------
+// Smear an event, entry of the model with RngModelKey model_key, in place
+// -------------------------------------------------------------------------
+void SmearGstEvent( const SmearingConfig &config,
+                    unsigned int model_key,
+                    Long64_t entry,
+                    GstEvent &event );
+
+// -------------------------------------------------------------------------
+
+#endif
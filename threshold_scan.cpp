@@ -0,0 +1,316 @@
+/*
+ * Proton kinetic energy threshold scans
+ *
+ * See threshold_scan.h for the description of each function
+ *
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include "TLeaf.h"
+#include "threshold_scan.h"
+#include "gst_reader.h"
+#include "topologies.h"
+#include "topology_index.h"
+#include "event_store.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          book a scan
+// -------------------------------------------------------------------------
+void BookThresholdScan( ThresholdScan &scan,
+                        int n_thresholds,
+                        double step,
+                        unsigned int topology_mask,
+                        int n_protons_bins, double n_protons_max,
+                        int sum_KE_bins, double sum_KE_max ){
+
+    if( n_thresholds < 1 || !( step > 0 ) ){
+        cerr << " Invalid threshold grid : " << n_thresholds << " thresholds of " << step << " GeV " << endl;
+        exit(1);
+    }
+
+    scan.n_thresholds  = n_thresholds;
+    scan.step          = step;
+    scan.topology_mask = topology_mask;
+    scan.hists.resize( n_thresholds );
+
+    for( int j = 0; j < n_thresholds; ++j ){
+        BookFlatHist( scan.hists[j], n_protons_bins, 0, n_protons_max, sum_KE_bins, 0, sum_KE_max );
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          protons above each threshold
+// -------------------------------------------------------------------------
+void ProtonThresholds( const double *pdg,
+                       const double *KE,
+                       Long64_t n_particles,
+                       int n_thresholds,
+                       double step,
+                       double *counts,
+                       double *sums ){
+
+    for( int j = 0; j < n_thresholds; ++j ){
+        counts[j] = 0;
+        sums[j]   = 0;
+    }
+
+    // Each proton at the last threshold it passes
+    for( Long64_t k = 0; k < n_particles; ++k ){
+
+        if( pdg[k] != kProtonPdg ) continue;
+
+        double u = KE[k] / step;
+        if( !( u >= 0 ) ) continue;
+
+        int j = u < n_thresholds - 1 ? int( u ) : n_thresholds - 1;
+
+        counts[j] += 1;
+        sums[j]   += KE[k];
+    }
+
+    // and so at every threshold below that
+    for( int j = n_thresholds - 2; j >= 0; --j ){
+        counts[j] += counts[ j + 1 ];
+        sums[j]   += sums[ j + 1 ];
+    }
+}
+
+// -------------------------------------------------------------------------
+// Fill the scans which select an event from its particles
+// -------------------------------------------------------------------------
+static void FillThresholdScans( vector< ThresholdScan > &scans,
+                                unsigned int mask,
+                                const double *pdg,
+                                const double *KE,
+                                Long64_t n_particles,
+                                vector< double > &counts,
+                                vector< double > &sums ){
+
+    for( unsigned int s = 0; s < scans.size(); ++s ){
+
+        ThresholdScan &scan = scans[s];
+        if( ( mask & scan.topology_mask ) != scan.topology_mask ) continue;
+
+        counts.resize( scan.n_thresholds );
+        sums.resize( scan.n_thresholds );
+
+        ProtonThresholds( pdg, KE, n_particles, scan.n_thresholds, scan.step, &counts[0], &sums[0] );
+
+        for( int j = 0; j < scan.n_thresholds; ++j ){
+            FillFlatHist( scan.hists[j], counts[j], sums[j], 1. );
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// One pass over the particle columns of an event store
+// -------------------------------------------------------------------------
+static Long64_t ScanEventStore( EventStore &store,
+                                vector< ThresholdScan > &scans ){
+
+    int topology_column = EventStoreColumn( store, "topology" );
+    int pdg_column      = EventStoreColumn( store, "pdgf" );
+    int KE_column       = EventStoreColumn( store, "KEf" );
+
+    // The topologies are read for every block, the particles only for the
+    // blocks with an event of some scan
+    LoadEventColumns( store, vector< string >( 1, "topology" ) );
+
+    vector< double >   topology, pdg, KE, counts, sums;
+    vector< Long64_t > offsets;
+
+    for( Long64_t block = 0; block < store.n_blocks; ++block ){
+
+        ReadEventBlock( store, topology_column, block, topology );
+
+        bool selected = false;
+        for( unsigned int row = 0; row < topology.size() && !selected; ++row ){
+            for( unsigned int s = 0; s < scans.size() && !selected; ++s ){
+                unsigned int mask = (unsigned int) topology[row];
+                selected = ( mask & scans[s].topology_mask ) == scans[s].topology_mask;
+            }
+        }
+        if( !selected ) continue;
+
+        ReadParticleOffsets( store, block, offsets );
+        ReadEventBlock( store, pdg_column, block, pdg );
+        ReadEventBlock( store, KE_column, block, KE );
+
+        for( unsigned int row = 0; row < topology.size(); ++row ){
+            FillThresholdScans( scans, (unsigned int) topology[row],
+                                pdg.data() + offsets[row], KE.data() + offsets[row],
+                                offsets[ row + 1 ] - offsets[row], counts, sums );
+        }
+    }
+
+    return store.n_entries;
+}
+
+// -------------------------------------------------------------------------
+// One pass over the particle arrays of a gst tree
+// -------------------------------------------------------------------------
+static Long64_t ScanGstTree( TTree *event_tree,
+                             vector< ThresholdScan > &scans ){
+
+    TLeaf *count    = event_tree->GetLeaf( "nf" );
+    TLeaf *pdgf     = event_tree->GetLeaf( "pdgf" );
+    TLeaf *energy   = event_tree->GetLeaf( "Ef" );
+    TLeaf *momentum = event_tree->GetLeaf( "pf" );
+
+    if( !count || !pdgf || !energy || !momentum ){
+        cerr << " The gst tree does not have the particle arrays of the threshold scan " << endl;
+        exit(1);
+    }
+
+    // Scans which all select a topology only visit the entries in the
+    // index of any of them
+    bool                   classify = false;
+    vector< unsigned int > topology_masks;
+    for( unsigned int s = 0; s < scans.size(); ++s ){
+        if( scans[s].topology_mask ) classify = true;
+        topology_masks.push_back( scans[s].topology_mask );
+    }
+
+    TEntryList *entries = GstTopologyUnion( event_tree, topology_masks );
+
+    TopologyLeaves leaves;
+    TopologyEvent  event;
+    if( classify ) GetTopologyLeaves( event_tree, leaves );
+
+    vector< double > pdg( kGstMaxParticles ), KE( kGstMaxParticles ), counts, sums;
+
+    Long64_t n_entries = entries ? entries->GetN() : event_tree->GetEntries();
+
+    for( Long64_t i_entry = 0; i_entry < n_entries; ++i_entry ){
+
+        Long64_t entry = entries ? entries->GetEntry( i_entry ) : i_entry;
+
+        Long64_t local_entry = event_tree->LoadTree( entry );
+        if( local_entry < 0 ) break;
+
+        unsigned int mask = 0;
+        if( classify ){
+            ReadTopologyEvent( leaves, local_entry, event );
+            mask = ClassifyTopology( event );
+        }
+
+        // The count is read first, the arrays are read with its length
+        count->GetBranch()->GetEntry( local_entry, 1 );
+        pdgf->GetBranch()->GetEntry( local_entry, 1 );
+        energy->GetBranch()->GetEntry( local_entry, 1 );
+        momentum->GetBranch()->GetEntry( local_entry, 1 );
+
+        int n_particles = int( count->GetValue() );
+
+        // Rather than leave the protons past the arrays out of the scan
+        if( n_particles > kGstMaxParticles ){
+            cerr << " Entry " << entry << " has " << n_particles << " final state particles, more than "
+                 << kGstMaxParticles << endl;
+            exit(1);
+        }
+
+        for( int k = 0; k < n_particles; ++k ){
+            double E = energy->GetValue( k );
+            double p = momentum->GetValue( k );
+            pdg[k] = pdgf->GetValue( k );
+            KE[k]  = E - sqrt( max( E * E - p * p, 0. ) );
+        }
+
+        FillThresholdScans( scans, mask, &pdg[0], &KE[0], n_particles, counts, sums );
+    }
+    delete entries;
+
+    return n_entries;
+}
+
+// -------------------------------------------------------------------------
+//                          fill the scans
+// -------------------------------------------------------------------------
+Long64_t RunThresholdScans( TTree *event_tree,
+                            vector< ThresholdScan > &scans ){
+
+    EventStore *store = GstEventStore( event_tree );
+
+    if( store && EventStoreColumn( *store, "pdgf" ) >= 0 && EventStoreColumn( *store, "KEf" ) >= 0 ){
+        return ScanEventStore( *store, scans );
+    }
+
+    return ScanGstTree( event_tree, scans );
+}
+
+// -------------------------------------------------------------------------
+//                          events above each threshold
+// -------------------------------------------------------------------------
+void ThresholdEventsAbove( const ThresholdScan &scan,
+                           int min_protons,
+                           TH1 *h ){
+
+    if( h->GetNbinsX() != scan.n_thresholds ){
+        cerr << " " << h->GetName() << " does not have a bin for each of the " << scan.n_thresholds << " thresholds " << endl;
+        exit(1);
+    }
+
+    for( int j = 0; j < scan.n_thresholds; ++j ){
+
+        const FlatHist< double > &hist = scan.hists[j];
+
+        int    n_x    = hist.x.n_bins + 2;
+        int    n_y    = hist.y.n_bins + 2;
+        double events = 0;
+
+        for( int bin_y = 0; bin_y < n_y; ++bin_y ){
+            for( int bin_x = FlatBin( hist.x, min_protons ); bin_x < n_x; ++bin_x ){
+                events += hist.cells[ bin_x + n_x * bin_y ];
+            }
+        }
+
+        h->SetBinContent( j + 1, events );
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          the cube of a scan
+// -------------------------------------------------------------------------
+TH3D *ThresholdCube( const ThresholdScan &scan,
+                     const char* name,
+                     const char* title ){
+
+    const FlatHist< double > &first = scan.hists[0];
+
+    TH3D *cube = new TH3D( name, title,
+                           first.x.n_bins, first.x.min, first.x.max,
+                           first.y.n_bins, first.y.min, first.y.max,
+                           scan.n_thresholds, -0.5 * scan.step, ( scan.n_thresholds - 0.5 ) * scan.step );
+
+    int      n_x     = first.x.n_bins + 2;
+    int      n_y     = first.y.n_bins + 2;
+    Long64_t entries = 0;
+
+    for( int j = 0; j < scan.n_thresholds; ++j ){
+
+        const FlatHist< double > &hist = scan.hists[j];
+
+        for( int bin_y = 0; bin_y < n_y; ++bin_y ){
+            for( int bin_x = 0; bin_x < n_x; ++bin_x ){
+                double content = hist.cells[ bin_x + n_x * bin_y ];
+                if( content != 0 ) cube->SetBinContent( cube->GetBin( bin_x, bin_y, j + 1 ), content );
+            }
+        }
+        entries += hist.entries;
+    }
+
+    cube->SetEntries( double( entries ) );
+
+    return cube;
+}
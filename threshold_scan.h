@@ -0,0 +1,104 @@
+/*
+ * Proton kinetic energy threshold scans
+ *
+ * The proton distributions count every final state proton, but SBND only
+ * reconstructs those above some kinetic energy. Rather than a pass over
+ * the sample for each threshold, ProtonThresholds finds the number of
+ * protons and their summed kinetic energy above every threshold of a
+ * uniform grid at once: each proton is added at the last threshold it
+ * passes, and a running sum from the highest threshold down gives the
+ * totals at all of them
+ *
+ * A ThresholdScan holds, for each threshold of the grid, the histogram of
+ * summed kinetic energy against the number of protons of the events of a
+ * topology, the same distribution as the N_p vs sum E_K plots without a
+ * threshold. Together they are the (N_p, sum E_K, threshold) cube of a
+ * model, and RunThresholdScans fills any number of them in one pass
+ *
+*/
+
+#ifndef THRESHOLD_SCAN_H
+#define THRESHOLD_SCAN_H
+
+#include <vector>
+#include "TTree.h"
+#include "TH1.h"
+#include "TH3.h"
+#include "flat_hist.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The PDG code of the proton
+// -------------------------------------------------------------------------
+const int kProtonPdg = 2212;
+
+// -------------------------------------------------------------------------
+// A threshold scan
+//      n_thresholds  : the thresholds are 0, step, ..., ( n_thresholds - 1 ) * step
+//      step          : the spacing of the thresholds (GeV)
+//      topology_mask : the TopologyBits of topologies.h the events must
+//                      belong to, 0 for every event
+//      hists         : for each threshold, the summed kinetic energy of the
+//                      protons above it (y) against their number (x)
+// -------------------------------------------------------------------------
+struct ThresholdScan {
+    int                          n_thresholds;
+    double                       step;
+    unsigned int                 topology_mask;
+    vector< FlatHist< double > > hists;
+};
+
+// -------------------------------------------------------------------------
+// Book an empty scan, with the N_p and sum E_K binning of each threshold
+// -------------------------------------------------------------------------
+void BookThresholdScan( ThresholdScan &scan,
+                        int n_thresholds,
+                        double step,
+                        unsigned int topology_mask,
+                        int n_protons_bins, double n_protons_max,
+                        int sum_KE_bins, double sum_KE_max );
+
+// -------------------------------------------------------------------------
+// The number of protons of an event, counts, and their summed kinetic
+// energy, sums, above each of the thresholds of a grid, a proton passes a
+// threshold when its kinetic energy is at least the threshold
+//      pdg, KE     : the PDG code and kinetic energy (GeV) of each particle
+//      n_particles : the number of particles
+//      counts, sums: n_thresholds values each
+// -------------------------------------------------------------------------
+void ProtonThresholds( const double *pdg,
+                       const double *KE,
+                       Long64_t n_particles,
+                       int n_thresholds,
+                       double step,
+                       double *counts,
+                       double *sums );
+
+// -------------------------------------------------------------------------
+// Fill the scans in a single pass over a gst tree, from the pdgf and KEf
+// columns of its event store if it has been written, otherwise from the
+// particle arrays of the tree itself. Returns the number of events read
+// -------------------------------------------------------------------------
+Long64_t RunThresholdScans( TTree *event_tree,
+                            vector< ThresholdScan > &scans );
+
+// -------------------------------------------------------------------------
+// Fill a histogram of n_thresholds bins, one for each threshold, with the
+// number of events with at least min_protons protons above it
+// -------------------------------------------------------------------------
+void ThresholdEventsAbove( const ThresholdScan &scan,
+                           int min_protons,
+                           TH1 *h );
+
+// -------------------------------------------------------------------------
+// The cube of a scan as a new TH3D: N_p on x, sum E_K on y and the
+// thresholds on z, with a bin centred on each threshold
+// -------------------------------------------------------------------------
+TH3D *ThresholdCube( const ThresholdScan &scan,
+                     const char* name,
+                     const char* title );
+
+// -------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,318 @@
+/*
+ * The final state topologies of the model comparisons
+ *
+ * The CC and NC pion topologies counted by FSINumbers and used as the
+ * Draw selections are fixed by their current and pion multiplicities, so
+ * they are written here as compile-time predicates rather than cut strings
+ * which are parsed at run time
+ *
+ * All of the topologies are evaluated together by ClassifyTopology, which
+ * the compiler unrolls and fuses into a single step giving a bit for each
+ * topology the event belongs to. To add a topology, give it an index before
+ * kNTopologies, a name and cut in the tables below and its predicate in
+ * GstTopologies
+ *
+*/
+
+#ifndef TOPOLOGIES_H
+#define TOPOLOGIES_H
+
+#include <iostream>
+#include <cstdlib>
+#include "TTree.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The topologies, the first 24 in the order of the FSI tables
+// -------------------------------------------------------------------------
+enum GstTopology {
+    kCC0Pi,
+    kCC1PiP,
+    kCC1PiM,
+    kCC1Pi0,
+    kCC2PiP,
+    kCC2PiM,
+    kCC2Pi0,
+    kCCPiPPiM,
+    kCCPiPPi0,
+    kCCPiMPi0,
+    kCC3Pi,
+    kCCCoh,
+    kNC0Pi,
+    kNC1PiP,
+    kNC1PiM,
+    kNC1Pi0,
+    kNC2PiP,
+    kNC2PiM,
+    kNC2Pi0,
+    kNCPiPPiM,
+    kNCPiPPi0,
+    kNCPiMPi0,
+    kNC3Pi,
+    kNCCoh,
+    kCC1Pi,
+    kNC1Pi,
+    kNTopologies
+};
+
+static_assert( kNTopologies <= 32, "The topologies must fit in the bits of an unsigned int" );
+
+// The number of CC topologies, and of NC topologies, in the FSI tables
+const int kNFSITopologies = 12;
+
+// The branches the topologies are read from, as a planned fill for OpenGstReader
+const char* const kTopologyFill = "cc + nc + coh + nfpip + nfpim + nfpi0";
+
+// -------------------------------------------------------------------------
+// The fields the topologies are defined by, as in the gst tree
+// -------------------------------------------------------------------------
+struct TopologyEvent {
+    bool cc;
+    bool nc;
+    bool coh;
+    int  nfpip;
+    int  nfpim;
+    int  nfpi0;
+};
+
+// -------------------------------------------------------------------------
+// The predicates, over any event type with the gst field names
+//      PionTopology      : exactly n_pip, n_pim and n_pi0 pions
+//      NPionTopology     : exactly n_pions pions of any charge
+//      MultiPionTopology : at least n_min pions of any charge
+//      CohTopology       : coherent
+// -------------------------------------------------------------------------
+template< bool is_cc, int n_pip, int n_pim, int n_pi0 >
+struct PionTopology {
+    template< typename E >
+    static constexpr bool Pass( const E &e ){
+        return ( is_cc ? e.cc : e.nc ) && e.nfpip == n_pip && e.nfpim == n_pim && e.nfpi0 == n_pi0;
+    }
+};
+
+template< bool is_cc, int n_pions >
+struct NPionTopology {
+    template< typename E >
+    static constexpr bool Pass( const E &e ){
+        return ( is_cc ? e.cc : e.nc ) && e.nfpip + e.nfpim + e.nfpi0 == n_pions;
+    }
+};
+
+template< bool is_cc, int n_min >
+struct MultiPionTopology {
+    template< typename E >
+    static constexpr bool Pass( const E &e ){
+        return ( is_cc ? e.cc : e.nc ) && e.nfpip + e.nfpim + e.nfpi0 >= n_min;
+    }
+};
+
+template< bool is_cc >
+struct CohTopology {
+    template< typename E >
+    static constexpr bool Pass( const E &e ){
+        return ( is_cc ? e.cc : e.nc ) && e.coh;
+    }
+};
+
+// -------------------------------------------------------------------------
+// A topology: its index and predicate
+// -------------------------------------------------------------------------
+template< int index, typename Predicate >
+struct Topology {
+    static_assert( index >= 0 && index < kNTopologies, "Unknown topology index" );
+
+    template< typename E >
+    static constexpr unsigned int Bit( const E &e ){
+        return Predicate::Pass( e ) ? 1u << index : 0u;
+    }
+};
+
+// -------------------------------------------------------------------------
+// A list of topologies, evaluated together into a bit mask
+// -------------------------------------------------------------------------
+template< typename... Topologies >
+struct TopologyList;
+
+template<>
+struct TopologyList<> {
+    template< typename E >
+    static constexpr unsigned int Mask( const E & ){ return 0u; }
+};
+
+template< typename First, typename... Rest >
+struct TopologyList< First, Rest... > {
+    template< typename E >
+    static constexpr unsigned int Mask( const E &e ){
+        return First::Bit( e ) | TopologyList< Rest... >::Mask( e );
+    }
+};
+
+typedef TopologyList< Topology< kCC0Pi,     PionTopology< true, 0, 0, 0 > >,
+                      Topology< kCC1PiP,    PionTopology< true, 1, 0, 0 > >,
+                      Topology< kCC1PiM,    PionTopology< true, 0, 1, 0 > >,
+                      Topology< kCC1Pi0,    PionTopology< true, 0, 0, 1 > >,
+                      Topology< kCC2PiP,    PionTopology< true, 2, 0, 0 > >,
+                      Topology< kCC2PiM,    PionTopology< true, 0, 2, 0 > >,
+                      Topology< kCC2Pi0,    PionTopology< true, 0, 0, 2 > >,
+                      Topology< kCCPiPPiM,  PionTopology< true, 1, 1, 0 > >,
+                      Topology< kCCPiPPi0,  PionTopology< true, 1, 0, 1 > >,
+                      Topology< kCCPiMPi0,  PionTopology< true, 0, 1, 1 > >,
+                      Topology< kCC3Pi,     MultiPionTopology< true, 3 > >,
+                      Topology< kCCCoh,     CohTopology< true > >,
+                      Topology< kNC0Pi,     PionTopology< false, 0, 0, 0 > >,
+                      Topology< kNC1PiP,    PionTopology< false, 1, 0, 0 > >,
+                      Topology< kNC1PiM,    PionTopology< false, 0, 1, 0 > >,
+                      Topology< kNC1Pi0,    PionTopology< false, 0, 0, 1 > >,
+                      Topology< kNC2PiP,    PionTopology< false, 2, 0, 0 > >,
+                      Topology< kNC2PiM,    PionTopology< false, 0, 2, 0 > >,
+                      Topology< kNC2Pi0,    PionTopology< false, 0, 0, 2 > >,
+                      Topology< kNCPiPPiM,  PionTopology< false, 1, 1, 0 > >,
+                      Topology< kNCPiPPi0,  PionTopology< false, 1, 0, 1 > >,
+                      Topology< kNCPiMPi0,  PionTopology< false, 0, 1, 1 > >,
+                      Topology< kNC3Pi,     MultiPionTopology< false, 3 > >,
+                      Topology< kNCCoh,     CohTopology< false > >,
+                      Topology< kCC1Pi,     NPionTopology< true, 1 > >,
+                      Topology< kNC1Pi,     NPionTopology< false, 1 > > > GstTopologies;
+
+// -------------------------------------------------------------------------
+// The bit of a topology in the mask
+// -------------------------------------------------------------------------
+constexpr unsigned int TopologyBit( int topology ){
+    return 1u << topology;
+}
+
+// -------------------------------------------------------------------------
+// The mask of every topology the event belongs to
+// -------------------------------------------------------------------------
+template< typename E >
+inline unsigned int ClassifyTopology( const E &e ){
+    return GstTopologies::Mask( e );
+}
+
+// -------------------------------------------------------------------------
+// The names of the topologies, as written in n_interactions.txt
+// -------------------------------------------------------------------------
+inline const char* TopologyName( int topology ){
+
+    static const char* names[kNTopologies] = {
+        "CC0Pi",    "CC1Pi+",   "CC1Pi-",   "CC1Pi0",   "CC2Pi+",   "CC2Pi-",
+        "CC2Pi0",   "CCPi+Pi-", "CCPi+Pi0", "CCPi-Pi0", "CC>3Pi",   "CCCOH",
+        "NC0Pi",    "NC1Pi+",   "NC1Pi-",   "NC1Pi0",   "NC2Pi+",   "NC2Pi-",
+        "NC2Pi0",   "NCPi+Pi-", "NCPi+Pi0", "NCPi-Pi0", "NC>3Pi",   "NCCOH",
+        "CC1Pi",    "NC1Pi"
+    };
+
+    return names[topology];
+}
+
+// -------------------------------------------------------------------------
+// The same topologies as TTree::Draw selections
+// -------------------------------------------------------------------------
+inline const char* TopologyCut( int topology ){
+
+    static const char* cuts[kNTopologies] = {
+        "cc && nfpip == 0 && nfpim == 0 && nfpi0 == 0",
+        "cc && nfpip == 1 && nfpim == 0 && nfpi0 == 0",
+        "cc && nfpip == 0 && nfpim == 1 && nfpi0 == 0",
+        "cc && nfpip == 0 && nfpim == 0 && nfpi0 == 1",
+        "cc && nfpip == 2 && nfpim == 0 && nfpi0 == 0",
+        "cc && nfpip == 0 && nfpim == 2 && nfpi0 == 0",
+        "cc && nfpip == 0 && nfpim == 0 && nfpi0 == 2",
+        "cc && nfpip == 1 && nfpim == 1 && nfpi0 == 0",
+        "cc && nfpip == 1 && nfpim == 0 && nfpi0 == 1",
+        "cc && nfpip == 0 && nfpim == 1 && nfpi0 == 1",
+        "cc && nfpip + nfpim + nfpi0 >= 3",
+        "cc && coh",
+        "nc && nfpip == 0 && nfpim == 0 && nfpi0 == 0",
+        "nc && nfpip == 1 && nfpim == 0 && nfpi0 == 0",
+        "nc && nfpip == 0 && nfpim == 1 && nfpi0 == 0",
+        "nc && nfpip == 0 && nfpim == 0 && nfpi0 == 1",
+        "nc && nfpip == 2 && nfpim == 0 && nfpi0 == 0",
+        "nc && nfpip == 0 && nfpim == 2 && nfpi0 == 0",
+        "nc && nfpip == 0 && nfpim == 0 && nfpi0 == 2",
+        "nc && nfpip == 1 && nfpim == 1 && nfpi0 == 0",
+        "nc && nfpip == 1 && nfpim == 0 && nfpi0 == 1",
+        "nc && nfpip == 0 && nfpim == 1 && nfpi0 == 1",
+        "nc && nfpip + nfpim + nfpi0 >= 3",
+        "nc && coh",
+        "cc && nfpip + nfpim + nfpi0 == 1",
+        "nc && nfpip + nfpim + nfpi0 == 1"
+    };
+
+    return cuts[topology];
+}
+
+// -------------------------------------------------------------------------
+// The leaves of a gst tree the topologies are read from
+// -------------------------------------------------------------------------
+struct TopologyLeaves {
+    TLeaf *cc;
+    TLeaf *nc;
+    TLeaf *coh;
+    TLeaf *nfpip;
+    TLeaf *nfpim;
+    TLeaf *nfpi0;
+};
+
+inline TLeaf *TopologyLeaf( TTree *event_tree,
+                            const char* name ){
+
+    TLeaf *leaf = event_tree->GetLeaf( name );
+
+    if( !leaf ){
+        cerr << " The gst tree has no " << name << " leaf " << endl;
+        exit(1);
+    }
+
+    return leaf;
+}
+
+inline void GetTopologyLeaves( TTree *event_tree,
+                               TopologyLeaves &leaves ){
+
+    leaves.cc    = TopologyLeaf( event_tree, "cc" );
+    leaves.nc    = TopologyLeaf( event_tree, "nc" );
+    leaves.coh   = TopologyLeaf( event_tree, "coh" );
+    leaves.nfpip = TopologyLeaf( event_tree, "nfpip" );
+    leaves.nfpim = TopologyLeaf( event_tree, "nfpim" );
+    leaves.nfpi0 = TopologyLeaf( event_tree, "nfpi0" );
+}
+
+// -------------------------------------------------------------------------
+// Fill the topology fields from leaves which have already been read
+// -------------------------------------------------------------------------
+inline void TopologyEventFrom( const TopologyLeaves &leaves,
+                               TopologyEvent &event ){
+
+    event.cc    = leaves.cc->GetValue()  != 0;
+    event.nc    = leaves.nc->GetValue()  != 0;
+    event.coh   = leaves.coh->GetValue() != 0;
+    event.nfpip = int( leaves.nfpip->GetValue() );
+    event.nfpim = int( leaves.nfpim->GetValue() );
+    event.nfpi0 = int( leaves.nfpi0->GetValue() );
+}
+
+// -------------------------------------------------------------------------
+// Read the topology branches of an entry, even if they are disabled, and
+// fill the topology fields
+// -------------------------------------------------------------------------
+inline void ReadTopologyEvent( const TopologyLeaves &leaves,
+                               Long64_t entry,
+                               TopologyEvent &event ){
+
+    leaves.cc->GetBranch()->GetEntry( entry, 1 );
+    leaves.nc->GetBranch()->GetEntry( entry, 1 );
+    leaves.coh->GetBranch()->GetEntry( entry, 1 );
+    leaves.nfpip->GetBranch()->GetEntry( entry, 1 );
+    leaves.nfpim->GetBranch()->GetEntry( entry, 1 );
+    leaves.nfpi0->GetBranch()->GetEntry( entry, 1 );
+
+    TopologyEventFrom( leaves, event );
+}
+
+// -------------------------------------------------------------------------
+
+#endif
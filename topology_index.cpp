@@ -0,0 +1,221 @@
+/*
+ * Persistent topology index of the gst files
+ *
+ * See topology_index.h for the description of each function
+ *
+*/
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include "TFile.h"
+#include "TNamed.h"
+#include "TSystem.h"
+#include "TDirectory.h"
+#include "topology_index.h"
+#include "topologies.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The index of each gst file read so far, by the path of the index, with
+// one list for each topology, or none if it could not be made
+// -------------------------------------------------------------------------
+static map< string, vector< TEntryList* > > gst_indices;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          index file location
+// -------------------------------------------------------------------------
+string GstIndexPath( const string &gst_path ){
+
+    string path = gst_path;
+
+    if( path.size() > 5 && path.compare( path.size() - 5, 5, ".root" ) == 0 ){
+        path.erase( path.size() - 5 );
+    }
+    path += ".topology_index.root";
+
+    const char* index_dir = getenv( "SBND_INDEX_DIR" );
+
+    if( !index_dir ) return path;
+
+    for( unsigned int i = 0; i < path.size(); ++i ){
+        if( path[i] == '/' ) path[i] = '_';
+    }
+
+    return string( index_dir ) + "/" + path;
+}
+
+// -------------------------------------------------------------------------
+// Read the index if it is up to date, filling lists, or return false
+// -------------------------------------------------------------------------
+static bool ReadGstIndex( const string &index_path,
+                          const string &source,
+                          vector< TEntryList* > &lists ){
+
+    if( gSystem->AccessPathName( index_path.c_str() ) ) return false;
+
+    TDirectory *current = gDirectory;
+    TFile index_file( index_path.c_str() );
+
+    TNamed *recorded = index_file.IsZombie() ? 0 : (TNamed*) index_file.Get( "gst_source" );
+    bool    current_index = recorded && source == recorded->GetTitle();
+
+    for( int i = 0; current_index && i < kNTopologies; ++i ){
+
+        TEntryList *list = (TEntryList*) index_file.Get( ( "topology_" + to_string( i ) ).c_str() );
+
+        if( !list ){
+            current_index = false;
+            break;
+        }
+
+        // Keep the list once the file is closed
+        list->SetDirectory( 0 );
+        lists.push_back( list );
+    }
+
+    if( current ) current->cd();
+
+    if( !current_index ){
+        for( unsigned int i = 0; i < lists.size(); ++i ) delete lists[i];
+        lists.clear();
+        cout << " The topology index " << index_path << " is out of date and is rebuilt " << endl;
+    }
+
+    return current_index;
+}
+
+// -------------------------------------------------------------------------
+// Build the index in one pass over the topology branches and write it
+// -------------------------------------------------------------------------
+static void BuildGstIndex( TTree *event_tree,
+                           const string &index_path,
+                           const string &source,
+                           vector< TEntryList* > &lists ){
+
+    cout << " Building the topology index " << index_path << endl;
+
+    for( int i = 0; i < kNTopologies; ++i ){
+        TEntryList *list = new TEntryList( ( "topology_" + to_string( i ) ).c_str(), TopologyName( i ) );
+        list->SetTree( event_tree );
+        list->SetDirectory( 0 );
+        lists.push_back( list );
+    }
+
+    TopologyLeaves leaves;
+    TopologyEvent  event;
+    GetTopologyLeaves( event_tree, leaves );
+
+    Long64_t n_entries = event_tree->GetEntries();
+
+    for( Long64_t entry = 0; entry < n_entries; ++entry ){
+
+        Long64_t local_entry = event_tree->LoadTree( entry );
+        if( local_entry < 0 ) break;
+
+        ReadTopologyEvent( leaves, local_entry, event );
+        unsigned int mask = ClassifyTopology( event );
+
+        for( int i = 0; mask && i < kNTopologies; ++i ){
+            if( mask & TopologyBit( i ) ) lists[i]->Enter( entry );
+        }
+    }
+
+    // The index is still used in memory if it cannot be written
+    TDirectory *current = gDirectory;
+    TFile index_file( index_path.c_str(), "RECREATE" );
+
+    if( index_file.IsZombie() ){
+        cout << " Could not write the topology index " << index_path << endl;
+    }
+    else{
+        TNamed recorded( "gst_source", source.c_str() );
+        recorded.Write();
+
+        for( int i = 0; i < kNTopologies; ++i ){
+            lists[i]->OptimizeStorage();
+            lists[i]->Write();
+        }
+        index_file.Close();
+    }
+
+    if( current ) current->cd();
+}
+
+// -------------------------------------------------------------------------
+//                          entries of a topology
+// -------------------------------------------------------------------------
+TEntryList *GstTopologyEntries( TTree *event_tree,
+                                unsigned int topology_mask ){
+
+    if( !topology_mask ) return 0;
+
+    TFile *gst_file = event_tree->GetCurrentFile();
+    if( !gst_file ) return 0;
+
+    string index_path = GstIndexPath( gst_file->GetName() );
+
+    map< string, vector< TEntryList* > >::iterator it = gst_indices.find( index_path );
+
+    if( it == gst_indices.end() ){
+
+        string source = GstSourceStamp( event_tree );
+
+        vector< TEntryList* > lists;
+        if( !ReadGstIndex( index_path, source, lists ) ){
+            BuildGstIndex( event_tree, index_path, source, lists );
+        }
+
+        it = gst_indices.insert( make_pair( index_path, lists ) ).first;
+    }
+
+    const vector< TEntryList* > &lists = it->second;
+    if( lists.empty() ) return 0;
+
+    TEntryList *rarest = 0;
+    for( int i = 0; i < kNTopologies; ++i ){
+        if( !( topology_mask & TopologyBit( i ) ) ) continue;
+        if( !rarest || lists[i]->GetN() < rarest->GetN() ) rarest = lists[i];
+    }
+
+    return rarest;
+}
+
+// -------------------------------------------------------------------------
+//                          entries of several fills
+// -------------------------------------------------------------------------
+TEntryList *GstTopologyUnion( TTree *event_tree,
+                              const vector< unsigned int > &topology_masks ){
+
+    if( topology_masks.empty() ) return 0;
+
+    vector< TEntryList* > lists;
+    for( unsigned int i = 0; i < topology_masks.size(); ++i ){
+
+        TEntryList *list = GstTopologyEntries( event_tree, topology_masks[i] );
+        if( !list ) return 0;
+
+        bool seen = false;
+        for( unsigned int j = 0; j < lists.size(); ++j ){
+            if( lists[j] == list ) seen = true;
+        }
+        if( !seen ) lists.push_back( list );
+    }
+
+    TEntryList *entries = new TEntryList( *lists[0] );
+    entries->SetDirectory( 0 );
+
+    for( unsigned int i = 1; i < lists.size(); ++i ) entries->Add( lists[i] );
+
+    return entries;
+}
@@ -0,0 +1,60 @@
+/*
+ * Persistent topology index of the gst files
+ *
+ * A lighter alternative to the skims of skim_tree.h: for each gst file a
+ * small sidecar file holds, for each topology in topologies.h, a TEntryList
+ * of the entries in it. TEntryList keeps the entry numbers sorted, in
+ * blocks which are stored as bitmaps or as lists whichever is smaller
+ *
+ * The index is built the first time it is asked for, in one pass over the
+ * topology branches, and written next to the gst file. It records the
+ * GstSourceStamp of the gst file, its number of entries, size,
+ * modification time and UUID, and is rebuilt automatically if any of
+ * them change
+ *
+ * FillFlat visits only the entries of the index when every fill selects a
+ * topology and there is no skim for it. The fills of a batch may select
+ * different topologies, it then visits the union of their lists
+ *
+*/
+
+#ifndef TOPOLOGY_INDEX_H
+#define TOPOLOGY_INDEX_H
+
+#include <string>
+#include <vector>
+#include "TTree.h"
+#include "TEntryList.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The file the index of a gst file is written to:
+//      path.topology_index.root next to the gst file, or below
+//      $SBND_INDEX_DIR if it is set, with the / of the path replaced by _
+// -------------------------------------------------------------------------
+string GstIndexPath( const string &gst_path );
+
+// -------------------------------------------------------------------------
+// The entries of a gst tree in every topology of a mask of TopologyBits.
+// For a mask of several topologies this is the list of the rarest of them,
+// so the entries must still be classified. 0 if the mask is empty or the
+// tree does not come from a file
+// The index is read, or built and written, once per file in each process
+// and the lists belong to it
+// -------------------------------------------------------------------------
+TEntryList *GstTopologyEntries( TTree *event_tree,
+                                unsigned int topology_mask );
+
+// -------------------------------------------------------------------------
+// The entries of a gst tree which may pass any of several fills, one mask
+// of TopologyBits for each: the union of the lists of GstTopologyEntries.
+// 0 if a mask is empty, as that fill needs every entry, or there is no
+// index. The list belongs to the caller
+// -------------------------------------------------------------------------
+TEntryList *GstTopologyUnion( TTree *event_tree,
+                              const vector< unsigned int > &topology_masks );
+
+// -------------------------------------------------------------------------
+
+#endif
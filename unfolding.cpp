@@ -0,0 +1,211 @@
+/*
+ * Sparse response matrices and iterative Bayesian unfolding
+ *
+ * See unfolding.h for the description of each function
+ *
+*/
+
+#include <cstdlib>
+#include "ROOT/TThreadExecutor.hxx"
+#include "unfolding.h"
+#include "gst_reader.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                          build a response
+// -------------------------------------------------------------------------
+void BuildResponseMatrix( const SparseMigration &migration,
+                          ResponseMatrix &response ){
+
+    int n_true = migration.true_axis.n_bins;
+    int n_reco = migration.reco_axis.n_bins;
+    int n_x    = n_true + 2;
+
+    response.n_true = n_true;
+    response.n_reco = n_reco;
+    response.truth.assign( n_true, 0 );
+    response.measured.assign( n_reco, 0 );
+    response.efficiency.assign( n_true, 0 );
+
+    // Every event of a true bin, wherever it was reconstructed
+    for( map< Long64_t, double >::const_iterator it = migration.cells.begin(); it != migration.cells.end(); ++it ){
+        int bin_true = int( it->first % n_x );
+        if( bin_true >= 1 && bin_true <= n_true ) response.truth[ bin_true - 1 ] += it->second;
+    }
+
+    // The cells are ordered by reco bin then true bin, the order of the rows
+    response.row_offsets.assign( n_reco + 1, 0 );
+    response.columns.clear();
+    response.values.clear();
+
+    for( map< Long64_t, double >::const_iterator it = migration.cells.begin(); it != migration.cells.end(); ++it ){
+
+        int bin_true = int( it->first % n_x );
+        int bin_reco = int( it->first / n_x );
+
+        if( bin_true < 1 || bin_true > n_true || bin_reco < 1 || bin_reco > n_reco ) continue;
+        if( response.truth[ bin_true - 1 ] <= 0 ) continue;
+
+        double p = it->second / response.truth[ bin_true - 1 ];
+
+        response.columns.push_back( bin_true - 1 );
+        response.values.push_back( p );
+        response.efficiency[ bin_true - 1 ] += p;
+        response.measured[ bin_reco - 1 ]   += it->second;
+        ++response.row_offsets[ bin_reco ];
+    }
+
+    for( int r = 0; r < n_reco; ++r ){
+        response.row_offsets[ r + 1 ] += response.row_offsets[r];
+    }
+
+    // The transpose, by counting the values of each true bin
+    Long64_t n_values = response.values.size();
+
+    response.t_offsets.assign( n_true + 1, 0 );
+    response.t_columns.resize( n_values );
+    response.t_values.resize( n_values );
+
+    for( Long64_t k = 0; k < n_values; ++k ){
+        ++response.t_offsets[ response.columns[k] + 1 ];
+    }
+    for( int t = 0; t < n_true; ++t ){
+        response.t_offsets[ t + 1 ] += response.t_offsets[t];
+    }
+
+    vector< Long64_t > next( response.t_offsets.begin(), response.t_offsets.end() - 1 );
+
+    for( int r = 0; r < n_reco; ++r ){
+        for( Long64_t k = response.row_offsets[r]; k < response.row_offsets[ r + 1 ]; ++k ){
+            Long64_t j = next[ response.columns[k] ]++;
+            response.t_columns[j] = r;
+            response.t_values[j]  = response.values[k];
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          fold a true distribution
+// -------------------------------------------------------------------------
+void FoldResponse( const ResponseMatrix &response,
+                   const vector< double > &true_values,
+                   vector< double > &reco_values ){
+
+    reco_values.assign( response.n_reco, 0 );
+
+    for( int r = 0; r < response.n_reco; ++r ){
+
+        double sum = 0;
+        for( Long64_t k = response.row_offsets[r]; k < response.row_offsets[ r + 1 ]; ++k ){
+            sum += response.values[k] * true_values[ response.columns[k] ];
+        }
+        reco_values[r] = sum;
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          D'Agostini unfolding
+// -------------------------------------------------------------------------
+void UnfoldDAgostini( const ResponseMatrix &response,
+                      const vector< double > &data,
+                      int n_iterations,
+                      vector< double > &unfolded ){
+
+    if( int( data.size() ) != response.n_reco ){
+        cerr << " The data has " << data.size() << " bins, the response " << response.n_reco << " reco bins " << endl;
+        exit(1);
+    }
+
+    unfolded = response.truth;
+
+    vector< double > folded, ratio( response.n_reco );
+
+    for( int iteration = 0; iteration < n_iterations; ++iteration ){
+
+        FoldResponse( response, unfolded, folded );
+
+        for( int r = 0; r < response.n_reco; ++r ){
+            ratio[r] = folded[r] > 0 ? data[r] / folded[r] : 0;
+        }
+
+        // u_t = p_t / eff_t * sum_r R_rt d_r / folded_r, by the rows of the transpose
+        for( int t = 0; t < response.n_true; ++t ){
+
+            double sum = 0;
+            for( Long64_t k = response.t_offsets[t]; k < response.t_offsets[ t + 1 ]; ++k ){
+                sum += response.t_values[k] * ratio[ response.t_columns[k] ];
+            }
+            unfolded[t] = response.efficiency[t] > 0 ? unfolded[t] * sum / response.efficiency[t] : 0;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+// Unfold one pair of the bias test
+// -------------------------------------------------------------------------
+static void UnfoldBiasPair( const vector< ResponseMatrix > &responses,
+                            int n_iterations,
+                            UnfoldBias &result ){
+
+    const ResponseMatrix &data     = responses[ result.data_model ];
+    const ResponseMatrix &response = responses[ result.response_model ];
+
+    UnfoldDAgostini( response, data.measured, n_iterations, result.unfolded );
+
+    result.chi2 = 0;
+    for( int t = 0; t < data.n_true; ++t ){
+        if( data.truth[t] <= 0 ) continue;
+        double d = result.unfolded[t] - data.truth[t];
+        result.chi2 += d * d / data.truth[t];
+    }
+}
+
+// -------------------------------------------------------------------------
+//                          cross model bias test
+// -------------------------------------------------------------------------
+void UnfoldBiasTest( const vector< ResponseMatrix > &responses,
+                     int n_iterations,
+                     vector< UnfoldBias > &results ){
+
+    int n_models = responses.size();
+
+    for( int i = 1; i < n_models; ++i ){
+        if( responses[i].n_true != responses[0].n_true || responses[i].n_reco != responses[0].n_reco ){
+            cerr << " The responses of the bias test have different binning " << endl;
+            exit(1);
+        }
+    }
+
+    results.resize( n_models * n_models );
+
+    vector< int > pairs( n_models * n_models );
+    for( int p = 0; p < n_models * n_models; ++p ){
+        pairs[p]                  = p;
+        results[p].data_model     = p / n_models;
+        results[p].response_model = p % n_models;
+    }
+
+    // Each pair writes only its own result
+    unsigned int n_threads = GstThreads();
+
+    if( n_threads < 2 ){
+        for( int p = 0; p < n_models * n_models; ++p ){
+            UnfoldBiasPair( responses, n_iterations, results[p] );
+        }
+    }
+    else{
+        ROOT::TThreadExecutor pool( n_threads );
+        pool.Foreach( [&]( int p ){
+                          UnfoldBiasPair( responses, n_iterations, results[p] );
+                      }, pairs );
+    }
+}
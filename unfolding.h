@@ -0,0 +1,108 @@
+/*
+ * Sparse response matrices and iterative Bayesian unfolding
+ *
+ * A response matrix holds the probability of an event of each true bin
+ * being reconstructed in each reco bin. Built from the migration matrices
+ * of energy_migration.h, it only has the cells which were filled, in
+ * compressed sparse row (CSR) form: the values of each reco bin one after
+ * the other with the true bin of each. The transpose is held the same way,
+ * so both the folding and the back projection of the D'Agostini iteration
+ * are a loop over contiguous rows
+ *
+ * UnfoldBiasTest unfolds the reco distribution of each model with the
+ * response of every other model, the pairs spread over a pool of threads,
+ * and compares the result to the truth of the model the data came from
+ *
+*/
+
+#ifndef UNFOLDING_H
+#define UNFOLDING_H
+
+#include <vector>
+#include "TTree.h"
+#include "energy_migration.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// A response matrix over the true and reco bins of a migration matrix,
+// without the under and overflow
+//      n_true, n_reco : the number of bins
+//      row_offsets    : the values of reco bin r are entries row_offsets[r]
+//                       to row_offsets[r + 1] - 1 of columns and values
+//      columns        : the true bin of each value, from 0
+//      values         : P( reco bin | true bin )
+//      t_offsets,     : the same for the transpose, by true bin, with the
+//      t_columns,       reco bin of each value
+//      t_values
+//      efficiency     : the probability of an event of each true bin being
+//                       reconstructed in any reco bin
+//      truth          : the events of each true bin
+//      measured       : the events of those in each reco bin
+// -------------------------------------------------------------------------
+struct ResponseMatrix {
+    int                n_true;
+    int                n_reco;
+    vector< Long64_t > row_offsets;
+    vector< int >      columns;
+    vector< double >   values;
+    vector< Long64_t > t_offsets;
+    vector< int >      t_columns;
+    vector< double >   t_values;
+    vector< double >   efficiency;
+    vector< double >   truth;
+    vector< double >   measured;
+};
+
+// -------------------------------------------------------------------------
+// Build the response of a migration matrix. Events with a true energy in
+// the under or overflow are left out, those reconstructed there count
+// against the efficiency
+// -------------------------------------------------------------------------
+void BuildResponseMatrix( const SparseMigration &migration,
+                          ResponseMatrix &response );
+
+// -------------------------------------------------------------------------
+// Fold a true distribution with the response: the expected events of each
+// reco bin
+// -------------------------------------------------------------------------
+void FoldResponse( const ResponseMatrix &response,
+                   const vector< double > &true_values,
+                   vector< double > &reco_values );
+
+// -------------------------------------------------------------------------
+// Unfold a reco distribution with n_iterations of D'Agostini's iterative
+// Bayesian method, starting from the truth of the response as the prior
+// -------------------------------------------------------------------------
+void UnfoldDAgostini( const ResponseMatrix &response,
+                      const vector< double > &data,
+                      int n_iterations,
+                      vector< double > &unfolded );
+
+// -------------------------------------------------------------------------
+// The unfolding of the data of one model with the response of another
+//      data_model, response_model : the indices of the models
+//      unfolded                   : the unfolded distribution
+//      chi2                       : sum over the true bins of
+//                                   ( unfolded - truth )^2 / truth, with
+//                                   the truth of the data model
+// -------------------------------------------------------------------------
+struct UnfoldBias {
+    int              data_model;
+    int              response_model;
+    vector< double > unfolded;
+    double           chi2;
+};
+
+// -------------------------------------------------------------------------
+// Unfold the measured distribution of each response with each response,
+// the n^2 pairs spread over the thread budget of SetGstThreads. The
+// results are in the order data_model * n + response_model
+// -------------------------------------------------------------------------
+void UnfoldBiasTest( const vector< ResponseMatrix > &responses,
+                     int n_iterations,
+                     vector< UnfoldBias > &results );
+
+// -------------------------------------------------------------------------
+
+#endif
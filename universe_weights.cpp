@@ -0,0 +1,253 @@
+/*
+ * Reweighting universes of the gst events and their covariance matrices
+ *
+ * See universe_weights.h for the description of each function
+ *
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include "TFile.h"
+#include "TFriendElement.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TSystem.h"
+#include "TDirectory.h"
+#include "gst_reader.h"
+#include "universe_weights.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+//
+//                                                DEFINING THE FUNCTIONS
+//
+// ----------------------------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------
+//                      path of the universe weights
+// -------------------------------------------------------------------------
+string GstUniversePath( const string &gst_path ){
+
+    string path = gst_path;
+
+    if( path.size() > 5 && path.compare( path.size() - 5, 5, ".root" ) == 0 ){
+        path.erase( path.size() - 5 );
+    }
+    path += ".universes.root";
+
+    const char* universe_dir = getenv( "SBND_UNIVERSE_DIR" );
+
+    if( !universe_dir ) return path;
+
+    for( unsigned int i = 0; i < path.size(); ++i ){
+        if( path[i] == '/' ) path[i] = '_';
+    }
+
+    return string( universe_dir ) + "/" + path;
+}
+
+// -------------------------------------------------------------------------
+// Whether the universe weights record the stamp of the current gst file
+// -------------------------------------------------------------------------
+static bool CurrentUniverseSource( const string &universe_path,
+                                   const string &source ){
+
+    TDirectory *current = gDirectory;
+    TFile universe_file( universe_path.c_str() );
+
+    TNamed *recorded = universe_file.IsZombie() ? 0 : (TNamed*) universe_file.Get( kGstUniverseSource );
+    bool    current_source = recorded && source == recorded->GetTitle();
+
+    universe_file.Close();
+    if( current ) current->cd();
+
+    return current_source;
+}
+
+// -------------------------------------------------------------------------
+//                      attach the universe weights
+// -------------------------------------------------------------------------
+bool AttachGstUniverses( TTree *event_tree ){
+
+    if( event_tree->GetFriend( kGstUniverseTree ) ) return true;
+
+    TFile *gst_file = event_tree->GetCurrentFile();
+    if( !gst_file ) return false;
+
+    string universe_path = GstUniversePath( gst_file->GetName() );
+
+    FileStat_t universe_stat;
+    if( gSystem->GetPathInfo( universe_path.c_str(), universe_stat ) != 0 ) return false;
+
+    // Weights made for another version of the gst file would be attached
+    // to the wrong events
+    if( !CurrentUniverseSource( universe_path, GstSourceStamp( event_tree ) ) ){
+        cout << " The universe weights in " << universe_path << " were not made for the current gst file and are not used " << endl;
+        return false;
+    }
+
+    TFriendElement *element = event_tree->AddFriend( kGstUniverseTree, universe_path.c_str() );
+    TTree *universes = element ? element->GetTree() : 0;
+
+    if( !universes
+        || universes->GetEntries() != event_tree->GetEntries()
+        || !universes->GetLeaf( kGstUniverseBranch ) ){
+
+        cout << " The universe weights in " << universe_path << " do not match the gst tree and are not used " << endl;
+
+        if( element ){
+            event_tree->GetListOfFriends()->Remove( element );
+            delete element;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------
+//                      source of the universe weights
+// -------------------------------------------------------------------------
+void WriteGstUniverseSource( TTree *event_tree ){
+
+    TNamed recorded( kGstUniverseSource, GstSourceStamp( event_tree ).c_str() );
+    recorded.Write();
+}
+
+// -------------------------------------------------------------------------
+//                      leaf of the universe weights
+// -------------------------------------------------------------------------
+TLeaf *GstUniverseLeaf( TTree *event_tree ){
+
+    TLeaf *leaf = event_tree->GetFriend( kGstUniverseTree ) ? event_tree->GetLeaf( kGstUniverseBranch ) : 0;
+
+    if( !leaf ){
+        cerr << " The universe weights are not attached to " << event_tree->GetName() << endl;
+        exit(1);
+    }
+
+    return leaf;
+}
+
+// -------------------------------------------------------------------------
+//                      number of universes
+// -------------------------------------------------------------------------
+int GstUniverseCount( TTree *event_tree ){
+
+    TLeaf *leaf = GstUniverseLeaf( event_tree );
+
+    Long64_t local_entry = event_tree->LoadTree( 0 );
+    if( local_entry < 0 ) return 0;
+
+    leaf->GetBranch()->GetEntry( local_entry, 1 );
+
+    return leaf->GetLen();
+}
+
+// -------------------------------------------------------------------------
+//                      read the weights of an entry
+// -------------------------------------------------------------------------
+void ReadUniverseWeights( TLeaf *leaf,
+                          Long64_t local_entry,
+                          vector< double > &weights ){
+
+    leaf->GetBranch()->GetEntry( local_entry, 1 );
+
+    int n_universes = weights.size();
+
+    if( leaf->GetLen() < n_universes ){
+        cerr << " Entry " << local_entry << " has " << leaf->GetLen() << " universe weights, the fills need "
+             << n_universes << endl;
+        exit(1);
+    }
+
+    for( int u = 0; u < n_universes; ++u ){
+        weights[u] = leaf->GetValue(u);
+    }
+}
+
+// -------------------------------------------------------------------------
+//                      covariance over the universes
+// -------------------------------------------------------------------------
+void FlatUniverseCovariance( const FlatFill &fill,
+                             vector< double > &mean,
+                             vector< double > &covariance ){
+
+    const FlatUniverses &universes = fill.universes;
+
+    if( universes.cells.empty() ){
+        cerr << " The fill " << fill.variable << " has no universes " << endl;
+        exit(1);
+    }
+
+    int n_universes = universes.n_universes;
+    int n_x         = fill.hist.x.n_bins;
+    int n_y         = fill.hist.y.n_bins;
+    int n_bins      = n_y > 0 ? n_x * n_y : n_x;
+
+    // The deviation of each bin from its mean in each universe, the
+    // universes of a bin next to each other as in the fill
+    mean.assign( n_bins, 0 );
+    vector< double > deviations( Long64_t( n_bins ) * n_universes );
+
+    for( int b = 0; b < n_bins; ++b ){
+
+        int bin_x = b % n_x + 1;
+        int bin_y = n_y > 0 ? b / n_x + 1 : 0;
+        int cell  = bin_x + ( n_x + 2 ) * bin_y;
+
+        const double *block     = &universes.cells[ Long64_t( cell ) * n_universes ];
+        double       *deviation = &deviations[ Long64_t( b ) * n_universes ];
+
+        double sum = 0;
+        for( int u = 0; u < n_universes; ++u ) sum += block[u];
+        mean[b] = sum / n_universes;
+
+        for( int u = 0; u < n_universes; ++u ) deviation[u] = block[u] - mean[b];
+    }
+
+    covariance.assign( Long64_t( n_bins ) * n_bins, 0 );
+
+    for( int i = 0; i < n_bins; ++i ){
+
+        const double *d_i = &deviations[ Long64_t( i ) * n_universes ];
+
+        for( int j = i; j < n_bins; ++j ){
+
+            const double *d_j = &deviations[ Long64_t( j ) * n_universes ];
+
+            double sum = 0;
+            for( int u = 0; u < n_universes; ++u ) sum += d_i[u] * d_j[u];
+
+            covariance[ Long64_t( i ) * n_bins + j ] = sum / n_universes;
+            covariance[ Long64_t( j ) * n_bins + i ] = sum / n_universes;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------
+//                      covariance into a TH2D
+// -------------------------------------------------------------------------
+void CovarianceToTH2( const vector< double > &covariance,
+                      TH2 *h ){
+
+    int n_bins = int( sqrt( double( covariance.size() ) ) + 0.5 );
+
+    if( Long64_t( n_bins ) * n_bins != Long64_t( covariance.size() )
+        || h->GetNbinsX() != n_bins || h->GetNbinsY() != n_bins ){
+        cerr << " The binning of " << h->GetName() << " does not match the covariance matrix " << endl;
+        exit(1);
+    }
+
+    h->Reset();
+
+    for( int i = 0; i < n_bins; ++i ){
+        for( int j = 0; j < n_bins; ++j ){
+            h->SetBinContent( i + 1, j + 1, covariance[ Long64_t( i ) * n_bins + j ] );
+        }
+    }
+}
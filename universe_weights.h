@@ -0,0 +1,98 @@
+/*
+ * Reweighting universes of the gst events and their covariance matrices
+ *
+ * The systematic universes of a model, from GENIE reweighting, are held as
+ * a friend of the gst tree: for each event an array of weights, one per
+ * universe. The fills of flat_hist.h booked with BookFlatUniverses add
+ * each event to its bin of every universe at once, the universes of a bin
+ * next to each other, and FlatUniverseCovariance gives the covariance of
+ * the bins over the universes at the end
+ *
+*/
+
+#ifndef UNIVERSE_WEIGHTS_H
+#define UNIVERSE_WEIGHTS_H
+
+#include <vector>
+#include <string>
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TH2.h"
+#include "flat_hist.h"
+
+using namespace std;
+
+// -------------------------------------------------------------------------
+// The friend tree of universe weights
+//      kGstUniverseTree   : the name of the tree, and of the friend
+//      kGstUniverseCount  : the branch with the number of universes
+//      kGstUniverseBranch : the branch with the weight of the event in each
+//                           universe, kGstUniverseBranch[kGstUniverseCount]
+//      kGstUniverseSource : the TNamed in the same file with the
+//                           GstSourceStamp of the gst file the weights were
+//                           made for, as its title
+// -------------------------------------------------------------------------
+const char* const kGstUniverseTree   = "gst_universes";
+const char* const kGstUniverseCount  = "n_universes";
+const char* const kGstUniverseBranch = "universe_weights";
+const char* const kGstUniverseSource = "gst_source";
+
+// -------------------------------------------------------------------------
+// The file the universe weights of a gst file are read from:
+//      path.universes.root next to the gst file, or below
+//      $SBND_UNIVERSE_DIR if it is set, with the / of the gst path replaced
+//      by _
+// -------------------------------------------------------------------------
+string GstUniversePath( const string &gst_path );
+
+// -------------------------------------------------------------------------
+// Attach the universe weights of a gst tree as a friend, if they have been
+// written for the current version of the gst file, by the GstSourceStamp
+// they record, and have the same number of entries. Returns whether the
+// friend is attached
+// -------------------------------------------------------------------------
+bool AttachGstUniverses( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// Record in the current directory, the file of the universe weights, the
+// GstSourceStamp of the gst tree they were made for
+// -------------------------------------------------------------------------
+void WriteGstUniverseSource( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// The leaf of the universe weights of a tree they are attached to
+// -------------------------------------------------------------------------
+TLeaf *GstUniverseLeaf( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// The number of universes of the first entry of a tree the weights are
+// attached to
+// -------------------------------------------------------------------------
+int GstUniverseCount( TTree *event_tree );
+
+// -------------------------------------------------------------------------
+// Read the weights of the first weights.size() universes of an entry
+// -------------------------------------------------------------------------
+void ReadUniverseWeights( TLeaf *leaf,
+                          Long64_t local_entry,
+                          vector< double > &weights );
+
+// -------------------------------------------------------------------------
+// The mean over the universes of each bin of a fill, without the under
+// and overflow, in the order of the TH1 global bins, and the covariance
+// of each pair of them over the universes, n_bins x n_bins row by row
+// -------------------------------------------------------------------------
+void FlatUniverseCovariance( const FlatFill &fill,
+                             vector< double > &mean,
+                             vector< double > &covariance );
+
+// -------------------------------------------------------------------------
+// Copy a covariance matrix into a TH2D with a bin for each of its rows and
+// columns
+// -------------------------------------------------------------------------
+void CovarianceToTH2( const vector< double > &covariance,
+                      TH2 *h );
+
+// -------------------------------------------------------------------------
+
+#endif